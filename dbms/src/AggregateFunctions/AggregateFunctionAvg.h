@@ -77,6 +77,21 @@ public:
         ++this->data(place).count;
     }
 
+    bool supportRemove() const override
+    {
+        // Subtracting a floating point value can not restore the previous sum exactly.
+        return !std::is_floating_point_v<T>;
+    }
+
+    void remove(AggregateDataPtr __restrict place, const IColumn ** columns, size_t row_num, Arena *) const override
+    {
+        if constexpr (IsDecimal<T>)
+            this->data(place).sum.value -= static_cast<typename TResult::NativeType>(static_cast<const ColumnDecimal<T> &>(*columns[0]).getData()[row_num].value);
+        else
+            this->data(place).sum -= static_cast<const ColumnVector<T> &>(*columns[0]).getData()[row_num];
+        --this->data(place).count;
+    }
+
     void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs, Arena *) const override
     {
         this->data(place).sum += this->data(rhs).sum;
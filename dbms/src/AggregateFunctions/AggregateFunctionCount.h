@@ -54,6 +54,13 @@ public:
         ++data(place).count;
     }
 
+    bool supportRemove() const override { return true; }
+
+    void remove(AggregateDataPtr __restrict place, const IColumn **, size_t, Arena *) const override
+    {
+        --data(place).count;
+    }
+
     void addBatchSinglePlace(
         size_t batch_size,
         AggregateDataPtr place,
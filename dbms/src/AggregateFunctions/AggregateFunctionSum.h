@@ -33,6 +33,11 @@ struct AggregateFunctionSumAddImpl
     {
         lhs += rhs;
     }
+
+    static void NO_SANITIZE_UNDEFINED ALWAYS_INLINE sub(T & lhs, const T & rhs)
+    {
+        lhs -= rhs;
+    }
 };
 
 template <typename T>
@@ -43,6 +48,12 @@ struct AggregateFunctionSumAddImpl<Decimal<T>>
     {
         lhs.value += static_cast<T>(rhs.value);
     }
+
+    template <typename U>
+    static void NO_SANITIZE_UNDEFINED ALWAYS_INLINE sub(Decimal<T> & lhs, const Decimal<U> & rhs)
+    {
+        lhs.value -= static_cast<T>(rhs.value);
+    }
 };
 
 template <typename T>
@@ -59,6 +70,12 @@ struct AggregateFunctionSumData
         Impl::add(sum, value);
     }
 
+    template <typename U>
+    void NO_SANITIZE_UNDEFINED ALWAYS_INLINE remove(U value)
+    {
+        Impl::sub(sum, value);
+    }
+
     /// Vectorized version
     template <typename Value>
     void NO_SANITIZE_UNDEFINED NO_INLINE addMany(const Value * __restrict ptr, size_t count)
@@ -360,6 +377,25 @@ public:
         this->data(place).add(column.getData()[row_num]);
     }
 
+    bool supportRemove() const override
+    {
+        // Subtracting a floating point value can not restore the previous sum exactly.
+        return std::is_same_v<Data, AggregateFunctionSumData<TResult>> && !std::is_floating_point_v<TResult>;
+    }
+
+    void remove(AggregateDataPtr __restrict place, const IColumn ** columns, size_t row_num, Arena *) const override
+    {
+        if constexpr (std::is_same_v<Data, AggregateFunctionSumData<TResult>>)
+        {
+            const auto & column = assert_cast<const ColVecType &>(*columns[0]);
+            this->data(place).remove(column.getData()[row_num]);
+        }
+        else
+        {
+            throw Exception("Method remove is not supported for " + getName(), ErrorCodes::NOT_IMPLEMENTED);
+        }
+    }
+
     /// Vectorized version when there is no GROUP BY keys.
     void addBatchSinglePlace(
         size_t batch_size,
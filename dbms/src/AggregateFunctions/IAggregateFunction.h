@@ -97,6 +97,17 @@ public:
     /// Merges state (on which place points to) with other state of current aggregation function.
     virtual void merge(AggregateDataPtr __restrict place, ConstAggregateDataPtr rhs, Arena * arena) const = 0;
 
+    /** Returns true if the function is invertible, that is `remove` can exactly undo an `add` of the same row.
+      * The aggregate window functions use it to slide the frame without rebuilding the state.
+      */
+    virtual bool supportRemove() const { return false; }
+
+    /// Removes a value which was added by `add` before. Only called if `supportRemove` returns true.
+    virtual void remove(AggregateDataPtr __restrict /*place*/, const IColumn ** /*columns*/, size_t /*row_num*/, Arena * /*arena*/) const
+    {
+        throw Exception("Method remove is not supported for " + getName(), ErrorCodes::NOT_IMPLEMENTED);
+    }
+
     /// Serializes state (to transmit it over the network, for example).
     virtual void serialize(ConstAggregateDataPtr __restrict place, WriteBuffer & buf) const = 0;
 
@@ -14,6 +14,7 @@
 
 #include <Columns/ColumnsCommon.h>
 #include <Columns/IColumn.h>
+#include <Common/TargetSpecific.h>
 #include <common/memcpy.h>
 
 namespace DB
@@ -94,6 +95,57 @@ size_t countBytesInFilterWithNull(const IColumn::Filter & filt, const UInt8 * nu
     return count;
 }
 
+namespace
+{
+TIFLASH_DECLARE_MULTITARGET_FUNCTION(
+    size_t,
+    filterToSelectionImpl,
+    (filt, size, res),
+    (const UInt8 * __restrict filt, size_t size, IColumn::Permutation::value_type * __restrict res),
+    {
+        static constexpr size_t CHUNK_SIZE = 64;
+        size_t count = 0;
+        size_t pos = 0;
+        for (; pos + CHUNK_SIZE <= size; pos += CHUNK_SIZE)
+        {
+            /// Building the mask is vectorized by the compiler with the instructions of the target.
+            UInt64 mask = 0;
+            for (size_t i = 0; i < CHUNK_SIZE; ++i)
+                mask |= static_cast<UInt64>(filt[pos + i] != 0) << i;
+
+            if (mask == std::numeric_limits<UInt64>::max())
+            {
+                for (size_t i = 0; i < CHUNK_SIZE; ++i)
+                    res[count + i] = pos + i;
+                count += CHUNK_SIZE;
+            }
+            else
+            {
+                while (mask)
+                {
+                    res[count++] = pos + __builtin_ctzll(mask);
+                    mask &= mask - 1;
+                }
+            }
+        }
+        /// `res` has room for `size` positions, so it is safe to write before checking the filter.
+        for (; pos < size; ++pos)
+        {
+            res[count] = pos;
+            count += filt[pos] != 0;
+        }
+        return count;
+    })
+} // namespace
+
+size_t filterToSelection(const IColumn::Filter & filt, IColumn::Permutation & selection)
+{
+    selection.resize(filt.size());
+    size_t count = filterToSelectionImpl(filt.data(), filt.size(), selection.data());
+    selection.resize(count);
+    return count;
+}
+
 std::vector<size_t> countColumnsSizeInSelector(IColumn::ColumnIndex num_columns, const IColumn::Selector & selector)
 {
     std::vector<size_t> counts(num_columns);
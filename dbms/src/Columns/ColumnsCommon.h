@@ -26,6 +26,10 @@ size_t countBytesInFilter(const UInt8 * filt, size_t sz);
 size_t countBytesInFilter(const IColumn::Filter & filt);
 size_t countBytesInFilterWithNull(const IColumn::Filter & filt, const UInt8 * null_map);
 
+/// Fills `selection` with the positions of the bytes of `filt` that are not zero, and returns the number of them.
+/// The selection vector can be passed to `IColumn::permute` to gather the rows passing the filter.
+size_t filterToSelection(const IColumn::Filter & filt, IColumn::Permutation & selection);
+
 /// Returns vector with num_columns elements. vector[i] is the count of i values in selector.
 /// Selector must contain values from 0 to num_columns - 1. NOTE: this is not checked.
 std::vector<size_t> countColumnsSizeInSelector(IColumn::ColumnIndex num_columns, const IColumn::Selector & selector);
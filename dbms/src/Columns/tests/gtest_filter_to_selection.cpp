@@ -0,0 +1,78 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnString.h>
+#include <Columns/ColumnsCommon.h>
+#include <Columns/ColumnsNumber.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <random>
+
+namespace DB
+{
+namespace tests
+{
+TEST(FilterToSelectionTest, Basic)
+{
+    std::mt19937_64 rand_gen(42);
+    /// Cover the full chunks, the empty chunks and the tail.
+    for (size_t size : {0, 1, 63, 64, 65, 128, 1000, 8192})
+    {
+        for (size_t percent : {0, 1, 50, 99, 100})
+        {
+            IColumn::Filter filter(size);
+            for (auto & f : filter)
+                f = (rand_gen() % 100 < percent) ? (rand_gen() % 255 + 1) : 0;
+
+            IColumn::Permutation selection;
+            size_t count = filterToSelection(filter, selection);
+            ASSERT_EQ(count, countBytesInFilter(filter));
+            ASSERT_EQ(selection.size(), count);
+
+            size_t pos = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (filter[i])
+                    ASSERT_EQ(selection[pos++], i);
+            }
+        }
+    }
+}
+
+TEST(FilterToSelectionTest, PermuteSameAsFilter)
+try
+{
+    size_t rows = 1000;
+    auto int_column = ColumnInt64::create();
+    auto str_column = ColumnString::create();
+    for (size_t i = 0; i < rows; ++i)
+    {
+        int_column->insert(Field(static_cast<Int64>(i)));
+        str_column->insert(Field(String(i % 17, 'a')));
+    }
+
+    IColumn::Filter filter(rows, 0);
+    for (size_t i = 0; i < rows; i += 13)
+        filter[i] = 1;
+
+    IColumn::Permutation selection;
+    size_t count = filterToSelection(filter, selection);
+    ASSERT_COLUMN_EQ(int_column->filter(filter, count), int_column->permute(selection, count));
+    ASSERT_COLUMN_EQ(str_column->filter(filter, count), str_column->permute(selection, count));
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
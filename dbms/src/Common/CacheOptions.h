@@ -0,0 +1,55 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Exception.h>
+#include <Poco/String.h>
+#include <common/types.h>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int INVALID_CONFIG_PARAMETER;
+}
+
+enum class CachePolicy
+{
+    /// Evict the least recently used entries.
+    LRU,
+    /// Segmented LRU, the entries hit only once are evicted first. See `LRUCache`.
+    SLRU,
+};
+
+/// How a `ShardedCache` is organized.
+struct CacheOptions
+{
+    CachePolicy policy = CachePolicy::LRU;
+    /// The entries are partitioned into shards by the hash of key, each with its own lock.
+    size_t num_shards = 1;
+    /// The ratio of weight of the protected segment in SLRU.
+    double protected_ratio = 0.8;
+
+    static CachePolicy parsePolicy(const String & name)
+    {
+        if (Poco::icompare(name, "LRU") == 0)
+            return CachePolicy::LRU;
+        if (Poco::icompare(name, "SLRU") == 0)
+            return CachePolicy::SLRU;
+        throw Exception("Unknown cache policy: " + name + ", should be LRU or SLRU", ErrorCodes::INVALID_CONFIG_PARAMETER);
+    }
+};
+
+} // namespace DB
@@ -18,6 +18,7 @@
 #include <Common/Logger.h>
 #include <common/logger_useful.h>
 
+#include <algorithm>
 #include <atomic>
 #include <list>
 #include <memory>
@@ -37,6 +38,11 @@ struct TrivialWeightFunction
 /// of that value.
 /// Cache starts to evict entries when their total weight exceeds max_size.
 /// Value weight should not change after insertion.
+///
+/// If `protected_ratio` is greater than 0, the cache works as a segmented LRU (SLRU): new entries are put
+/// into the probationary segment, and only the entries hit again are promoted to the protected segment, which
+/// takes up to `protected_ratio` of max_weight. The entries are evicted from the probationary segment first,
+/// so a large scan that touches every entry once can not flush the hot entries out.
 template <
     typename TKey,
     typename TMapped,
@@ -52,9 +58,11 @@ public:
 public:
     /** Initialize LRUCache with max_weight and max_elements_size.
       * max_elements_size == 0 means no elements size restrictions.
+      * protected_ratio == 0 means plain LRU, otherwise SLRU.
       */
-    explicit LRUCache(size_t max_weight_, size_t max_elements_size_ = 0)
+    explicit LRUCache(size_t max_weight_, size_t max_elements_size_ = 0, double protected_ratio_ = 0)
         : max_weight(std::max(static_cast<size_t>(1), max_weight_))
+        , max_protected_weight(static_cast<size_t>(max_weight * std::clamp(protected_ratio_, 0.0, 1.0)))
         , max_elements_size(max_elements_size_)
     {}
 
@@ -150,7 +158,15 @@ public:
 
         Cell & cell = it->second;
         current_weight -= cell.size;
-        queue.erase(cell.queue_iterator);
+        if (cell.is_protected)
+        {
+            protected_weight -= cell.size;
+            protected_queue.erase(cell.queue_iterator);
+        }
+        else
+        {
+            queue.erase(cell.queue_iterator);
+        }
         cells.erase(it);
     }
 
@@ -177,9 +193,11 @@ public:
     {
         std::lock_guard cache_lock(mutex);
         queue.clear();
+        protected_queue.clear();
         cells.clear();
         insert_tokens.clear();
         current_weight = 0;
+        protected_weight = 0;
         hits = 0;
         misses = 0;
     }
@@ -262,6 +280,8 @@ private:
     {
         MappedPtr value;
         size_t size = 0;
+        /// Whether the cell is in `protected_queue` or `queue`
+        bool is_protected = false;
         LRUQueueIterator queue_iterator;
     };
 
@@ -269,12 +289,18 @@ private:
 
     InsertTokenById insert_tokens;
 
+    /// The probationary segment in SLRU, or all entries in plain LRU.
     LRUQueue queue;
+    /// The protected segment in SLRU, always empty in plain LRU.
+    LRUQueue protected_queue;
     Cells cells;
 
     /// Total weight of values.
     size_t current_weight = 0;
+    /// Total weight of values in `protected_queue`.
+    size_t protected_weight = 0;
     const size_t max_weight;
+    const size_t max_protected_weight;
     const size_t max_elements_size;
 
     mutable std::mutex mutex;
@@ -294,7 +320,22 @@ private:
 
         Cell & cell = it->second;
         /// Move the key to the end of the queue. The iterator remains valid.
-        queue.splice(queue.end(), queue, cell.queue_iterator);
+        if (cell.is_protected)
+        {
+            protected_queue.splice(protected_queue.end(), protected_queue, cell.queue_iterator);
+        }
+        else if (max_protected_weight == 0)
+        {
+            queue.splice(queue.end(), queue, cell.queue_iterator);
+        }
+        else
+        {
+            /// Hit in the probationary segment, promote it to the protected segment.
+            protected_queue.splice(protected_queue.end(), queue, cell.queue_iterator);
+            cell.is_protected = true;
+            protected_weight += cell.size;
+            shrinkProtected();
+        }
 
         return cell.value;
     }
@@ -321,16 +362,44 @@ private:
         else
         {
             current_weight -= cell.size;
-            queue.splice(queue.end(), queue, cell.queue_iterator);
+            if (cell.is_protected)
+            {
+                protected_weight -= cell.size;
+                protected_queue.splice(protected_queue.end(), protected_queue, cell.queue_iterator);
+            }
+            else
+            {
+                queue.splice(queue.end(), queue, cell.queue_iterator);
+            }
         }
 
         cell.value = mapped;
         cell.size = cell.value ? weight_function(key, *cell.value) : 0;
         current_weight += cell.size;
+        if (cell.is_protected)
+        {
+            protected_weight += cell.size;
+            shrinkProtected();
+        }
 
         removeOverflow();
     }
 
+    /// Demote the least recently used entries of the protected segment to the end of the probationary segment.
+    void shrinkProtected()
+    {
+        while (protected_weight > max_protected_weight && protected_queue.size() > 1)
+        {
+            auto it = cells.find(protected_queue.front());
+            RUNTIME_ASSERT(it != cells.end(), "LRUCache became inconsistent. There must be a bug in it.");
+
+            Cell & cell = it->second;
+            queue.splice(queue.end(), protected_queue, cell.queue_iterator);
+            cell.is_protected = false;
+            protected_weight -= cell.size;
+        }
+    }
+
     void removeOverflow()
     {
         size_t current_weight_lost = 0;
@@ -338,7 +407,9 @@ private:
 
         while ((current_weight > max_weight || (max_elements_size != 0 && queue_size > max_elements_size)) && (queue_size > 1))
         {
-            const Key & key = queue.front();
+            /// Evict from the probationary segment first.
+            auto & evict_queue = queue.empty() ? protected_queue : queue;
+            const Key & key = evict_queue.front();
 
             auto it = cells.find(key);
             RUNTIME_ASSERT(it != cells.end(), "LRUCache became inconsistent. There must be a bug in it.");
@@ -346,9 +417,11 @@ private:
             const auto & cell = it->second;
             current_weight -= cell.size;
             current_weight_lost += cell.size;
+            if (cell.is_protected)
+                protected_weight -= cell.size;
 
             cells.erase(it);
-            queue.pop_front();
+            evict_queue.pop_front();
             --queue_size;
         }
 
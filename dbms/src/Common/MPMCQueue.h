@@ -214,6 +214,13 @@ public:
         return static_cast<size_t>(write_pos - read_pos);
     }
 
+    /// Whether `push` would block now, that is the queue is `NORMAL` and full.
+    bool isFull() const
+    {
+        std::unique_lock lock(mu);
+        return isNormal() && write_pos - read_pos >= capacity;
+    }
+
     const String & getCancelReason() const
     {
         std::unique_lock lock(mu);
@@ -35,9 +35,16 @@
     M(UncompressedCacheWeightLost)             \
     M(MarkCacheHits)                           \
     M(MarkCacheMisses)                         \
+    M(MinMaxIndexCacheHits)                    \
+    M(MinMaxIndexCacheMisses)                  \
+    M(DMFilePackCacheHits)                     \
+    M(DMFilePackCacheMisses)                   \
                                                \
     M(ExternalAggregationCompressedBytes)      \
     M(ExternalAggregationUncompressedBytes)    \
+    M(ExternalJoinSpillBuild)                  \
+    M(ExternalJoinRestorePartition)            \
+    M(ExternalJoinOversizedPartition)          \
                                                \
     M(ContextLock)                             \
                                                \
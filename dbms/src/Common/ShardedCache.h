@@ -0,0 +1,131 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/CacheOptions.h>
+#include <Common/HashTable/Hash.h>
+#include <Common/LRUCache.h>
+
+#include <memory>
+#include <vector>
+
+namespace DB
+{
+/// A thread-safe cache with the same interface as `LRUCache`, but the entries are partitioned into
+/// `options.num_shards` shards by the hash of key. Every shard is an `LRUCache` with its own lock and
+/// `max_weight / num_shards` of the weight, so the concurrent lookups of different keys rarely contend.
+/// With the default options (one shard, LRU) it behaves the same as `LRUCache`.
+template <
+    typename TKey,
+    typename TMapped,
+    typename HashFunction = std::hash<TKey>,
+    typename WeightFunction = TrivialWeightFunction<TKey, TMapped>>
+class ShardedCache
+{
+public:
+    using Key = TKey;
+    using Mapped = TMapped;
+    using MappedPtr = std::shared_ptr<Mapped>;
+
+    explicit ShardedCache(size_t max_weight_, const CacheOptions & options = {})
+    {
+        const size_t num_shards = std::max(static_cast<size_t>(1), options.num_shards);
+        const double protected_ratio = options.policy == CachePolicy::SLRU ? options.protected_ratio : 0;
+        shards.reserve(num_shards);
+        for (size_t i = 0; i < num_shards; ++i)
+            shards.emplace_back(std::make_unique<Shard>(*this, max_weight_ / num_shards, protected_ratio));
+    }
+
+    virtual ~ShardedCache() = default;
+
+    MappedPtr get(const Key & key) { return shardOf(key).get(key); }
+
+    void set(const Key & key, const MappedPtr & mapped) { shardOf(key).set(key, mapped); }
+
+    /// See `LRUCache::getOrSet`
+    template <typename LoadFunc>
+    std::pair<MappedPtr, bool> getOrSet(const Key & key, LoadFunc && load_func)
+    {
+        return shardOf(key).getOrSet(key, std::forward<LoadFunc>(load_func));
+    }
+
+    void remove(const Key & key) { shardOf(key).remove(key); }
+
+    void getStats(size_t & out_hits, size_t & out_misses) const
+    {
+        out_hits = 0;
+        out_misses = 0;
+        for (const auto & shard : shards)
+        {
+            size_t hits = 0, misses = 0;
+            shard->getStats(hits, misses);
+            out_hits += hits;
+            out_misses += misses;
+        }
+    }
+
+    size_t weight() const
+    {
+        size_t res = 0;
+        for (const auto & shard : shards)
+            res += shard->weight();
+        return res;
+    }
+
+    size_t count() const
+    {
+        size_t res = 0;
+        for (const auto & shard : shards)
+            res += shard->count();
+        return res;
+    }
+
+    void reset()
+    {
+        for (auto & shard : shards)
+            shard->reset();
+    }
+
+private:
+    class Shard : public LRUCache<Key, Mapped, HashFunction, WeightFunction>
+    {
+    public:
+        Shard(ShardedCache & owner_, size_t max_weight_, double protected_ratio_)
+            : LRUCache<Key, Mapped, HashFunction, WeightFunction>(max_weight_, 0, protected_ratio_)
+            , owner(owner_)
+        {}
+
+    private:
+        void onRemoveOverflowWeightLoss(size_t weight_loss) override { owner.onRemoveOverflowWeightLoss(weight_loss); }
+
+        ShardedCache & owner;
+    };
+
+    Shard & shardOf(const Key & key)
+    {
+        if (shards.size() == 1)
+            return *shards[0];
+        // Mix the hash value, the hash functions like `TrivialHash` may not be well distributed in the low bits.
+        return *shards[intHash64(hash_function(key)) % shards.size()];
+    }
+
+    /// Override this method if you want to track how much weight was lost in removeOverflow method.
+    virtual void onRemoveOverflowWeightLoss(size_t /*weight_loss*/) {}
+
+    HashFunction hash_function;
+    std::vector<std::unique_ptr<Shard>> shards;
+};
+
+} // namespace DB
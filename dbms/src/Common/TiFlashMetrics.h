@@ -184,6 +184,11 @@ namespace DB
         F(type_fullgc_commit, {{"type", "fullgc_commit"}},         ExpBuckets{0.0005, 2, 20}),                                            \
         F(type_clean_external, {{"type", "clean_external"}},       ExpBuckets{0.0005, 2, 20}),                                            \
         F(type_v3, {{"type", "v3"}}, ExpBuckets{0.0005, 2, 20}))                                                                          \
+    M(tiflash_storage_page_restore_duration_seconds, "The duration of restoring PageDirectory of PageStorage V3 from disk", Histogram,    \
+        F(type_load_wal, {{"type", "load_wal"}}, ExpBuckets{0.001, 2, 20}),                                                               \
+        F(type_gc_in_mem, {{"type", "gc_in_mem"}}, ExpBuckets{0.001, 2, 20}),                                                             \
+        F(type_restore_blob_stats, {{"type", "restore_blob_stats"}}, ExpBuckets{0.001, 2, 20}),                                           \
+        F(type_total, {{"type", "total"}}, ExpBuckets{0.001, 2, 20}))                                                                     \
     M(tiflash_storage_page_command_count, "Total number of PageStorage's command, such as write / read / scan / snapshot", Counter,       \
         F(type_write, {"type", "write"}), F(type_read, {"type", "read"}),  F(type_read_page_dir, {"type", "read_page_dir"}),              \
         F(type_read_blob, {"type", "read_blob"}), F(type_scan, {"type", "scan"}), F(type_snapshot, {"type", "snapshot"}))                 \
@@ -0,0 +1,139 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/HashTable/FixedHashMap.h>
+#include <Common/HashTable/HashMap.h>
+#include <Common/HashTable/StringHashMap.h>
+#include <Common/HashTable/TwoLevelHashMap.h>
+#include <benchmark/benchmark.h>
+#include <common/StringRef.h>
+#include <fmt/format.h>
+
+#include <random>
+#include <vector>
+
+namespace DB
+{
+namespace bench
+{
+static std::vector<UInt64> genIntKeys(size_t rows, size_t cardinality)
+{
+    std::mt19937_64 rand_gen(rows ^ cardinality);
+    std::vector<UInt64> keys(rows);
+    for (auto & key : keys)
+        key = rand_gen() % cardinality;
+    return keys;
+}
+
+static std::vector<String> genStringKeys(size_t rows, size_t cardinality, size_t key_size)
+{
+    std::mt19937_64 rand_gen(rows ^ cardinality);
+    std::vector<String> keys(rows);
+    for (auto & key : keys)
+        key = fmt::format("{:0>{}}", rand_gen() % cardinality, key_size);
+    return keys;
+}
+
+template <typename Map>
+static void HashTableIntEmplace(benchmark::State & state)
+{
+    const auto keys = genIntKeys(state.range(0), state.range(1));
+    for (auto _ : state)
+    {
+        Map map;
+        typename Map::LookupResult it;
+        bool inserted;
+        for (const auto & key : keys)
+        {
+            map.emplace(static_cast<typename Map::key_type>(key), it, inserted);
+            ++it->getMapped();
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Map>
+static void HashTableIntFind(benchmark::State & state)
+{
+    const auto keys = genIntKeys(state.range(0), state.range(1));
+    Map map;
+    typename Map::LookupResult it;
+    bool inserted;
+    for (const auto & key : keys)
+        map.emplace(static_cast<typename Map::key_type>(key), it, inserted);
+
+    for (auto _ : state)
+    {
+        size_t found = 0;
+        for (const auto & key : keys)
+            found += map.find(static_cast<typename Map::key_type>(key)) != nullptr;
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Map>
+static void HashTableStringEmplace(benchmark::State & state)
+{
+    const auto keys = genStringKeys(state.range(0), state.range(1), state.range(2));
+    for (auto _ : state)
+    {
+        Map map;
+        typename Map::LookupResult it;
+        bool inserted;
+        for (const auto & key : keys)
+        {
+            map.emplace(StringRef(key), it, inserted);
+            ++it->getMapped();
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+/// Args: {rows, cardinality}
+static void intArgs(benchmark::internal::Benchmark * b)
+{
+    for (int64_t cardinality : {16, 1024, 65536, 1 << 20})
+        b->Args({1 << 20, cardinality});
+}
+
+/// Args: {rows, cardinality, key_size}
+static void stringArgs(benchmark::internal::Benchmark * b)
+{
+    for (int64_t cardinality : {1024, 1 << 20})
+    {
+        /// Cover the different sub maps of StringHashMap.
+        for (int64_t key_size : {4, 16, 24, 64})
+            b->Args({1 << 20, cardinality, key_size});
+    }
+}
+
+using UInt64HashMap = HashMap<UInt64, UInt64, HashCRC32<UInt64>>;
+using UInt64TwoLevelHashMap = TwoLevelHashMap<UInt64, UInt64, HashCRC32<UInt64>>;
+using UInt16FixedHashMap = FixedHashMap<UInt16, UInt64>;
+using StringRefHashMap = HashMapWithSavedHash<StringRef, UInt64>;
+using StringRefStringHashMap = StringHashMap<UInt64>;
+
+BENCHMARK_TEMPLATE(HashTableIntEmplace, UInt64HashMap)->Apply(intArgs);
+BENCHMARK_TEMPLATE(HashTableIntEmplace, UInt64TwoLevelHashMap)->Apply(intArgs);
+BENCHMARK_TEMPLATE(HashTableIntEmplace, UInt16FixedHashMap)->Args({1 << 20, 16})->Args({1 << 20, 1024})->Args({1 << 20, 65536});
+BENCHMARK_TEMPLATE(HashTableIntFind, UInt64HashMap)->Apply(intArgs);
+BENCHMARK_TEMPLATE(HashTableIntFind, UInt64TwoLevelHashMap)->Apply(intArgs);
+BENCHMARK_TEMPLATE(HashTableStringEmplace, StringRefHashMap)->Apply(stringArgs);
+BENCHMARK_TEMPLATE(HashTableStringEmplace, StringRefStringHashMap)->Apply(stringArgs);
+
+} // namespace bench
+} // namespace DB
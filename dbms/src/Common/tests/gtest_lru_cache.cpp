@@ -14,9 +14,13 @@
 
 #include <Common/LRUCache.h>
 #include <Common/Logger.h>
+#include <Common/ShardedCache.h>
 #include <common/types.h>
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <vector>
+
 namespace DB
 {
 namespace tests
@@ -136,5 +140,118 @@ TEST(LRUCacheTest, WeightAfterRemove)
     ASSERT_EQ(cache.weight(), 0);
 }
 
+TEST(LRUCacheTest, SLRUScanResistant)
+{
+    constexpr size_t cache_max_size = 100;
+    auto load = [](Int32 i) {
+        return [i]() {
+            return std::make_shared<Int32>(i);
+        };
+    };
+
+    auto run_scan_after_hot_set = [&](LRUCache<Int32, Int32> & cache) {
+        // The hot set is accessed twice.
+        for (Int32 round = 0; round < 2; ++round)
+        {
+            for (Int32 i = 0; i < 50; ++i)
+                cache.getOrSet(i, load(i));
+        }
+        // A large scan that touches every entry once.
+        for (Int32 i = 1000; i < 2000; ++i)
+            cache.getOrSet(i, load(i));
+
+        size_t hot_hits = 0;
+        for (Int32 i = 0; i < 50; ++i)
+            hot_hits += cache.get(i) != nullptr;
+        return hot_hits;
+    };
+
+    LRUCache<Int32, Int32> lru(cache_max_size);
+    ASSERT_EQ(run_scan_after_hot_set(lru), 0);
+    ASSERT_EQ(lru.count(), cache_max_size);
+
+    LRUCache<Int32, Int32> slru(cache_max_size, 0, 0.8);
+    ASSERT_EQ(run_scan_after_hot_set(slru), 50);
+    ASSERT_EQ(slru.count(), cache_max_size);
+    ASSERT_EQ(slru.weight(), cache_max_size);
+
+    // The protected segment is bounded, the least recently used entries are demoted and then evicted.
+    for (Int32 i = 3000; i < 3080; ++i)
+    {
+        slru.set(i, load(i)());
+        ASSERT_NE(slru.get(i), nullptr);
+    }
+    ASSERT_EQ(slru.count(), cache_max_size);
+    ASSERT_EQ(slru.get(0), nullptr);
+    ASSERT_NE(slru.get(49), nullptr);
+    ASSERT_NE(slru.get(3000), nullptr);
+
+    for (Int32 i = 0; i < 5000; ++i)
+        slru.remove(i);
+    ASSERT_EQ(slru.count(), 0);
+    ASSERT_EQ(slru.weight(), 0);
+}
+
+TEST(ShardedCacheTest, Basic)
+{
+    CacheOptions options;
+    options.policy = CachePolicy::SLRU;
+    options.num_shards = 8;
+    ShardedCache<Int32, size_t, std::hash<Int32>, ValueWeight> cache(8000, options);
+
+    for (Int32 i = 0; i < 40; ++i)
+        cache.set(i, std::make_shared<size_t>(10));
+    ASSERT_EQ(cache.count(), 40);
+    ASSERT_EQ(cache.weight(), 400);
+
+    for (Int32 i = 0; i < 40; ++i)
+    {
+        auto value = cache.get(i);
+        ASSERT_NE(value, nullptr);
+        ASSERT_EQ(*value, 10);
+    }
+    auto [value, loaded] = cache.getOrSet(100, [] { return std::make_shared<size_t>(20); });
+    ASSERT_TRUE(loaded);
+    ASSERT_EQ(*value, 20);
+    ASSERT_EQ(cache.get(101), nullptr);
+
+    size_t hits = 0, misses = 0;
+    cache.getStats(hits, misses);
+    ASSERT_EQ(hits, 40);
+    ASSERT_EQ(misses, 2);
+
+    cache.remove(100);
+    ASSERT_EQ(cache.count(), 40);
+    cache.reset();
+    ASSERT_EQ(cache.count(), 0);
+    ASSERT_EQ(cache.weight(), 0);
+}
+
+TEST(ShardedCacheTest, ConcurrentGetOrSet)
+{
+    CacheOptions options;
+    options.num_shards = 16;
+    ShardedCache<Int32, Int32> cache(1000, options);
+
+    std::vector<std::thread> threads;
+    for (Int32 t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&cache, t]() {
+            for (Int32 i = 0; i < 10000; ++i)
+            {
+                Int32 key = (i * 7 + t) % 5000;
+                auto [value, loaded] = cache.getOrSet(key, [key]() { return std::make_shared<Int32>(key); });
+                ASSERT_EQ(*value, key);
+            }
+        });
+    }
+    for (auto & thread : threads)
+        thread.join();
+
+    // Every shard keeps no more than its own share of weight
+    ASSERT_LE(cache.weight(), 1000);
+    ASSERT_EQ(cache.weight(), cache.count());
+}
+
 } // namespace tests
 } // namespace DB
@@ -685,5 +685,27 @@ try
 }
 CATCH
 
+TEST_F(MPMCQueueTest, isFull)
+try
+{
+    MPMCQueue<int> queue(2);
+    ASSERT_FALSE(queue.isFull());
+    queue.push(1);
+    ASSERT_FALSE(queue.isFull());
+    queue.push(2);
+    ASSERT_TRUE(queue.isFull());
+
+    int value = 0;
+    queue.pop(value);
+    ASSERT_FALSE(queue.isFull());
+
+    // `push` never blocks after the queue is finished.
+    queue.push(3);
+    ASSERT_TRUE(queue.isFull());
+    queue.finish();
+    ASSERT_FALSE(queue.isFull());
+}
+CATCH
+
 } // namespace
 } // namespace DB::tests
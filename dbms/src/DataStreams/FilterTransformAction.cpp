@@ -114,23 +114,35 @@ bool FilterTransformAction::transform(Block & block)
       *  or calculate number of set bytes in the filter.
       */
     size_t first_non_constant_column = 0;
+    size_t non_constant_columns = 0;
     for (size_t i = 0; i < columns; ++i)
     {
         if (!block.safeGetByPosition(i).column->isColumnConst())
         {
-            first_non_constant_column = i;
-
-            if (first_non_constant_column != filter_column)
-                break;
+            if (i != filter_column && non_constant_columns++ == 0)
+                first_non_constant_column = i;
         }
     }
 
+    /** If only a small part of rows pass the filter and there are several columns to filter,
+      *  collect the positions of these rows once and gather them from every column,
+      *  instead of scanning the whole filter again for each column.
+      */
+    IColumn::Permutation selection;
     size_t filtered_rows = 0;
-    if (first_non_constant_column != filter_column)
+    bool first_column_filtered = false;
+    if (non_constant_columns > 1)
+    {
+        filtered_rows = countBytesInFilter(*filter);
+        if (filtered_rows * selective_filter_ratio < rows)
+            filterToSelection(*filter, selection);
+    }
+    else if (non_constant_columns > 0)
     {
         ColumnWithTypeAndName & current_column = block.safeGetByPosition(first_non_constant_column);
         current_column.column = current_column.column->filter(*filter, -1);
         filtered_rows = current_column.column->size();
+        first_column_filtered = true;
     }
     else
     {
@@ -167,11 +179,13 @@ bool FilterTransformAction::transform(Block & block)
             continue;
         }
 
-        if (i == first_non_constant_column)
+        if (i == first_non_constant_column && first_column_filtered)
             continue;
 
         if (current_column.column->isColumnConst())
             current_column.column = current_column.column->cut(0, filtered_rows);
+        else if (!selection.empty() && !current_column.column->isDummy())
+            current_column.column = current_column.column->permute(selection, filtered_rows);
         else
             current_column.column = current_column.column->filter(*filter, filtered_rows);
     }
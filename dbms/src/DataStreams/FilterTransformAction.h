@@ -34,6 +34,9 @@ public:
     ExpressionActionsPtr getExperssion() const;
 
 private:
+    /// Gather the rows by a selection vector if less than 1/selective_filter_ratio of rows pass the filter.
+    static constexpr size_t selective_filter_ratio = 8;
+
     Block header;
     ExpressionActionsPtr expression;
     size_t filter_column;
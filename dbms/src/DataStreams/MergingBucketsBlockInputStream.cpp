@@ -0,0 +1,129 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataStreams/MergingBucketsBlockInputStream.h>
+#include <DataStreams/ParallelAggregatingBlockInputStream.h>
+
+namespace DB
+{
+MergingBucketsBlockInputStream::SharedState::SharedState(
+    const std::shared_ptr<ParallelAggregatingBlockInputStream> & aggregating_,
+    size_t concurrency_)
+    : aggregating(aggregating_)
+    , concurrency(concurrency_)
+{}
+
+Block MergingBucketsBlockInputStream::SharedState::read(size_t concurrency_index)
+{
+    {
+        std::lock_guard lock(mutex);
+        if (!started)
+        {
+            started = true;
+            try
+            {
+                aggregating->startAggregation();
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+        }
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+    /// All the output streams return the bypassed blocks while aggregating, until all the aggregating threads are done.
+    Block block;
+    if (aggregating->popBypassedBlock(block))
+        return block;
+
+    {
+        std::lock_guard lock(mutex);
+        if (!aggregated)
+        {
+            aggregated = true;
+            try
+            {
+                merging_buckets = aggregating->aggregateAndGetMergingBuckets(concurrency);
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+        }
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+    if (merging_buckets)
+        return merging_buckets->getData(concurrency_index);
+
+    /// The aggregated data is spilled to disk or the aggregation is cancelled.
+    return concurrency_index == 0 ? aggregating->read() : Block{};
+}
+
+void MergingBucketsBlockInputStream::SharedState::finish()
+{
+    /// Finish the aggregation after all the output streams are finished, so that no one is reading it.
+    if (finished_count.fetch_add(1) + 1 < concurrency)
+        return;
+
+    std::lock_guard lock(mutex);
+    if (started)
+        aggregating->readSuffix();
+}
+
+BlockInputStreams MergingBucketsBlockInputStream::build(
+    const std::shared_ptr<ParallelAggregatingBlockInputStream> & aggregating,
+    size_t concurrency)
+{
+    auto state = std::make_shared<SharedState>(aggregating, concurrency);
+    BlockInputStreams streams;
+    streams.reserve(concurrency);
+    for (size_t i = 0; i < concurrency; ++i)
+        streams.push_back(std::make_shared<MergingBucketsBlockInputStream>(state, i));
+    return streams;
+}
+
+MergingBucketsBlockInputStream::MergingBucketsBlockInputStream(
+    const std::shared_ptr<SharedState> & state_,
+    size_t concurrency_index_)
+    : state(state_)
+    , concurrency_index(concurrency_index_)
+{
+    children.push_back(state->getAggregating());
+}
+
+Block MergingBucketsBlockInputStream::getHeader() const
+{
+    return state->getAggregating()->getHeader();
+}
+
+void MergingBucketsBlockInputStream::readSuffix()
+{
+    if (finished)
+        return;
+    finished = true;
+    state->finish();
+}
+
+Block MergingBucketsBlockInputStream::readImpl()
+{
+    if (isCancelledOrThrowIfKilled())
+        return {};
+    return state->read(concurrency_index);
+}
+
+} // namespace DB
@@ -0,0 +1,83 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <DataStreams/IProfilingBlockInputStream.h>
+#include <Interpreters/Aggregator.h>
+
+namespace DB
+{
+class ParallelAggregatingBlockInputStream;
+
+/** One of the output streams of a ParallelAggregatingBlockInputStream, which return the merged data in parallel, see `MergingBuckets`.
+  * It replaces a single ParallelAggregatingBlockInputStream followed by a SharedQueryBlockInputStream, so that merging and
+  *  converting the buckets is not serialized by the single stream, and is not limited by its thread pool.
+  *
+  * The blocks aggregated in bypass mode are returned by any output stream while aggregating. After all the aggregating
+  *  threads are done, the merging is prepared by the output stream read first, and the others wait for it.
+  * If the aggregated data is spilled to disk, all the blocks are returned by the first output stream.
+  */
+class MergingBucketsBlockInputStream : public IProfilingBlockInputStream
+{
+    static constexpr auto NAME = "MergingBuckets";
+
+public:
+    /// The state shared by all the output streams of an aggregation.
+    class SharedState
+    {
+    public:
+        SharedState(const std::shared_ptr<ParallelAggregatingBlockInputStream> & aggregating_, size_t concurrency_);
+
+        Block read(size_t concurrency_index);
+        void finish();
+
+        const std::shared_ptr<ParallelAggregatingBlockInputStream> & getAggregating() const { return aggregating; }
+
+    private:
+        const std::shared_ptr<ParallelAggregatingBlockInputStream> aggregating;
+        const size_t concurrency;
+
+        std::mutex mutex;
+        bool started = false;
+        bool aggregated = false;
+        std::exception_ptr exception;
+        MergingBucketsPtr merging_buckets;
+
+        std::atomic<size_t> finished_count{0};
+    };
+
+    /// Create `concurrency` output streams of `aggregating`.
+    static BlockInputStreams build(const std::shared_ptr<ParallelAggregatingBlockInputStream> & aggregating, size_t concurrency);
+
+    MergingBucketsBlockInputStream(const std::shared_ptr<SharedState> & state_, size_t concurrency_index_);
+
+    String getName() const override { return NAME; }
+
+    Block getHeader() const override;
+
+    /// The aggregation is shared by all the output streams, it is started and finished by `SharedState` only once.
+    void readPrefix() override {}
+    void readSuffix() override;
+
+protected:
+    Block readImpl() override;
+
+private:
+    const std::shared_ptr<SharedState> state;
+    const size_t concurrency_index;
+    bool finished = false;
+};
+
+} // namespace DB
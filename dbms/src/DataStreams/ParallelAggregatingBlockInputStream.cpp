@@ -28,7 +28,9 @@ ParallelAggregatingBlockInputStream::ParallelAggregatingBlockInputStream(
     bool final_,
     size_t max_threads_,
     size_t temporary_data_merge_threads_,
-    const String & req_id)
+    const String & req_id,
+    size_t bypass_sample_rows_,
+    double bypass_ratio_threshold_)
     : log(Logger::get(req_id))
     , params(params_)
     , aggregator(params, req_id)
@@ -36,6 +38,8 @@ ParallelAggregatingBlockInputStream::ParallelAggregatingBlockInputStream(
     , final(final_)
     , max_threads(std::min(inputs.size(), max_threads_))
     , temporary_data_merge_threads(temporary_data_merge_threads_)
+    , bypass_sample_rows(bypass_sample_rows_)
+    , bypass_ratio_threshold(bypass_ratio_threshold_)
     , keys_size(params.keys_size)
     , aggregates_size(params.aggregates_size)
     , handler(*this)
@@ -43,6 +47,17 @@ ParallelAggregatingBlockInputStream::ParallelAggregatingBlockInputStream(
 {
     children = inputs;
     children.insert(children.end(), additional_inputs_at_end.begin(), additional_inputs_at_end.end());
+
+    if (bypass_sample_rows > 0)
+        bypass_queue = std::make_unique<MPMCQueue<Block>>(max_threads * 2);
+}
+
+ParallelAggregatingBlockInputStream::~ParallelAggregatingBlockInputStream()
+{
+    /// The threads may be blocked on pushing into the bypass queue that is no longer read,
+    /// wake them up before `processor` waits for them.
+    if (bypass_queue)
+        bypass_queue->cancel();
 }
 
 
@@ -62,6 +77,9 @@ void ParallelAggregatingBlockInputStream::cancel(bool kill)
 
     if (!executed)
         processor.cancel(kill);
+
+    if (bypass_queue)
+        bypass_queue->cancel();
 }
 
 
@@ -69,10 +87,12 @@ Block ParallelAggregatingBlockInputStream::readImpl()
 {
     if (!executed)
     {
-        Aggregator::CancellationHook hook = [&]() {
-            return this->isCancelled();
-        };
-        aggregator.setCancellationHook(hook);
+        startAggregation();
+
+        /// Return the blocks of the threads in bypass mode while the others are still aggregating.
+        Block block;
+        if (popBypassedBlock(block))
+            return block;
 
         execute();
 
@@ -87,32 +107,7 @@ Block ParallelAggregatingBlockInputStream::readImpl()
         }
         else
         {
-            /** If there are temporary files with partially-aggregated data on the disk,
-                *  then read and merge them, spending the minimum amount of memory.
-                */
-
-            const auto & files = aggregator.getTemporaryFiles();
-            BlockInputStreams input_streams;
-            for (const auto & file : files.files)
-            {
-                temporary_inputs.emplace_back(std::make_unique<TemporaryFileStream>(file->path(), file_provider));
-                input_streams.emplace_back(temporary_inputs.back()->block_in);
-            }
-
-            LOG_TRACE(
-                log,
-                "Will merge {} temporary files of size {:.2f} MiB compressed, {:.2f} MiB uncompressed.",
-                files.files.size(),
-                (files.sum_size_compressed / 1048576.0),
-                (files.sum_size_uncompressed / 1048576.0));
-
-            impl = std::make_unique<MergingAggregatedMemoryEfficientBlockInputStream>(
-                input_streams,
-                params,
-                final,
-                temporary_data_merge_threads,
-                temporary_data_merge_threads,
-                log->identifier());
+            impl = mergeTemporaryFiles();
         }
 
         executed = true;
@@ -125,19 +120,136 @@ Block ParallelAggregatingBlockInputStream::readImpl()
     return impl->read();
 }
 
+void ParallelAggregatingBlockInputStream::startAggregation()
+{
+    if (started)
+        return;
+
+    Aggregator::CancellationHook hook = [&]() {
+        return this->isCancelled();
+    };
+    aggregator.setCancellationHook(hook);
+
+    started = true;
+    startExecute();
+}
+
+bool ParallelAggregatingBlockInputStream::popBypassedBlock(Block & block)
+{
+    /// The queue is finished after all threads are done, or cancelled with the stream.
+    return bypass_queue && bypass_queue->pop(block) == MPMCQueueResult::OK;
+}
+
+MergingBucketsPtr ParallelAggregatingBlockInputStream::aggregateAndGetMergingBuckets(size_t concurrency)
+{
+    RUNTIME_CHECK(!executed);
+
+    startAggregation();
+    execute();
+    executed = true;
+
+    if (isCancelledOrThrowIfKilled())
+        return nullptr;
+
+    if (aggregator.hasTemporaryFiles())
+    {
+        impl = mergeTemporaryFiles();
+        return nullptr;
+    }
+
+    return std::make_shared<MergingBuckets>(aggregator, aggregator.prepareVariantsToMerge(many_data), final, concurrency);
+}
+
+std::unique_ptr<IBlockInputStream> ParallelAggregatingBlockInputStream::mergeTemporaryFiles()
+{
+    /** If there are temporary files with partially-aggregated data on the disk,
+      *  then read and merge them, spending the minimum amount of memory.
+      */
+    const auto & files = aggregator.getTemporaryFiles();
+    BlockInputStreams input_streams;
+    for (const auto & file : files.files)
+    {
+        temporary_inputs.emplace_back(std::make_unique<TemporaryFileStream>(file->path(), file_provider));
+        input_streams.emplace_back(temporary_inputs.back()->block_in);
+    }
+
+    LOG_TRACE(
+        log,
+        "Will merge {} temporary files of size {:.2f} MiB compressed, {:.2f} MiB uncompressed.",
+        files.files.size(),
+        (files.sum_size_compressed / 1048576.0),
+        (files.sum_size_uncompressed / 1048576.0));
+
+    return std::make_unique<MergingAggregatedMemoryEfficientBlockInputStream>(
+        input_streams,
+        params,
+        final,
+        temporary_data_merge_threads,
+        temporary_data_merge_threads,
+        log->identifier());
+}
+
 void ParallelAggregatingBlockInputStream::Handler::onBlock(Block & block, size_t thread_num)
 {
-    parent.aggregator.executeOnBlock(
+    auto & thread_data = parent.threads_data[thread_num];
+    if (thread_data.bypass)
+    {
+        parent.bypassBlock(block, thread_num);
+    }
+    else
+    {
+        parent.aggregator.executeOnBlock(
+            block,
+            *parent.many_data[thread_num],
+            parent.file_provider,
+            thread_data.key_columns,
+            thread_data.aggregate_columns,
+            thread_data.local_delta_memory,
+            parent.no_more_keys);
+    }
+
+    thread_data.src_rows += block.rows();
+    thread_data.src_bytes += block.bytes();
+
+    if (parent.bypass_sample_rows > 0 && !thread_data.bypass_checked && thread_data.src_rows >= parent.bypass_sample_rows)
+    {
+        thread_data.bypass_checked = true;
+        size_t keys = parent.many_data[thread_num]->size();
+        if (keys >= parent.bypass_ratio_threshold * thread_data.src_rows)
+        {
+            thread_data.bypass = true;
+            LOG_DEBUG(
+                parent.log,
+                "Thread {} aggregated {} rows to {} keys, bypass the partial aggregation for the rest blocks",
+                thread_num,
+                thread_data.src_rows,
+                keys);
+        }
+    }
+}
+
+void ParallelAggregatingBlockInputStream::bypassBlock(const Block & block, size_t thread_num)
+{
+    auto & thread_data = threads_data[thread_num];
+    AggregatedDataVariants data;
+    aggregator.executeOnBlock(
         block,
-        *parent.many_data[thread_num],
-        parent.file_provider,
-        parent.threads_data[thread_num].key_columns,
-        parent.threads_data[thread_num].aggregate_columns,
-        parent.threads_data[thread_num].local_delta_memory,
-        parent.no_more_keys);
-
-    parent.threads_data[thread_num].src_rows += block.rows();
-    parent.threads_data[thread_num].src_bytes += block.bytes();
+        data,
+        file_provider,
+        thread_data.key_columns,
+        thread_data.aggregate_columns,
+        thread_data.local_delta_memory,
+        no_more_keys);
+
+    for (auto & res : aggregator.convertToBlocks(data, final, 1))
+    {
+        if (!res)
+            continue;
+        thread_data.bypass_rows += res.rows();
+        /// Return false only if the queue is cancelled, then the result is not needed any more.
+        if (bypass_queue->push(std::move(res)) != MPMCQueueResult::OK)
+            return;
+    }
 }
 
 void ParallelAggregatingBlockInputStream::Handler::onFinishThread(size_t thread_num)
@@ -157,6 +269,9 @@ void ParallelAggregatingBlockInputStream::Handler::onFinishThread(size_t thread_
 
 void ParallelAggregatingBlockInputStream::Handler::onFinish()
 {
+    if (parent.bypass_queue)
+        parent.bypass_queue->finish();
+
     if (!parent.isCancelled() && parent.aggregator.hasTemporaryFiles())
     {
         /// It may happen that some data has not yet been flushed,
@@ -184,7 +299,7 @@ void ParallelAggregatingBlockInputStream::Handler::onException(std::exception_pt
 }
 
 
-void ParallelAggregatingBlockInputStream::execute()
+void ParallelAggregatingBlockInputStream::startExecute()
 {
     many_data.resize(max_threads);
     exceptions.resize(max_threads);
@@ -194,12 +309,16 @@ void ParallelAggregatingBlockInputStream::execute()
 
     LOG_TRACE(log, "Aggregating");
 
-    Stopwatch watch;
+    aggregate_watch.restart();
 
     for (auto & elem : many_data)
         elem = std::make_shared<AggregatedDataVariants>();
 
     processor.process();
+}
+
+void ParallelAggregatingBlockInputStream::execute()
+{
     processor.wait();
 
     if (first_exception_index != -1)
@@ -208,7 +327,7 @@ void ParallelAggregatingBlockInputStream::execute()
     if (isCancelledOrThrowIfKilled())
         return;
 
-    double elapsed_seconds = watch.elapsedSeconds();
+    double elapsed_seconds = aggregate_watch.elapsedSeconds();
 
     size_t total_src_rows = 0;
     size_t total_src_bytes = 0;
@@ -219,7 +338,7 @@ void ParallelAggregatingBlockInputStream::execute()
             log,
             "Aggregated. {} to {} rows (from {:.3f} MiB) in {:.3f} sec. ({:.3f} rows/sec., {:.3f} MiB/sec.)",
             threads_data[i].src_rows,
-            rows,
+            rows + threads_data[i].bypass_rows,
             (threads_data[i].src_bytes / 1048576.0),
             elapsed_seconds,
             threads_data[i].src_rows / elapsed_seconds,
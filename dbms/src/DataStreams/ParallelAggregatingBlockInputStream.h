@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Common/MPMCQueue.h>
 #include <DataStreams/IProfilingBlockInputStream.h>
 #include <DataStreams/ParallelInputsProcessor.h>
 #include <DataStreams/TemporaryFileStream.h>
@@ -24,6 +25,12 @@ namespace DB
   * Makes aggregation of blocks from different sources independently in different threads, then combines the results.
   * If final == false, aggregate functions are not finalized, that is, they are not replaced by their value, but contain an intermediate state of calculations.
   * This is necessary so that aggregation can continue (for example, by combining streams of partially aggregated data).
+  *
+  * If `bypass_sample_rows_` > 0, the aggregation is the partial (first) phase of a two-phase aggregation, and the
+  *  output will be aggregated again. After aggregating `bypass_sample_rows_` rows, a thread checks how much its hash
+  *  table reduces the rows. If the number of keys is more than `bypass_ratio_threshold_` of the rows, e.g. group by
+  *  a unique id, building the whole hash table is a waste of CPU and memory. Then the thread stops inserting into its
+  *  hash table, but aggregates every following block alone and returns it at once, leaving the work to the final phase.
   */
 class ParallelAggregatingBlockInputStream : public IProfilingBlockInputStream
 {
@@ -40,7 +47,11 @@ public:
         bool final_,
         size_t max_threads_,
         size_t temporary_data_merge_threads_,
-        const String & req_id);
+        const String & req_id,
+        size_t bypass_sample_rows_ = 0,
+        double bypass_ratio_threshold_ = 1.0);
+
+    ~ParallelAggregatingBlockInputStream() override;
 
     String getName() const override { return NAME; }
 
@@ -53,6 +64,21 @@ public:
         cnt += processor.getMaxThreads();
     }
 
+    /// Start the aggregating threads if they are not started yet.
+    void startAggregation();
+
+    /** Pop a block aggregated by the threads in bypass mode, can be called by multiple threads after `startAggregation`.
+      * Return false if the bypass is not enabled, or all the threads are done or cancelled.
+      */
+    bool popBypassedBlock(Block & block);
+
+    /** Aggregate all the inputs instead of `read`, and return the result to be read by `concurrency` streams in parallel.
+      * Return nullptr if the aggregated data is spilled to disk or the stream is cancelled, then the result is read by `read`.
+      * With the bypass of the partial aggregation, the bypassed blocks must be popped by `popBypassedBlock` before,
+      *  otherwise the threads are blocked on the full queue.
+      */
+    MergingBucketsPtr aggregateAndGetMergingBuckets(size_t concurrency);
+
 protected:
     /// Do nothing that preparation to execution of the query be done in parallel, in ParallelInputsProcessor.
     void readPrefix() override
@@ -72,6 +98,8 @@ private:
     bool final;
     size_t max_threads;
     size_t temporary_data_merge_threads;
+    const size_t bypass_sample_rows;
+    const double bypass_ratio_threshold;
 
     size_t keys_size;
     size_t aggregates_size;
@@ -83,7 +111,12 @@ private:
       */
     bool no_more_keys = false;
 
+    bool started = false;
     std::atomic<bool> executed{false};
+    Stopwatch aggregate_watch;
+
+    /// The blocks aggregated by the threads in bypass mode, only used if `bypass_sample_rows` > 0.
+    std::unique_ptr<MPMCQueue<Block>> bypass_queue;
 
     TemporaryFileStreams temporary_inputs;
 
@@ -96,6 +129,10 @@ private:
         size_t src_rows = 0;
         size_t src_bytes = 0;
         Int64 local_delta_memory = 0;
+        /// Whether the reduction ratio has been checked after the sample
+        bool bypass_checked = false;
+        bool bypass = false;
+        size_t bypass_rows = 0;
 
         ColumnRawPtrs key_columns;
         Aggregator::AggregateColumns aggregate_columns;
@@ -132,8 +169,17 @@ private:
     ParallelInputsProcessor<Handler> processor;
 
 
+    /// Start aggregating in the background threads.
+    void startExecute();
+    /// Wait for the threads to finish aggregating.
     void execute();
 
+    /// Aggregate a block alone and push the result into `bypass_queue`.
+    void bypassBlock(const Block & block, size_t thread_num);
+
+    /// Read and merge the partially-aggregated data spilled to disk.
+    std::unique_ptr<IBlockInputStream> mergeTemporaryFiles();
+
 
     /** From here we get the finished blocks after the aggregation.
       */
@@ -68,6 +68,9 @@ class TiRemoteBlockInputStream : public IProfilingBlockInputStream
 
     std::unique_ptr<CHBlockChunkDecodeAndSquash> decoder_ptr;
 
+    // only used by `tryRead`
+    bool finished = false;
+
     void initRemoteExecutionSummaries(tipb::SelectResponse & resp, size_t index)
     {
         for (const auto & execution_summary : resp.execution_summaries())
@@ -126,51 +129,76 @@ class TiRemoteBlockInputStream : public IProfilingBlockInputStream
         }
     }
 
+    enum class FetchResult
+    {
+        // some rows are decoded into `block_queue`
+        fetched,
+        // the result is consumed but no row is decoded
+        notFetched,
+        finished,
+    };
+
+    template <typename RemoteResult>
+    FetchResult handleRemoteResult(RemoteResult & result)
+    {
+        if (result.meet_error)
+        {
+            LOG_WARNING(log, "remote reader meets error: {}", result.error_msg);
+            throw Exception(result.error_msg);
+        }
+        if (result.eof)
+        {
+            LOG_DEBUG(log, "remote reader meets eof");
+            return FetchResult::finished;
+        }
+        if (result.resp != nullptr && result.resp->has_error())
+        {
+            LOG_WARNING(log, "remote reader meets error: {}", result.resp->error().DebugString());
+            throw Exception(result.resp->error().DebugString());
+        }
+
+        size_t index = 0;
+        if constexpr (is_streaming_reader)
+            index = result.call_index;
+
+        /// only the last response contains execution summaries
+        if (result.resp != nullptr)
+            addRemoteExecutionSummaries(*result.resp, index);
+
+        const auto & decode_detail = result.decode_detail;
+        auto & connection_profile_info = connection_profile_infos[index];
+        connection_profile_info.packets += decode_detail.packets;
+        connection_profile_info.bytes += decode_detail.packet_bytes;
+        connection_profile_info.uncompressed_bytes += decode_detail.uncompressed_bytes;
+        connection_profile_info.compressed_bytes += decode_detail.compressed_bytes;
+        connection_profile_info.compression_time_ns += decode_detail.compression_time_ns;
+
+        total_rows += decode_detail.rows;
+        LOG_TRACE(
+            log,
+            "recv {} rows from remote for {}, total recv row num: {}",
+            decode_detail.rows,
+            result.req_info,
+            total_rows);
+
+        return decode_detail.rows > 0 ? FetchResult::fetched : FetchResult::notFetched;
+    }
+
     bool fetchRemoteResult()
     {
         while (true)
         {
             auto result = remote_reader->nextResult(block_queue, sample_block, stream_id, decoder_ptr);
-            if (result.meet_error)
+            switch (handleRemoteResult(result))
             {
-                LOG_WARNING(log, "remote reader meets error: {}", result.error_msg);
-                throw Exception(result.error_msg);
-            }
-            if (result.eof)
-            {
-                LOG_DEBUG(log, "remote reader meets eof");
+            case FetchResult::fetched:
+                return true;
+            case FetchResult::finished:
                 return false;
+            case FetchResult::notFetched:
+                // continue
+                break;
             }
-            if (result.resp != nullptr && result.resp->has_error())
-            {
-                LOG_WARNING(log, "remote reader meets error: {}", result.resp->error().DebugString());
-                throw Exception(result.resp->error().DebugString());
-            }
-
-            size_t index = 0;
-            if constexpr (is_streaming_reader)
-                index = result.call_index;
-
-            /// only the last response contains execution summaries
-            if (result.resp != nullptr)
-                addRemoteExecutionSummaries(*result.resp, index);
-
-            const auto & decode_detail = result.decode_detail;
-            auto & connection_profile_info = connection_profile_infos[index];
-            connection_profile_info.packets += decode_detail.packets;
-            connection_profile_info.bytes += decode_detail.packet_bytes;
-
-            total_rows += decode_detail.rows;
-            LOG_TRACE(
-                log,
-                "recv {} rows from remote for {}, total recv row num: {}",
-                decode_detail.rows,
-                result.req_info,
-                total_rows);
-
-            if (decode_detail.rows > 0)
-                return true;
-            // else continue
         }
     }
 
@@ -228,6 +256,31 @@ public:
         return block;
     }
 
+    /// The non-blocking version of `read` used by the pipeline model, only for the streaming reader.
+    /// Return false if there is no data received now, otherwise `block` is set to the next block,
+    /// which is empty at the end of data.
+    /// Note that the profile info of the stream is not updated here.
+    bool tryRead(Block & block)
+    {
+        static_assert(is_streaming_reader);
+        while (block_queue.empty())
+        {
+            if (finished)
+            {
+                block = {};
+                return true;
+            }
+            auto result = remote_reader->tryNextResult(block_queue, sample_block, stream_id, decoder_ptr);
+            if (!result)
+                return false;
+            if (handleRemoteResult(*result) == FetchResult::finished)
+                finished = true;
+        }
+        block = std::move(block_queue.front());
+        block_queue.pop();
+        return true;
+    }
+
     const std::unordered_map<String, ExecutionSummary> * getRemoteExecutionSummaries(size_t index)
     {
         return execution_summaries_inited[index].load() ? &execution_summaries[index] : nullptr;
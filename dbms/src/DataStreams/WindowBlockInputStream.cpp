@@ -80,6 +80,7 @@ void WindowTransformAction::initialWorkspaces()
         WindowFunctionWorkspace workspace;
         workspace.window_function = window_function_description.window_function;
         workspace.arguments = window_function_description.arguments;
+        workspace.state = workspace.window_function->createState();
         workspaces.push_back(std::move(workspace));
     }
     only_have_row_number = onlyHaveRowNumber();
@@ -271,14 +272,25 @@ void WindowTransformAction::advanceFrameStart()
         break;
     case WindowFrame::BoundaryType::Current:
     {
-        RUNTIME_CHECK_MSG(
-            only_have_pure_window,
-            "window function only support pure window function in WindowFrame::BoundaryType::Current now.");
-        frame_start = current_row;
+        // For RANGE frame, the frame starts at the first peer of the current row.
+        // The pure window functions don't depend on the frame, so simply use the
+        // current row for them.
+        if (window_description.frame.type == WindowFrame::FrameType::Rows || only_have_pure_window)
+        {
+            frame_start = current_row;
+            frame_start_row_number = current_row_number;
+        }
+        else
+        {
+            frame_start = peer_group_start;
+            frame_start_row_number = peer_group_start_row_number;
+        }
         frame_started = true;
         break;
     }
     case WindowFrame::BoundaryType::Offset:
+        advanceFrameStartRowsOffset();
+        break;
     default:
         throw Exception(
             ErrorCodes::NOT_IMPLEMENTED,
@@ -287,6 +299,39 @@ void WindowTransformAction::advanceFrameStart()
     }
 }
 
+void WindowTransformAction::advanceFrameStartRowsOffset()
+{
+    if (window_description.frame.type != WindowFrame::FrameType::Rows)
+        throw Exception(
+            ErrorCodes::NOT_IMPLEMENTED,
+            "The frame type '{}' with offset boundary is not implemented",
+            frameTypeToString(window_description.frame.type));
+
+    // The frame starts at the row `current_row_number -/+ offset` of the
+    // partition, and it is cut off at the partition start. The frame start
+    // never moves backward, so we can move it from where it was.
+    const auto offset = window_description.frame.begin_offset.get<UInt64>();
+    UInt64 target_row_number;
+    if (window_description.frame.begin_preceding)
+        target_row_number = current_row_number > offset ? current_row_number - offset : 1;
+    else
+        target_row_number = current_row_number + offset;
+
+    while (frame_start_row_number < target_row_number)
+    {
+        if (frame_start == partition_end)
+        {
+            // The frame starts after the partition end, so the frame is empty.
+            // If the partition hasn't ended, wait for more input data.
+            frame_started = partition_ended;
+            return;
+        }
+        advanceRowNumber(frame_start);
+        ++frame_start_row_number;
+    }
+    frame_started = true;
+}
+
 bool WindowTransformAction::arePeers(const RowNumber & x, const RowNumber & y) const
 {
     if (x == y)
@@ -343,12 +388,64 @@ void WindowTransformAction::advanceFrameEndCurrentRow()
     assert(frame_end.block == partition_end.block
            || frame_end.block + 1 == partition_end.block);
 
-    // If window only have row_number or rank/dense_rank functions, set frame_end to the next row of current_row and frame_ended to true
-    RUNTIME_CHECK_MSG(
-        only_have_pure_window,
-        "window function only support pure window function in WindowFrame::BoundaryType::Current now.");
+    // For ROWS frame, or if window only have row_number or rank/dense_rank functions,
+    // set frame_end to the next row of current_row and frame_ended to true
     frame_end = current_row;
     advanceRowNumber(frame_end);
+    frame_end_row_number = current_row_number + 1;
+    frame_ended = true;
+}
+
+void WindowTransformAction::advanceFrameEndRangeCurrentRow()
+{
+    // For RANGE frame, the frame ends after the last peer of the current row.
+    // The frame_end of the previous row is not after the current row, so we
+    // can search from it.
+    assert(current_row <= frame_end);
+    while (frame_end < partition_end)
+    {
+        if (!arePeers(current_row, frame_end))
+        {
+            frame_ended = true;
+            return;
+        }
+        advanceRowNumber(frame_end);
+        ++frame_end_row_number;
+    }
+    // All the rows till the partition end are peers, wait for more input data
+    // if the partition hasn't ended.
+    frame_ended = partition_ended;
+}
+
+void WindowTransformAction::advanceFrameEndRowsOffset()
+{
+    if (window_description.frame.type != WindowFrame::FrameType::Rows)
+        throw Exception(
+            ErrorCodes::NOT_IMPLEMENTED,
+            "The frame type '{}' with offset boundary is not implemented",
+            frameTypeToString(window_description.frame.type));
+
+    // The frame ends at the row `current_row_number -/+ offset` of the
+    // partition, and frame_end is past-the-end of it.
+    const auto offset = window_description.frame.end_offset.get<UInt64>();
+    UInt64 target_row_number;
+    if (window_description.frame.end_preceding)
+        target_row_number = current_row_number > offset ? current_row_number - offset + 1 : 1;
+    else
+        target_row_number = current_row_number + offset + 1;
+
+    while (frame_end_row_number < target_row_number)
+    {
+        if (frame_end == partition_end)
+        {
+            // The frame is cut off at the partition end. If the partition
+            // hasn't ended, wait for more input data.
+            frame_ended = partition_ended;
+            return;
+        }
+        advanceRowNumber(frame_end);
+        ++frame_end_row_number;
+    }
     frame_ended = true;
 }
 
@@ -360,6 +457,7 @@ void WindowTransformAction::advanceFrameEnd()
     if (frame_end < frame_start)
     {
         frame_end = frame_start;
+        frame_end_row_number = frame_start_row_number;
     }
 
     // No reason for this function to be called again after it succeeded.
@@ -369,7 +467,10 @@ void WindowTransformAction::advanceFrameEnd()
     switch (window_description.frame.end_type)
     {
     case WindowFrame::BoundaryType::Current:
-        advanceFrameEndCurrentRow();
+        if (window_description.frame.type == WindowFrame::FrameType::Rows || only_have_pure_window)
+            advanceFrameEndCurrentRow();
+        else
+            advanceFrameEndRangeCurrentRow();
         break;
     case WindowFrame::BoundaryType::Unbounded:
     {
@@ -379,6 +480,8 @@ void WindowTransformAction::advanceFrameEnd()
         break;
     }
     case WindowFrame::BoundaryType::Offset:
+        advanceFrameEndRowsOffset();
+        break;
     default:
         throw Exception(ErrorCodes::NOT_IMPLEMENTED,
                         "The frame end type '{}' is not implemented",
@@ -496,6 +599,19 @@ void WindowTransformAction::appendBlock(Block & current_block)
     }
 
     window_block.input_columns = current_block.getColumns();
+
+    // The window functions with state read the arguments row by row, so the
+    // constant arguments are materialized.
+    for (const auto & ws : workspaces)
+    {
+        if (!ws.state)
+            continue;
+        for (auto argument : ws.arguments)
+        {
+            if (ColumnPtr converted = window_block.input_columns[argument]->convertToFullColumnIfConst())
+                window_block.input_columns[argument] = converted;
+        }
+    }
 }
 
 void WindowTransformAction::tryCalculate()
@@ -522,6 +638,7 @@ void WindowTransformAction::tryCalculate()
                 // peer_group_last save the row before current_row
                 if (!arePeers(peer_group_last, current_row))
                 {
+                    peer_group_start = current_row;
                     peer_group_start_row_number = current_row_number;
                     ++peer_group_number;
                 }
@@ -561,7 +678,9 @@ void WindowTransformAction::tryCalculate()
             // TODO execute the window function by block instead of row.
             writeOutCurrentRow();
 
-            prev_frame_start = frame_start;
+            // The frame start might be past the current row, but the partition
+            // standard must be a row of the current partition.
+            prev_frame_start = std::min(frame_start, current_row);
 
             // Move to the next row. The frame will have to be recalculated.
             // The peer group start is updated at the beginning of the loop,
@@ -599,10 +718,13 @@ void WindowTransformAction::tryCalculate()
         // starts.
         frame_start = partition_start;
         frame_end = partition_start;
+        frame_start_row_number = 1;
+        frame_end_row_number = 1;
         prev_frame_start = partition_start;
         assert(current_row == partition_start);
         current_row_number = 1;
         peer_group_last = partition_start;
+        peer_group_start = partition_start;
         peer_group_start_row_number = 1;
         peer_group_number = 1;
     }
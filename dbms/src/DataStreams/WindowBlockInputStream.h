@@ -27,10 +27,12 @@ namespace DB
 // Runtime data for computing one window function.
 struct WindowFunctionWorkspace
 {
-    // TODO add aggregation function
     WindowFunctionPtr window_function = nullptr;
 
     ColumnNumbers arguments;
+
+    // The state of the window function in this stream, like the aggregation state of the frame.
+    WindowFunctionStatePtr state;
 };
 
 struct WindowBlock
@@ -81,7 +83,10 @@ struct WindowTransformAction
     bool arePeers(const RowNumber & x, const RowNumber & y) const;
 
     void advanceFrameStart();
+    void advanceFrameStartRowsOffset();
     void advanceFrameEndCurrentRow();
+    void advanceFrameEndRangeCurrentRow();
+    void advanceFrameEndRowsOffset();
     void advanceFrameEnd();
 
     void writeOutCurrentRow();
@@ -206,6 +211,8 @@ struct WindowTransformAction
     // For ROWS frame, always equal to the current row, and for RANGE and GROUP
     // frames may be earlier.
     RowNumber peer_group_last;
+    // The first row of the current peer group, the frame start of `RANGE CURRENT ROW`.
+    RowNumber peer_group_start;
 
     // Row and group numbers in partition for calculating rank() and friends.
     UInt64 current_row_number = 1;
@@ -225,10 +232,14 @@ struct WindowTransformAction
     RowNumber frame_end;
     bool frame_ended = false;
     bool frame_started = false;
-
-    // The previous frame boundaries that correspond to the current state of the
-    // aggregate function. We use them to determine how to update the aggregation
-    // state after we find the new frame.
+    // Row numbers in partition of frame_start and frame_end, for calculating the
+    // ROWS frame with offset.
+    UInt64 frame_start_row_number = 1;
+    UInt64 frame_end_row_number = 1;
+
+    // The row used as the partition standard in `isDifferentFromPrevPartition`,
+    // which is the frame start of the previous row, or the previous row itself
+    // if the frame starts after it, e.g. ROWS BETWEEN 1 FOLLOWING AND 2 FOLLOWING.
     RowNumber prev_frame_start;
 
     //TODO: used as template parameters
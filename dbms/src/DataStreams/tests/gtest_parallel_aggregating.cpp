@@ -0,0 +1,263 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <AggregateFunctions/AggregateFunctionFactory.h>
+#include <AggregateFunctions/registerAggregateFunctions.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataStreams/BlocksListBlockInputStream.h>
+#include <DataStreams/MergingBucketsBlockInputStream.h>
+#include <DataStreams/ParallelAggregatingBlockInputStream.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <map>
+#include <thread>
+
+namespace DB
+{
+namespace tests
+{
+/// Aggregate `sum(v), count()` group by `k` with ParallelAggregatingBlockInputStream.
+class ParallelAggregatingBypassTest : public ::testing::Test
+{
+public:
+    static constexpr size_t block_size = 100;
+    static constexpr size_t sample_rows = 1000;
+    static constexpr double ratio_threshold = 0.8;
+
+    /// The result of the aggregation, key -> {sum(v), count()}.
+    using AggResult = std::map<Int64, std::pair<Int64, UInt64>>;
+
+    static void SetUpTestCase()
+    {
+        try
+        {
+            registerAggregateFunctions();
+        }
+        catch (DB::Exception &)
+        {
+            // Maybe another test has already registered, ignore exception here.
+        }
+    }
+
+    void SetUp() override
+    {
+        auto & factory = AggregateFunctionFactory::instance();
+        auto type = std::make_shared<DataTypeInt64>();
+        header = Block{{type, "k"}, {type, "v"}};
+        AggregateDescriptions aggregates(2);
+        aggregates[0].function = factory.get("sum", {type});
+        aggregates[0].arguments = {header.getPositionByName("v")};
+        aggregates[0].column_name = "sum(v)";
+        aggregates[1].function = factory.get("count", {});
+        aggregates[1].column_name = "count()";
+        params = std::make_unique<Aggregator::Params>(
+            header,
+            ColumnNumbers{header.getPositionByName("k")},
+            aggregates,
+            false,
+            0,
+            OverflowMode::THROW,
+            0,
+            0,
+            0,
+            false,
+            "");
+    }
+
+protected:
+    /// `rows` rows whose key of the i-th row is `key_of_row(i)` and value is i, split into blocks of `block_size` rows.
+    template <typename F>
+    Blocks genBlocks(size_t rows, F && key_of_row) const
+    {
+        Blocks blocks;
+        for (size_t begin = 0; begin < rows; begin += block_size)
+        {
+            auto keys = ColumnInt64::create();
+            auto values = ColumnInt64::create();
+            for (size_t i = begin; i < std::min(rows, begin + block_size); ++i)
+            {
+                keys->insert(static_cast<Int64>(key_of_row(i)));
+                values->insert(static_cast<Int64>(i));
+            }
+            auto block = header.cloneEmpty();
+            block.getByName("k").column = std::move(keys);
+            block.getByName("v").column = std::move(values);
+            blocks.push_back(std::move(block));
+        }
+        return blocks;
+    }
+
+    /// Deal the blocks to `num_streams` input streams in turn.
+    std::shared_ptr<ParallelAggregatingBlockInputStream> createStream(const Blocks & blocks, size_t num_streams, size_t bypass_sample_rows) const
+    {
+        std::vector<BlocksList> blocks_of_streams(num_streams);
+        for (size_t i = 0; i < blocks.size(); ++i)
+            blocks_of_streams[i % num_streams].push_back(blocks[i]);
+        BlockInputStreams inputs;
+        for (auto & stream_blocks : blocks_of_streams)
+            inputs.push_back(std::make_shared<BlocksListBlockInputStream>(std::move(stream_blocks)));
+        return std::make_shared<ParallelAggregatingBlockInputStream>(
+            inputs,
+            BlockInputStreams{},
+            *params,
+            TiFlashTestEnv::getGlobalContext().getFileProvider(),
+            true,
+            num_streams,
+            num_streams,
+            "ParallelAggregatingBypassTest",
+            bypass_sample_rows,
+            ratio_threshold);
+    }
+
+    /// Read all the output of the stream and merge the rows of the same key, return the number of output rows.
+    static size_t readAll(const BlockInputStreamPtr & stream, AggResult & result)
+    {
+        size_t output_rows = 0;
+        stream->readPrefix();
+        while (Block block = stream->read())
+        {
+            const auto & keys = block.getByName("k").column;
+            const auto & sums = block.getByName("sum(v)").column;
+            const auto & counts = block.getByName("count()").column;
+            for (size_t i = 0; i < block.rows(); ++i)
+            {
+                auto & [sum, count] = result[keys->getInt(i)];
+                sum += sums->getInt(i);
+                count += counts->getUInt(i);
+            }
+            output_rows += block.rows();
+        }
+        stream->readSuffix();
+        return output_rows;
+    }
+
+    Block header;
+    std::unique_ptr<Aggregator::Params> params;
+};
+
+TEST_F(ParallelAggregatingBypassTest, Triggered)
+try
+{
+    /// The sampled rows are all distinct, and each of the rest keys appears once in every block.
+    auto blocks = genBlocks(sample_rows * 2, [](size_t i) { return i % sample_rows; });
+    AggResult result;
+    size_t output_rows = readAll(createStream(blocks, 1, sample_rows), result);
+    ASSERT_EQ(result.size(), sample_rows);
+    /// The rest blocks are aggregated alone instead of being merged into the hash table.
+    ASSERT_EQ(output_rows, sample_rows * 2);
+}
+CATCH
+
+TEST_F(ParallelAggregatingBypassTest, NotTriggered)
+try
+{
+    /// The sampled rows are reduced to 1/10, which is below the threshold.
+    const size_t num_keys = sample_rows / 10;
+    auto blocks = genBlocks(sample_rows * 2, [&](size_t i) { return i % num_keys; });
+    AggResult result;
+    size_t output_rows = readAll(createStream(blocks, 1, sample_rows), result);
+    ASSERT_EQ(result.size(), num_keys);
+    ASSERT_EQ(output_rows, num_keys);
+}
+CATCH
+
+TEST_F(ParallelAggregatingBypassTest, SameResult)
+try
+{
+    const size_t num_streams = 4;
+    const size_t rows = sample_rows * num_streams * 4;
+    auto blocks = genBlocks(rows, [&](size_t i) { return (i * 7) % (rows / 2); });
+
+    AggResult expected;
+    ASSERT_EQ(readAll(createStream(blocks, num_streams, 0), expected), rows / 2);
+
+    AggResult result;
+    size_t output_rows = readAll(createStream(blocks, num_streams, sample_rows), result);
+    ASSERT_GT(output_rows, rows / 2);
+    ASSERT_EQ(result, expected);
+}
+CATCH
+
+TEST_F(ParallelAggregatingBypassTest, ParallelMerge)
+try
+{
+    const size_t num_streams = 4;
+    const size_t rows = sample_rows * num_streams * 4;
+    auto blocks = genBlocks(rows, [&](size_t i) { return (i * 7) % (rows / 2); });
+
+    AggResult expected;
+    ASSERT_EQ(readAll(createStream(blocks, num_streams, 0), expected), rows / 2);
+
+    /// The bypassed blocks and the merged data are returned by the output streams read concurrently.
+    auto outputs = MergingBucketsBlockInputStream::build(createStream(blocks, num_streams, sample_rows), num_streams);
+    std::vector<AggResult> results(outputs.size());
+    std::vector<size_t> output_rows(outputs.size());
+    std::vector<std::exception_ptr> exceptions(outputs.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < outputs.size(); ++i)
+    {
+        threads.emplace_back([&, i]() {
+            try
+            {
+                output_rows[i] = readAll(outputs[i], results[i]);
+            }
+            catch (...)
+            {
+                exceptions[i] = std::current_exception();
+            }
+        });
+    }
+    for (auto & thread : threads)
+        thread.join();
+
+    AggResult result;
+    size_t total_rows = 0;
+    for (size_t i = 0; i < outputs.size(); ++i)
+    {
+        if (exceptions[i])
+            std::rethrow_exception(exceptions[i]);
+        for (const auto & [key, value] : results[i])
+        {
+            auto & [sum, count] = result[key];
+            sum += value.first;
+            count += value.second;
+        }
+        total_rows += output_rows[i];
+    }
+    ASSERT_GT(total_rows, rows / 2);
+    ASSERT_EQ(result, expected);
+}
+CATCH
+
+TEST_F(ParallelAggregatingBypassTest, CancelWithQueuedBlocks)
+try
+{
+    /// Every thread produces much more bypassed blocks than the capacity of the queue.
+    const size_t num_streams = 2;
+    auto blocks = genBlocks(sample_rows * num_streams * 10, [](size_t i) { return i; });
+    auto stream = createStream(blocks, num_streams, sample_rows);
+
+    BlockInputStreamPtr input = stream;
+    input->readPrefix();
+    ASSERT_GT(input->read().rows(), 0);
+
+    /// The threads blocked on the full queue must be woken up, so the stream can be finished.
+    stream->cancel(false);
+    ASSERT_EQ(input->read().rows(), 0);
+}
+CATCH
+
+} // namespace tests
+} // namespace DB
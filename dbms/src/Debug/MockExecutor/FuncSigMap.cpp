@@ -96,5 +96,10 @@ std::unordered_map<String, tipb::ExprType> window_func_name_to_sig({
     {"DenseRank", tipb::ExprType::DenseRank},
     {"Lead", tipb::ExprType::Lead},
     {"Lag", tipb::ExprType::Lag},
+    {"count", tipb::ExprType::Count},
+    {"sum", tipb::ExprType::Sum},
+    {"min", tipb::ExprType::Min},
+    {"max", tipb::ExprType::Max},
+    {"avg", tipb::ExprType::Avg},
 });
 } // namespace DB::tests
@@ -70,6 +70,32 @@ bool WindowBinder::toTiPBExecutor(tipb::Executor * tipb_executor, int32_t collat
             ft->set_decimal(first_arg_type.decimal());
             break;
         }
+        case tipb::ExprType::Count:
+        {
+            ft->set_tp(TiDB::TypeLongLong);
+            ft->set_flag(TiDB::ColumnFlagUnsigned | TiDB::ColumnFlagNotNull);
+            break;
+        }
+        case tipb::ExprType::Sum:
+        case tipb::ExprType::Min:
+        case tipb::ExprType::Max:
+        {
+            // The result is NULL for the empty frame.
+            assert(window_expr->children_size() == 1);
+            const auto arg_type = window_expr->children(0).field_type();
+            ft->set_tp(arg_type.tp());
+            ft->set_flag(arg_type.flag() & (~TiDB::ColumnFlagNotNull));
+            ft->set_collate(arg_type.collate());
+            ft->set_flen(arg_type.flen());
+            ft->set_decimal(arg_type.decimal());
+            break;
+        }
+        case tipb::ExprType::Avg:
+        {
+            ft->set_tp(TiDB::TypeDouble);
+            ft->set_flag(TiDB::ColumnFlagBinary);
+            break;
+        }
         default:
             ft->set_tp(TiDB::TypeLongLong);
             ft->set_flag(TiDB::ColumnFlagBinary);
@@ -199,6 +225,27 @@ ExecutorBinderPtr compileWindow(ExecutorBinderPtr input, size_t & executor_index
                 }
                 break;
             }
+            case tipb::ExprType::Count:
+            {
+                ci.tp = TiDB::TypeLongLong;
+                ci.flag = TiDB::ColumnFlagUnsigned | TiDB::ColumnFlagNotNull;
+                break;
+            }
+            case tipb::ExprType::Sum:
+            case tipb::ExprType::Min:
+            case tipb::ExprType::Max:
+            {
+                assert(children_ci.size() == 1);
+                ci = children_ci[0];
+                ci.clearNotNullFlag();
+                break;
+            }
+            case tipb::ExprType::Avg:
+            {
+                ci.tp = TiDB::TypeDouble;
+                ci.flag = TiDB::ColumnFlagBinary;
+                break;
+            }
             default:
                 throw Exception(fmt::format("Unsupported window function {}", func->name), ErrorCodes::LOGICAL_ERROR);
             }
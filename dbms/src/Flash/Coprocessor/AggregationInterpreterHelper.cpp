@@ -12,11 +12,19 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/Logger.h>
 #include <Common/TiFlashException.h>
 #include <Core/ColumnNumbers.h>
+#include <DataStreams/OneBlockInputStream.h>
 #include <Flash/Coprocessor/AggregationInterpreterHelper.h>
+#include <Flash/Coprocessor/DAGCodec.h>
 #include <Flash/Coprocessor/DAGContext.h>
+#include <Flash/Coprocessor/DAGPipeline.h>
+#include <Flash/Coprocessor/DAGUtils.h>
+#include <Flash/Coprocessor/TiDBTableScan.h>
 #include <Interpreters/Context.h>
+#include <Storages/Transaction/TiDB.h>
+#include <common/logger_useful.h>
 
 namespace DB::AggregationInterpreterHelper
 {
@@ -39,6 +47,62 @@ bool isAllowToUseTwoLevelGroupBy(size_t before_agg_streams_size, const Settings
       */
     return before_agg_streams_size > 1 || settings.max_bytes_before_external_group_by != 0;
 }
+
+/// The types whose values are read without casting and have the minmax index in DMFile.
+bool isMinMaxPushDownSupported(const TiDB::ColumnInfo & column_info)
+{
+    switch (column_info.tp)
+    {
+    case TiDB::TypeTiny:
+    case TiDB::TypeShort:
+    case TiDB::TypeInt24:
+    case TiDB::TypeLong:
+    case TiDB::TypeLongLong:
+    case TiDB::TypeYear:
+    case TiDB::TypeDate:
+    case TiDB::TypeNewDate:
+    case TiDB::TypeDatetime:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Same as the analyzer, count(not null expr) is count().
+std::optional<DM::PushDownAggregation::Func> toPushDownFunc(const tipb::Expr & expr, const TiDBTableScan & table_scan)
+{
+    using FuncKind = DM::PushDownAggregation::FuncKind;
+    if (expr.has_distinct() || expr.children_size() != 1)
+        return std::nullopt;
+    const auto & arg = expr.children(0);
+    if (expr.tp() == tipb::ExprType::Count && isLiteralExpr(arg))
+    {
+        if (decodeLiteral(arg).isNull())
+            return std::nullopt;
+        return DM::PushDownAggregation::Func{FuncKind::CountAll};
+    }
+    if (!isColumnExpr(arg))
+        return std::nullopt;
+    auto column_index = decodeDAGInt64(arg.val());
+    if (column_index < 0 || column_index >= table_scan.getColumns().size())
+        return std::nullopt;
+    auto column_info = TiDB::toTiDBColumnInfo(table_scan.getColumns()[column_index]);
+
+    switch (expr.tp())
+    {
+    case tipb::ExprType::Count:
+        if (column_info.hasNotNullFlag())
+            return DM::PushDownAggregation::Func{FuncKind::CountAll};
+        return DM::PushDownAggregation::Func{FuncKind::Count, column_info.id};
+    case tipb::ExprType::Min:
+    case tipb::ExprType::Max:
+        if (!isMinMaxPushDownSupported(column_info))
+            return std::nullopt;
+        return DM::PushDownAggregation::Func{expr.tp() == tipb::ExprType::Min ? FuncKind::Min : FuncKind::Max, column_info.id};
+    default:
+        return std::nullopt;
+    }
+}
 } // namespace
 
 bool isSumOnPartialResults(const tipb::Expr & expr)
@@ -121,4 +185,83 @@ void fillArgColumnNumbers(AggregateDescriptions & aggregate_descriptions, const
         }
     }
 }
+
+size_t getPartialAggBypassSampleRows(const Context & context, const Aggregator::Params & params, bool is_final_agg)
+{
+    /// Only the partial results can be passed to the next phase without being fully aggregated.
+    /// Aggregation without keys always reduces the rows to one.
+    /// The bypassed blocks are not spilled, so don't bypass if external aggregation is enabled.
+    if (is_final_agg || params.keys_size == 0 || params.max_bytes_before_external_group_by != 0)
+        return 0;
+    return context.getSettingsRef().partial_agg_bypass_sample_rows;
+}
+
+size_t getParallelMergeConcurrency(const Context & context, size_t final_concurrency)
+{
+    const auto & settings = context.getSettingsRef();
+    if (!settings.enable_parallel_agg_merge || final_concurrency <= 1)
+        return 0;
+    /// `MergingBuckets` merges the buckets without the limit of keys.
+    if (settings.max_rows_to_group_by && settings.group_by_overflow_mode == OverflowMode::ANY)
+        return 0;
+    return final_concurrency;
+}
+
+DM::PushDownAggregationPtr tryPushDownToTableScan(
+    const Context & context,
+    const tipb::Aggregation & aggregation,
+    bool is_final_agg,
+    const TiDBTableScan & table_scan)
+{
+    /// Only the partial results can be merged with the result answered by the storage.
+    if (!context.getSettingsRef().dt_enable_aggregation_pushdown || is_final_agg
+        || aggregation.group_by_size() != 0 || aggregation.agg_func_size() == 0)
+        return nullptr;
+
+    DM::PushDownAggregation::Funcs funcs;
+    for (const auto & expr : aggregation.agg_func())
+    {
+        auto func = toPushDownFunc(expr, table_scan);
+        if (!func)
+            return nullptr;
+        /// The duplicated functions are merged by the analyzer, keep it simple by not pushing them down.
+        auto duplicated = std::any_of(funcs.begin(), funcs.end(), [&](const auto & f) {
+            return f.kind == func->kind && (f.kind == DM::PushDownAggregation::FuncKind::CountAll || f.col_id == func->col_id);
+        });
+        if (duplicated)
+            return nullptr;
+        funcs.push_back(*func);
+    }
+
+    auto push_down_aggregation = std::make_shared<DM::PushDownAggregation>(std::move(funcs));
+    context.getDAGContext()->setPushDownAggregation(table_scan.getTableScanExecutorID(), push_down_aggregation);
+    return push_down_aggregation;
+}
+
+void appendPushDownAggregationResult(
+    DAGPipeline & pipeline,
+    const DM::PushDownAggregationPtr & push_down_aggregation,
+    const AggregateDescriptions & aggregate_descriptions,
+    const String & req_id)
+{
+    if (!push_down_aggregation)
+        return;
+    auto result = push_down_aggregation->getResult();
+    if (!result)
+        return;
+
+    const auto & funcs = push_down_aggregation->getFuncs();
+    RUNTIME_CHECK(aggregate_descriptions.size() == funcs.size(), aggregate_descriptions.size(), funcs.size());
+    Block header = pipeline.firstStream()->getHeader();
+    auto columns = header.cloneEmptyColumns();
+    for (size_t i = 0; i < funcs.size(); ++i)
+        columns[header.getPositionByName(aggregate_descriptions[i].column_name)]->insert(result->values[i]);
+    LOG_DEBUG(
+        Logger::get(req_id),
+        "Append the result answered by pack stats, funcs=[{}] packs={} rows={}",
+        push_down_aggregation->toDebugString(),
+        result->packs,
+        result->rows);
+    pipeline.streams.push_back(std::make_shared<OneBlockInputStream>(header.cloneWithColumns(std::move(columns))));
+}
 } // namespace DB::AggregationInterpreterHelper
\ No newline at end of file
@@ -18,11 +18,14 @@
 #include <Core/Names.h>
 #include <Interpreters/AggregateDescription.h>
 #include <Interpreters/Aggregator.h>
+#include <Storages/DeltaMerge/PushDownAggregation.h>
 #include <tipb/executor.pb.h>
 
 namespace DB
 {
 class Context;
+class TiDBTableScan;
+struct DAGPipeline;
 
 namespace AggregationInterpreterHelper
 {
@@ -43,5 +46,29 @@ Aggregator::Params buildParams(
     bool is_final_agg);
 
 void fillArgColumnNumbers(AggregateDescriptions & aggregate_descriptions, const Block & before_agg_header);
+
+// The sample rows for the adaptive bypass of partial aggregation, 0 means the bypass is disabled.
+// See `ParallelAggregatingBlockInputStream`.
+size_t getPartialAggBypassSampleRows(const Context & context, const Aggregator::Params & params, bool is_final_agg);
+
+// The number of output streams merging the result of a parallel aggregation, 0 means merging by the aggregation itself.
+// See `MergingBucketsBlockInputStream`.
+size_t getParallelMergeConcurrency(const Context & context, size_t final_concurrency);
+
+// Try to push the partial aggregation without group by keys down to `table_scan`, which is the source of the aggregation
+// with an optional pushed down selection. The aggregation is registered into the DAGContext and returned if it can be
+// answered by the pack statistics of the storage, otherwise nullptr is returned.
+DM::PushDownAggregationPtr tryPushDownToTableScan(
+    const Context & context,
+    const tipb::Aggregation & aggregation,
+    bool is_final_agg,
+    const TiDBTableScan & table_scan);
+
+// Append the partial result answered by the storage as an extra stream of the aggregation.
+void appendPushDownAggregationResult(
+    DAGPipeline & pipeline,
+    const DM::PushDownAggregationPtr & push_down_aggregation,
+    const AggregateDescriptions & aggregate_descriptions,
+    const String & req_id);
 } // namespace AggregationInterpreterHelper
 } // namespace DB
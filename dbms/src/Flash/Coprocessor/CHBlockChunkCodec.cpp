@@ -12,22 +12,89 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnString.h>
+#include <Common/HashTable/HashMap.h>
+#include <Common/StringUtils/StringUtils.h>
 #include <Common/TiFlashException.h>
+#include <Common/typeid_cast.h>
 #include <DataStreams/IBlockInputStream.h>
 #include <DataStreams/NativeBlockInputStream.h>
 #include <DataTypes/DataTypeFactory.h>
 #include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypeString.h>
 #include <Flash/Coprocessor/CHBlockChunkCodec.h>
 #include <Flash/Coprocessor/DAGUtils.h>
+#include <IO/CompressedReadBuffer.h>
+#include <IO/CompressedWriteBuffer.h>
 #include <IO/ReadBufferFromString.h>
+#include <IO/copyData.h>
 
 namespace DB
 {
+namespace
+{
+const String dictionary_encoded_type_prefix = "DictionaryEncoded(";
+
+String toDictionaryEncodedTypeName(const String & type_name)
+{
+    return dictionary_encoded_type_prefix + type_name + ")";
+}
+
+/// Return whether `type_name` is wrapped by `toDictionaryEncodedTypeName`, and unwrap it if so.
+bool unwrapDictionaryEncodedTypeName(String & type_name)
+{
+    if (!startsWith(type_name, dictionary_encoded_type_prefix) || !endsWith(type_name, ")"))
+        return false;
+    type_name = type_name.substr(dictionary_encoded_type_prefix.size(), type_name.size() - dictionary_encoded_type_prefix.size() - 1);
+    return true;
+}
+
+/// The width of the indexes in a dictionary of `dictionary_size` values.
+size_t dictionaryIndexSize(size_t dictionary_size)
+{
+    if (dictionary_size <= std::numeric_limits<UInt8>::max() + 1)
+        return sizeof(UInt8);
+    if (dictionary_size <= std::numeric_limits<UInt16>::max() + 1)
+        return sizeof(UInt16);
+    return sizeof(UInt32);
+}
+
+template <typename IndexType>
+void writeDictionaryIndexes(const PaddedPODArray<UInt32> & indexes, WriteBuffer & ostr)
+{
+    for (auto index : indexes)
+    {
+        auto narrowed = static_cast<IndexType>(index);
+        ostr.write(reinterpret_cast<const char *>(&narrowed), sizeof(IndexType));
+    }
+}
+
+template <typename IndexType>
+void readDictionaryIndexes(const ColumnString & dictionary, ColumnString & column, ReadBuffer & istr, size_t rows)
+{
+    PaddedPODArray<IndexType> indexes(rows);
+    istr.readStrict(reinterpret_cast<char *>(indexes.data()), rows * sizeof(IndexType));
+
+    const size_t dictionary_size = dictionary.size();
+    column.getOffsets().reserve(column.size() + rows);
+    for (auto index : indexes)
+    {
+        if (unlikely(index >= dictionary_size))
+            throw TiFlashException(
+                fmt::format("Dictionary index {} out of range, the dictionary size is {}", index, dictionary_size),
+                Errors::Coprocessor::Internal);
+        column.insertFrom(dictionary, index);
+    }
+}
+} // namespace
+
 class CHBlockChunkCodecStream : public ChunkCodecStream
 {
 public:
-    explicit CHBlockChunkCodecStream(const std::vector<tipb::FieldType> & field_types)
+    CHBlockChunkCodecStream(const std::vector<tipb::FieldType> & field_types, bool enable_dictionary_encoding_)
         : ChunkCodecStream(field_types)
+        , enable_dictionary_encoding(enable_dictionary_encoding_)
     {
         for (const auto & field_type : field_types)
         {
@@ -48,6 +115,19 @@ public:
     void encode(const Block & block, size_t start, size_t end) override;
     std::unique_ptr<WriteBufferFromOwnString> output;
     DataTypes expected_types;
+
+private:
+    /// Write the type and the data of a String or Nullable(String) column encoded with a dictionary.
+    /// Return false and write nothing if the column is not a string column, or the cardinality is not low.
+    bool tryEncodeWithDictionary(const ColumnWithTypeAndName & column, size_t rows);
+
+    const bool enable_dictionary_encoding;
+
+    /// Reused by all the columns to encode with dictionaries.
+    using DictionaryMap = HashMapWithSavedHash<StringRef, UInt32>;
+    DictionaryMap dictionary_map;
+    std::vector<StringRef> dictionary;
+    PaddedPODArray<UInt32> dictionary_indexes;
 };
 
 CHBlockChunkCodec::CHBlockChunkCodec(
@@ -99,14 +179,112 @@ void writeData(const IDataType & type, const ColumnPtr & column, WriteBuffer & o
     type.serializeBinaryBulkWithMultipleStreams(*full_column, output_stream_getter, offset, limit, false, {});
 }
 
-void CHBlockChunkCodec::readData(const IDataType & type, IColumn & column, ReadBuffer & istr, size_t rows)
+void CHBlockChunkCodec::readData(const IDataType & type, IColumn & column, ReadBuffer & istr, size_t rows, bool dictionary_encoded)
 {
+    if (dictionary_encoded)
+    {
+        /// See `CHBlockChunkCodecStream::tryEncodeWithDictionary` for the format.
+        IColumn * nested_column = &column;
+        if (auto * nullable_column = typeid_cast<ColumnNullable *>(&column))
+        {
+            auto & null_map = nullable_column->getNullMapData();
+            size_t old_size = null_map.size();
+            null_map.resize(old_size + rows);
+            istr.readStrict(reinterpret_cast<char *>(&null_map[old_size]), rows);
+            nested_column = &nullable_column->getNestedColumn();
+        }
+        auto & string_column = typeid_cast<ColumnString &>(*nested_column);
+
+        size_t dictionary_size = 0;
+        readVarUInt(dictionary_size, istr);
+        auto dictionary = ColumnString::create();
+        DataTypeString().deserializeBinaryBulk(*dictionary, istr, dictionary_size, 0);
+
+        switch (dictionaryIndexSize(dictionary_size))
+        {
+        case sizeof(UInt8):
+            readDictionaryIndexes<UInt8>(*dictionary, string_column, istr, rows);
+            break;
+        case sizeof(UInt16):
+            readDictionaryIndexes<UInt16>(*dictionary, string_column, istr, rows);
+            break;
+        default:
+            readDictionaryIndexes<UInt32>(*dictionary, string_column, istr, rows);
+            break;
+        }
+        return;
+    }
+
     IDataType::InputStreamGetter input_stream_getter = [&](const IDataType::SubstreamPath &) {
         return &istr;
     };
     type.deserializeBinaryBulkWithMultipleStreams(column, input_stream_getter, rows, 0, false, {});
 }
 
+bool CHBlockChunkCodecStream::tryEncodeWithDictionary(const ColumnWithTypeAndName & column, size_t rows)
+{
+    if (rows < CHBlockChunkCodec::dictionary_encoding_min_rows)
+        return false;
+
+    ColumnPtr full_column = column.column->isColumnConst() ? column.column->convertToFullColumnIfConst() : column.column;
+
+    const ColumnUInt8 * null_map = nullptr;
+    const IColumn * nested_column = full_column.get();
+    if (const auto * nullable_column = typeid_cast<const ColumnNullable *>(nested_column))
+    {
+        null_map = &nullable_column->getNullMapColumn();
+        nested_column = &nullable_column->getNestedColumn();
+    }
+    const auto * string_column = typeid_cast<const ColumnString *>(nested_column);
+    if (!string_column)
+        return false;
+
+    /// Give up as soon as there are too many distinct values. The values under the nulls are
+    /// empty strings, and they are put into the dictionary like other values.
+    const size_t max_dictionary_size = rows / CHBlockChunkCodec::dictionary_encoding_min_ratio;
+    dictionary_map.clear();
+    dictionary.clear();
+    dictionary_indexes.resize(rows);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        StringRef value = string_column->getDataAt(i);
+        DictionaryMap::LookupResult it;
+        bool inserted;
+        dictionary_map.emplace(value, it, inserted);
+        if (inserted)
+        {
+            if (dictionary.size() >= max_dictionary_size)
+                return false;
+            it->getMapped() = dictionary.size();
+            dictionary.push_back(value);
+        }
+        dictionary_indexes[i] = it->getMapped();
+    }
+
+    /// Type name, null map if nullable, dictionary size, the values of the dictionary in the format of
+    /// DataTypeString, then the index of every row in the narrowest width that can hold the dictionary size.
+    writeStringBinary(toDictionaryEncodedTypeName(column.type->getName()), *output);
+    if (null_map)
+        output->write(reinterpret_cast<const char *>(null_map->getData().data()), rows);
+    writeVarUInt(dictionary.size(), *output);
+    for (const auto & value : dictionary)
+        writeStringBinary(value, *output);
+
+    switch (dictionaryIndexSize(dictionary.size()))
+    {
+    case sizeof(UInt8):
+        writeDictionaryIndexes<UInt8>(dictionary_indexes, *output);
+        break;
+    case sizeof(UInt16):
+        writeDictionaryIndexes<UInt16>(dictionary_indexes, *output);
+        break;
+    default:
+        writeDictionaryIndexes<UInt32>(dictionary_indexes, *output);
+        break;
+    }
+    return true;
+}
+
 void CHBlockChunkCodecStream::encode(const Block & block, size_t start, size_t end)
 {
     /// only check block schema in CHBlock codec because for both
@@ -132,6 +310,9 @@ void CHBlockChunkCodecStream::encode(const Block & block, size_t start, size_t e
         const ColumnWithTypeAndName & column = block.safeGetByPosition(i);
 
         writeStringBinary(column.name, *output);
+        if (enable_dictionary_encoding && tryEncodeWithDictionary(column, rows))
+            continue;
+
         writeStringBinary(column.type->getName(), *output);
 
         if (rows)
@@ -141,7 +322,44 @@ void CHBlockChunkCodecStream::encode(const Block & block, size_t start, size_t e
 
 std::unique_ptr<ChunkCodecStream> CHBlockChunkCodec::newCodecStream(const std::vector<tipb::FieldType> & field_types)
 {
-    return std::make_unique<CHBlockChunkCodecStream>(field_types);
+    return newCodecStream(field_types, false);
+}
+
+std::unique_ptr<ChunkCodecStream> CHBlockChunkCodec::newCodecStream(const std::vector<tipb::FieldType> & field_types, bool enable_dictionary_encoding)
+{
+    return std::make_unique<CHBlockChunkCodecStream>(field_types, enable_dictionary_encoding);
+}
+
+String CHBlockChunkCodec::compress(const String & chunk, CompressionMethod method)
+{
+    static constexpr size_t min_compress_chunk_size = 1024;
+    if (chunk.empty())
+        return chunk;
+    if (chunk.size() < min_compress_chunk_size)
+        method = CompressionMethod::NONE;
+
+    WriteBufferFromOwnString output;
+    {
+        CompressedWriteBuffer<false> compressed_output(
+            output,
+            CompressionSettings(method),
+            std::min(chunk.size(), static_cast<size_t>(DBMS_DEFAULT_BUFFER_SIZE)));
+        compressed_output.write(chunk.data(), chunk.size());
+        compressed_output.next();
+    }
+    return output.releaseStr();
+}
+
+String CHBlockChunkCodec::decompress(const String & compressed_chunk)
+{
+    if (compressed_chunk.empty())
+        return compressed_chunk;
+
+    ReadBufferFromString input(compressed_chunk);
+    CompressedReadBuffer<false> compressed_input(input);
+    WriteBufferFromOwnString output;
+    copyData(compressed_input, output);
+    return output.releaseStr();
 }
 
 Block CHBlockChunkCodec::decodeImpl(ReadBuffer & istr, size_t reserve_size)
@@ -160,7 +378,8 @@ Block CHBlockChunkCodec::decodeImpl(ReadBuffer & istr, size_t reserve_size)
     for (size_t i = 0; i < columns; ++i)
     {
         ColumnWithTypeAndName column;
-        readColumnMeta(i, istr, column);
+        bool dictionary_encoded = false;
+        readColumnMeta(i, istr, column, dictionary_encoded);
 
         /// Data
         MutableColumnPtr read_column = column.type->createColumn();
@@ -174,7 +393,7 @@ Block CHBlockChunkCodec::decodeImpl(ReadBuffer & istr, size_t reserve_size)
         }
 
         if (rows) /// If no rows, nothing to read.
-            readData(*column.type, *read_column, istr, rows);
+            readData(*column.type, *read_column, istr, rows, dictionary_encoded);
 
         column.column = std::move(read_column);
         res.insert(std::move(column));
@@ -193,7 +412,7 @@ void CHBlockChunkCodec::readBlockMeta(ReadBuffer & istr, size_t & columns, size_
         CodecUtils::checkColumnSize("CHBlockChunkCodec", output_names.size(), columns);
 }
 
-void CHBlockChunkCodec::readColumnMeta(size_t i, ReadBuffer & istr, ColumnWithTypeAndName & column)
+void CHBlockChunkCodec::readColumnMeta(size_t i, ReadBuffer & istr, ColumnWithTypeAndName & column, bool & dictionary_encoded)
 {
     /// Name
     readBinary(column.name, istr);
@@ -205,6 +424,7 @@ void CHBlockChunkCodec::readColumnMeta(size_t i, ReadBuffer & istr, ColumnWithTy
     /// Type
     String type_name;
     readBinary(type_name, istr);
+    dictionary_encoded = unwrapDictionaryEncodedTypeName(type_name);
     const DataTypeFactory & data_type_factory = DataTypeFactory::instance();
     if (header)
     {
@@ -16,6 +16,7 @@
 
 #include <Flash/Coprocessor/ChunkCodec.h>
 #include <Flash/Coprocessor/CodecUtils.h>
+#include <IO/CompressedStream.h>
 
 namespace DB
 {
@@ -31,12 +32,29 @@ public:
     Block decode(const String &, const DAGSchema & schema) override;
     static Block decode(const String &, const Block & header);
     std::unique_ptr<ChunkCodecStream> newCodecStream(const std::vector<tipb::FieldType> & field_types) override;
+    /// If `enable_dictionary_encoding` is true, the low-cardinality String and Nullable(String) columns are encoded
+    /// as a dictionary of the distinct values and the index of every row in the dictionary.
+    /// The type name of such a column is wrapped as `DictionaryEncoded(<type name>)`, so that the decoder knows it
+    /// without any agreement, and the decoders not knowing the dictionary encoding fail on the type check.
+    std::unique_ptr<ChunkCodecStream> newCodecStream(const std::vector<tipb::FieldType> & field_types, bool enable_dictionary_encoding);
+
+    /// Compress an encoded chunk for the exchange between the MPP tasks on different nodes.
+    /// The result is in the format of CompressedWriteBuffer without checksum, tiny chunks are
+    /// not worth compressing and are wrapped with CompressionMethod::NONE.
+    static String compress(const String & chunk, CompressionMethod method);
+    static String decompress(const String & compressed_chunk);
+
+    /// A column is encoded with a dictionary only if it has at least `dictionary_encoding_min_rows` rows,
+    /// and the number of distinct values is at most 1/`dictionary_encoding_min_ratio` of the rows.
+    static constexpr size_t dictionary_encoding_min_rows = 64;
+    static constexpr size_t dictionary_encoding_min_ratio = 4;
 
 private:
     friend class CHBlockChunkDecodeAndSquash;
-    void readColumnMeta(size_t i, ReadBuffer & istr, ColumnWithTypeAndName & column);
+    /// `dictionary_encoded` is set to whether the data of the column is encoded with a dictionary.
+    void readColumnMeta(size_t i, ReadBuffer & istr, ColumnWithTypeAndName & column, bool & dictionary_encoded);
     void readBlockMeta(ReadBuffer & istr, size_t & columns, size_t & rows) const;
-    static void readData(const IDataType & type, IColumn & column, ReadBuffer & istr, size_t rows);
+    static void readData(const IDataType & type, IColumn & column, ReadBuffer & istr, size_t rows, bool dictionary_encoded);
     /// 'reserve_size' used for Squash usage, and takes effect when 'reserve_size' > 0
     Block decodeImpl(ReadBuffer & istr, size_t reserve_size = 0);
 
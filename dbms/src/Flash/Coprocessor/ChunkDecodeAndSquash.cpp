@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/Stopwatch.h>
 #include <Flash/Coprocessor/ChunkDecodeAndSquash.h>
 #include <IO/ReadBufferFromString.h>
 
@@ -57,8 +58,9 @@ std::optional<Block> CHBlockChunkDecodeAndSquash::decodeAndSquash(const String &
             for (size_t i = 0; i < columns; ++i)
             {
                 ColumnWithTypeAndName column;
-                codec.readColumnMeta(i, istr, column);
-                CHBlockChunkCodec::readData(*column.type, *(mutable_columns[i]), istr, rows);
+                bool dictionary_encoded = false;
+                codec.readColumnMeta(i, istr, column, dictionary_encoded);
+                CHBlockChunkCodec::readData(*column.type, *(mutable_columns[i]), istr, rows, dictionary_encoded);
             }
             accumulated_block->setColumns(std::move(mutable_columns));
         }
@@ -73,6 +75,16 @@ std::optional<Block> CHBlockChunkDecodeAndSquash::decodeAndSquash(const String &
     return res;
 }
 
+std::optional<Block> CHBlockChunkDecodeAndSquash::decodeAndSquashCompressed(const String & str, DecodeDetail & detail)
+{
+    Stopwatch watch(CLOCK_THREAD_CPUTIME_ID);
+    String decompressed = CHBlockChunkCodec::decompress(str);
+    detail.compression_time_ns += watch.elapsed();
+    detail.compressed_bytes += str.size();
+    detail.uncompressed_bytes += decompressed.size();
+    return decodeAndSquash(decompressed);
+}
+
 std::optional<Block> CHBlockChunkDecodeAndSquash::flush()
 {
     if (!accumulated_block)
@@ -17,6 +17,7 @@
 #include <Flash/Coprocessor/CHBlockChunkCodec.h>
 #include <Flash/Coprocessor/ChunkCodec.h>
 #include <Flash/Coprocessor/CodecUtils.h>
+#include <Flash/Coprocessor/DecodeDetail.h>
 
 namespace DB
 {
@@ -27,6 +28,8 @@ public:
     CHBlockChunkDecodeAndSquash(const Block & header, size_t rows_limit_);
     ~CHBlockChunkDecodeAndSquash() = default;
     std::optional<Block> decodeAndSquash(const String &);
+    /// Decode the chunk compressed by `CHBlockChunkCodec::compress`, and record the decompression in `detail`.
+    std::optional<Block> decodeAndSquashCompressed(const String &, DecodeDetail & detail);
     std::optional<Block> flush();
 
 private:
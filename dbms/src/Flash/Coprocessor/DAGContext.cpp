@@ -18,6 +18,7 @@
 #include <Flash/Coprocessor/collectOutputFieldTypes.h>
 #include <Flash/Mpp/ExchangeReceiver.h>
 #include <Flash/Statistics/traverseExecutors.h>
+#include <Storages/DeltaMerge/Filter/RuntimeFilter.h>
 #include <Storages/Transaction/TMTContext.h>
 
 namespace DB
@@ -120,6 +121,37 @@ std::unordered_map<String, BlockInputStreams> & DAGContext::getInBoundIOInputStr
     return inbound_io_input_streams_map;
 }
 
+DM::RuntimeFilterListPtr DAGContext::getOrCreateRuntimeFilterList(const String & executor_id)
+{
+    auto & runtime_filter_list = runtime_filter_lists[executor_id];
+    if (!runtime_filter_list)
+        runtime_filter_list = std::make_shared<DM::RuntimeFilterList>();
+    return runtime_filter_list;
+}
+
+void DAGContext::setPushDownAggregation(const String & executor_id, const DM::PushDownAggregationPtr & aggregation)
+{
+    push_down_aggregations[executor_id] = aggregation;
+}
+
+DM::PushDownAggregationPtr DAGContext::getPushDownAggregation(const String & executor_id) const
+{
+    auto iter = push_down_aggregations.find(executor_id);
+    return iter == push_down_aggregations.end() ? nullptr : iter->second;
+}
+
+bool DAGContext::hasFineGrainedShuffle() const
+{
+    if (!dag_request)
+        return false;
+    bool found = false;
+    traverseExecutors(dag_request, [&](const tipb::Executor & executor) {
+        found = enableFineGrainedShuffle(executor.fine_grained_shuffle_stream_count());
+        return !found;
+    });
+    return found;
+}
+
 void DAGContext::handleTruncateError(const String & msg)
 {
     if (!(flags & TiDBSQLFlags::IGNORE_TRUNCATE || flags & TiDBSQLFlags::TRUNCATE_AS_WARNING))
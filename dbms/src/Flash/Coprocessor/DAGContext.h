@@ -37,6 +37,14 @@
 
 namespace DB
 {
+namespace DM
+{
+class RuntimeFilterList;
+using RuntimeFilterListPtr = std::shared_ptr<RuntimeFilterList>;
+class PushDownAggregation;
+using PushDownAggregationPtr = std::shared_ptr<PushDownAggregation>;
+} // namespace DM
+
 class Context;
 class MPPTunnelSet;
 class ExchangeReceiver;
@@ -211,6 +219,14 @@ public:
 
     std::unordered_map<String, JoinExecuteInfo> & getJoinExecuteInfoMap();
     std::unordered_map<String, BlockInputStreams> & getInBoundIOInputStreamsMap();
+    /// The runtime filters generated by the joins that probe the table scan `executor_id`.
+    /// Both the table scan and the joins may be interpreted first, so the list is created by whichever comes first.
+    DM::RuntimeFilterListPtr getOrCreateRuntimeFilterList(const String & executor_id);
+    /// The aggregation pushed down to the table scan `executor_id`, which is registered before the table scan is interpreted.
+    void setPushDownAggregation(const String & executor_id, const DM::PushDownAggregationPtr & aggregation);
+    DM::PushDownAggregationPtr getPushDownAggregation(const String & executor_id) const;
+    /// Whether any executor of the request runs with fine grained shuffle.
+    bool hasFineGrainedShuffle() const;
     void handleTruncateError(const String & msg);
     void handleOverflowError(const String & msg, const TiFlashError & error);
     void handleDivisionByZero();
@@ -380,6 +396,10 @@ private:
     /// profile_streams_map is a map that maps from executor_id (table_scan / exchange_receiver) to BlockInputStreams.
     /// BlockInputStreams contains ExchangeReceiverInputStream, CoprocessorBlockInputStream and local_read_input_stream etc.
     std::unordered_map<String, BlockInputStreams> inbound_io_input_streams_map;
+    /// executor_id of table scan, the runtime filters applied to it.
+    std::unordered_map<String, DM::RuntimeFilterListPtr> runtime_filter_lists;
+    /// executor_id of table scan, the aggregation pushed down to it.
+    std::unordered_map<String, DM::PushDownAggregationPtr> push_down_aggregations;
     UInt64 flags;
     UInt64 sql_mode;
     mpp::TaskMeta mpp_task_meta;
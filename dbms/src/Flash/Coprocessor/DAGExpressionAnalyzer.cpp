@@ -186,6 +186,7 @@ void appendWindowDescription(
     window_function_description.argument_names = arg_names;
     window_function_description.column_name = func_string;
     window_function_description.window_function = WindowFunctionFactory::instance().get(window_func_name, arg_types);
+    window_function_description.window_function->setCollators(arg_collators);
     DataTypePtr result_type = window_function_description.window_function->getReturnType();
     window_description.window_functions_descriptions.emplace_back(std::move(window_function_description));
     window_columns.emplace_back(func_string, result_type);
@@ -610,7 +611,13 @@ void DAGExpressionAnalyzer::appendWindowColumns(WindowDescription & window_descr
     NamesAndTypes window_columns;
     for (const tipb::Expr & expr : window.func_desc())
     {
-        RUNTIME_CHECK_MSG(isWindowFunctionExpr(expr), "Now Window Operator only support window function.");
+        if (isAggFunctionExpr(expr))
+        {
+            buildCommonWindowFunc(expr, actions, getWindowAggFunctionName(expr), window_description, source_columns, window_columns);
+            continue;
+        }
+
+        RUNTIME_CHECK_MSG(isWindowFunctionExpr(expr), "Now Window Operator only support window function and aggregate function.");
         if (expr.tp() == tipb::ExprType::Lead || expr.tp() == tipb::ExprType::Lag)
         {
             buildLeadLag(expr, actions, getWindowFunctionName(expr), window_description, source_columns, window_columns);
@@ -22,6 +22,7 @@ struct DAGPipeline
 {
     BlockInputStreams streams;
     /** When executing FULL or RIGHT JOIN, there will be a data stream from which you can read "not joined" rows.
+      * The streams that join the spilled partitions of grace hash join are kept here as well.
       * It has a special meaning, since reading from it should be done after reading from the main streams.
       * It is appended to the main streams in UnionBlockInputStream or ParallelAggregatingBlockInputStream.
       */
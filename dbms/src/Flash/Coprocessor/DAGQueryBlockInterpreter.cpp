@@ -23,6 +23,7 @@
 #include <DataStreams/HashJoinProbeBlockInputStream.h>
 #include <DataStreams/LimitBlockInputStream.h>
 #include <DataStreams/MergeSortingBlockInputStream.h>
+#include <DataStreams/MergingBucketsBlockInputStream.h>
 #include <DataStreams/MockExchangeReceiverInputStream.h>
 #include <DataStreams/MockExchangeSenderInputStream.h>
 #include <DataStreams/MockTableScanBlockInputStream.h>
@@ -250,6 +251,9 @@ void DAGQueryBlockInterpreter::handleJoin(const tipb::Join & join, DAGPipeline &
     size_t max_block_size_for_cross_join = settings.max_block_size;
     fiu_do_on(FailPoints::minimum_block_size_for_cross_join, { max_block_size_for_cross_join = 1; });
 
+    /// The spilled partitions are restored by extra streams that can not be fit into the fine grained shuffle pipelines.
+    size_t max_bytes_before_external_join = dagContext().hasFineGrainedShuffle() ? 0 : settings.max_bytes_before_external_join;
+
     JoinPtr join_ptr = std::make_shared<Join>(
         probe_key_names,
         build_key_names,
@@ -266,10 +270,14 @@ void DAGQueryBlockInterpreter::handleJoin(const tipb::Join & join, DAGPipeline &
         other_eq_filter_from_in_column_name,
         other_condition_expr,
         max_block_size_for_cross_join,
-        match_helper_name);
+        match_helper_name,
+        JoinSpillConfig{max_bytes_before_external_join, settings.join_spill_partition_num, context.getTemporaryPath(), context.getFileProvider()});
 
     recordJoinExecuteInfo(tiflash_join.build_side_index, join_ptr);
 
+    if (settings.enable_join_runtime_filter)
+        join_ptr->setRuntimeFilters(tiflash_join.genRuntimeFilters(dagContext(), build_key_names, settings.join_runtime_filter_max_in_values));
+
     auto & join_execute_info = dagContext().getJoinExecuteInfoMap()[query_block.source_name];
 
     size_t join_build_concurrency = std::max(build_pipeline.streams.size(), build_pipeline.streams_with_non_joined_data.size());
@@ -324,6 +332,22 @@ void DAGQueryBlockInterpreter::handleJoin(const tipb::Join & join, DAGPipeline &
             join_execute_info.non_joined_streams.push_back(non_joined_stream);
         }
     }
+    if (join_ptr->isSpillEnabled())
+    {
+        /// the spilled partitions, if any, are joined after all the probe streams are finished.
+        size_t restore_concurrency = join_ptr->getBuildConcurrency();
+        for (size_t i = 0; i < restore_concurrency; ++i)
+        {
+            auto restore_stream = createStreamWithSpilledPartitions(
+                join_ptr,
+                pipeline.firstStream()->getHeader(),
+                i,
+                restore_concurrency,
+                settings.max_block_size);
+            restore_stream->setExtraInfo("add stream with spilled partitions of grace hash join");
+            pipeline.streams_with_non_joined_data.push_back(restore_stream);
+        }
+    }
     for (auto & stream : pipeline.streams)
     {
         stream = std::make_shared<HashJoinProbeBlockInputStream>(stream, chain.getLastActions(), log->identifier());
@@ -426,7 +450,8 @@ void DAGQueryBlockInterpreter::executeAggregation(
     {
         /// If there are several sources, then we perform parallel aggregation
         const Settings & settings = context.getSettingsRef();
-        BlockInputStreamPtr stream = std::make_shared<ParallelAggregatingBlockInputStream>(
+        size_t bypass_sample_rows = AggregationInterpreterHelper::getPartialAggBypassSampleRows(context, params, is_final_agg);
+        auto stream = std::make_shared<ParallelAggregatingBlockInputStream>(
             pipeline.streams,
             pipeline.streams_with_non_joined_data,
             params,
@@ -434,15 +459,29 @@ void DAGQueryBlockInterpreter::executeAggregation(
             true,
             max_streams,
             settings.aggregation_memory_efficient_merge_threads ? static_cast<size_t>(settings.aggregation_memory_efficient_merge_threads) : static_cast<size_t>(settings.max_threads),
-            log->identifier());
+            log->identifier(),
+            bypass_sample_rows,
+            settings.partial_agg_bypass_ratio_threshold);
 
-        pipeline.streams.resize(1);
+        size_t merge_concurrency = query_block.can_restore_pipeline_concurrency
+            ? AggregationInterpreterHelper::getParallelMergeConcurrency(context, dagContext().final_concurrency)
+            : 0;
         pipeline.streams_with_non_joined_data.clear();
-        pipeline.firstStream() = std::move(stream);
+        if (merge_concurrency > 0)
+        {
+            /// The output streams merge the aggregated data in parallel, so the concurrency is restored without SharedQuery.
+            pipeline.streams = MergingBucketsBlockInputStream::build(stream, merge_concurrency);
+            recordProfileStreams(pipeline, query_block.aggregation_name);
+        }
+        else
+        {
+            pipeline.streams.resize(1);
+            pipeline.firstStream() = std::move(stream);
 
-        // should record for agg before restore concurrency. See #3804.
-        recordProfileStreams(pipeline, query_block.aggregation_name);
-        restorePipelineConcurrency(pipeline);
+            // should record for agg before restore concurrency. See #3804.
+            recordProfileStreams(pipeline, query_block.aggregation_name);
+            restorePipelineConcurrency(pipeline);
+        }
     }
     else
     {
@@ -611,6 +650,7 @@ void DAGQueryBlockInterpreter::handleWindowOrder(DAGPipeline & pipeline, const t
 //    like final_project.emplace_back(col.name, query_block.qb_column_prefix + col.name);
 void DAGQueryBlockInterpreter::executeImpl(DAGPipeline & pipeline)
 {
+    DM::PushDownAggregationPtr push_down_aggregation;
     if (query_block.source->tp() == tipb::ExecType::TypeJoin)
     {
         SubqueryForSet right_query;
@@ -641,7 +681,18 @@ void DAGQueryBlockInterpreter::executeImpl(DAGPipeline & pipeline)
         if (unlikely(context.isTest()))
             handleMockTableScan(table_scan, pipeline);
         else
+        {
+            if (query_block.aggregation)
+            {
+                const auto & aggregation = query_block.aggregation->aggregation();
+                push_down_aggregation = AggregationInterpreterHelper::tryPushDownToTableScan(
+                    context,
+                    aggregation,
+                    AggregationInterpreterHelper::isFinalAgg(aggregation),
+                    table_scan);
+            }
             handleTableScan(table_scan, pipeline);
+        }
         dagContext().table_scan_executor_id = query_block.source_name;
     }
     else if (query_block.source->tp() == tipb::ExecType::TypeWindow)
@@ -687,6 +738,7 @@ void DAGQueryBlockInterpreter::executeImpl(DAGPipeline & pipeline)
     {
         // execute aggregation
         executeAggregation(pipeline, res.before_aggregation, res.aggregation_keys, res.aggregation_collators, res.aggregate_descriptions, res.is_final_agg, res.enable_fine_grained_shuffle_agg);
+        AggregationInterpreterHelper::appendPushDownAggregationResult(pipeline, push_down_aggregation, res.aggregate_descriptions, log->identifier());
     }
     if (res.before_having)
     {
@@ -784,7 +836,8 @@ void DAGQueryBlockInterpreter::handleExchangeSender(DAGPipeline & pipeline)
             dagContext(),
             enable_fine_grained_shuffle,
             stream_count,
-            batch_size);
+            batch_size,
+            context.getSettingsRef().mpp_exchange_dictionary_encoding);
         stream = std::make_shared<ExchangeSenderBlockInputStream>(stream, std::move(response_writer), log->identifier());
         stream->setExtraInfo(extra_info);
     });
@@ -17,6 +17,9 @@
 #include <Core/NamesAndTypes.h>
 #include <Flash/Coprocessor/DAGExpressionAnalyzer.h>
 #include <Flash/Coprocessor/DAGQuerySource.h>
+#include <Storages/DeltaMerge/Filter/LateMaterializationFilter.h>
+#include <Storages/DeltaMerge/Filter/RuntimeFilter.h>
+#include <Storages/DeltaMerge/PushDownAggregation.h>
 
 #include <unordered_map>
 
@@ -30,11 +33,17 @@ struct DAGQueryInfo
         const std::vector<const tipb::Expr *> & filters_,
         DAGPreparedSets dag_sets_,
         const NamesAndTypes & source_columns_,
-        const TimezoneInfo & timezone_info_)
+        const TimezoneInfo & timezone_info_,
+        const DM::RuntimeFilterListPtr & runtime_filter_list_ = nullptr,
+        const DM::LateMaterializationFilterPtr & late_materialization_filter_ = nullptr,
+        const DM::PushDownAggregationPtr & push_down_aggregation_ = nullptr)
         : filters(filters_)
         , dag_sets(std::move(dag_sets_))
         , source_columns(source_columns_)
-        , timezone_info(timezone_info_){};
+        , timezone_info(timezone_info_)
+        , runtime_filter_list(runtime_filter_list_)
+        , late_materialization_filter(late_materialization_filter_)
+        , push_down_aggregation(push_down_aggregation_){};
     // filters in dag request
     const std::vector<const tipb::Expr *> & filters;
     // Prepared sets extracted from dag request, which are used for indices
@@ -43,5 +52,16 @@ struct DAGQueryInfo
     const NamesAndTypes & source_columns;
 
     const TimezoneInfo & timezone_info;
+
+    // Runtime filters pushed down from the hash joins that probe this table scan.
+    DM::RuntimeFilterListPtr runtime_filter_list;
+
+    // The pushed down filter that can be executed on the columns read from the storage directly,
+    // nullptr if there is no such filter.
+    DM::LateMaterializationFilterPtr late_materialization_filter;
+
+    // The aggregation above this table scan that can be answered by the pack statistics,
+    // nullptr if there is no such aggregation.
+    DM::PushDownAggregationPtr push_down_aggregation;
 };
 } // namespace DB
@@ -325,6 +325,11 @@ void DAGStorageInterpreter::executeImpl(DAGPipeline & pipeline)
         auto scan_context = std::make_shared<DM::ScanContext>();
         scan_context->num_columns = required_columns.size();
         dagContext().scan_context_map[table_scan.getTableScanExecutorID()] = scan_context;
+        if (settings.enable_join_runtime_filter)
+            runtime_filter_list = dagContext().getOrCreateRuntimeFilterList(table_scan.getTableScanExecutorID());
+        if (push_down_filter.hasValue() && settings.dt_enable_late_materialization)
+            late_materialization_filter = buildLateMaterializationFilter();
+        push_down_aggregation = dagContext().getPushDownAggregation(table_scan.getTableScanExecutorID());
         buildLocalStreams(pipeline, settings.max_block_size);
     }
 
@@ -449,6 +454,41 @@ std::tuple<ExpressionActionsPtr, String, ExpressionActionsPtr> DAGStorageInterpr
     return {before_where, filter_column_name, project_after_where};
 }
 
+DM::LateMaterializationFilterPtr DAGStorageInterpreter::buildLateMaterializationFilter()
+{
+    assert(push_down_filter.hasValue());
+
+    // The storage returns the columns before the generated column placeholders and the timezone/duration casts
+    // are applied, so the filter can only be executed by the storage if it doesn't depend on such columns.
+    const auto & source_columns = analyzer->getCurrentInputColumns();
+    NameSet unsupported_columns;
+    for (const auto & generated_column_info : generated_column_infos)
+        unsupported_columns.insert(std::get<1>(generated_column_info));
+    for (size_t i = 0; i < is_need_add_cast_column.size() && i < source_columns.size(); ++i)
+    {
+        if (is_need_add_cast_column[i] != ExtraCastAfterTSMode::None)
+            unsupported_columns.insert(source_columns[i].name);
+    }
+    unsupported_columns.insert(MutableSupport::extra_table_id_column_name);
+
+    ExpressionActionsChain chain;
+    analyzer->initChain(chain, source_columns);
+    String filter_column_name = analyzer->appendWhere(chain, push_down_filter.conditions);
+    ExpressionActionsPtr before_where = chain.getLastActions();
+    chain.finalize();
+    chain.clear();
+
+    for (const auto & name : before_where->getRequiredColumns())
+    {
+        if (unsupported_columns.count(name))
+        {
+            LOG_DEBUG(log, "Late materialization is disabled because the pushed down filter depends on column {}", name);
+            return nullptr;
+        }
+    }
+    return std::make_shared<DM::LateMaterializationFilter>(before_where, filter_column_name);
+}
+
 void DAGStorageInterpreter::executePushedDownFilter(
     size_t remote_read_streams_start_index,
     DAGPipeline & pipeline)
@@ -673,7 +713,10 @@ std::unordered_map<TableID, SelectQueryInfo> DAGStorageInterpreter::generateSele
             push_down_filter.conditions,
             analyzer->getPreparedSets(),
             analyzer->getCurrentInputColumns(),
-            context.getTimezoneInfo());
+            context.getTimezoneInfo(),
+            runtime_filter_list,
+            late_materialization_filter,
+            push_down_aggregation);
         query_info.req_id = fmt::format("{} table_id={}", log->identifier(), table_id);
         query_info.keep_order = table_scan.keepOrder();
         query_info.is_fast_scan = table_scan.isFastScan();
@@ -810,6 +853,8 @@ void DAGStorageInterpreter::buildLocalStreamsForPhysicalTable(
             {
                 // clean all streams from local because we are not sure the correctness of those streams
                 pipeline.streams.clear();
+                if (push_down_aggregation)
+                    push_down_aggregation->dropResult(table_id);
                 if (likely(checkRetriableForBatchCopOrMPP(table_id, query_info, e, num_allow_retry)))
                     continue;
                 else
@@ -20,6 +20,8 @@
 #include <Flash/Coprocessor/PushDownFilter.h>
 #include <Flash/Coprocessor/RemoteRequest.h>
 #include <Flash/Coprocessor/TiDBTableScan.h>
+#include <Storages/DeltaMerge/Filter/LateMaterializationFilter.h>
+#include <Storages/DeltaMerge/Filter/RuntimeFilter.h>
 #include <Storages/RegionQueryInfo.h>
 #include <Storages/SelectQueryInfo.h>
 #include <Storages/TableLockHolder.h>
@@ -100,6 +102,7 @@ private:
 
     // before_where, filter_column_name, after_where
     std::tuple<ExpressionActionsPtr, String, ExpressionActionsPtr> buildPushDownFilter();
+    DM::LateMaterializationFilterPtr buildLateMaterializationFilter();
     void executePushedDownFilter(
         size_t remote_read_streams_start_index,
         DAGPipeline & pipeline);
@@ -130,6 +133,12 @@ private:
     /// Intermediate variables shared by multiple member functions
 
     std::unique_ptr<MvccQueryInfo> mvcc_query_info;
+    // Filled by the joins that probe this table scan, see `DAGContext::getOrCreateRuntimeFilterList`.
+    DM::RuntimeFilterListPtr runtime_filter_list;
+    // The pushed down filter executed by the storage while reading, see `buildLateMaterializationFilter`.
+    DM::LateMaterializationFilterPtr late_materialization_filter;
+    // Registered by the aggregation above this table scan, see `DAGContext::setPushDownAggregation`.
+    DM::PushDownAggregationPtr push_down_aggregation;
     // We need to validate regions snapshot after getting streams from storage.
     LearnerReadSnapshot learner_read_snapshot;
     /// Table from where to read data, if not subquery.
@@ -43,6 +43,15 @@ const std::unordered_map<tipb::ExprType, String> window_func_map({
     {tipb::ExprType::Lag, "lag"},
 });
 
+// The aggregate functions which can be used as window functions over a frame.
+const std::unordered_map<tipb::ExprType, String> window_agg_func_map({
+    {tipb::ExprType::Count, "count"},
+    {tipb::ExprType::Sum, "sum"},
+    {tipb::ExprType::Min, "min"},
+    {tipb::ExprType::Max, "max"},
+    {tipb::ExprType::Avg, "avg"},
+});
+
 const std::unordered_map<tipb::ExprType, String> agg_func_map({
     {tipb::ExprType::Count, "count"},
     {tipb::ExprType::Sum, "sum"},
@@ -769,6 +778,21 @@ const String & getWindowFunctionName(const tipb::Expr & expr)
     throw TiFlashException(errmsg, Errors::Coprocessor::Unimplemented);
 }
 
+const String & getWindowAggFunctionName(const tipb::Expr & expr)
+{
+    if (!expr.has_distinct())
+    {
+        auto it = window_agg_func_map.find(expr.tp());
+        if (it != window_agg_func_map.end())
+            return it->second;
+    }
+
+    const auto errmsg = fmt::format(
+        "{}(distinct={}) is not supported in window.",
+        tipb::ExprType_Name(expr.tp()),
+        expr.has_distinct() ? "true" : "false");
+    throw TiFlashException(errmsg, Errors::Coprocessor::Unimplemented);
+}
 
 const String & getFunctionName(const tipb::Expr & expr)
 {
@@ -40,6 +40,7 @@ bool isWindowFunctionExpr(const tipb::Expr & expr);
 const String & getFunctionName(const tipb::Expr & expr);
 const String & getAggFunctionName(const tipb::Expr & expr);
 const String & getWindowFunctionName(const tipb::Expr & expr);
+const String & getWindowAggFunctionName(const tipb::Expr & expr);
 String getExchangeTypeName(const tipb::ExchangeType & tp);
 String getJoinTypeName(const tipb::JoinType & tp);
 String getFieldTypeName(Int32 tp);
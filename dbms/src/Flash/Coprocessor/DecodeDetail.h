@@ -31,5 +31,10 @@ struct DecodeDetail
 
     // Total byte size of the origin packet, even for fine grained shuffle.
     Int64 packet_bytes = 0;
+
+    // Byte size of the compressed chunks before and after decompression, and the cpu time of decompression.
+    Int64 compressed_bytes = 0;
+    Int64 uncompressed_bytes = 0;
+    UInt64 compression_time_ns = 0;
 };
 } // namespace DB
@@ -17,11 +17,14 @@
 #include <DataTypes/DataTypeNullable.h>
 #include <DataTypes/DataTypeString.h>
 #include <DataTypes/getLeastSupertype.h>
+#include <Flash/Coprocessor/DAGCodec.h>
+#include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/DAGExpressionAnalyzer.h>
 #include <Flash/Coprocessor/DAGUtils.h>
 #include <Flash/Coprocessor/JoinInterpreterHelper.h>
 #include <Interpreters/Context.h>
 #include <Interpreters/Join.h>
+#include <Storages/DeltaMerge/Filter/RuntimeFilter.h>
 #include <Storages/Transaction/TypeMapping.h>
 #include <fmt/format.h>
 
@@ -361,6 +364,53 @@ std::tuple<ExpressionActionsPtr, String, String> TiFlashJoin::genJoinOtherCondit
     return doGenJoinOtherConditionAction(context, join, columns_for_other_join_filter);
 }
 
+DM::RuntimeFilters TiFlashJoin::genRuntimeFilters(
+    DAGContext & dag_context,
+    const Names & build_key_names,
+    size_t max_in_values) const
+{
+    DM::RuntimeFilters runtime_filters;
+    /// Only the probe side rows without matched build side rows are dropped by inner join (including semi join) and tiflash right join.
+    if (kind != ASTTableJoin::Kind::Inner && kind != ASTTableJoin::Kind::Right)
+        return runtime_filters;
+    if (join.children_size() != 2)
+        return runtime_filters;
+
+    /// Selection does not change the schema, so the probe keys are still columns of the table scan.
+    const tipb::Executor * probe_child = &join.children(1 - build_side_index);
+    while (probe_child->tp() == tipb::ExecType::TypeSelection)
+        probe_child = &probe_child->selection().child();
+    const google::protobuf::RepeatedPtrField<tipb::ColumnInfo> * scan_columns = nullptr;
+    if (probe_child->tp() == tipb::ExecType::TypeTableScan)
+        scan_columns = &probe_child->tbl_scan().columns();
+    else if (probe_child->tp() == tipb::ExecType::TypePartitionTableScan)
+        scan_columns = &probe_child->partition_table_scan().columns();
+    else
+        return runtime_filters;
+
+    DM::RuntimeFilterListPtr runtime_filter_list;
+    const auto & probe_keys = getProbeJoinKeys();
+    RUNTIME_CHECK(static_cast<size_t>(probe_keys.size()) == build_key_names.size());
+    for (int i = 0; i < probe_keys.size(); ++i)
+    {
+        const auto & key = probe_keys[i];
+        if (!isColumnExpr(key))
+            continue;
+        const auto key_type = removeNullable(join_key_types[i].key_type);
+        if (!key_type->isInteger() && !key_type->isDateOrDateTime())
+            continue;
+        auto column_index = decodeDAGInt64(key.val());
+        if (column_index < 0 || column_index >= scan_columns->size())
+            continue;
+        auto runtime_filter = std::make_shared<DM::RuntimeFilter>((*scan_columns)[column_index].column_id(), build_key_names[i], max_in_values);
+        if (!runtime_filter_list)
+            runtime_filter_list = dag_context.getOrCreateRuntimeFilterList(probe_child->executor_id());
+        runtime_filter_list->add(runtime_filter);
+        runtime_filters.push_back(runtime_filter);
+    }
+    return runtime_filters;
+}
+
 std::tuple<ExpressionActionsPtr, Names, String> prepareJoin(
     const Context & context,
     const Block & input_header,
@@ -28,6 +28,16 @@
 namespace DB
 {
 class Context;
+class DAGContext;
+
+namespace DM
+{
+class RuntimeFilter;
+using RuntimeFilterPtr = std::shared_ptr<RuntimeFilter>;
+using RuntimeFilters = std::vector<RuntimeFilterPtr>;
+class RuntimeFilterList;
+using RuntimeFilterListPtr = std::shared_ptr<RuntimeFilterList>;
+} // namespace DM
 
 struct JoinKeyType
 {
@@ -117,6 +127,14 @@ struct TiFlashJoin
         const Block & right_input_header,
         const ExpressionActionsPtr & probe_side_prepare_join) const;
 
+    /// Generate the runtime filters for the probe side table scan, see `DM::RuntimeFilter`.
+    /// A filter is generated for each integer/date join key that is a column of the table scan, the filters are
+    /// registered to the table scan through `DAGContext::getOrCreateRuntimeFilterList`.
+    DM::RuntimeFilters genRuntimeFilters(
+        DAGContext & dag_context,
+        const Names & build_key_names,
+        size_t max_in_values) const;
+
     NamesAndTypes genColumnsForOtherJoinFilter(
         const Block & left_input_header,
         const Block & right_input_header,
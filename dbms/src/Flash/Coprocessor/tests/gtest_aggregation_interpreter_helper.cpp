@@ -0,0 +1,65 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataStreams/OneBlockInputStream.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Flash/Coprocessor/AggregationInterpreterHelper.h>
+#include <Flash/Coprocessor/DAGPipeline.h>
+#include <TestUtils/FunctionTestUtils.h>
+#include <gtest/gtest.h>
+
+namespace DB
+{
+namespace tests
+{
+TEST(AggregationInterpreterHelperTest, AppendPushDownAggregationResult)
+{
+    using FuncKind = DM::PushDownAggregation::FuncKind;
+    auto aggregation = std::make_shared<DM::PushDownAggregation>(DM::PushDownAggregation::Funcs{{FuncKind::CountAll}, {FuncKind::Max, 2}});
+    AggregateDescriptions aggregate_descriptions(2);
+    aggregate_descriptions[0].column_name = "count(1)";
+    aggregate_descriptions[1].column_name = "max(a)";
+
+    // The output columns of the aggregation are not in the order of the aggregate functions.
+    DAGPipeline pipeline;
+    pipeline.streams.push_back(std::make_shared<OneBlockInputStream>(Block{
+        createColumn<Nullable<Int64>>({7}, "max(a)"),
+        createColumn<UInt64>({3}, "count(1)"),
+    }));
+
+    // Nothing is appended if no pack is answered.
+    AggregationInterpreterHelper::appendPushDownAggregationResult(pipeline, nullptr, aggregate_descriptions, "test");
+    ASSERT_EQ(pipeline.streams.size(), 1);
+    AggregationInterpreterHelper::appendPushDownAggregationResult(pipeline, aggregation, aggregate_descriptions, "test");
+    ASSERT_EQ(pipeline.streams.size(), 1);
+
+    auto result = aggregation->createEmptyResult();
+    result.packs = 2;
+    result.rows = 100;
+    result.values = {Field(static_cast<UInt64>(100)), Field(static_cast<Int64>(42))};
+    aggregation->setResult(/*physical_table_id*/ 1, std::move(result));
+
+    // The answered result is appended as an extra row, which is merged by the final aggregation.
+    AggregationInterpreterHelper::appendPushDownAggregationResult(pipeline, aggregation, aggregate_descriptions, "test");
+    ASSERT_EQ(pipeline.streams.size(), 2);
+    Block block = pipeline.streams.back()->read();
+    ASSERT_EQ(block.rows(), 1);
+    ASSERT_TRUE(blocksHaveEqualStructure(block, pipeline.firstStream()->getHeader()));
+    ASSERT_COLUMN_EQ(createColumn<Nullable<Int64>>({42}), block.getByName("max(a)"));
+    ASSERT_COLUMN_EQ(createColumn<UInt64>({100}), block.getByName("count(1)"));
+}
+
+} // namespace tests
+} // namespace DB
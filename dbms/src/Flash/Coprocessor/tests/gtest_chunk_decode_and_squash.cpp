@@ -91,7 +91,7 @@ public:
         return block;
     }
 
-    void doTestWork(bool flush_something)
+    void doTestWork(bool flush_something, CompressionMethod compression_method = CompressionMethod::NONE)
     {
         const size_t block_rows = 1024;
         const size_t block_num = 256;
@@ -112,7 +112,10 @@ public:
         for (const auto & block : blocks)
         {
             codec_stream->encode(block, 0, block.rows());
-            encode_str_vec.push_back(codec_stream->getString());
+            if (compression_method == CompressionMethod::NONE)
+                encode_str_vec.push_back(codec_stream->getString());
+            else
+                encode_str_vec.push_back(CHBlockChunkCodec::compress(codec_stream->getString(), compression_method));
             codec_stream->clear();
         }
 
@@ -120,9 +123,12 @@ public:
         Block header = blocks.back();
         std::vector<Block> decoded_blocks;
         CHBlockChunkDecodeAndSquash decoder(header, block_rows * 4);
+        DecodeDetail detail;
         for (const auto & str : encode_str_vec)
         {
-            auto result = decoder.decodeAndSquash(str);
+            auto result = compression_method == CompressionMethod::NONE
+                ? decoder.decodeAndSquash(str)
+                : decoder.decodeAndSquashCompressed(str, detail);
             if (result)
                 decoded_blocks.push_back(std::move(result.value()));
         }
@@ -136,6 +142,8 @@ public:
         Block reference_block = squashBlocks(blocks);
         Block decoded_block = squashBlocks(decoded_blocks);
         ASSERT_BLOCK_EQ(reference_block, decoded_block);
+        if (compression_method != CompressionMethod::NONE)
+            ASSERT_GT(detail.uncompressed_bytes, 0);
     }
     Context context;
 };
@@ -148,5 +156,77 @@ try
 }
 CATCH
 
+TEST_F(TestChunkDecodeAndSquash, testDecodeAndSquashCompressed)
+try
+{
+    for (auto method : {CompressionMethod::LZ4, CompressionMethod::ZSTD})
+    {
+        doTestWork(true, method);
+        doTestWork(false, method);
+    }
+}
+CATCH
+
+TEST_F(TestChunkDecodeAndSquash, testDecodeAndSquashDictionaryEncoded)
+try
+{
+    std::vector<tipb::FieldType> fields(3);
+    fields[0].set_tp(TiDB::TypeString);
+    fields[0].set_flag(TiDB::ColumnFlagNotNull);
+    fields[1].set_tp(TiDB::TypeString);
+    fields[2].set_tp(TiDB::TypeLongLong);
+    fields[2].set_flag(TiDB::ColumnFlagNotNull);
+
+    auto make_block = [](size_t rows, size_t cardinality) {
+        auto str_col = ColumnGenerator::instance().generate({rows, "String", RANDOM, 16, cardinality});
+        auto nullable_str_col = ColumnGenerator::instance().generate({rows, "Nullable(String)", RANDOM, 16, cardinality, 0.2});
+        auto int_col = ColumnGenerator::instance().generate({rows, "Int64", RANDOM});
+        str_col.name = "col0";
+        nullable_str_col.name = "col1";
+        int_col.name = "col2";
+        return Block{str_col, nullable_str_col, int_col};
+    };
+
+    /// The columns of low cardinality, high cardinality and too few rows.
+    std::vector<Block> blocks{make_block(1000, 10), make_block(1000, 0), make_block(10, 2), make_block(3000, 300), make_block(0, 0)};
+
+    auto plain_stream = std::make_unique<CHBlockChunkCodec>()->newCodecStream(fields);
+    auto dictionary_stream = std::make_unique<CHBlockChunkCodec>()->newCodecStream(fields, true);
+    std::vector<String> encode_str_vec;
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+        const auto & block = blocks[i];
+        plain_stream->encode(block, 0, block.rows());
+        String plain_str = plain_stream->getString();
+        plain_stream->clear();
+        dictionary_stream->encode(block, 0, block.rows());
+        String dictionary_str = dictionary_stream->getString();
+        dictionary_stream->clear();
+
+        if (i == 0 || i == 3)
+            ASSERT_LT(dictionary_str.size(), plain_str.size());
+        else
+            ASSERT_EQ(dictionary_str, plain_str);
+
+        ASSERT_BLOCK_EQ(CHBlockChunkCodec::decode(dictionary_str, block.cloneEmpty()), block);
+        encode_str_vec.push_back(std::move(dictionary_str));
+    }
+
+    /// The decoded columns are appended to the accumulated block.
+    std::vector<Block> decoded_blocks;
+    CHBlockChunkDecodeAndSquash decoder(blocks.back(), 100000);
+    for (const auto & str : encode_str_vec)
+    {
+        auto result = decoder.decodeAndSquash(str);
+        if (result)
+            decoded_blocks.push_back(std::move(result.value()));
+    }
+    auto last_block = decoder.flush();
+    if (last_block)
+        decoded_blocks.push_back(std::move(last_block.value()));
+    ASSERT_BLOCK_EQ(squashBlocks(decoded_blocks), squashBlocks(blocks));
+}
+CATCH
+
 } // namespace tests
 } // namespace DB
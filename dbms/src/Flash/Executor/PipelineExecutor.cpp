@@ -0,0 +1,74 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Coprocessor/DAGContext.h>
+#include <Flash/Executor/PipelineExecutor.h>
+#include <Flash/Pipeline/Operators/GetResultSinkOp.h>
+#include <Flash/Pipeline/Schedule/PipelineTask.h>
+#include <Flash/Pipeline/Schedule/TaskScheduler.h>
+#include <Flash/Planner/PhysicalPlan.h>
+#include <Interpreters/Context.h>
+
+namespace DB
+{
+PipelineExecutor::PipelineExecutor(
+    const ProcessListEntryPtr & process_list_entry_,
+    Context & context_,
+    PhysicalPlan & physical_plan)
+    : QueryExecutor(process_list_entry_)
+    , context(context_)
+    , plan_str(physical_plan.toString())
+{
+    physical_plan.buildPipelineExecGroup(status, group_builder, context, context.getMaxStreams());
+}
+
+ExecutionResult PipelineExecutor::execute(ResultHandler result_handler)
+{
+    if (!group_builder.hasSinkOp())
+    {
+        // The handler is called by many threads of the `TaskScheduler` concurrently.
+        auto mu = std::make_shared<std::mutex>();
+        ResultHandler sync_result_handler = result_handler.isIgnored()
+            ? result_handler
+            : ResultHandler([mu, result_handler](const Block & block) {
+                  std::lock_guard lock(*mu);
+                  result_handler(block);
+              });
+        group_builder.transform([&](auto & builder) {
+            builder.setSinkOp(std::make_unique<GetResultSinkOp>(status, context.getDAGContext()->log->identifier(), sync_result_handler));
+        });
+    }
+
+    auto pipeline_exec_group = group_builder.build();
+    std::vector<TaskPtr> tasks;
+    tasks.reserve(pipeline_exec_group.size());
+    for (auto & pipeline_exec : pipeline_exec_group)
+        tasks.push_back(std::make_unique<PipelineTask>(status, std::move(pipeline_exec)));
+    assert(TaskScheduler::instance);
+    TaskScheduler::instance->submit(tasks);
+
+    status.wait();
+    return status.toExecutionResult();
+}
+
+void PipelineExecutor::cancel(bool /*is_kill*/)
+{
+    status.cancel();
+}
+
+String PipelineExecutor::dump() const
+{
+    return plan_str;
+}
+} // namespace DB
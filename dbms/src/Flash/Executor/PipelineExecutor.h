@@ -0,0 +1,61 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Flash/Executor/QueryExecutor.h>
+#include <Flash/Pipeline/Exec/PipelineExecBuilder.h>
+#include <Flash/Pipeline/Exec/PipelineExecutorStatus.h>
+
+namespace DB
+{
+class Context;
+class PhysicalPlan;
+
+/**
+ * PipelineExecutor executes the physical plan by the pipeline model.
+ * The plan is split into a group of pipeline_execs running in parallel, and every pipeline_exec
+ * is driven by a task of the `TaskScheduler`, so the query does not create any thread by itself.
+ */
+class PipelineExecutor : public QueryExecutor
+{
+public:
+    PipelineExecutor(
+        const ProcessListEntryPtr & process_list_entry_,
+        Context & context_,
+        PhysicalPlan & physical_plan);
+
+    String dump() const override;
+
+    void cancel(bool is_kill) override;
+
+    // All the tasks are executed by the threads of `TaskScheduler`.
+    int estimateNewThreadCount() override { return 0; }
+
+protected:
+    ExecutionResult execute(ResultHandler result_handler) override;
+
+private:
+    Context & context;
+
+    String plan_str;
+
+    // Must be declared before `group_builder`, the operators hold the reference of it.
+    PipelineExecutorStatus status;
+
+    // The operators are built in the constructor, and the result sink is appended in `execute`
+    // if the plan does not end with a sink.
+    PipelineExecGroupBuilder group_builder;
+};
+} // namespace DB
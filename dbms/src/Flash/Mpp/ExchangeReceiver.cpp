@@ -53,6 +53,7 @@ String constructStatusString(ExchangeReceiverState state, const String & error_m
 template <bool enable_fine_grained_shuffle, bool is_sync>
 bool pushPacket(size_t source_index,
                 const String & req_info,
+                bool compressed,
                 const TrackedMppDataPacketPtr & tracked_packet,
                 const std::vector<MsgChannelPtr> & msg_channels,
                 LoggerPtr & log)
@@ -105,7 +106,8 @@ bool pushPacket(size_t source_index,
                 tracked_packet,
                 error_ptr,
                 resp_ptr,
-                std::move(chunks[i]));
+                std::move(chunks[i]),
+                compressed);
             push_succeed = msg_channels[i]->push(std::move(recv_msg)) == MPMCQueueResult::OK;
             if constexpr (is_sync)
                 fiu_do_on(FailPoints::random_receiver_sync_msg_push_failure_failpoint, push_succeed = false;);
@@ -132,7 +134,8 @@ bool pushPacket(size_t source_index,
                 tracked_packet,
                 error_ptr,
                 resp_ptr,
-                std::move(chunks));
+                std::move(chunks),
+                compressed);
 
             push_succeed = msg_channels[0]->push(std::move(recv_msg)) == MPMCQueueResult::OK;
             if constexpr (is_sync)
@@ -365,6 +368,7 @@ private:
             if (!pushPacket<enable_fine_grained_shuffle, false>(
                     request->source_index,
                     req_info,
+                    request->is_compressed,
                     packet,
                     *msg_channels,
                     log))
@@ -601,6 +605,7 @@ void ExchangeReceiverBase<RPCContext>::readLoop(const Request & req)
                 if (!pushPacket<enable_fine_grained_shuffle, true>(
                         req.source_index,
                         req_info,
+                        req.is_compressed,
                         packet,
                         msg_channels,
                         log))
@@ -670,7 +675,9 @@ DecodeDetail ExchangeReceiverBase<RPCContext>::decodeChunks(
     detail.packet_bytes = packet.ByteSizeLong();
     for (const String * chunk : recv_msg->chunks)
     {
-        auto result = decoder_ptr->decodeAndSquash(*chunk);
+        auto result = recv_msg->compressed
+            ? decoder_ptr->decodeAndSquashCompressed(*chunk, detail)
+            : decoder_ptr->decodeAndSquash(*chunk);
         if (!result)
             continue;
         detail.rows += result->rows();
@@ -696,7 +703,39 @@ ExchangeReceiverResult ExchangeReceiverBase<RPCContext>::nextResult(
     }
 
     std::shared_ptr<ReceivedMessage> recv_msg;
-    if (msg_channels[stream_id]->pop(recv_msg) != MPMCQueueResult::OK)
+    auto pop_result = msg_channels[stream_id]->pop(recv_msg);
+    return handleReceivedMessage(pop_result, recv_msg, block_queue, header, decoder_ptr);
+}
+
+template <typename RPCContext>
+std::optional<ExchangeReceiverResult> ExchangeReceiverBase<RPCContext>::tryNextResult(
+    std::queue<Block> & block_queue,
+    const Block & header,
+    size_t stream_id,
+    std::unique_ptr<CHBlockChunkDecodeAndSquash> & decoder_ptr)
+{
+    if (unlikely(stream_id >= msg_channels.size()))
+    {
+        LOG_ERROR(exc_log, "stream_id out of range, stream_id: {}, total_stream_count: {}", stream_id, msg_channels.size());
+        return ExchangeReceiverResult::newError(0, "", "stream_id out of range");
+    }
+
+    std::shared_ptr<ReceivedMessage> recv_msg;
+    auto pop_result = msg_channels[stream_id]->tryPop(recv_msg);
+    if (pop_result == MPMCQueueResult::EMPTY)
+        return std::nullopt;
+    return handleReceivedMessage(pop_result, recv_msg, block_queue, header, decoder_ptr);
+}
+
+template <typename RPCContext>
+ExchangeReceiverResult ExchangeReceiverBase<RPCContext>::handleReceivedMessage(
+    MPMCQueueResult pop_result,
+    const std::shared_ptr<ReceivedMessage> & recv_msg,
+    std::queue<Block> & block_queue,
+    const Block & header,
+    std::unique_ptr<CHBlockChunkDecodeAndSquash> & decoder_ptr)
+{
+    if (pop_result != MPMCQueueResult::OK)
     {
         return handleUnnormalChannel(block_queue, decoder_ptr);
     }
@@ -30,6 +30,7 @@
 
 #include <future>
 #include <mutex>
+#include <optional>
 #include <thread>
 
 namespace DB
@@ -43,6 +44,8 @@ struct ReceivedMessage
     const mpp::Error * error_ptr;
     const String * resp_ptr;
     std::vector<const String *> chunks;
+    // Whether the chunks are compressed by CHBlockChunkCodec::compress.
+    bool compressed;
 
     // Constructor that move chunks.
     ReceivedMessage(size_t source_index_,
@@ -50,13 +53,15 @@ struct ReceivedMessage
                     const std::shared_ptr<DB::TrackedMppDataPacket> & packet_,
                     const mpp::Error * error_ptr_,
                     const String * resp_ptr_,
-                    std::vector<const String *> && chunks_)
+                    std::vector<const String *> && chunks_,
+                    bool compressed_ = false)
         : source_index(source_index_)
         , req_info(req_info_)
         , packet(packet_)
         , error_ptr(error_ptr_)
         , resp_ptr(resp_ptr_)
         , chunks(chunks_)
+        , compressed(compressed_)
     {}
 };
 
@@ -146,6 +151,13 @@ public:
         size_t stream_id,
         std::unique_ptr<CHBlockChunkDecodeAndSquash> & decoder_ptr);
 
+    /// The non-blocking version of `nextResult`, return std::nullopt if no message is received now.
+    std::optional<ExchangeReceiverResult> tryNextResult(
+        std::queue<Block> & block_queue,
+        const Block & header,
+        size_t stream_id,
+        std::unique_ptr<CHBlockChunkDecodeAndSquash> & decoder_ptr);
+
     size_t getSourceNum() const { return source_num; }
     uint64_t getFineGrainedShuffleStreamCount() const { return enable_fine_grained_shuffle_flag ? output_stream_count : 0; }
 
@@ -165,6 +177,13 @@ private:
     bool setEndState(ExchangeReceiverState new_state);
     String getStatusString();
 
+    ExchangeReceiverResult handleReceivedMessage(
+        MPMCQueueResult pop_result,
+        const std::shared_ptr<ReceivedMessage> & recv_msg,
+        std::queue<Block> & block_queue,
+        const Block & header,
+        std::unique_ptr<CHBlockChunkDecodeAndSquash> & decoder_ptr);
+
     ExchangeReceiverResult handleUnnormalChannel(
         std::queue<Block> & block_queue,
         std::unique_ptr<CHBlockChunkDecodeAndSquash> & decoder_ptr);
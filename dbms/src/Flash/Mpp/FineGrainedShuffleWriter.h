@@ -32,7 +32,8 @@ public:
         TiDB::TiDBCollators collators_,
         DAGContext & dag_context_,
         UInt64 fine_grained_shuffle_stream_count_,
-        UInt64 fine_grained_shuffle_batch_size);
+        UInt64 fine_grained_shuffle_batch_size,
+        bool enable_dictionary_encoding = false);
     void prepare(const Block & sample_block) override;
     void write(const Block & block) override;
     void flush() override;
@@ -194,13 +194,15 @@ GRPCReceiverContext::GRPCReceiverContext(
     pingcap::kv::Cluster * cluster_,
     std::shared_ptr<MPPTaskManager> task_manager_,
     bool enable_local_tunnel_,
-    bool enable_async_grpc_)
+    bool enable_async_grpc_,
+    bool enable_compression_)
     : exchange_receiver_meta(exchange_receiver_meta_)
     , task_meta(task_meta_)
     , cluster(cluster_)
     , task_manager(std::move(task_manager_))
     , enable_local_tunnel(enable_local_tunnel_)
     , enable_async_grpc(enable_async_grpc_)
+    , enable_compression(enable_compression_)
 {}
 
 ExchangeRecvRequest GRPCReceiverContext::makeRequest(int index) const
@@ -213,6 +215,7 @@ ExchangeRecvRequest GRPCReceiverContext::makeRequest(int index) const
     ExchangeRecvRequest req;
     req.source_index = index;
     req.is_local = enable_local_tunnel && sender_task->address() == task_meta.address();
+    req.is_compressed = enable_compression && !req.is_local;
     req.send_task_id = sender_task->task_id();
     req.recv_task_id = task_meta.task_id();
     req.req = std::make_shared<mpp::EstablishMPPConnectionRequest>();
@@ -59,6 +59,8 @@ struct ExchangeRecvRequest
     Int64 recv_task_id = -2;
     std::shared_ptr<mpp::EstablishMPPConnectionRequest> req;
     bool is_local = false;
+    // The chunks sent through the remote tunnels are compressed if the exchange compression is enabled.
+    bool is_compressed = false;
 
     String debugString() const;
 };
@@ -77,7 +79,8 @@ public:
         pingcap::kv::Cluster * cluster_,
         std::shared_ptr<MPPTaskManager> task_manager_,
         bool enable_local_tunnel_,
-        bool enable_async_grpc_);
+        bool enable_async_grpc_,
+        bool enable_compression_ = false);
 
     ExchangeRecvRequest makeRequest(int index) const;
 
@@ -105,5 +108,6 @@ private:
     std::shared_ptr<MPPTaskManager> task_manager;
     bool enable_local_tunnel;
     bool enable_async_grpc;
+    bool enable_compression;
 };
 } // namespace DB
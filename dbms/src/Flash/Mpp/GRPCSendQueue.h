@@ -106,6 +106,12 @@ public:
         RUNTIME_ASSERT(status == Status::NONE, log, "status {} is not none", magic_enum::enum_name(status));
     }
 
+    /// Whether `push` would block now.
+    bool isFull() const
+    {
+        return send_queue.isFull();
+    }
+
     /// Push the data from queue and kick the grpc completion queue.
     ///
     /// Return true if push succeed.
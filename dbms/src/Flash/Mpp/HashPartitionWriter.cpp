@@ -26,7 +26,8 @@ HashPartitionWriter<ExchangeWriterPtr>::HashPartitionWriter(
     std::vector<Int64> partition_col_ids_,
     TiDB::TiDBCollators collators_,
     Int64 batch_send_min_limit_,
-    DAGContext & dag_context_)
+    DAGContext & dag_context_,
+    bool enable_dictionary_encoding)
     : DAGResponseWriter(/*records_per_chunk=*/-1, dag_context_)
     , batch_send_min_limit(batch_send_min_limit_)
     , writer(writer_)
@@ -37,7 +38,7 @@ HashPartitionWriter<ExchangeWriterPtr>::HashPartitionWriter(
     partition_num = writer_->getPartitionNum();
     RUNTIME_CHECK(partition_num > 0);
     RUNTIME_CHECK(dag_context.encode_type == tipb::EncodeType::TypeCHBlock);
-    chunk_codec_stream = std::make_unique<CHBlockChunkCodec>()->newCodecStream(dag_context.result_field_types);
+    chunk_codec_stream = std::make_unique<CHBlockChunkCodec>()->newCodecStream(dag_context.result_field_types, enable_dictionary_encoding);
 }
 
 template <class ExchangeWriterPtr>
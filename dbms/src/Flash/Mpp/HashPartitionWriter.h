@@ -31,7 +31,8 @@ public:
         std::vector<Int64> partition_col_ids_,
         TiDB::TiDBCollators collators_,
         Int64 batch_send_min_limit_,
-        DAGContext & dag_context_);
+        DAGContext & dag_context_,
+        bool enable_dictionary_encoding = false);
     void write(const Block & block) override;
     void flush() override;
 
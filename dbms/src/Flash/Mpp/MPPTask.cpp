@@ -123,7 +123,11 @@ void MPPTask::run()
 
 void MPPTask::registerTunnels(const mpp::DispatchTaskRequest & task_request)
 {
-    auto tunnel_set_local = std::make_shared<MPPTunnelSet>(log->identifier());
+    // TiDB can not decode the compressed chunks, so only the non-root tasks compress the exchanged data.
+    auto compression_method = dag_context->isRootMPPTask()
+        ? CompressionMethod::NONE
+        : static_cast<CompressionMethod>(context->getSettingsRef().mpp_exchange_compression_method);
+    auto tunnel_set_local = std::make_shared<MPPTunnelSet>(log->identifier(), compression_method);
     std::chrono::seconds timeout(task_request.timeout());
     const auto & exchange_sender = dag_req.root_executor().exchange_sender();
 
@@ -170,7 +174,8 @@ void MPPTask::initExchangeReceivers()
                     context->getTMTContext().getKVCluster(),
                     context->getTMTContext().getMPPTaskManager(),
                     context->getSettingsRef().enable_local_tunnel,
-                    context->getSettingsRef().enable_async_grpc_client),
+                    context->getSettingsRef().enable_async_grpc_client,
+                    context->getSettingsRef().mpp_exchange_compression_method != CompressionMethod::NONE),
                 executor.exchange_receiver().encoded_task_meta_size(),
                 context->getMaxStreams(),
                 log->identifier(),
@@ -168,6 +168,19 @@ void MPPTunnel::write(TrackedMppDataPacketPtr && data)
     throw Exception(fmt::format("write to tunnel which is already closed,{}", tunnel_sender->isConsumerFinished() ? tunnel_sender->getConsumerFinishMsg() : ""));
 }
 
+bool MPPTunnel::isReadyForWrite()
+{
+    std::unique_lock lk(mu);
+    if (status == TunnelStatus::Unconnected)
+    {
+        if (timeout.count() > 0 && connect_watch.elapsedSeconds() >= timeout.count())
+            throw Exception(tunnel_id + " is timeout");
+        return false;
+    }
+    // `write` throws immediately if the tunnel is already closed.
+    return tunnel_sender == nullptr || tunnel_sender->isReadyForWrite();
+}
+
 /// done normally and being called exactly once after writing all packets
 void MPPTunnel::writeDone()
 {
@@ -16,6 +16,7 @@
 
 #include <Common/Logger.h>
 #include <Common/MPMCQueue.h>
+#include <Common/Stopwatch.h>
 #include <Common/ThreadManager.h>
 #include <Flash/FlashService.h>
 #include <Flash/Mpp/GRPCSendQueue.h>
@@ -77,6 +78,12 @@ public:
         return send_queue.push(std::move(data)) == MPMCQueueResult::OK;
     }
 
+    /// Whether `push` can return without blocking.
+    virtual bool isReadyForWrite() const
+    {
+        return !send_queue.isFull();
+    }
+
     virtual void cancelWith(const String & reason)
     {
         send_queue.cancelWith(reason);
@@ -179,6 +186,11 @@ public:
         return queue.push(std::move(data));
     }
 
+    bool isReadyForWrite() const override
+    {
+        return !queue.isFull();
+    }
+
     bool finish() override
     {
         return queue.finish();
@@ -275,6 +287,10 @@ public:
     // write a single packet to the tunnel's send queue, it will block if tunnel is not ready.
     void write(TrackedMppDataPacketPtr && data);
 
+    // whether `write` can return without blocking, i.e. the tunnel is connected and its send queue is not full.
+    // It throws if the tunnel is still not connected after `timeout`, the same as `write`.
+    bool isReadyForWrite();
+
     // finish the writing, and wait until the sender finishes.
     void writeDone();
 
@@ -295,6 +311,14 @@ public:
 
     const ConnectionProfileInfo & getConnectionProfileInfo() const { return connection_profile_info; }
 
+    // record the compression of the chunks written to this tunnel, only the remote tunnels compress chunks.
+    void addCompressionInfo(const ConnectionProfileInfo & info)
+    {
+        connection_profile_info.uncompressed_bytes += info.uncompressed_bytes;
+        connection_profile_info.compressed_bytes += info.compressed_bytes;
+        connection_profile_info.compression_time_ns += info.compression_time_ns;
+    }
+
     bool isLocal() const { return mode == TunnelSenderMode::LOCAL; }
     bool isAsync() const { return mode == TunnelSenderMode::ASYNC_GRPC; }
 
@@ -333,6 +357,8 @@ private:
     TunnelStatus status;
 
     std::chrono::seconds timeout;
+    // measures the time waiting for the connection in `isReadyForWrite`.
+    Stopwatch connect_watch;
 
     // tunnel id is in the format like "tunnel[sender]+[receiver]"
     String tunnel_id;
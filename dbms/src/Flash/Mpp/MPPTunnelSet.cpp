@@ -14,6 +14,8 @@
 
 #include <Common/Exception.h>
 #include <Common/FailPoint.h>
+#include <Common/Stopwatch.h>
+#include <Flash/Coprocessor/CHBlockChunkCodec.h>
 #include <Flash/Mpp/MPPTunnelSet.h>
 #include <Flash/Mpp/TrackedMppDataPacket.h>
 #include <Flash/Mpp/Utils.h>
@@ -37,6 +39,23 @@ TrackedMppDataPacketPtr serializePacket(const tipb::SelectResponse & response)
     checkPacketSize(tracked_packet->getPacket().ByteSizeLong());
     return tracked_packet;
 }
+
+/// Compress the chunks of the packet for the remote tunnels, the byte size and cpu time are recorded in `info`.
+TrackedMppDataPacketPtr compressPacket(const TrackedMppDataPacket & packet, CompressionMethod method, ConnectionProfileInfo & info)
+{
+    Stopwatch watch(CLOCK_THREAD_CPUTIME_ID);
+    auto compressed_packet = std::make_shared<TrackedMppDataPacket>(packet.mem_tracker_wrapper.memory_tracker);
+    for (const auto & chunk : packet.packet.chunks())
+    {
+        auto compressed_chunk = CHBlockChunkCodec::compress(chunk, method);
+        info.uncompressed_bytes += chunk.size();
+        info.compressed_bytes += compressed_chunk.size();
+        compressed_packet->addChunk(std::move(compressed_chunk));
+    }
+    *compressed_packet->getPacket().mutable_stream_ids() = packet.packet.stream_ids();
+    info.compression_time_ns += watch.elapsed();
+    return compressed_packet;
+}
 } // namespace
 
 template <typename Tunnel>
@@ -60,16 +79,44 @@ void MPPTunnelSetBase<Tunnel>::broadcastOrPassThroughWrite(TrackedMppDataPacketP
 {
     checkPacketSize(packet->getPacket().ByteSizeLong());
     RUNTIME_CHECK(!tunnels.empty());
-    // TODO avoid copy packet for broadcast.
-    for (size_t i = 1; i < tunnels.size(); ++i)
-        tunnels[i]->write(packet->copy());
-    tunnels[0]->write(std::move(packet));
+    if (compression_method == CompressionMethod::NONE || remote_tunnel_cnt == 0)
+    {
+        // TODO avoid copy packet for broadcast.
+        for (size_t i = 1; i < tunnels.size(); ++i)
+            tunnels[i]->write(packet->copy());
+        tunnels[0]->write(std::move(packet));
+        return;
+    }
+
+    // The chunks are compressed only once and shared by all the remote tunnels,
+    // so the compression time is only recorded by the first remote tunnel.
+    ConnectionProfileInfo compression_info;
+    auto compressed_packet = compressPacket(*packet, compression_method, compression_info);
+    for (size_t i = 0; i < tunnels.size(); ++i)
+    {
+        if (needCompress(i))
+        {
+            tunnels[i]->addCompressionInfo(compression_info);
+            compression_info.compression_time_ns = 0;
+            tunnels[i]->write(compressed_packet->copy());
+        }
+        else
+        {
+            tunnels[i]->write(packet->copy());
+        }
+    }
 }
 
 template <typename Tunnel>
 void MPPTunnelSetBase<Tunnel>::partitionWrite(TrackedMppDataPacketPtr && packet, int16_t partition_id)
 {
     checkPacketSize(packet->getPacket().ByteSizeLong());
+    if (needCompress(partition_id))
+    {
+        ConnectionProfileInfo compression_info;
+        packet = compressPacket(*packet, compression_method, compression_info);
+        tunnels[partition_id]->addCompressionInfo(compression_info);
+    }
     tunnels[partition_id]->write(std::move(packet));
 }
 
@@ -85,6 +132,8 @@ void MPPTunnelSetBase<Tunnel>::registerTunnel(const MPPTaskId & receiver_task_id
     {
         ++external_thread_cnt;
     }
+    if (!tunnel->isLocal())
+        ++remote_tunnel_cnt;
 }
 
 template <typename Tunnel>
@@ -94,6 +143,17 @@ void MPPTunnelSetBase<Tunnel>::close(const String & reason, bool wait_sender_fin
         tunnel->close(reason, wait_sender_finish);
 }
 
+template <typename Tunnel>
+bool MPPTunnelSetBase<Tunnel>::isReadyForWrite() const
+{
+    for (const auto & tunnel : tunnels)
+    {
+        if (!tunnel->isReadyForWrite())
+            return false;
+    }
+    return true;
+}
+
 template <typename Tunnel>
 void MPPTunnelSetBase<Tunnel>::finishWrite()
 {
@@ -16,6 +16,7 @@
 
 #include <Flash/Mpp/MPPTaskId.h>
 #include <Flash/Mpp/MPPTunnel.h>
+#include <IO/CompressedStream.h>
 #ifdef __clang__
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wdeprecated-declarations"
@@ -33,8 +34,11 @@ class MPPTunnelSetBase : private boost::noncopyable
 {
 public:
     using TunnelPtr = std::shared_ptr<Tunnel>;
-    explicit MPPTunnelSetBase(const String & req_id)
+    /// The chunks written to the remote tunnels are compressed with `compression_method_`,
+    /// local tunnels never compress since the packets are not serialized.
+    explicit MPPTunnelSetBase(const String & req_id, CompressionMethod compression_method_ = CompressionMethod::NONE)
         : log(Logger::get(req_id))
+        , compression_method(compression_method_)
     {}
 
     // this is a root mpp writing.
@@ -54,6 +58,9 @@ public:
     /// user confused.
     void sendExecutionSummary(const tipb::SelectResponse & response);
 
+    /// Whether all the tunnels can be written without blocking, see `MPPTunnel::isReadyForWrite`.
+    bool isReadyForWrite() const;
+
     void close(const String & reason, bool wait_sender_finish);
     void finishWrite();
     void registerTunnel(const MPPTaskId & id, const TunnelPtr & tunnel);
@@ -70,11 +77,18 @@ public:
     const std::vector<TunnelPtr> & getTunnels() const { return tunnels; }
 
 private:
+    bool needCompress(size_t index) const
+    {
+        return compression_method != CompressionMethod::NONE && !tunnels[index]->isLocal();
+    }
+
     std::vector<TunnelPtr> tunnels;
     std::unordered_map<MPPTaskId, size_t> receiver_task_id_to_index_map;
     const LoggerPtr log;
+    const CompressionMethod compression_method;
 
     int external_thread_cnt = 0;
+    size_t remote_tunnel_cnt = 0;
 };
 
 class MPPTunnelSet : public MPPTunnelSetBase<MPPTunnel>
@@ -32,7 +32,8 @@ std::unique_ptr<DAGResponseWriter> newMPPExchangeWriter(
     DAGContext & dag_context,
     bool enable_fine_grained_shuffle,
     UInt64 fine_grained_shuffle_stream_count,
-    UInt64 fine_grained_shuffle_batch_size)
+    UInt64 fine_grained_shuffle_batch_size,
+    bool enable_dictionary_encoding = false)
 {
     RUNTIME_CHECK(dag_context.isMPPTask());
     if (dag_context.isRootMPPTask())
@@ -57,7 +58,8 @@ std::unique_ptr<DAGResponseWriter> newMPPExchangeWriter(
                     partition_col_collators,
                     dag_context,
                     fine_grained_shuffle_stream_count,
-                    fine_grained_shuffle_batch_size);
+                    fine_grained_shuffle_batch_size,
+                    enable_dictionary_encoding);
             }
             else
             {
@@ -66,7 +68,8 @@ std::unique_ptr<DAGResponseWriter> newMPPExchangeWriter(
                     partition_col_ids,
                     partition_col_collators,
                     batch_send_min_limit,
-                    dag_context);
+                    dag_context,
+                    enable_dictionary_encoding);
             }
         }
         else
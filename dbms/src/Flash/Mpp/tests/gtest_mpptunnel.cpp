@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -529,6 +530,48 @@ try
 }
 CATCH
 
+TEST_F(TestMPPTunnel, LocalIsReadyForWrite)
+try
+{
+    auto mpp_tunnel_ptr = constructLocalSyncTunnel();
+    GTEST_ASSERT_EQ(mpp_tunnel_ptr->isReadyForWrite(), false);
+    mpp_tunnel_ptr->connect(nullptr);
+    GTEST_ASSERT_EQ(mpp_tunnel_ptr->isReadyForWrite(), true);
+
+    // Without the reader, the send queue is full after writing `queue_size` packets.
+    size_t written = 0;
+    while (written < 100 && mpp_tunnel_ptr->isReadyForWrite())
+    {
+        mpp_tunnel_ptr->write(newDataPacket("First"));
+        ++written;
+    }
+    GTEST_ASSERT_EQ(written, 10);
+
+    MockLocalReaderPtr local_reader_ptr = std::make_shared<MockLocalReader>(mpp_tunnel_ptr->getLocalTunnelSender());
+    mpp_tunnel_ptr->writeDone();
+    local_reader_ptr->thread_manager->wait(); // Join local read thread
+    GTEST_ASSERT_EQ(local_reader_ptr->write_packet_vec.size(), written);
+    GTEST_ASSERT_EQ(mpp_tunnel_ptr->isReadyForWrite(), true);
+}
+CATCH
+
+TEST_F(TestMPPTunnel, IsReadyForWriteTimeout)
+{
+    try
+    {
+        timeout = std::chrono::seconds(1);
+        auto mpp_tunnel_ptr = constructRemoteSyncTunnel();
+        GTEST_ASSERT_EQ(mpp_tunnel_ptr->isReadyForWrite(), false);
+        std::this_thread::sleep_for(timeout);
+        mpp_tunnel_ptr->isReadyForWrite();
+        GTEST_FAIL();
+    }
+    catch (Exception & e)
+    {
+        GTEST_ASSERT_EQ(e.message(), "0000_0001 is timeout");
+    }
+}
+
 TEST_F(TestMPPTunnel, LocalConsumerFinish)
 try
 {
@@ -0,0 +1,77 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Flash/Pipeline/Exec/PipelineExecutorStatus.h>
+
+namespace DB
+{
+ExecutionResult PipelineExecutorStatus::toExecutionResult()
+{
+    auto get_err_msg = getErrMsg();
+    if (!get_err_msg.empty())
+        return ExecutionResult::fail(get_err_msg);
+    // cancelled without error, the result is incomplete.
+    if (isCancelled())
+        return ExecutionResult::fail(cancelled_err_msg);
+    return ExecutionResult::success();
+}
+
+String PipelineExecutorStatus::getErrMsg()
+{
+    std::lock_guard lock(mu);
+    return err_msg;
+}
+
+void PipelineExecutorStatus::onErrorOccurred(String && err_msg_)
+{
+    {
+        std::lock_guard lock(mu);
+        // only record the first error.
+        if (!err_msg.empty())
+            return;
+        err_msg = err_msg_.empty() ? empty_err_msg : std::move(err_msg_);
+    }
+    cancel();
+}
+
+void PipelineExecutorStatus::onTaskSubmit()
+{
+    std::lock_guard lock(mu);
+    ++active_task_count;
+}
+
+void PipelineExecutorStatus::onTaskFinish()
+{
+    bool is_finished = false;
+    {
+        std::lock_guard lock(mu);
+        RUNTIME_CHECK(active_task_count > 0);
+        is_finished = (--active_task_count == 0);
+    }
+    if (is_finished)
+        cv.notify_all();
+}
+
+void PipelineExecutorStatus::wait()
+{
+    std::unique_lock lock(mu);
+    cv.wait(lock, [&] { return 0 == active_task_count; });
+}
+
+void PipelineExecutorStatus::cancel()
+{
+    is_cancelled.store(true, std::memory_order_release);
+}
+} // namespace DB
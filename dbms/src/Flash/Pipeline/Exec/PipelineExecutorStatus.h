@@ -0,0 +1,63 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Flash/Executor/QueryExecutor.h>
+#include <common/types.h>
+
+#include <atomic>
+#include <boost/noncopyable.hpp>
+#include <condition_variable>
+#include <mutex>
+
+namespace DB
+{
+/// The shared status of all the tasks of a query executed by the pipeline model.
+/// The query is finished after all of its tasks are finished, and the first error
+/// occurred in any task cancels the other tasks.
+class PipelineExecutorStatus : private boost::noncopyable
+{
+public:
+    static constexpr auto empty_err_msg = "error without err msg";
+    static constexpr auto cancelled_err_msg = "query is cancelled";
+
+    ExecutionResult toExecutionResult();
+
+    String getErrMsg();
+
+    void onErrorOccurred(String && err_msg);
+
+    void onTaskSubmit();
+
+    void onTaskFinish();
+
+    void wait();
+
+    void cancel();
+
+    bool isCancelled() const
+    {
+        return is_cancelled.load(std::memory_order_acquire);
+    }
+
+private:
+    std::mutex mu;
+    std::condition_variable cv;
+    String err_msg;
+    UInt32 active_task_count{0};
+
+    std::atomic_bool is_cancelled{false};
+};
+} // namespace DB
@@ -0,0 +1,52 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <DataStreams/IBlockInputStream.h>
+#include <Flash/Pipeline/Operators/Operator.h>
+
+#include <optional>
+
+namespace DB
+{
+/// Wrap an `IBlockInputStream` as the source of pipeline, e.g. the streams of storage read.
+/// Reading from the stream may block, so the read is always done by `executeIO` in the io thread pool.
+class BlockInputStreamSourceOp : public SourceOp
+{
+public:
+    BlockInputStreamSourceOp(
+        PipelineExecutorStatus & exec_status_,
+        const String & req_id,
+        const BlockInputStreamPtr & impl_);
+
+    String getName() const override
+    {
+        return "BlockInputStreamSourceOp";
+    }
+
+protected:
+    void operatePrefixImpl() override;
+    void operateSuffixImpl() override;
+
+    OperatorStatus readImpl(Block & block) override;
+
+    OperatorStatus executeIOImpl() override;
+
+private:
+    BlockInputStreamPtr impl;
+
+    std::optional<Block> io_block;
+};
+} // namespace DB
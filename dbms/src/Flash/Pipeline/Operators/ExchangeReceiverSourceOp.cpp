@@ -0,0 +1,51 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Pipeline/Operators/ExchangeReceiverSourceOp.h>
+
+namespace DB
+{
+void ExchangeReceiverSourceOp::operatePrefixImpl()
+{
+    stream->readPrefix();
+}
+
+void ExchangeReceiverSourceOp::operateSuffixImpl()
+{
+    stream->readSuffix();
+}
+
+OperatorStatus ExchangeReceiverSourceOp::readImpl(Block & block)
+{
+    if (recv_block)
+    {
+        std::swap(block, *recv_block);
+        recv_block.reset();
+        return OperatorStatus::HAS_OUTPUT;
+    }
+    return stream->tryRead(block) ? OperatorStatus::HAS_OUTPUT : OperatorStatus::WAITING;
+}
+
+OperatorStatus ExchangeReceiverSourceOp::awaitImpl()
+{
+    if (recv_block)
+        return OperatorStatus::HAS_OUTPUT;
+
+    Block block;
+    if (!stream->tryRead(block))
+        return OperatorStatus::WAITING;
+    recv_block.emplace(std::move(block));
+    return OperatorStatus::HAS_OUTPUT;
+}
+} // namespace DB
@@ -0,0 +1,61 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <DataStreams/TiRemoteBlockInputStream.h>
+#include <Flash/Pipeline/Operators/Operator.h>
+
+#include <optional>
+
+namespace DB
+{
+/// Read the blocks received by the exchange receiver without blocking the thread.
+/// If there is no data received now, the operator returns WAITING and the task is polled
+/// by the wait reactor instead of occupying a cpu thread.
+/// The stream is still registered in `DAGContext::getInBoundIOInputStreamsMap` so that
+/// the remote execution summaries and connection profiles are collected as before.
+class ExchangeReceiverSourceOp : public SourceOp
+{
+public:
+    ExchangeReceiverSourceOp(
+        PipelineExecutorStatus & exec_status_,
+        const String & req_id,
+        const std::shared_ptr<ExchangeReceiverInputStream> & stream_)
+        : SourceOp(exec_status_, req_id)
+        , stream(stream_)
+    {
+        setHeader(stream->getHeader());
+    }
+
+    String getName() const override
+    {
+        return "ExchangeReceiverSourceOp";
+    }
+
+protected:
+    void operatePrefixImpl() override;
+    void operateSuffixImpl() override;
+
+    OperatorStatus readImpl(Block & block) override;
+
+    OperatorStatus awaitImpl() override;
+
+private:
+    std::shared_ptr<ExchangeReceiverInputStream> stream;
+
+    // the block received in `awaitImpl`
+    std::optional<Block> recv_block;
+};
+} // namespace DB
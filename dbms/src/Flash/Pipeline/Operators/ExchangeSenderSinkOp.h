@@ -0,0 +1,58 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Flash/Coprocessor/DAGResponseWriter.h>
+#include <Flash/Mpp/MPPTunnelSet.h>
+#include <Flash/Pipeline/Operators/Operator.h>
+
+namespace DB
+{
+/// The pipeline version of `ExchangeSenderBlockInputStream`.
+/// It waits for the tunnels instead of blocking the cpu thread when their send queues are full.
+class ExchangeSenderSinkOp : public SinkOp
+{
+public:
+    ExchangeSenderSinkOp(
+        PipelineExecutorStatus & exec_status_,
+        const String & req_id,
+        std::unique_ptr<DAGResponseWriter> && writer_,
+        const MPPTunnelSetPtr & tunnel_set_)
+        : SinkOp(exec_status_, req_id)
+        , writer(std::move(writer_))
+        , tunnel_set(tunnel_set_)
+    {}
+
+    String getName() const override
+    {
+        return "ExchangeSenderSinkOp";
+    }
+
+protected:
+    void operatePrefixImpl() override;
+    void operateSuffixImpl() override;
+
+    OperatorStatus prepareImpl() override;
+
+    OperatorStatus writeImpl(Block && block) override;
+
+    OperatorStatus awaitImpl() override;
+
+private:
+    std::unique_ptr<DAGResponseWriter> writer;
+    MPPTunnelSetPtr tunnel_set;
+    size_t total_rows = 0;
+};
+} // namespace DB
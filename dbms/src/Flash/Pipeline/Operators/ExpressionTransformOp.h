@@ -0,0 +1,46 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Flash/Pipeline/Operators/Operator.h>
+#include <Interpreters/ExpressionActions.h>
+
+namespace DB
+{
+class ExpressionTransformOp : public TransformOp
+{
+public:
+    ExpressionTransformOp(
+        PipelineExecutorStatus & exec_status_,
+        const String & req_id,
+        const ExpressionActionsPtr & expression_)
+        : TransformOp(exec_status_, req_id)
+        , expression(expression_)
+    {}
+
+    String getName() const override
+    {
+        return "ExpressionTransformOp";
+    }
+
+protected:
+    OperatorStatus transformImpl(Block & block) override;
+
+    void transformHeader(Block & header_) override;
+
+private:
+    ExpressionActionsPtr expression;
+};
+} // namespace DB
@@ -0,0 +1,43 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Pipeline/Operators/FilterTransformOp.h>
+
+namespace DB
+{
+OperatorStatus FilterTransformOp::transformImpl(Block & block)
+{
+    /// The empty block means the end of data, pass it through to the subsequent operators.
+    /// If the filter is always false, finish the pipeline by an empty block as `FilterBlockInputStream` does.
+    if (unlikely(!block || filter_transform_action.alwaysFalse()))
+    {
+        block = {};
+        return OperatorStatus::HAS_OUTPUT;
+    }
+
+    /// `FilterTransformAction::transform` returns false if all the rows are filtered out,
+    /// then ask for the next block.
+    if (!filter_transform_action.transform(block))
+    {
+        block = {};
+        return OperatorStatus::NEED_INPUT;
+    }
+    return OperatorStatus::HAS_OUTPUT;
+}
+
+void FilterTransformOp::transformHeader(Block & header_)
+{
+    header_ = filter_transform_action.getHeader();
+}
+} // namespace DB
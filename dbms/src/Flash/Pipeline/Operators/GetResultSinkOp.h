@@ -0,0 +1,46 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Flash/Executor/ResultHandler.h>
+#include <Flash/Pipeline/Operators/Operator.h>
+
+namespace DB
+{
+/// Pass the result blocks to the `ResultHandler` of `QueryExecutor::execute`.
+/// The handler is shared by all the pipeline_execs, so it must be thread safe.
+class GetResultSinkOp : public SinkOp
+{
+public:
+    GetResultSinkOp(
+        PipelineExecutorStatus & exec_status_,
+        const String & req_id,
+        const ResultHandler & result_handler_)
+        : SinkOp(exec_status_, req_id)
+        , result_handler(result_handler_)
+    {}
+
+    String getName() const override
+    {
+        return "GetResultSinkOp";
+    }
+
+protected:
+    OperatorStatus writeImpl(Block && block) override;
+
+private:
+    ResultHandler result_handler;
+};
+} // namespace DB
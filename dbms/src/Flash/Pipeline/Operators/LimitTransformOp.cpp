@@ -0,0 +1,47 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Pipeline/Operators/LimitTransformOp.h>
+
+namespace DB
+{
+bool GlobalLimitTransformAction::transform(Block & block)
+{
+    size_t rows = block.rows();
+    size_t rows_to_keep = 0;
+    {
+        std::lock_guard lock(mu);
+        if (pos >= limit)
+            return false;
+        rows_to_keep = std::min(rows, limit - pos);
+        pos += rows_to_keep;
+    }
+
+    /// give away a piece of the block
+    if (rows_to_keep < rows)
+    {
+        for (size_t i = 0; i < block.columns(); ++i)
+            block.safeGetByPosition(i).column = block.safeGetByPosition(i).column->cut(0, rows_to_keep);
+    }
+    return true;
+}
+
+OperatorStatus LimitTransformOp::transformImpl(Block & block)
+{
+    /// Once the limit is reached, finish the pipeline_exec by an empty block.
+    if (block && !action->transform(block))
+        block = {};
+    return OperatorStatus::HAS_OUTPUT;
+}
+} // namespace DB
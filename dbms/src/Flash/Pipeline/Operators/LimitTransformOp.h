@@ -0,0 +1,67 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Flash/Pipeline/Operators/Operator.h>
+
+#include <mutex>
+
+namespace DB
+{
+/// The limit shared by all the `LimitTransformOp`s of a query, so that the pipeline_execs
+/// running in parallel output `limit` rows in total without a final union and limit.
+struct GlobalLimitTransformAction
+{
+public:
+    explicit GlobalLimitTransformAction(size_t limit_)
+        : limit(limit_)
+    {}
+
+    // return false if the limit is reached and the block should be discarded.
+    bool transform(Block & block);
+
+private:
+    const size_t limit;
+
+    std::mutex mu;
+    size_t pos = 0;
+};
+using GlobalLimitPtr = std::shared_ptr<GlobalLimitTransformAction>;
+
+class LimitTransformOp : public TransformOp
+{
+public:
+    LimitTransformOp(
+        PipelineExecutorStatus & exec_status_,
+        const String & req_id,
+        const GlobalLimitPtr & action_)
+        : TransformOp(exec_status_, req_id)
+        , action(action_)
+    {}
+
+    String getName() const override
+    {
+        return "LimitTransformOp";
+    }
+
+protected:
+    OperatorStatus transformImpl(Block & block) override;
+
+    void transformHeader(Block &) override {}
+
+private:
+    GlobalLimitPtr action;
+};
+} // namespace DB
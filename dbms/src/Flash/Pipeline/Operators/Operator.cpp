@@ -0,0 +1,157 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Flash/Pipeline/Exec/PipelineExecutorStatus.h>
+#include <Flash/Pipeline/Operators/Operator.h>
+#include <magic_enum.hpp>
+
+namespace DB
+{
+#define CHECK_IS_CANCELLED                  \
+    if (unlikely(exec_status.isCancelled())) \
+        return OperatorStatus::CANCELLED;
+
+namespace
+{
+void assertOperatorStatus(OperatorStatus status, std::initializer_list<OperatorStatus> expect_running_statuses)
+{
+    switch (status)
+    {
+    // finish status, cancel status, waiting status and io status can be returned in all method of operator.
+    case OperatorStatus::FINISHED:
+    case OperatorStatus::CANCELLED:
+    case OperatorStatus::WAITING:
+    case OperatorStatus::IO:
+        return;
+    default:
+    {
+        for (const auto & expect_running_status : expect_running_statuses)
+        {
+            if (expect_running_status == status)
+                return;
+        }
+        RUNTIME_ASSERT(false, "Unexpected operator status {}", magic_enum::enum_name(status));
+    }
+    }
+}
+} // namespace
+
+OperatorStatus Operator::await()
+{
+    CHECK_IS_CANCELLED
+    auto op_status = awaitImpl();
+#ifndef NDEBUG
+    assertOperatorStatus(op_status, {OperatorStatus::NEED_INPUT, OperatorStatus::HAS_OUTPUT});
+#endif
+    return op_status;
+}
+
+OperatorStatus Operator::executeIO()
+{
+    CHECK_IS_CANCELLED
+    auto op_status = executeIOImpl();
+#ifndef NDEBUG
+    assertOperatorStatus(op_status, {OperatorStatus::NEED_INPUT, OperatorStatus::HAS_OUTPUT});
+#endif
+    return op_status;
+}
+
+void Operator::operatePrefix()
+{
+    operatePrefixImpl();
+}
+
+void Operator::operateSuffix()
+{
+    operateSuffixImpl();
+}
+
+OperatorStatus SourceOp::read(Block & block)
+{
+    CHECK_IS_CANCELLED
+    assert(!block);
+    auto op_status = readImpl(block);
+#ifndef NDEBUG
+    if (op_status == OperatorStatus::HAS_OUTPUT && block)
+    {
+        Block header = getHeader();
+        assertBlocksHaveEqualStructure(block, header, getName());
+    }
+    assertOperatorStatus(op_status, {OperatorStatus::HAS_OUTPUT});
+#endif
+    return op_status;
+}
+
+OperatorStatus TransformOp::transform(Block & block)
+{
+    CHECK_IS_CANCELLED
+    auto op_status = transformImpl(block);
+#ifndef NDEBUG
+    if (op_status == OperatorStatus::HAS_OUTPUT && block)
+    {
+        Block header = getHeader();
+        assertBlocksHaveEqualStructure(block, header, getName());
+    }
+    assertOperatorStatus(op_status, {OperatorStatus::NEED_INPUT, OperatorStatus::HAS_OUTPUT});
+#endif
+    return op_status;
+}
+
+OperatorStatus TransformOp::tryOutput(Block & block)
+{
+    CHECK_IS_CANCELLED
+    assert(!block);
+    auto op_status = tryOutputImpl(block);
+#ifndef NDEBUG
+    if (op_status == OperatorStatus::HAS_OUTPUT && block)
+    {
+        Block header = getHeader();
+        assertBlocksHaveEqualStructure(block, header, getName());
+    }
+    assertOperatorStatus(op_status, {OperatorStatus::NEED_INPUT, OperatorStatus::HAS_OUTPUT});
+#endif
+    return op_status;
+}
+
+OperatorStatus SinkOp::prepare()
+{
+    CHECK_IS_CANCELLED
+    auto op_status = prepareImpl();
+#ifndef NDEBUG
+    assertOperatorStatus(op_status, {OperatorStatus::NEED_INPUT});
+#endif
+    return op_status;
+}
+
+OperatorStatus SinkOp::write(Block && block)
+{
+#ifndef NDEBUG
+    if (block)
+    {
+        Block header = getHeader();
+        assertBlocksHaveEqualStructure(block, header, getName());
+    }
+#endif
+    CHECK_IS_CANCELLED
+    auto op_status = writeImpl(std::move(block));
+#ifndef NDEBUG
+    assertOperatorStatus(op_status, {OperatorStatus::NEED_INPUT});
+#endif
+    return op_status;
+}
+
+#undef CHECK_IS_CANCELLED
+
+} // namespace DB
@@ -0,0 +1,156 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Exception.h>
+#include <Common/Logger.h>
+#include <Core/Block.h>
+
+#include <memory>
+
+namespace DB
+{
+class PipelineExecutorStatus;
+
+/**
+ * All interfaces of the operator may return the following state.
+ * - finish status, cancel status, waiting status and io status can be returned in all method of operator.
+ * - operator may return a different running status depending on the method.
+*/
+enum class OperatorStatus
+{
+    /// finish status
+    FINISHED,
+    /// cancel status
+    CANCELLED,
+    /// waiting status, the operator is waiting for an event, e.g. the data of exchange receiver
+    /// is not ready. The task will be polled by `await` instead of occupying a cpu thread.
+    WAITING,
+    /// io status, the operator needs to do a blocking io, e.g. reading from the storage.
+    /// The task will be moved to the io thread pool and call `executeIO`.
+    IO,
+    /// running status
+    // means that TransformOp/SinkOp needs to input a block to do the calculation,
+    NEED_INPUT,
+    // means that SourceOp/TransformOp outputs a block as input to the subsequent operators.
+    HAS_OUTPUT,
+};
+
+// TODO support operator profile info like `BlockStreamProfileInfo`.
+class Operator
+{
+public:
+    Operator(PipelineExecutorStatus & exec_status_, const String & req_id)
+        : exec_status(exec_status_)
+        , log(Logger::get(req_id))
+    {}
+
+    virtual ~Operator() = default;
+
+    // running status may return are NEED_INPUT and HAS_OUTPUT here.
+    OperatorStatus await();
+    virtual OperatorStatus awaitImpl() { throw Exception("Unsupport"); }
+
+    // running status may return are NEED_INPUT and HAS_OUTPUT here.
+    OperatorStatus executeIO();
+    virtual OperatorStatus executeIOImpl() { throw Exception("Unsupport"); }
+
+    // These two methods are used to set state, log and etc, and should not perform calculation logic.
+    void operatePrefix();
+    void operateSuffix();
+
+    virtual String getName() const = 0;
+
+    /// Only for `PipelineExecBuilder`.
+    const Block & getHeader() const
+    {
+        assert(header);
+        return header;
+    }
+    void setHeader(const Block & header_)
+    {
+        assert(header_ && !header);
+        header = header_;
+    }
+
+protected:
+    virtual void operatePrefixImpl() {}
+    virtual void operateSuffixImpl() {}
+
+protected:
+    PipelineExecutorStatus & exec_status;
+    const LoggerPtr log;
+    Block header;
+};
+
+// The running status returned by Source can only be `HAS_OUTPUT`.
+class SourceOp : public Operator
+{
+public:
+    SourceOp(PipelineExecutorStatus & exec_status_, const String & req_id)
+        : Operator(exec_status_, req_id)
+    {}
+    // read will inplace the block when return status is HAS_OUTPUT;
+    // After source has finished, source op still needs to return an empty block and HAS_OUTPUT,
+    // the empty block is passed through all the operators to notify the end of data, see `SinkOp::write`.
+    OperatorStatus read(Block & block);
+    virtual OperatorStatus readImpl(Block & block) = 0;
+
+    OperatorStatus awaitImpl() override { return OperatorStatus::HAS_OUTPUT; }
+};
+using SourceOpPtr = std::unique_ptr<SourceOp>;
+
+class TransformOp : public Operator
+{
+public:
+    TransformOp(PipelineExecutorStatus & exec_status_, const String & req_id)
+        : Operator(exec_status_, req_id)
+    {}
+    // running status may return are NEED_INPUT and HAS_OUTPUT here.
+    // tryOutput will inplace the block when return status is HAS_OUPUT; do nothing to the block when NEED_INPUT or others.
+    OperatorStatus tryOutput(Block &);
+    virtual OperatorStatus tryOutputImpl(Block &) { return OperatorStatus::NEED_INPUT; }
+    // running status may return are NEED_INPUT and HAS_OUTPUT here.
+    // transform will inplace the block and if the return status is HAS_OUTPUT, this block can be used as input to subsequent operators.
+    // If an empty block is input, transform must return HAS_OUTPUT with the empty block to notify
+    // the subsequent operators of the end of data.
+    OperatorStatus transform(Block & block);
+    virtual OperatorStatus transformImpl(Block & block) = 0;
+
+    virtual void transformHeader(Block & header_) = 0;
+
+    OperatorStatus awaitImpl() override { return OperatorStatus::NEED_INPUT; }
+};
+using TransformOpPtr = std::unique_ptr<TransformOp>;
+using TransformOps = std::vector<TransformOpPtr>;
+
+// The running status returned by Sink can only be `NEED_INPUT`.
+// `write` returns FINISHED after the empty block which means the end of data is written.
+class SinkOp : public Operator
+{
+public:
+    SinkOp(PipelineExecutorStatus & exec_status_, const String & req_id)
+        : Operator(exec_status_, req_id)
+    {}
+    OperatorStatus prepare();
+    virtual OperatorStatus prepareImpl() { return OperatorStatus::NEED_INPUT; }
+
+    OperatorStatus write(Block && block);
+    virtual OperatorStatus writeImpl(Block && block) = 0;
+
+    OperatorStatus awaitImpl() override { return OperatorStatus::NEED_INPUT; }
+};
+using SinkOpPtr = std::unique_ptr<SinkOp>;
+} // namespace DB
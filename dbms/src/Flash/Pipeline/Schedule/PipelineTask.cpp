@@ -0,0 +1,96 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Common/Stopwatch.h>
+#include <Flash/Pipeline/Schedule/PipelineTask.h>
+
+#include <magic_enum.hpp>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int LOGICAL_ERROR;
+} // namespace ErrorCodes
+
+#define HANDLE_NOT_RUNNING_STATUS(op_status)                                                          \
+    case OperatorStatus::FINISHED:                                                                    \
+        return finish();                                                                              \
+    case OperatorStatus::CANCELLED:                                                                   \
+        return ExecTaskStatus::CANCELLED;                                                             \
+    case OperatorStatus::WAITING:                                                                     \
+        return ExecTaskStatus::WAITING;                                                               \
+    case OperatorStatus::IO:                                                                          \
+        return ExecTaskStatus::IO;                                                                    \
+    default:                                                                                          \
+        throw Exception(                                                                              \
+            fmt::format("Unexpected operator status {} for PipelineTask", magic_enum::enum_name(op_status)), \
+            ErrorCodes::LOGICAL_ERROR);
+
+ExecTaskStatus PipelineTask::executeImpl()
+{
+    if (unlikely(!is_prefix_executed))
+    {
+        pipeline_exec->executePrefix();
+        is_prefix_executed = true;
+    }
+
+    Stopwatch stopwatch{CLOCK_MONOTONIC_COARSE};
+    while (true)
+    {
+        auto op_status = pipeline_exec->execute();
+        switch (op_status)
+        {
+        case OperatorStatus::NEED_INPUT:
+            // The time slice is used up, yield the cpu thread.
+            if (stopwatch.elapsed() >= YIELD_MAX_TIME_SPENT_NS)
+                return ExecTaskStatus::RUNNING;
+            break;
+            HANDLE_NOT_RUNNING_STATUS(op_status)
+        }
+    }
+}
+
+ExecTaskStatus PipelineTask::executeIOImpl()
+{
+    auto op_status = pipeline_exec->executeIO();
+    switch (op_status)
+    {
+    case OperatorStatus::NEED_INPUT:
+        return ExecTaskStatus::RUNNING;
+        HANDLE_NOT_RUNNING_STATUS(op_status)
+    }
+}
+
+ExecTaskStatus PipelineTask::awaitImpl()
+{
+    auto op_status = pipeline_exec->await();
+    switch (op_status)
+    {
+    case OperatorStatus::NEED_INPUT:
+        return ExecTaskStatus::RUNNING;
+        HANDLE_NOT_RUNNING_STATUS(op_status)
+    }
+}
+
+ExecTaskStatus PipelineTask::finish()
+{
+    pipeline_exec->executeSuffix();
+    return ExecTaskStatus::FINISHED;
+}
+
+#undef HANDLE_NOT_RUNNING_STATUS
+
+} // namespace DB
@@ -0,0 +1,52 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Flash/Pipeline/Exec/PipelineExec.h>
+#include <Flash/Pipeline/Schedule/Task.h>
+
+namespace DB
+{
+/// The task which drives a `PipelineExec`.
+class PipelineTask : public Task
+{
+public:
+    PipelineTask(
+        PipelineExecutorStatus & exec_status_,
+        PipelineExecPtr && pipeline_exec_)
+        : Task(exec_status_)
+        , pipeline_exec(std::move(pipeline_exec_))
+    {
+        assert(pipeline_exec);
+    }
+
+protected:
+    ExecTaskStatus executeImpl() override;
+
+    ExecTaskStatus executeIOImpl() override;
+
+    ExecTaskStatus awaitImpl() override;
+
+private:
+    ExecTaskStatus finish();
+
+private:
+    // The time slice of `executeImpl`, after which the task yields the cpu thread.
+    static constexpr UInt64 YIELD_MAX_TIME_SPENT_NS = 100'000'000L;
+
+    PipelineExecPtr pipeline_exec;
+    bool is_prefix_executed = false;
+};
+} // namespace DB
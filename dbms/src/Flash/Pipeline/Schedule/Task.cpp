@@ -0,0 +1,85 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Common/MemoryTrackerSetter.h>
+#include <Flash/Pipeline/Exec/PipelineExecutorStatus.h>
+#include <Flash/Pipeline/Schedule/Task.h>
+#include <common/likely.h>
+
+namespace DB
+{
+#define CHECK_IS_CANCELLED                                              \
+    if (exec_status != nullptr && unlikely(exec_status->isCancelled())) \
+        return ExecTaskStatus::CANCELLED;
+
+#define EXECUTE(function)                                                \
+    try                                                                  \
+    {                                                                    \
+        MemoryTrackerSetter setter(true, mem_tracker);                   \
+        CHECK_IS_CANCELLED                                               \
+        return (function)();                                             \
+    }                                                                    \
+    catch (...)                                                          \
+    {                                                                    \
+        return onError(getCurrentExceptionMessage(true, true));          \
+    }
+
+Task::Task(PipelineExecutorStatus & exec_status_)
+    : exec_status(&exec_status_)
+    , mem_tracker(current_memory_tracker)
+    , log(Logger::get("Task"))
+{
+    exec_status->onTaskSubmit();
+}
+
+Task::Task()
+    : exec_status(nullptr)
+    , mem_tracker(nullptr)
+    , log(Logger::get("Task"))
+{}
+
+Task::~Task()
+{
+    if (exec_status != nullptr)
+        exec_status->onTaskFinish();
+}
+
+ExecTaskStatus Task::execute() noexcept
+{
+    EXECUTE(executeImpl);
+}
+
+ExecTaskStatus Task::executeIO() noexcept
+{
+    EXECUTE(executeIOImpl);
+}
+
+ExecTaskStatus Task::await() noexcept
+{
+    EXECUTE(awaitImpl);
+}
+
+ExecTaskStatus Task::onError(String && err_msg)
+{
+    LOG_WARNING(log, "task meets error: {}", err_msg);
+    if (exec_status != nullptr)
+        exec_status->onErrorOccurred(std::move(err_msg));
+    return ExecTaskStatus::ERROR;
+}
+
+#undef EXECUTE
+#undef CHECK_IS_CANCELLED
+
+} // namespace DB
@@ -0,0 +1,90 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Logger.h>
+#include <Common/MemoryTracker.h>
+
+#include <boost/noncopyable.hpp>
+#include <memory>
+
+namespace DB
+{
+class PipelineExecutorStatus;
+
+/**
+ *    CANCELLED/ERROR/FINISHED
+ *               ▲
+ *               │
+ *  ┌───────────────────────┐
+ *  │     ┌──►RUNNING◄──┐   │
+ *  │     │             │   │
+ *  │     ▼             ▼   │
+ *  │ WATITING◄────────►IO  │
+ *  └───────────────────────┘
+ */
+enum class ExecTaskStatus
+{
+    WAITING,
+    RUNNING,
+    IO,
+    FINISHED,
+    ERROR,
+    CANCELLED,
+};
+
+/// The unit of scheduling of `TaskScheduler`.
+/// - RUNNING tasks are executed by the cpu thread pool by `execute`,
+/// - IO tasks are executed by the io thread pool by `executeIO`,
+/// - WAITING tasks are polled by the wait reactor by `await`.
+/// A task must not block the thread in `execute` and `await`, and should yield the thread by
+/// returning RUNNING after running for a while so that the other tasks can be executed.
+class Task : private boost::noncopyable
+{
+public:
+    explicit Task(PipelineExecutorStatus & exec_status_);
+
+    // Only used for unit test.
+    Task();
+
+    virtual ~Task();
+
+    ExecTaskStatus execute() noexcept;
+
+    ExecTaskStatus executeIO() noexcept;
+
+    ExecTaskStatus await() noexcept;
+
+protected:
+    virtual ExecTaskStatus executeImpl() = 0;
+    virtual ExecTaskStatus executeIOImpl() { return ExecTaskStatus::RUNNING; }
+    // Avoid allocating memory in `await` if possible.
+    virtual ExecTaskStatus awaitImpl() { return ExecTaskStatus::RUNNING; }
+
+private:
+    ExecTaskStatus onError(String && err_msg);
+
+protected:
+    // nullptr only in unit test.
+    PipelineExecutorStatus * exec_status;
+
+    // The memory tracker of the query, which is set to `current_memory_tracker` when the task is executed
+    // by the threads of `TaskScheduler`.
+    MemoryTracker * mem_tracker;
+
+    LoggerPtr log;
+};
+using TaskPtr = std::unique_ptr<Task>;
+} // namespace DB
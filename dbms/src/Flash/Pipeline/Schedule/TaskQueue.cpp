@@ -0,0 +1,109 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Pipeline/Schedule/TaskQueue.h>
+#include <common/likely.h>
+
+namespace DB
+{
+void TaskQueue::submit(TaskPtr && task)
+{
+    assert(task);
+    {
+        std::lock_guard lock(mu);
+        // The task submitted after closing is dropped directly.
+        if (unlikely(is_closed))
+        {
+            task.reset();
+            return;
+        }
+        task_queue.push_back(std::move(task));
+    }
+    cv.notify_one();
+}
+
+void TaskQueue::submit(std::vector<TaskPtr> & tasks)
+{
+    if (tasks.empty())
+        return;
+    {
+        std::lock_guard lock(mu);
+        if (unlikely(is_closed))
+        {
+            tasks.clear();
+            return;
+        }
+        for (auto & task : tasks)
+        {
+            assert(task);
+            task_queue.push_back(std::move(task));
+        }
+        tasks.clear();
+    }
+    cv.notify_all();
+}
+
+bool TaskQueue::take(TaskPtr & task)
+{
+    assert(!task);
+    std::unique_lock lock(mu);
+    cv.wait(lock, [&] { return is_closed || !task_queue.empty(); });
+    if (task_queue.empty())
+        return false;
+    task = std::move(task_queue.front());
+    task_queue.pop_front();
+    return true;
+}
+
+void TaskQueue::takeAll(std::vector<TaskPtr> & tasks)
+{
+    std::lock_guard lock(mu);
+    while (!task_queue.empty())
+    {
+        tasks.push_back(std::move(task_queue.front()));
+        task_queue.pop_front();
+    }
+}
+
+void TaskQueue::waitFor(std::chrono::milliseconds timeout)
+{
+    std::unique_lock lock(mu);
+    cv.wait_for(lock, timeout, [&] { return is_closed || !task_queue.empty(); });
+}
+
+bool TaskQueue::empty()
+{
+    std::lock_guard lock(mu);
+    return task_queue.empty();
+}
+
+void TaskQueue::close()
+{
+    std::deque<TaskPtr> dropped_tasks;
+    {
+        std::lock_guard lock(mu);
+        is_closed = true;
+        dropped_tasks.swap(task_queue);
+    }
+    cv.notify_all();
+    // The destructors of the tasks notify the `PipelineExecutorStatus`, so drop them outside the lock.
+    dropped_tasks.clear();
+}
+
+bool TaskQueue::isClosed()
+{
+    std::lock_guard lock(mu);
+    return is_closed;
+}
+} // namespace DB
@@ -0,0 +1,59 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Flash/Pipeline/Schedule/Task.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace DB
+{
+/// A FIFO queue of tasks shared by the threads of a task thread pool.
+class TaskQueue : private boost::noncopyable
+{
+public:
+    void submit(TaskPtr && task);
+
+    void submit(std::vector<TaskPtr> & tasks);
+
+    /// Block until a task is taken or the queue is closed.
+    /// Return false if the queue is closed and there is no task left.
+    bool take(TaskPtr & task);
+
+    /// Take all the tasks in the queue without blocking.
+    void takeAll(std::vector<TaskPtr> & tasks);
+
+    /// Block until there are some tasks in the queue or the queue is closed,
+    /// or the timeout is reached.
+    void waitFor(std::chrono::milliseconds timeout);
+
+    bool empty();
+
+    /// Drop all the tasks in the queue, and the tasks submitted later are dropped directly.
+    void close();
+
+    bool isClosed();
+
+private:
+    std::mutex mu;
+    std::condition_variable cv;
+    std::deque<TaskPtr> task_queue;
+    bool is_closed = false;
+};
+} // namespace DB
@@ -0,0 +1,76 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Pipeline/Schedule/TaskScheduler.h>
+#include <common/logger_useful.h>
+
+namespace DB
+{
+std::unique_ptr<TaskScheduler> TaskScheduler::instance;
+
+TaskScheduler::TaskScheduler(const TaskSchedulerConfig & config)
+    : cpu_task_thread_pool(*this, config.cpu_task_thread_pool_size)
+    , io_task_thread_pool(*this, config.io_task_thread_pool_size)
+    , wait_reactor(*this)
+{
+    LOG_INFO(
+        logger,
+        "task scheduler is started with cpu_task_thread_pool_size={} io_task_thread_pool_size={}",
+        config.cpu_task_thread_pool_size,
+        config.io_task_thread_pool_size);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    cpu_task_thread_pool.close();
+    io_task_thread_pool.close();
+    wait_reactor.close();
+
+    cpu_task_thread_pool.waitForStop();
+    io_task_thread_pool.waitForStop();
+    wait_reactor.waitForStop();
+}
+
+void TaskScheduler::submit(std::vector<TaskPtr> & tasks)
+{
+    // All the tasks start from the cpu thread pool, and the task will be moved to
+    // the io thread pool or the wait reactor by the returned status.
+    submitToCPUTaskThreadPool(tasks);
+}
+
+void TaskScheduler::submitToCPUTaskThreadPool(TaskPtr && task)
+{
+    cpu_task_thread_pool.submit(std::move(task));
+}
+
+void TaskScheduler::submitToCPUTaskThreadPool(std::vector<TaskPtr> & tasks)
+{
+    cpu_task_thread_pool.submit(tasks);
+}
+
+void TaskScheduler::submitToIOTaskThreadPool(TaskPtr && task)
+{
+    io_task_thread_pool.submit(std::move(task));
+}
+
+void TaskScheduler::submitToIOTaskThreadPool(std::vector<TaskPtr> & tasks)
+{
+    io_task_thread_pool.submit(tasks);
+}
+
+void TaskScheduler::submitToWaitReactor(TaskPtr && task)
+{
+    wait_reactor.submit(std::move(task));
+}
+} // namespace DB
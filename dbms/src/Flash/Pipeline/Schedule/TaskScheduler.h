@@ -0,0 +1,82 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Flash/Pipeline/Schedule/Task.h>
+#include <Flash/Pipeline/Schedule/TaskThreadPool.h>
+#include <Flash/Pipeline/Schedule/WaitReactor.h>
+
+#include <memory>
+#include <vector>
+
+namespace DB
+{
+struct TaskSchedulerConfig
+{
+    size_t cpu_task_thread_pool_size;
+    size_t io_task_thread_pool_size;
+};
+
+/**
+ * TaskScheduler is the process-wide scheduler of the tasks of the queries executed by the pipeline model.
+ * A query is split into many tasks, and the tasks are scheduled among a fixed number of threads instead of
+ * each query creating its own threads.
+ *
+ *            submit
+ *              │
+ *              ▼
+ *   ┌───►cpu thread pool◄───┐
+ *   │         ▲ │           │
+ *   │         │ ▼           │
+ *   │    wait reactor       │
+ *   │         ▲ │           │
+ *   │         │ ▼           │
+ *   └────io thread pool─────┘
+ *
+ * - cpu thread pool: execute the computation of the tasks, sized to the number of cpu cores.
+ * - io thread pool: execute the blocking io of the tasks, such as reading the storage.
+ * - wait reactor: poll the tasks waiting for an event, such as the data from the exchange receiver.
+ */
+class TaskScheduler : private boost::noncopyable
+{
+public:
+    explicit TaskScheduler(const TaskSchedulerConfig & config);
+
+    ~TaskScheduler();
+
+    void submit(std::vector<TaskPtr> & tasks);
+
+    void submitToCPUTaskThreadPool(TaskPtr && task);
+
+    void submitToCPUTaskThreadPool(std::vector<TaskPtr> & tasks);
+
+    void submitToIOTaskThreadPool(TaskPtr && task);
+
+    void submitToIOTaskThreadPool(std::vector<TaskPtr> & tasks);
+
+    void submitToWaitReactor(TaskPtr && task);
+
+    static std::unique_ptr<TaskScheduler> instance;
+
+private:
+    TaskThreadPool<CPUImpl> cpu_task_thread_pool;
+
+    TaskThreadPool<IOImpl> io_task_thread_pool;
+
+    WaitReactor wait_reactor;
+
+    LoggerPtr logger = Logger::get("TaskScheduler");
+};
+} // namespace DB
@@ -0,0 +1,116 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Common/setThreadName.h>
+#include <Flash/Pipeline/Schedule/TaskScheduler.h>
+#include <Flash/Pipeline/Schedule/TaskThreadPool.h>
+#include <common/logger_useful.h>
+
+#include <magic_enum.hpp>
+
+namespace DB
+{
+template <typename Impl>
+TaskThreadPool<Impl>::TaskThreadPool(TaskScheduler & scheduler_, size_t thread_num)
+    : scheduler(scheduler_)
+{
+    RUNTIME_CHECK(thread_num > 0);
+    threads.reserve(thread_num);
+    for (size_t i = 0; i < thread_num; ++i)
+        threads.emplace_back(&TaskThreadPool::loop, this, i);
+}
+
+template <typename Impl>
+void TaskThreadPool<Impl>::close()
+{
+    task_queue.close();
+}
+
+template <typename Impl>
+void TaskThreadPool<Impl>::waitForStop()
+{
+    for (auto & thread : threads)
+        thread.join();
+    LOG_INFO(logger, "task thread pool is stopped");
+}
+
+template <typename Impl>
+void TaskThreadPool<Impl>::loop(size_t thread_no) noexcept
+{
+    auto thread_no_str = fmt::format("thread_no={}", thread_no);
+    auto thread_logger = logger->getChild(thread_no_str);
+    setThreadName(Impl::NAME);
+    LOG_INFO(thread_logger, "start loop");
+
+    TaskPtr task;
+    while (likely(task_queue.take(task)))
+    {
+        handleTask(task, thread_logger);
+        assert(!task);
+    }
+
+    LOG_INFO(thread_logger, "loop finished");
+}
+
+template <typename Impl>
+void TaskThreadPool<Impl>::handleTask(TaskPtr & task, const LoggerPtr & log)
+{
+    assert(task);
+    auto status = Impl::exec(task);
+    // Keep the task in this pool as long as it needs this kind of thread.
+    if (status == Impl::TARGET_STATUS)
+    {
+        task_queue.submit(std::move(task));
+        return;
+    }
+    switch (status)
+    {
+    case ExecTaskStatus::RUNNING:
+        scheduler.submitToCPUTaskThreadPool(std::move(task));
+        break;
+    case ExecTaskStatus::IO:
+        scheduler.submitToIOTaskThreadPool(std::move(task));
+        break;
+    case ExecTaskStatus::WAITING:
+        scheduler.submitToWaitReactor(std::move(task));
+        break;
+    case ExecTaskStatus::FINISHED:
+    case ExecTaskStatus::ERROR:
+    case ExecTaskStatus::CANCELLED:
+        // The destructor of the task notifies the `PipelineExecutorStatus`.
+        task.reset();
+        break;
+    default:
+        LOG_ERROR(log, "Unexpected task state {}", magic_enum::enum_name(status));
+        task.reset();
+    }
+}
+
+template <typename Impl>
+void TaskThreadPool<Impl>::submit(TaskPtr && task)
+{
+    task_queue.submit(std::move(task));
+}
+
+template <typename Impl>
+void TaskThreadPool<Impl>::submit(std::vector<TaskPtr> & tasks)
+{
+    task_queue.submit(tasks);
+}
+
+template class TaskThreadPool<CPUImpl>;
+template class TaskThreadPool<IOImpl>;
+
+} // namespace DB
@@ -0,0 +1,83 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Logger.h>
+#include <Flash/Pipeline/Schedule/TaskQueue.h>
+
+#include <thread>
+#include <vector>
+
+namespace DB
+{
+class TaskScheduler;
+
+struct CPUImpl
+{
+    static constexpr auto NAME = "CPUPool";
+
+    static constexpr auto TARGET_STATUS = ExecTaskStatus::RUNNING;
+
+    static ExecTaskStatus exec(TaskPtr & task)
+    {
+        return task->execute();
+    }
+};
+
+struct IOImpl
+{
+    static constexpr auto NAME = "IOPool";
+
+    static constexpr auto TARGET_STATUS = ExecTaskStatus::IO;
+
+    static ExecTaskStatus exec(TaskPtr & task)
+    {
+        return task->executeIO();
+    }
+};
+
+/// A fixed size thread pool executing the tasks in the status `Impl::TARGET_STATUS`.
+/// After a task is executed, it is kept in this pool if its status is still `TARGET_STATUS`,
+/// otherwise it is handed over to the other thread pool or the wait reactor.
+template <typename Impl>
+class TaskThreadPool : private boost::noncopyable
+{
+public:
+    TaskThreadPool(TaskScheduler & scheduler_, size_t thread_num);
+
+    // After close, the tasks in the queue will be dropped and no new task can be submitted.
+    void close();
+
+    void waitForStop();
+
+    void submit(TaskPtr && task);
+
+    void submit(std::vector<TaskPtr> & tasks);
+
+private:
+    void loop(size_t thread_no) noexcept;
+
+    void handleTask(TaskPtr & task, const LoggerPtr & log);
+
+private:
+    TaskQueue task_queue;
+
+    LoggerPtr logger = Logger::get(Impl::NAME);
+
+    TaskScheduler & scheduler;
+
+    std::vector<std::thread> threads;
+};
+} // namespace DB
@@ -0,0 +1,128 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/setThreadName.h>
+#include <Flash/Pipeline/Schedule/TaskScheduler.h>
+#include <Flash/Pipeline/Schedule/WaitReactor.h>
+#include <common/logger_useful.h>
+
+#include <magic_enum.hpp>
+
+namespace DB
+{
+WaitReactor::WaitReactor(TaskScheduler & scheduler_)
+    : scheduler(scheduler_)
+{
+    thread = std::thread(&WaitReactor::loop, this);
+}
+
+void WaitReactor::close()
+{
+    waiting_task_queue.close();
+}
+
+void WaitReactor::waitForStop()
+{
+    thread.join();
+    LOG_INFO(logger, "wait reactor is stopped");
+}
+
+void WaitReactor::submit(TaskPtr && task)
+{
+    waiting_task_queue.submit(std::move(task));
+}
+
+bool WaitReactor::awaitAndCollectReadyTask(TaskPtr & task)
+{
+    assert(task);
+    auto status = task->await();
+    switch (status)
+    {
+    case ExecTaskStatus::WAITING:
+        return false;
+    case ExecTaskStatus::RUNNING:
+        cpu_tasks.push_back(std::move(task));
+        return true;
+    case ExecTaskStatus::IO:
+        io_tasks.push_back(std::move(task));
+        return true;
+    case ExecTaskStatus::FINISHED:
+    case ExecTaskStatus::ERROR:
+    case ExecTaskStatus::CANCELLED:
+        task.reset();
+        return true;
+    default:
+        LOG_ERROR(logger, "Unexpected task state {}", magic_enum::enum_name(status));
+        task.reset();
+        return true;
+    }
+}
+
+void WaitReactor::submitReadyTasks()
+{
+    if (!cpu_tasks.empty())
+        scheduler.submitToCPUTaskThreadPool(cpu_tasks);
+    if (!io_tasks.empty())
+        scheduler.submitToIOTaskThreadPool(io_tasks);
+    cpu_tasks.clear();
+    io_tasks.clear();
+}
+
+void WaitReactor::loop() noexcept
+{
+    setThreadName("WaitReactor");
+    LOG_INFO(logger, "start wait reactor loop");
+
+    std::vector<TaskPtr> new_tasks;
+    while (true)
+    {
+        if (local_waiting_tasks.empty())
+        {
+            // Nothing to poll, block until new tasks arrive.
+            TaskPtr task;
+            if (!waiting_task_queue.take(task))
+                break;
+            local_waiting_tasks.push_back(std::move(task));
+        }
+        else if (unlikely(waiting_task_queue.isClosed()))
+        {
+            break;
+        }
+
+        waiting_task_queue.takeAll(new_tasks);
+        for (auto & task : new_tasks)
+            local_waiting_tasks.push_back(std::move(task));
+        new_tasks.clear();
+
+        for (auto it = local_waiting_tasks.begin(); it != local_waiting_tasks.end();)
+        {
+            if (awaitAndCollectReadyTask(*it))
+                it = local_waiting_tasks.erase(it);
+            else
+                ++it;
+        }
+
+        bool has_ready_tasks = !cpu_tasks.empty() || !io_tasks.empty();
+        submitReadyTasks();
+
+        // None of the tasks is ready, avoid busy polling.
+        if (!has_ready_tasks && !local_waiting_tasks.empty())
+            waiting_task_queue.waitFor(IDLE_WAIT_TIME);
+    }
+
+    // Drop the remaining tasks, the destructors notify the `PipelineExecutorStatus`.
+    local_waiting_tasks.clear();
+    LOG_INFO(logger, "wait reactor loop finished");
+}
+} // namespace DB
@@ -0,0 +1,67 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Logger.h>
+#include <Flash/Pipeline/Schedule/TaskQueue.h>
+
+#include <list>
+#include <thread>
+
+namespace DB
+{
+class TaskScheduler;
+
+/// A single thread polling the tasks in the WAITING status, so that the waiting tasks
+/// do not occupy the threads of the cpu/io thread pool.
+/// Once the task is not WAITING anymore, it is submitted to the cpu/io thread pool again.
+class WaitReactor : private boost::noncopyable
+{
+public:
+    explicit WaitReactor(TaskScheduler & scheduler_);
+
+    // After close, the waiting tasks will be dropped and no new task can be submitted.
+    void close();
+
+    void waitForStop();
+
+    void submit(TaskPtr && task);
+
+private:
+    void loop() noexcept;
+
+    // Return true if the task is not waiting anymore.
+    bool awaitAndCollectReadyTask(TaskPtr & task);
+
+    void submitReadyTasks();
+
+private:
+    // The time to wait for new tasks when none of the waiting tasks is ready.
+    static constexpr std::chrono::milliseconds IDLE_WAIT_TIME{1};
+
+    TaskQueue waiting_task_queue;
+
+    LoggerPtr logger = Logger::get("WaitReactor");
+
+    TaskScheduler & scheduler;
+
+    // Only accessed by the reactor thread.
+    std::list<TaskPtr> local_waiting_tasks;
+    std::vector<TaskPtr> cpu_tasks;
+    std::vector<TaskPtr> io_tasks;
+
+    std::thread thread;
+};
+} // namespace DB
@@ -0,0 +1,224 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Flash/Pipeline/Exec/PipelineExecutorStatus.h>
+#include <Flash/Pipeline/Schedule/TaskScheduler.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <atomic>
+
+namespace DB::tests
+{
+namespace
+{
+class SimpleTask : public Task
+{
+public:
+    SimpleTask(PipelineExecutorStatus & exec_status_, std::atomic_size_t & counter_)
+        : Task(exec_status_)
+        , counter(counter_)
+    {}
+
+protected:
+    ExecTaskStatus executeImpl() override
+    {
+        if (--loop_count > 0)
+            return ExecTaskStatus::RUNNING;
+        ++counter;
+        return ExecTaskStatus::FINISHED;
+    }
+
+private:
+    int loop_count = 5;
+    std::atomic_size_t & counter;
+};
+
+/// RUNNING -> IO -> WAITING -> RUNNING -> ... -> FINISHED
+class MixedTask : public Task
+{
+public:
+    MixedTask(PipelineExecutorStatus & exec_status_, std::atomic_size_t & counter_)
+        : Task(exec_status_)
+        , counter(counter_)
+    {}
+
+protected:
+    ExecTaskStatus executeImpl() override
+    {
+        EXPECT_EQ(state, 0);
+        if (--loop_count <= 0)
+        {
+            ++counter;
+            return ExecTaskStatus::FINISHED;
+        }
+        state = 1;
+        return ExecTaskStatus::IO;
+    }
+
+    ExecTaskStatus executeIOImpl() override
+    {
+        EXPECT_EQ(state, 1);
+        state = 2;
+        return ExecTaskStatus::WAITING;
+    }
+
+    ExecTaskStatus awaitImpl() override
+    {
+        EXPECT_EQ(state, 2);
+        // Stay in the wait reactor for several rounds.
+        if (++await_count % 3 != 0)
+            return ExecTaskStatus::WAITING;
+        state = 0;
+        return ExecTaskStatus::RUNNING;
+    }
+
+private:
+    int loop_count = 5;
+    int state = 0;
+    size_t await_count = 0;
+    std::atomic_size_t & counter;
+};
+
+class ErrorTask : public Task
+{
+public:
+    explicit ErrorTask(PipelineExecutorStatus & exec_status_)
+        : Task(exec_status_)
+    {}
+
+protected:
+    ExecTaskStatus executeImpl() override
+    {
+        throw Exception("error task");
+    }
+};
+
+class EndlessTask : public Task
+{
+public:
+    explicit EndlessTask(PipelineExecutorStatus & exec_status_)
+        : Task(exec_status_)
+    {}
+
+protected:
+    ExecTaskStatus executeImpl() override
+    {
+        return ExecTaskStatus::WAITING;
+    }
+
+    ExecTaskStatus awaitImpl() override
+    {
+        return ExecTaskStatus::RUNNING;
+    }
+};
+} // namespace
+
+class TaskSchedulerTestRunner : public ::testing::Test
+{
+public:
+    static constexpr size_t thread_num = 4;
+    static constexpr size_t task_num = 100;
+
+    template <typename T, typename... Args>
+    static std::vector<TaskPtr> newTasks(PipelineExecutorStatus & status, Args &&... args)
+    {
+        std::vector<TaskPtr> tasks;
+        for (size_t i = 0; i < task_num; ++i)
+            tasks.push_back(std::make_unique<T>(status, std::forward<Args>(args)...));
+        return tasks;
+    }
+};
+
+TEST_F(TaskSchedulerTestRunner, simpleTask)
+try
+{
+    TaskSchedulerConfig config{thread_num, thread_num};
+    TaskScheduler task_scheduler{config};
+
+    PipelineExecutorStatus status;
+    std::atomic_size_t counter{0};
+    auto tasks = newTasks<SimpleTask>(status, counter);
+    task_scheduler.submit(tasks);
+    status.wait();
+    ASSERT_EQ(counter, task_num);
+    ASSERT_TRUE(status.toExecutionResult().is_success);
+}
+CATCH
+
+TEST_F(TaskSchedulerTestRunner, mixedTask)
+try
+{
+    TaskSchedulerConfig config{thread_num, thread_num};
+    TaskScheduler task_scheduler{config};
+
+    PipelineExecutorStatus status;
+    std::atomic_size_t counter{0};
+    auto tasks = newTasks<MixedTask>(status, counter);
+    task_scheduler.submit(tasks);
+    status.wait();
+    ASSERT_EQ(counter, task_num);
+    ASSERT_TRUE(status.toExecutionResult().is_success);
+}
+CATCH
+
+TEST_F(TaskSchedulerTestRunner, errorTask)
+try
+{
+    TaskSchedulerConfig config{thread_num, thread_num};
+    TaskScheduler task_scheduler{config};
+
+    PipelineExecutorStatus status;
+    auto tasks = newTasks<ErrorTask>(status);
+    task_scheduler.submit(tasks);
+    status.wait();
+    auto result = status.toExecutionResult();
+    ASSERT_FALSE(result.is_success);
+    ASSERT_NE(result.err_msg.find("error task"), String::npos);
+    ASSERT_TRUE(status.isCancelled());
+}
+CATCH
+
+TEST_F(TaskSchedulerTestRunner, cancelTask)
+try
+{
+    TaskSchedulerConfig config{thread_num, thread_num};
+    TaskScheduler task_scheduler{config};
+
+    PipelineExecutorStatus status;
+    auto tasks = newTasks<EndlessTask>(status);
+    task_scheduler.submit(tasks);
+    status.cancel();
+    status.wait();
+    auto result = status.toExecutionResult();
+    ASSERT_FALSE(result.is_success);
+    ASSERT_EQ(result.err_msg, PipelineExecutorStatus::cancelled_err_msg);
+}
+CATCH
+
+TEST_F(TaskSchedulerTestRunner, shutdownWithRunningTasks)
+try
+{
+    PipelineExecutorStatus status;
+    {
+        TaskSchedulerConfig config{thread_num, thread_num};
+        TaskScheduler task_scheduler{config};
+        auto tasks = newTasks<EndlessTask>(status);
+        task_scheduler.submit(tasks);
+    }
+    // All the tasks are dropped when the scheduler is destroyed.
+    status.wait();
+}
+CATCH
+
+} // namespace DB::tests
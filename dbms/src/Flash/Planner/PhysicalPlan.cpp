@@ -275,4 +275,47 @@ void PhysicalPlan::transform(DAGPipeline & pipeline, Context & context, size_t m
     assert(root_node);
     root_node->transform(pipeline, context, max_streams);
 }
+
+bool PhysicalPlan::isSupportPipeline() const
+{
+    assert(root_node);
+    bool is_supported = true;
+    PhysicalPlanVisitor::visit(root_node, [&](const PhysicalPlanNodePtr & plan) {
+        switch (plan->tp())
+        {
+        case PlanType::TableScan:
+        case PlanType::MockTableScan:
+        case PlanType::ExchangeReceiver:
+        case PlanType::MockExchangeReceiver:
+        case PlanType::Filter:
+        case PlanType::Projection:
+        case PlanType::Limit:
+        case PlanType::ExchangeSender:
+            return true;
+        default:
+            is_supported = false;
+            return false;
+        }
+    });
+    return is_supported;
+}
+
+void PhysicalPlan::buildPipelineExecGroup(
+    PipelineExecutorStatus & exec_status,
+    PipelineExecGroupBuilder & group_builder,
+    Context & context,
+    size_t concurrency)
+{
+    assert(root_node);
+    root_node->buildPipelineExec(exec_status, group_builder, context, concurrency);
+
+    // The operators of the pipeline model are not profiled by the streams,
+    // register the empty profile streams to keep the execution summaries complete.
+    auto & profile_streams_map = dagContext().getProfileStreamsMap();
+    PhysicalPlanVisitor::visit(root_node, [&](const PhysicalPlanNodePtr & plan) {
+        if (plan->isTiDBOperator())
+            profile_streams_map[plan->execId()];
+        return true;
+    });
+}
 } // namespace DB
@@ -41,6 +41,16 @@ public:
 
     void transform(DAGPipeline & pipeline, Context & context, size_t max_streams);
 
+    /// Return true if the physical plan can be executed by the pipeline execution model.
+    /// Now only the linear plans without blocking operators are supported.
+    bool isSupportPipeline() const;
+
+    void buildPipelineExecGroup(
+        PipelineExecutorStatus & exec_status,
+        PipelineExecGroupBuilder & group_builder,
+        Context & context,
+        size_t concurrency);
+
 private:
     void addRootFinalProjectionIfNeed();
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Common/FmtUtils.h>
+#include <Common/TiFlashException.h>
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/DAGPipeline.h>
 #include <Flash/Coprocessor/InterpreterUtils.h>
@@ -69,6 +70,17 @@ void PhysicalPlanNode::recordProfileStreams(DAGPipeline & pipeline, const Contex
     }
 }
 
+void PhysicalPlanNode::buildPipelineExec(
+    PipelineExecutorStatus &,
+    PipelineExecGroupBuilder &,
+    Context &,
+    size_t)
+{
+    throw TiFlashException(
+        fmt::format("{} does not support the pipeline execution model", type.toString()),
+        Errors::Planner::Unimplemented);
+}
+
 void PhysicalPlanNode::transform(DAGPipeline & pipeline, Context & context, size_t max_streams)
 {
     transformImpl(pipeline, context, max_streams);
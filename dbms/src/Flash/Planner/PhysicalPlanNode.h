@@ -27,6 +27,8 @@ namespace DB
 struct DAGPipeline;
 class Context;
 class DAGContext;
+class PipelineExecutorStatus;
+struct PipelineExecGroupBuilder;
 
 class PhysicalPlanNode;
 using PhysicalPlanNodePtr = std::shared_ptr<PhysicalPlanNode>;
@@ -56,6 +58,15 @@ public:
 
     virtual void transform(DAGPipeline & pipeline, Context & context, size_t max_streams);
 
+    /// Build the operators of the subtree rooted at this node for the pipeline execution model.
+    /// Like `transform`, the node builds its child first and then appends its own operators.
+    /// Only the plan nodes in `PhysicalPlan::isSupportPipeline` support it.
+    virtual void buildPipelineExec(
+        PipelineExecutorStatus & exec_status,
+        PipelineExecGroupBuilder & group_builder,
+        Context & context,
+        size_t concurrency);
+
     virtual void finalize(const Names & parent_require) = 0;
     void finalize();
 
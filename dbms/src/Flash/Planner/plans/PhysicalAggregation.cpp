@@ -17,6 +17,7 @@
 #include <DataStreams/AggregatingBlockInputStream.h>
 #include <DataStreams/ConcatBlockInputStream.h>
 #include <DataStreams/ExpressionBlockInputStream.h>
+#include <DataStreams/MergingBucketsBlockInputStream.h>
 #include <DataStreams/ParallelAggregatingBlockInputStream.h>
 #include <Flash/Coprocessor/AggregationInterpreterHelper.h>
 #include <Flash/Coprocessor/DAGContext.h>
@@ -26,6 +27,7 @@
 #include <Flash/Planner/FinalizeHelper.h>
 #include <Flash/Planner/PhysicalPlanHelper.h>
 #include <Flash/Planner/plans/PhysicalAggregation.h>
+#include <Flash/Planner/plans/PhysicalTableScan.h>
 #include <Interpreters/Context.h>
 
 namespace DB
@@ -72,6 +74,11 @@ PhysicalPlanNodePtr PhysicalAggregation::build(
     /// project action after aggregation to remove useless columns.
     auto schema = PhysicalPlanHelper::addSchemaProjectAction(expr_after_agg_actions, analyzer.getCurrentInputColumns());
 
+    bool is_final_agg = AggregationInterpreterHelper::isFinalAgg(aggregation);
+    DM::PushDownAggregationPtr push_down_aggregation;
+    if (auto physical_table_scan = std::dynamic_pointer_cast<PhysicalTableScan>(child); physical_table_scan)
+        push_down_aggregation = AggregationInterpreterHelper::tryPushDownToTableScan(context, aggregation, is_final_agg, physical_table_scan->getTiDBTableScan());
+
     auto physical_agg = std::make_shared<PhysicalAggregation>(
         executor_id,
         schema,
@@ -80,10 +87,11 @@ PhysicalPlanNodePtr PhysicalAggregation::build(
         before_agg_actions,
         aggregation_keys,
         collators,
-        AggregationInterpreterHelper::isFinalAgg(aggregation),
+        is_final_agg,
         aggregate_descriptions,
         expr_after_agg_actions,
-        fine_grained_shuffle);
+        fine_grained_shuffle,
+        push_down_aggregation);
     return physical_agg;
 }
 
@@ -122,7 +130,8 @@ void PhysicalAggregation::transformImpl(DAGPipeline & pipeline, Context & contex
     {
         /// If there are several sources, then we perform parallel aggregation
         const Settings & settings = context.getSettingsRef();
-        BlockInputStreamPtr stream = std::make_shared<ParallelAggregatingBlockInputStream>(
+        size_t bypass_sample_rows = AggregationInterpreterHelper::getPartialAggBypassSampleRows(context, params, is_final_agg);
+        auto stream = std::make_shared<ParallelAggregatingBlockInputStream>(
             pipeline.streams,
             pipeline.streams_with_non_joined_data,
             params,
@@ -130,13 +139,25 @@ void PhysicalAggregation::transformImpl(DAGPipeline & pipeline, Context & contex
             true,
             max_streams,
             settings.aggregation_memory_efficient_merge_threads ? static_cast<size_t>(settings.aggregation_memory_efficient_merge_threads) : static_cast<size_t>(settings.max_threads),
-            log->identifier());
+            log->identifier(),
+            bypass_sample_rows,
+            settings.partial_agg_bypass_ratio_threshold);
 
-        pipeline.streams.resize(1);
+        size_t final_concurrency = context.getDAGContext()->final_concurrency;
+        size_t merge_concurrency = AggregationInterpreterHelper::getParallelMergeConcurrency(context, final_concurrency);
         pipeline.streams_with_non_joined_data.clear();
-        pipeline.firstStream() = std::move(stream);
-
-        restoreConcurrency(pipeline, context.getDAGContext()->final_concurrency, log);
+        if (merge_concurrency > 0)
+        {
+            /// The output streams merge the aggregated data in parallel, so the concurrency is restored without SharedQuery.
+            pipeline.streams = MergingBucketsBlockInputStream::build(stream, merge_concurrency);
+        }
+        else
+        {
+            pipeline.streams.resize(1);
+            pipeline.firstStream() = std::move(stream);
+
+            restoreConcurrency(pipeline, final_concurrency, log);
+        }
     }
     else
     {
@@ -158,6 +179,8 @@ void PhysicalAggregation::transformImpl(DAGPipeline & pipeline, Context & contex
             log->identifier());
     }
 
+    AggregationInterpreterHelper::appendPushDownAggregationResult(pipeline, push_down_aggregation, aggregate_descriptions, log->identifier());
+
     // we can record for agg after restore concurrency.
     // Because the streams of expr_after_agg will provide the correct ProfileInfo.
     // See #3804.
@@ -17,6 +17,7 @@
 #include <Flash/Planner/plans/PhysicalUnary.h>
 #include <Interpreters/AggregateDescription.h>
 #include <Interpreters/ExpressionActions.h>
+#include <Storages/DeltaMerge/PushDownAggregation.h>
 #include <tipb/executor.pb.h>
 
 namespace DB
@@ -43,7 +44,8 @@ public:
         bool is_final_agg_,
         const AggregateDescriptions & aggregate_descriptions_,
         const ExpressionActionsPtr & expr_after_agg_,
-        const FineGrainedShuffle & fine_grained_shuffle_)
+        const FineGrainedShuffle & fine_grained_shuffle_,
+        const DM::PushDownAggregationPtr & push_down_aggregation_)
         : PhysicalUnary(executor_id_, PlanType::Aggregation, schema_, req_id, child_)
         , before_agg_actions(before_agg_actions_)
         , aggregation_keys(aggregation_keys_)
@@ -52,6 +54,7 @@ public:
         , aggregate_descriptions(aggregate_descriptions_)
         , expr_after_agg(expr_after_agg_)
         , fine_grained_shuffle(fine_grained_shuffle_)
+        , push_down_aggregation(push_down_aggregation_)
     {}
 
     void finalize(const Names & parent_require) override;
@@ -68,5 +71,7 @@ private:
     AggregateDescriptions aggregate_descriptions;
     ExpressionActionsPtr expr_after_agg;
     FineGrainedShuffle fine_grained_shuffle;
+    // Not null if the aggregation is partially answered by the table scan child.
+    DM::PushDownAggregationPtr push_down_aggregation;
 };
 } // namespace DB
@@ -17,6 +17,8 @@
 #include <Flash/Coprocessor/DAGPipeline.h>
 #include <Flash/Coprocessor/FineGrainedShuffle.h>
 #include <Flash/Coprocessor/GenSchemaAndColumn.h>
+#include <Flash/Pipeline/Exec/PipelineExecBuilder.h>
+#include <Flash/Pipeline/Operators/ExchangeReceiverSourceOp.h>
 #include <Flash/Planner/FinalizeHelper.h>
 #include <Flash/Planner/PhysicalPlanHelper.h>
 #include <Flash/Planner/plans/PhysicalExchangeReceiver.h>
@@ -87,6 +89,36 @@ void PhysicalExchangeReceiver::transformImpl(DAGPipeline & pipeline, Context & c
     }
 }
 
+void PhysicalExchangeReceiver::buildPipelineExec(
+    PipelineExecutorStatus & exec_status,
+    PipelineExecGroupBuilder & group_builder,
+    Context & context,
+    size_t concurrency)
+{
+    auto & dag_context = *context.getDAGContext();
+    auto & exchange_receiver_io_input_streams = dag_context.getInBoundIOInputStreamsMap()[executor_id];
+    auto & profile_streams = dag_context.getProfileStreamsMap()[executor_id];
+
+    const bool enable_fine_grained_shuffle = enableFineGrainedShuffle(mpp_exchange_receiver->getFineGrainedShuffleStreamCount());
+    size_t stream_count = concurrency;
+    if (enable_fine_grained_shuffle)
+        stream_count = std::min(concurrency, mpp_exchange_receiver->getFineGrainedShuffleStreamCount());
+    dag_context.updateFinalConcurrency(stream_count, concurrency);
+
+    group_builder.init(stream_count);
+    size_t i = 0;
+    group_builder.transform([&](auto & builder) {
+        auto stream = std::make_shared<ExchangeReceiverInputStream>(mpp_exchange_receiver,
+                                                                    log->identifier(),
+                                                                    execId(),
+                                                                    /*stream_id=*/enable_fine_grained_shuffle ? i : 0);
+        ++i;
+        exchange_receiver_io_input_streams.push_back(stream);
+        profile_streams.push_back(stream);
+        builder.setSourceOp(std::make_unique<ExchangeReceiverSourceOp>(exec_status, log->identifier(), stream));
+    });
+}
+
 void PhysicalExchangeReceiver::finalize(const Names & parent_require)
 {
     FinalizeHelper::checkSchemaContainsParentRequire(schema, parent_require);
@@ -40,6 +40,12 @@ public:
 
     const Block & getSampleBlock() const override;
 
+    void buildPipelineExec(
+        PipelineExecutorStatus & exec_status,
+        PipelineExecGroupBuilder & group_builder,
+        Context & context,
+        size_t concurrency) override;
+
     size_t getSourceNum() const
     {
         return mpp_exchange_receiver->getSourceNum();
@@ -19,6 +19,8 @@
 #include <Flash/Coprocessor/ExchangeSenderInterpreterHelper.h>
 #include <Flash/Coprocessor/InterpreterUtils.h>
 #include <Flash/Mpp/newMPPExchangeWriter.h>
+#include <Flash/Pipeline/Exec/PipelineExecBuilder.h>
+#include <Flash/Pipeline/Operators/ExchangeSenderSinkOp.h>
 #include <Flash/Planner/plans/PhysicalExchangeSender.h>
 #include <Interpreters/Context.h>
 
@@ -81,12 +83,47 @@ void PhysicalExchangeSender::transformImpl(DAGPipeline & pipeline, Context & con
             dag_context,
             fine_grained_shuffle.enable(),
             fine_grained_shuffle.stream_count,
-            fine_grained_shuffle.batch_size);
+            fine_grained_shuffle.batch_size,
+            context.getSettingsRef().mpp_exchange_dictionary_encoding);
         stream = std::make_shared<ExchangeSenderBlockInputStream>(stream, std::move(response_writer), log->identifier());
         stream->setExtraInfo(extra_info);
     });
 }
 
+void PhysicalExchangeSender::buildPipelineExec(
+    PipelineExecutorStatus & exec_status,
+    PipelineExecGroupBuilder & group_builder,
+    Context & context,
+    size_t concurrency)
+{
+    child->buildPipelineExec(exec_status, group_builder, context, concurrency);
+
+    auto & dag_context = *context.getDAGContext();
+    RUNTIME_ASSERT(dag_context.isMPPTask() && dag_context.tunnel_set != nullptr, log, "exchange_sender only run in MPP");
+    if (fine_grained_shuffle.enable())
+    {
+        RUNTIME_CHECK(exchange_type == tipb::ExchangeType::Hash, ExchangeType_Name(exchange_type));
+        RUNTIME_CHECK(fine_grained_shuffle.stream_count <= 1024, fine_grained_shuffle.stream_count);
+    }
+
+    group_builder.transform([&](auto & builder) {
+        // construct writer
+        std::unique_ptr<DAGResponseWriter> response_writer = newMPPExchangeWriter(
+            dag_context.tunnel_set,
+            partition_col_ids,
+            partition_col_collators,
+            exchange_type,
+            context.getSettingsRef().dag_records_per_chunk,
+            context.getSettingsRef().batch_send_min_limit,
+            dag_context,
+            fine_grained_shuffle.enable(),
+            fine_grained_shuffle.stream_count,
+            fine_grained_shuffle.batch_size,
+            context.getSettingsRef().mpp_exchange_dictionary_encoding);
+        builder.setSinkOp(std::make_unique<ExchangeSenderSinkOp>(exec_status, log->identifier(), std::move(response_writer), dag_context.tunnel_set));
+    });
+}
+
 void PhysicalExchangeSender::finalize(const Names & parent_require)
 {
     child->finalize(parent_require);
@@ -47,6 +47,12 @@ public:
         , fine_grained_shuffle(fine_grained_shuffle_)
     {}
 
+    void buildPipelineExec(
+        PipelineExecutorStatus & exec_status,
+        PipelineExecGroupBuilder & group_builder,
+        Context & context,
+        size_t concurrency) override;
+
     void finalize(const Names & parent_require) override;
 
     const Block & getSampleBlock() const override;
@@ -42,6 +42,12 @@ public:
         , before_filter_actions(before_filter_actions_)
     {}
 
+    void buildPipelineExec(
+        PipelineExecutorStatus & exec_status,
+        PipelineExecGroupBuilder & group_builder,
+        Context & context,
+        size_t concurrency) override;
+
     void finalize(const Names & parent_require) override;
 
     const Block & getSampleBlock() const override;
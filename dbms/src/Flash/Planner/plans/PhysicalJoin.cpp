@@ -130,6 +130,9 @@ PhysicalPlanNodePtr PhysicalJoin::build(
     size_t max_block_size_for_cross_join = settings.max_block_size;
     fiu_do_on(FailPoints::minimum_block_size_for_cross_join, { max_block_size_for_cross_join = 1; });
 
+    /// The spilled partitions are restored by extra streams that can not be fit into the fine grained shuffle pipelines.
+    size_t max_bytes_before_external_join = dag_context.hasFineGrainedShuffle() ? 0 : settings.max_bytes_before_external_join;
+
     JoinPtr join_ptr = std::make_shared<Join>(
         probe_key_names,
         build_key_names,
@@ -146,10 +149,14 @@ PhysicalPlanNodePtr PhysicalJoin::build(
         other_eq_filter_from_in_column_name,
         other_condition_expr,
         max_block_size_for_cross_join,
-        match_helper_name);
+        match_helper_name,
+        JoinSpillConfig{max_bytes_before_external_join, settings.join_spill_partition_num, context.getTemporaryPath(), context.getFileProvider()});
 
     recordJoinExecuteInfo(dag_context, executor_id, build_plan->execId(), join_ptr);
 
+    if (settings.enable_join_runtime_filter)
+        join_ptr->setRuntimeFilters(tiflash_join.genRuntimeFilters(dag_context, build_key_names, settings.join_runtime_filter_max_in_values));
+
     auto physical_join = std::make_shared<PhysicalJoin>(
         executor_id,
         join_output_schema,
@@ -193,6 +200,18 @@ void PhysicalJoin::probeSideTransform(DAGPipeline & probe_pipeline, Context & co
             join_execute_info.non_joined_streams.push_back(non_joined_stream);
         }
     }
+    if (join_ptr->isSpillEnabled())
+    {
+        /// the spilled partitions, if any, are joined after all the probe streams are finished.
+        size_t restore_concurrency = join_ptr->getBuildConcurrency();
+        const auto & input_header = probe_pipeline.firstStream()->getHeader();
+        for (size_t i = 0; i < restore_concurrency; ++i)
+        {
+            auto restore_stream = createStreamWithSpilledPartitions(join_ptr, input_header, i, restore_concurrency, settings.max_block_size);
+            restore_stream->setExtraInfo("add stream with spilled partitions of grace hash join");
+            probe_pipeline.streams_with_non_joined_data.push_back(restore_stream);
+        }
+    }
     String join_probe_extra_info = fmt::format("join probe, join_executor_id = {}", execId());
     for (auto & stream : probe_pipeline.streams)
     {
@@ -0,0 +1,47 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <DataStreams/NullBlockInputStream.h>
+#include <Flash/Coprocessor/DAGContext.h>
+#include <Flash/Coprocessor/DAGPipeline.h>
+#include <Flash/Pipeline/Exec/PipelineExecBuilder.h>
+#include <Flash/Pipeline/Operators/BlockInputStreamSourceOp.h>
+#include <Flash/Planner/plans/PhysicalLeaf.h>
+#include <Interpreters/Context.h>
+
+namespace DB
+{
+void PhysicalLeaf::buildPipelineExec(
+    PipelineExecutorStatus & exec_status,
+    PipelineExecGroupBuilder & group_builder,
+    Context & context,
+    size_t concurrency)
+{
+    // Call `transformImpl` instead of `transform` to avoid `restoreConcurrency`,
+    // the concurrency of the pipeline is decided by the number of the sources.
+    DAGPipeline pipeline;
+    transformImpl(pipeline, context, concurrency);
+    if (is_tidb_operator)
+        recordProfileStreams(pipeline, context);
+    if (pipeline.streams.empty())
+        pipeline.streams.push_back(std::make_shared<NullBlockInputStream>(getSampleBlock()));
+    context.getDAGContext()->updateFinalConcurrency(pipeline.streams.size(), concurrency);
+
+    group_builder.init(pipeline.streams.size());
+    size_t i = 0;
+    group_builder.transform([&](auto & builder) {
+        builder.setSourceOp(std::make_unique<BlockInputStreamSourceOp>(exec_status, log->identifier(), pipeline.streams[i++]));
+    });
+}
+} // namespace DB
@@ -44,5 +44,13 @@ public:
     }
 
     size_t childrenSize() const override { return 0; };
+
+    /// By default, the streams built by `transformImpl` are wrapped as the sources of the pipeline_execs,
+    /// and the blocking reads of the streams are executed by the io thread pool.
+    void buildPipelineExec(
+        PipelineExecutorStatus & exec_status,
+        PipelineExecGroupBuilder & group_builder,
+        Context & context,
+        size_t concurrency) override;
 };
 } // namespace DB
\ No newline at end of file
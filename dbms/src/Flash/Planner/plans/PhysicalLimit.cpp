@@ -17,6 +17,8 @@
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/DAGPipeline.h>
 #include <Flash/Coprocessor/InterpreterUtils.h>
+#include <Flash/Pipeline/Exec/PipelineExecBuilder.h>
+#include <Flash/Pipeline/Operators/LimitTransformOp.h>
 #include <Flash/Planner/plans/PhysicalLimit.h>
 #include <Interpreters/Context.h>
 
@@ -50,6 +52,21 @@ void PhysicalLimit::transformImpl(DAGPipeline & pipeline, Context & context, siz
     }
 }
 
+void PhysicalLimit::buildPipelineExec(
+    PipelineExecutorStatus & exec_status,
+    PipelineExecGroupBuilder & group_builder,
+    Context & context,
+    size_t concurrency)
+{
+    child->buildPipelineExec(exec_status, group_builder, context, concurrency);
+
+    // The limit is shared by all the pipeline_execs, so no need to union the streams and limit again.
+    auto global_limit = std::make_shared<GlobalLimitTransformAction>(limit);
+    group_builder.transform([&](auto & builder) {
+        builder.appendTransformOp(std::make_unique<LimitTransformOp>(exec_status, log->identifier(), global_limit));
+    });
+}
+
 void PhysicalLimit::finalize(const Names & parent_require)
 {
     child->finalize(parent_require);
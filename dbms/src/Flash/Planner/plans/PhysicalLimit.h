@@ -38,6 +38,12 @@ public:
         , limit(limit_)
     {}
 
+    void buildPipelineExec(
+        PipelineExecutorStatus & exec_status,
+        PipelineExecGroupBuilder & group_builder,
+        Context & context,
+        size_t concurrency) override;
+
     void finalize(const Names & parent_require) override;
 
     const Block & getSampleBlock() const override;
@@ -18,6 +18,8 @@
 #include <Flash/Coprocessor/DAGExpressionAnalyzer.h>
 #include <Flash/Coprocessor/DAGPipeline.h>
 #include <Flash/Coprocessor/InterpreterUtils.h>
+#include <Flash/Pipeline/Exec/PipelineExecBuilder.h>
+#include <Flash/Pipeline/Operators/ExpressionTransformOp.h>
 #include <Flash/Planner/FinalizeHelper.h>
 #include <Flash/Planner/PhysicalPlanHelper.h>
 #include <Flash/Planner/plans/PhysicalProjection.h>
@@ -141,6 +143,22 @@ void PhysicalProjection::transformImpl(DAGPipeline & pipeline, Context & context
     executeExpression(pipeline, project_actions, log, extra_info);
 }
 
+void PhysicalProjection::buildPipelineExec(
+    PipelineExecutorStatus & exec_status,
+    PipelineExecGroupBuilder & group_builder,
+    Context & context,
+    size_t concurrency)
+{
+    child->buildPipelineExec(exec_status, group_builder, context, concurrency);
+
+    if (project_actions && !project_actions->getActions().empty())
+    {
+        group_builder.transform([&](auto & builder) {
+            builder.appendTransformOp(std::make_unique<ExpressionTransformOp>(exec_status, log->identifier(), project_actions));
+        });
+    }
+}
+
 void PhysicalProjection::finalize(const Names & parent_require)
 {
     FinalizeHelper::checkSampleBlockContainsParentRequire(getSampleBlock(), parent_require);
@@ -62,6 +62,12 @@ public:
         , project_actions(project_actions_)
     {}
 
+    void buildPipelineExec(
+        PipelineExecutorStatus & exec_status,
+        PipelineExecGroupBuilder & group_builder,
+        Context & context,
+        size_t concurrency) override;
+
     void finalize(const Names & parent_require) override;
 
     const Block & getSampleBlock() const override;
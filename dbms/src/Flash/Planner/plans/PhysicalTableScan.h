@@ -44,6 +44,8 @@ public:
 
     const String & getPushDownFilterId() const;
 
+    const TiDBTableScan & getTiDBTableScan() const { return tidb_table_scan; }
+
 private:
     void transformImpl(DAGPipeline & pipeline, Context & context, size_t max_streams) override;
 
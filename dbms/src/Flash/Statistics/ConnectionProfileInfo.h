@@ -22,5 +22,17 @@ struct ConnectionProfileInfo
 {
     Int64 packets = 0;
     Int64 bytes = 0;
+
+    /// Only the chunks exchanged between the MPP tasks on different nodes are compressed.
+    /// Byte size of those chunks before and after compression.
+    Int64 uncompressed_bytes = 0;
+    Int64 compressed_bytes = 0;
+    /// The cpu time of compression on the sender side, or decompression on the receiver side.
+    UInt64 compression_time_ns = 0;
+
+    double compressionRatio() const
+    {
+        return compressed_bytes == 0 ? 1.0 : static_cast<double>(uncompressed_bytes) / compressed_bytes;
+    }
 };
 } // namespace DB
\ No newline at end of file
@@ -20,10 +20,12 @@ namespace DB
 String ExchangeReceiveDetail::toJson() const
 {
     return fmt::format(
-        R"({{"receiver_source_task_id":{},"packets":{},"bytes":{}}})",
+        R"({{"receiver_source_task_id":{},"packets":{},"bytes":{},"compression_ratio":{:.2f},"compression_time_ns":{}}})",
         receiver_source_task_id,
         packets,
-        bytes);
+        bytes,
+        compressionRatio(),
+        compression_time_ns);
 }
 
 void ExchangeReceiverStatistics::appendExtraJson(FmtBuffer & fmt_buffer) const
@@ -57,6 +59,9 @@ void ExchangeReceiverStatistics::collectExtraRuntimeDetail()
                 {
                     exchange_receive_details[i].packets += connection_profile_infos[i].packets;
                     exchange_receive_details[i].bytes += connection_profile_infos[i].bytes;
+                    exchange_receive_details[i].uncompressed_bytes += connection_profile_infos[i].uncompressed_bytes;
+                    exchange_receive_details[i].compressed_bytes += connection_profile_infos[i].compressed_bytes;
+                    exchange_receive_details[i].compression_time_ns += connection_profile_infos[i].compression_time_ns;
                 }
             }
         }
@@ -22,13 +22,15 @@ namespace DB
 String MPPTunnelDetail::toJson() const
 {
     return fmt::format(
-        R"({{"tunnel_id":"{}","sender_target_task_id":{},"sender_target_host":"{}","is_local":{},"packets":{},"bytes":{}}})",
+        R"({{"tunnel_id":"{}","sender_target_task_id":{},"sender_target_host":"{}","is_local":{},"packets":{},"bytes":{},"compression_ratio":{:.2f},"compression_time_ns":{}}})",
         tunnel_id,
         sender_target_task_id,
         sender_target_host,
         is_local,
         packets,
-        bytes);
+        bytes,
+        compressionRatio(),
+        compression_time_ns);
 }
 
 void ExchangeSenderStatistics::appendExtraJson(FmtBuffer & fmt_buffer) const
@@ -54,6 +56,9 @@ void ExchangeSenderStatistics::collectExtraRuntimeDetail()
         const auto & connection_profile_info = mpp_tunnels[i]->getConnectionProfileInfo();
         mpp_tunnel_details[i].packets = connection_profile_info.packets;
         mpp_tunnel_details[i].bytes = connection_profile_info.bytes;
+        mpp_tunnel_details[i].uncompressed_bytes = connection_profile_info.uncompressed_bytes;
+        mpp_tunnel_details[i].compressed_bytes = connection_profile_info.compressed_bytes;
+        mpp_tunnel_details[i].compression_time_ns = connection_profile_info.compression_time_ns;
     }
 }
 
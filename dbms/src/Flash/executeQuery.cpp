@@ -17,6 +17,9 @@
 #include <Flash/Coprocessor/DAGContext.h>
 #include <Flash/Coprocessor/DAGQuerySource.h>
 #include <Flash/Executor/DataStreamExecutor.h>
+#include <Flash/Executor/PipelineExecutor.h>
+#include <Flash/Pipeline/Schedule/TaskScheduler.h>
+#include <Flash/Planner/PhysicalPlan.h>
 #include <Flash/Planner/PlanQuerySource.h>
 #include <Flash/executeQuery.h>
 #include <Interpreters/Context.h>
@@ -24,6 +27,8 @@
 #include <Interpreters/Quota.h>
 #include <Interpreters/executeQuery.h>
 
+#include <optional>
+
 namespace ProfileEvents
 {
 extern const Event Query;
@@ -97,6 +102,42 @@ BlockIO executeDAG(IQuerySource & dag, Context & context, bool internal)
 
     return res;
 }
+
+/// Return nullopt if the query can not be executed by the pipeline model,
+/// and then the query will fall back to be executed by the block input streams.
+std::optional<QueryExecutorPtr> executeAsPipeline(Context & context, bool internal)
+{
+    RUNTIME_ASSERT(context.getDAGContext());
+    auto & dag_context = *context.getDAGContext();
+    const auto & logger = dag_context.log;
+    RUNTIME_ASSERT(logger);
+
+    PhysicalPlan physical_plan{context, logger->identifier()};
+    physical_plan.build(dag_context.dag_request);
+    physical_plan.outputAndOptimize();
+    if (!physical_plan.isSupportPipeline())
+    {
+        LOG_DEBUG(logger, "the physical plan is not supported by the pipeline model, fall back to the block input streams");
+        // The plan will be built again by `Planner`, reset the state filled by `outputAndOptimize`.
+        dag_context.list_based_executors_order.clear();
+        return {};
+    }
+
+    prepareForExecute(context);
+
+    ProcessList::EntryPtr process_list_entry;
+    if (likely(!internal))
+    {
+        process_list_entry = getProcessListEntry(context, dag_context);
+        logQuery(dag_context.dummy_query_string, context, logger);
+    }
+
+    FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::random_interpreter_failpoint);
+    auto executor = std::make_unique<PipelineExecutor>(process_list_entry, context, physical_plan);
+    if (likely(!internal))
+        LOG_DEBUG(logger, "Query pipeline:\n{}", executor->dump());
+    return {std::move(executor)};
+}
 } // namespace
 
 BlockIO executeQuery(Context & context, bool internal)
@@ -115,6 +156,12 @@ BlockIO executeQuery(Context & context, bool internal)
 
 QueryExecutorPtr queryExecute(Context & context, bool internal)
 {
+    const auto & settings = context.getSettingsRef();
+    if (settings.enable_planner && settings.enable_pipeline && TaskScheduler::instance)
+    {
+        if (auto res = executeAsPipeline(context, internal); res)
+            return std::move(*res);
+    }
     return std::make_unique<DataStreamExecutor>(executeQuery(context, internal));
 }
 } // namespace DB
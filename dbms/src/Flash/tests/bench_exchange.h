@@ -61,6 +61,7 @@ struct MockReceiverContext
         int source_index = 0;
         int send_task_id = 0;
         int recv_task_id = -1;
+        bool is_compressed = false;
     };
 
     struct Reader
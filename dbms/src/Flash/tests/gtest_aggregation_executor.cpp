@@ -119,6 +119,19 @@ public:
                              {toVec<Int64>("s1", {1, 2, 3}),
                               toVec<Int64>("s2", {1, 2, 3})});
 
+        {
+            std::vector<Int64> keys, values;
+            for (Int64 i = 0; i < 1000; ++i)
+            {
+                keys.push_back(i % 100);
+                values.push_back(i);
+            }
+            context.addMockTable({"test_db", "test_table_many_keys"},
+                                 {{"s1", TiDB::TP::TypeLongLong}, {"s2", TiDB::TP::TypeLongLong}},
+                                 {toVec<Int64>("s1", keys),
+                                  toVec<Int64>("s2", values)});
+        }
+
         context.addMockTable({"test_db", "test_table_not_null"},
                              {
                                  {"c1_i64", TiDB::TP::TypeLongLong},
@@ -510,6 +523,28 @@ try
 }
 CATCH
 
+TEST_F(ExecutorAggTestRunner, TwoLevelAggMerge)
+try
+{
+    std::vector<UInt64> counts(100, 10);
+    std::vector<std::optional<Int64>> maxs;
+    for (Int64 i = 0; i < 100; ++i)
+        maxs.push_back(i + 900);
+    ColumnsWithTypeAndName expect_cols{toVec<UInt64>("count(s2)", counts), toNullableVec<Int64>("max(s2)", maxs)};
+
+    auto request = buildDAGRequest(std::make_pair(db_name, "test_table_many_keys"), {Count(col("s2")), Max(col("s2"))}, {col("s1")}, {"count(s2)", "max(s2)"});
+    /// Convert to two-level hash tables at once, so that the buckets are merged by the output streams in parallel or by the aggregation.
+    context.context.setSetting("group_by_two_level_threshold", Field(static_cast<UInt64>(1)));
+    for (auto enable_parallel_agg_merge : {true, false})
+    {
+        context.context.setSetting("enable_parallel_agg_merge", Field(static_cast<UInt64>(enable_parallel_agg_merge)));
+        executeAndAssertColumnsEqual(request, expect_cols);
+    }
+    context.context.setSetting("group_by_two_level_threshold", Field(static_cast<UInt64>(100000)));
+    context.context.setSetting("enable_parallel_agg_merge", Field(static_cast<UInt64>(1)));
+}
+CATCH
+
 // TODO support more type of min, max, count.
 //      support more aggregation functions: sum, forst_row, group_concat
 
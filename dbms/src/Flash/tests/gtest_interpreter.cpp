@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Flash/executeQuery.h>
 #include <TestUtils/ExecutorTestUtils.h>
 #include <TestUtils/mockExecutor.h>
 
@@ -57,7 +58,7 @@ Union: <for test>
      PartialSorting x 10: limit = 10
       Expression: <before order and select>
        Filter: <execute having>
-        SharedQuery: <restore concurrency>
+        MergingBuckets
          ParallelAggregating, max_threads: 10, final: true
           Expression x 10: <before aggregation>
            Filter: <execute where>
@@ -82,7 +83,7 @@ Union: <for test>
      Expression: <final projection>
       Expression: <before order and select>
        Filter: <execute having>
-        SharedQuery: <restore concurrency>
+        MergingBuckets
          ParallelAggregating, max_threads: 10, final: true
           Expression x 10: <before aggregation>
            Filter: <execute where>
@@ -148,7 +149,7 @@ Union: <for test>
  Expression x 10: <final projection>
   Expression: <projection>
    Expression: <final projection>
-    SharedQuery: <restore concurrency>
+    MergingBuckets
      ParallelAggregating, max_threads: 10, final: true
       Expression x 10: <projection>
        SharedQuery: <restore concurrency>
@@ -186,7 +187,7 @@ Union: <for test>
          Filter: <execute where>
           Expression: <projection>
            Expression: <final projection>
-            SharedQuery: <restore concurrency>
+            MergingBuckets
              ParallelAggregating, max_threads: 10, final: true
               Expression x 10: <projection>
                SharedQuery: <restore concurrency>
@@ -548,7 +549,7 @@ CreatingSets
      MockTableScan
  Union: <for test>
   Expression x 10: <final projection>
-   SharedQuery: <restore concurrency>
+   MergingBuckets
     ParallelAggregating, max_threads: 10, final: true
      Expression x 10: <remove useless column after join>
       HashJoinProbe: <join probe, join_executor_id = Join_2>
@@ -577,7 +578,7 @@ CreatingSets
      MockTableScan
  Union: <for test>
   Expression x 10: <final projection>
-   SharedQuery: <restore concurrency>
+   MergingBuckets
     ParallelAggregating, max_threads: 10, final: true
      Expression x 10: <remove useless column after join>
       HashJoinProbe: <join probe, join_executor_id = Join_2>
@@ -617,7 +618,7 @@ CreatingSets
       Limit x 20, limit = 10
        Expression: <final projection>
         Expression: <before order and select>
-         SharedQuery: <restore concurrency>
+         MergingBuckets
           ParallelAggregating, max_threads: 20, final: true
            Expression x 20: <remove useless column after join>
             HashJoinProbe: <join probe, join_executor_id = Join_2>
@@ -631,6 +632,40 @@ CreatingSets
 }
 CATCH
 
+TEST_F(InterpreterExecuteTest, JoinSpillWithFineGrainedShuffle)
+try
+{
+    auto dump_streams = [&](const std::shared_ptr<tipb::DAGRequest> & request) {
+        DAGContext dag_context(*request, "interpreter_test", 10);
+        context.context.setDAGContext(&dag_context);
+        context.context.setExecutorTest();
+        return queryExecute(context.context, /*internal=*/true)->dump();
+    };
+
+    context.context.setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(1)));
+    {
+        // the spilled partitions are restored after the probe streams.
+        DAGRequestBuilder receiver1 = context.receive("sender_l");
+        DAGRequestBuilder receiver2 = context.receive("sender_r");
+        auto request = receiver1.join(receiver2, tipb::JoinType::TypeInnerJoin, {col("join_c")})
+                           .aggregation({Max(col("r_a"))}, {col("join_c")})
+                           .build(context);
+        ASSERT_NE(dump_streams(request).find("SpilledPartitions"), String::npos);
+    }
+    {
+        // the restore streams can not be added to the fine grained shuffle pipelines, so the join is not spilled.
+        const uint64_t enable = 8;
+        DAGRequestBuilder receiver1 = context.receive("sender_l", enable);
+        DAGRequestBuilder receiver2 = context.receive("sender_r", enable);
+        auto request = receiver1.join(receiver2, tipb::JoinType::TypeInnerJoin, {col("join_c")})
+                           .aggregation({Max(col("r_a"))}, {col("join_c")}, enable)
+                           .build(context);
+        ASSERT_EQ(dump_streams(request).find("SpilledPartitions"), String::npos);
+    }
+    context.context.setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(0)));
+}
+CATCH
+
 TEST_F(InterpreterExecuteTest, ListBase)
 try
 {
@@ -666,7 +701,7 @@ Union: <for test>
    MergeSorting, limit = 10
     Union: <for partial order>
      PartialSorting x 20: limit = 10
-      SharedQuery: <restore concurrency>
+      MergingBuckets
        ParallelAggregating, max_threads: 20, final: true
         Expression x 20: <before aggregation>
          Filter: <execute where>
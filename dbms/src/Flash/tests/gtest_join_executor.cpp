@@ -12,11 +12,19 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/ProfileEvents.h>
 #include <TestUtils/ExecutorTestUtils.h>
 
 #include <ext/enumerate.h>
 #include <tuple>
 
+namespace ProfileEvents
+{
+extern const Event ExternalJoinSpillBuild;
+extern const Event ExternalJoinRestorePartition;
+extern const Event ExternalJoinOversizedPartition;
+} // namespace ProfileEvents
+
 namespace DB
 {
 namespace tests
@@ -142,6 +150,72 @@ try
 }
 CATCH
 
+TEST_F(JoinExecutorTestRunner, SpillToDisk)
+try
+{
+    context.addMockTable("spill_test", "t1", {{"a", TiDB::TP::TypeString}, {"b", TiDB::TP::TypeString}}, {toNullableVec<String>("a", {"1", "2", {}, "1", {}, "5", "6", "7", "2", "9"}), toNullableVec<String>("b", {"3", "4", "3", {}, {}, "8", "8", "1", "5", "4"})});
+    context.addMockTable("spill_test", "t2", {{"a", TiDB::TP::TypeString}, {"b", TiDB::TP::TypeString}}, {toNullableVec<String>("a", {"1", "3", {}, "1", {}, "6", "7", "7", "8"}), toNullableVec<String>("b", {"3", "4", "3", {}, {}, "9", "8", "5", "4"})});
+
+    const std::tuple<String, String, String> join_cases[] = {
+        std::make_tuple("t1", "t2", "a"),
+        std::make_tuple("t2", "t1", "a"),
+        std::make_tuple("t1", "t2", "b"),
+        std::make_tuple("t2", "t1", "b"),
+    };
+
+    for (const auto join_type : join_types)
+    {
+        for (const auto & [l, r, k] : join_cases)
+        {
+            auto request = context.scan("spill_test", l)
+                               .join(context.scan("spill_test", r), join_type, {col(k)})
+                               .build(context);
+
+            /// the result of grace hash join should be the same as the in-memory one.
+            context.context.setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(0)));
+            auto expect_columns = executeStreams(request, 1);
+            context.context.setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(1)));
+            auto spill_count = ProfileEvents::get(ProfileEvents::ExternalJoinSpillBuild);
+            auto restore_count = ProfileEvents::get(ProfileEvents::ExternalJoinRestorePartition);
+            executeAndAssertColumnsEqual(request, expect_columns);
+            /// make sure the build side is really spilled and the partitions are restored.
+            ASSERT_GT(ProfileEvents::get(ProfileEvents::ExternalJoinSpillBuild), spill_count);
+            ASSERT_GT(ProfileEvents::get(ProfileEvents::ExternalJoinRestorePartition), restore_count);
+        }
+    }
+    context.context.setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(0)));
+}
+CATCH
+
+TEST_F(JoinExecutorTestRunner, SpillToDiskWithSkewedPartition)
+try
+{
+    /// All the build rows have the same key, so they fall into one partition which is still too big after restored.
+    std::vector<std::optional<String>> skewed_keys(100, "1");
+    std::vector<std::optional<String>> skewed_values;
+    for (size_t i = 0; i < skewed_keys.size(); ++i)
+        skewed_values.push_back(std::to_string(i));
+    context.addMockTable("skew_test", "t1", {{"a", TiDB::TP::TypeString}, {"b", TiDB::TP::TypeString}}, {toNullableVec<String>("a", {"1", "2", {}, "1"}), toNullableVec<String>("b", {"3", "4", "3", {}})});
+    context.addMockTable("skew_test", "t2", {{"a", TiDB::TP::TypeString}, {"b", TiDB::TP::TypeString}}, {toNullableVec<String>("a", skewed_keys), toNullableVec<String>("b", skewed_values)});
+
+    for (const auto join_type : join_types)
+    {
+        auto request = context.scan("skew_test", "t1")
+                           .join(context.scan("skew_test", "t2"), join_type, {col("a")})
+                           .build(context);
+
+        context.context.setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(0)));
+        auto expect_columns = executeStreams(request, 1);
+        context.context.setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(1)));
+        auto oversized_count = ProfileEvents::get(ProfileEvents::ExternalJoinOversizedPartition);
+        /// The skewed partition can not be spilled again, it is joined in memory and gives the same result.
+        executeAndAssertColumnsEqual(request, expect_columns);
+        ASSERT_GT(ProfileEvents::get(ProfileEvents::ExternalJoinOversizedPartition), oversized_count);
+    }
+    context.context.setSetting("max_bytes_before_external_join", Field(static_cast<UInt64>(0)));
+}
+CATCH
+
 TEST_F(JoinExecutorTestRunner, MultiJoin)
 try
 {
@@ -129,7 +129,7 @@ Union: <for test>
       Expression: <before TopN>
        Filter
         Expression: <expr after aggregation>
-         SharedQuery: <restore concurrency>
+         MergingBuckets
           ParallelAggregating, max_threads: 10, final: true
            Expression x 10: <before aggregation>
             Filter
@@ -154,7 +154,7 @@ Union: <for test>
      Limit x 10, limit = 10
       Filter
        Expression: <expr after aggregation>
-        SharedQuery: <restore concurrency>
+        MergingBuckets
          ParallelAggregating, max_threads: 10, final: true
           Expression x 10: <before aggregation>
            Filter
@@ -221,7 +221,7 @@ Expression: <final projection>
 Union: <for test>
  Expression x 5: <final projection>
   Expression: <expr after aggregation>
-   SharedQuery: <restore concurrency>
+   MergingBuckets
     ParallelAggregating, max_threads: 5, final: true
      MockTableScan x 5)";
         ASSERT_BLOCKINPUTSTREAM_EQAUL(expected, request, 5);
@@ -278,7 +278,7 @@ Union: <for test>
 Union: <for test>
  Expression x 10: <final projection>
   Expression: <expr after aggregation>
-   SharedQuery: <restore concurrency>
+   MergingBuckets
     ParallelAggregating, max_threads: 10, final: true
      SharedQuery x 10: <restore concurrency>
       Limit, limit = 10
@@ -307,7 +307,7 @@ Expression: <final projection>
 Union: <for test>
  Expression x 10: <final projection>
   Expression: <expr after aggregation>
-   SharedQuery: <restore concurrency>
+   MergingBuckets
     ParallelAggregating, max_threads: 10, final: true
      SharedQuery x 10: <restore concurrency>
       MergeSorting, limit = 10
@@ -337,11 +337,11 @@ Expression: <final projection>
 Union: <for test>
  Expression x 10: <final projection>
   Expression: <expr after aggregation>
-   SharedQuery: <restore concurrency>
+   MergingBuckets
     ParallelAggregating, max_threads: 10, final: true
      Expression x 10: <projection>
       Expression: <expr after aggregation>
-       SharedQuery: <restore concurrency>
+       MergingBuckets
         ParallelAggregating, max_threads: 10, final: true
          MockTableScan x 10)";
         ASSERT_BLOCKINPUTSTREAM_EQAUL(expected, request, 10);
@@ -369,7 +369,7 @@ Union: <for test>
  MockExchangeSender x 10
   Expression: <final projection>
    Expression: <expr after aggregation>
-    SharedQuery: <restore concurrency>
+    MergingBuckets
      ParallelAggregating, max_threads: 10, final: true
       MockTableScan x 10)";
         ASSERT_BLOCKINPUTSTREAM_EQAUL(expected, request, 10);
@@ -509,7 +509,7 @@ Union: <for test>
 Union: <for test>
  Expression x 10: <final projection>
   Expression: <expr after aggregation>
-   SharedQuery: <restore concurrency>
+   MergingBuckets
     ParallelAggregating, max_threads: 10, final: true
      Expression x 10: <projection>
       SharedQuery: <restore concurrency>
@@ -542,7 +542,7 @@ Union: <for test>
       Expression: <projection>
        Filter
         Expression: <expr after aggregation>
-         SharedQuery: <restore concurrency>
+         MergingBuckets
           ParallelAggregating, max_threads: 10, final: true
            Expression x 10: <projection>
             SharedQuery: <restore concurrency>
@@ -881,7 +881,7 @@ CreatingSets
  Union: <for test>
   Expression x 10: <final projection>
    Expression: <expr after aggregation>
-    SharedQuery: <restore concurrency>
+    MergingBuckets
      ParallelAggregating, max_threads: 10, final: true
       Expression x 10: <before aggregation>
        Expression: <remove useless column after join>
@@ -912,7 +912,7 @@ CreatingSets
  Union: <for test>
   Expression x 10: <final projection>
    Expression: <expr after aggregation>
-    SharedQuery: <restore concurrency>
+    MergingBuckets
      ParallelAggregating, max_threads: 10, final: true
       Expression x 10: <before aggregation>
        Expression: <remove useless column after join>
@@ -954,7 +954,7 @@ CreatingSets
       Union: <for partial limit>
        Limit x 20, limit = 10
         Expression: <expr after aggregation>
-         SharedQuery: <restore concurrency>
+         MergingBuckets
           ParallelAggregating, max_threads: 20, final: true
            Expression x 20: <before aggregation>
             Expression: <remove useless column after join>
@@ -1012,7 +1012,7 @@ Union: <for test>
       Expression: <before TopN>
        Filter
         Expression: <expr after aggregation>
-         SharedQuery: <restore concurrency>
+         MergingBuckets
           ParallelAggregating, max_threads: 20, final: true
            Expression x 20: <before aggregation>
             Filter
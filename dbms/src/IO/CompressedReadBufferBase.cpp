@@ -18,6 +18,7 @@
 #include <IO/BufferWithOwnMemory.h>
 #include <IO/CompressedReadBufferBase.h>
 #include <IO/CompressedStream.h>
+#include <IO/LightweightCompression.h>
 #include <IO/ReadBuffer.h>
 #include <IO/WriteHelpers.h>
 #include <city.h>
@@ -64,7 +65,7 @@ size_t CompressedReadBufferBase<has_checksum>::readCompressedData(size_t & size_
     size_t & size_compressed = size_compressed_without_checksum;
 
     if (method == static_cast<UInt8>(CompressionMethodByte::LZ4) || method == static_cast<UInt8>(CompressionMethodByte::ZSTD)
-        || method == static_cast<UInt8>(CompressionMethodByte::NONE))
+        || method == static_cast<UInt8>(CompressionMethodByte::NONE) || method == static_cast<UInt8>(CompressionMethodByte::Lightweight))
     {
         size_compressed = unalignedLoad<UInt32>(&own_compressed_buffer[1]);
         size_decompressed = unalignedLoad<UInt32>(&own_compressed_buffer[5]);
@@ -123,6 +124,10 @@ void CompressedReadBufferBase<has_checksum>::decompress(char * to, size_t size_d
     {
         memcpy(to, &compressed_buffer[COMPRESSED_BLOCK_HEADER_SIZE], size_decompressed);
     }
+    else if (method == static_cast<UInt8>(CompressionMethodByte::Lightweight))
+    {
+        decompressLightweight(compressed_buffer, size_compressed_without_checksum, to, size_decompressed);
+    }
     else
         throw Exception("Unknown compression method: " + toString(method), ErrorCodes::UNKNOWN_COMPRESSION_METHOD);
 }
@@ -52,6 +52,9 @@ enum class CompressionMethod
   *
   * 0x90 - ZSTD
   *
+  * 0x96 - Lightweight encodings of fixed size integers, see LightweightCompression.h.
+  *        Next 4 bytes - the size of the compressed data, taking into account the header; 4 bytes is the size of the uncompressed data.
+  *
   * All sizes are little endian.
   */
 
@@ -60,8 +63,21 @@ enum class CompressionMethodByte : uint8_t
     NONE = 0x02,
     LZ4 = 0x82,
     ZSTD = 0x90,
+    Lightweight = 0x96,
     // COL_END is not a compreesion method, but a flag of column end used in compact file.
     COL_END = 0x66,
 };
 
+/** The type of the data to compress. The lightweight encodings are tried only if the data is
+  * known to be fixed size integers, the value is the size of an integer.
+  */
+enum class CompressionDataType : uint8_t
+{
+    Unknown = 0,
+    Int8 = 1,
+    Int16 = 2,
+    Int32 = 4,
+    Int64 = 8,
+};
+
 } // namespace DB
@@ -14,6 +14,7 @@
 
 #include <Core/Types.h>
 #include <IO/CompressedWriteBuffer.h>
+#include <IO/LightweightCompression.h>
 #include <city.h>
 #include <common/unaligned.h>
 #include <lz4.h>
@@ -126,6 +127,17 @@ void CompressedWriteBuffer<add_checksum>::nextImpl()
         throw Exception("Unknown compression method", ErrorCodes::UNKNOWN_COMPRESSION_METHOD);
     }
 
+    if (compression_settings.data_type != CompressionDataType::Unknown)
+    {
+        // The data are integers, use the lightweight encodings if they are smaller.
+        size_t lightweight_size = compressLightweight(working_buffer.begin(), uncompressed_size, compression_settings.data_type, lightweight_buffer);
+        if (lightweight_size != 0 && lightweight_size < compressed_size)
+        {
+            compressed_size = lightweight_size;
+            compressed_buffer_ptr = &lightweight_buffer[0];
+        }
+    }
+
     if constexpr (add_checksum)
     {
         CityHash_v1_0_2::uint128 checksum = CityHash_v1_0_2::CityHash128(compressed_buffer_ptr, compressed_size);
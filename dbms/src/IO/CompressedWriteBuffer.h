@@ -32,6 +32,7 @@ private:
     CompressionSettings compression_settings;
 
     PODArray<char> compressed_buffer;
+    PODArray<char> lightweight_buffer;
 
     void nextImpl() override;
 
@@ -25,6 +25,8 @@ struct CompressionSettings
 {
     CompressionMethod method;
     int level;
+    /// Try the lightweight encodings besides `method` if the data type is known.
+    CompressionDataType data_type = CompressionDataType::Unknown;
 
     CompressionSettings()
         : CompressionSettings(CompressionMethod::LZ4)
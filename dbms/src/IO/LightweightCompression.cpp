@@ -0,0 +1,300 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <IO/LightweightCompression.h>
+#include <common/unaligned.h>
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int CANNOT_DECOMPRESS;
+} // namespace ErrorCodes
+
+namespace
+{
+enum class LightweightEncoding : UInt8
+{
+    RLE = 1,
+    FOR = 2,
+    DELTA_FOR = 3,
+};
+
+constexpr size_t BLOCK_HEADER_SIZE = COMPRESSED_BLOCK_HEADER_SIZE + 2;
+// Every packed value is decoded by one unaligned load of UInt64, so the bit width should be small enough
+// that a value never spans over 8 bytes.
+constexpr UInt8 MAX_PACKED_BITS = 56;
+
+UInt8 bitWidth(UInt64 x)
+{
+    return x == 0 ? 0 : 64 - __builtin_clzll(x);
+}
+
+size_t bitPackedSize(size_t n, UInt8 bits)
+{
+    return (n * bits + 7) / 8 + sizeof(UInt64);
+}
+
+template <typename Getter>
+void bitPack(size_t n, UInt8 bits, Getter && get, char * out)
+{
+    memset(out, 0, bitPackedSize(n, bits));
+    if (bits == 0)
+        return;
+    for (size_t i = 0; i < n; ++i)
+    {
+        size_t bit_pos = i * bits;
+        char * p = out + bit_pos / 8;
+        unalignedStore<UInt64>(p, unalignedLoad<UInt64>(p) | (static_cast<UInt64>(get(i)) << (bit_pos % 8)));
+    }
+}
+
+template <typename T>
+T bitUnpack(const char * in, size_t i, UInt8 bits, UInt64 mask)
+{
+    size_t bit_pos = i * bits;
+    return static_cast<T>((unalignedLoad<UInt64>(in + bit_pos / 8) >> (bit_pos % 8)) & mask);
+}
+
+template <typename T>
+size_t compressImpl(const char * source, size_t source_size, PODArray<char> & dest)
+{
+    const size_t n = source_size / sizeof(T);
+    auto value_at = [source](size_t i) {
+        return unalignedLoad<T>(source + i * sizeof(T));
+    };
+
+    // Collect the statistics of all encodings in one pass.
+    const T first = value_at(0);
+    T min_value = first;
+    T max_value = first;
+    T min_delta = std::numeric_limits<T>::max();
+    T max_delta = 0;
+    size_t runs = 1;
+    for (size_t i = 1; i < n; ++i)
+    {
+        T prev = value_at(i - 1);
+        T cur = value_at(i);
+        min_value = std::min(min_value, cur);
+        max_value = std::max(max_value, cur);
+        T delta = static_cast<T>(cur - prev);
+        min_delta = std::min(min_delta, delta);
+        max_delta = std::max(max_delta, delta);
+        runs += cur != prev;
+    }
+    if (n == 1)
+        min_delta = 0;
+
+    const UInt8 for_bits = bitWidth(static_cast<T>(max_value - min_value));
+    const UInt8 delta_bits = bitWidth(static_cast<T>(max_delta - min_delta));
+
+    const size_t rle_size = BLOCK_HEADER_SIZE + sizeof(UInt32) + runs * (sizeof(T) + sizeof(UInt32));
+    const size_t for_size = for_bits <= MAX_PACKED_BITS //
+        ? BLOCK_HEADER_SIZE + sizeof(UInt64) + 1 + bitPackedSize(n, for_bits)
+        : std::numeric_limits<size_t>::max();
+    const size_t delta_size = delta_bits <= MAX_PACKED_BITS //
+        ? BLOCK_HEADER_SIZE + sizeof(UInt64) * 2 + 1 + bitPackedSize(n - 1, delta_bits)
+        : std::numeric_limits<size_t>::max();
+
+    const size_t compressed_size = std::min({rle_size, for_size, delta_size});
+    if (compressed_size >= COMPRESSED_BLOCK_HEADER_SIZE + source_size)
+        return 0;
+
+    dest.resize(compressed_size);
+    dest[0] = static_cast<UInt8>(CompressionMethodByte::Lightweight);
+    unalignedStore<UInt32>(&dest[1], static_cast<UInt32>(compressed_size));
+    unalignedStore<UInt32>(&dest[5], static_cast<UInt32>(source_size));
+    dest[COMPRESSED_BLOCK_HEADER_SIZE] = sizeof(T);
+    char * pos = &dest[BLOCK_HEADER_SIZE];
+
+    if (compressed_size == rle_size)
+    {
+        dest[COMPRESSED_BLOCK_HEADER_SIZE + 1] = static_cast<UInt8>(LightweightEncoding::RLE);
+        unalignedStore<UInt32>(pos, static_cast<UInt32>(runs));
+        char * values = pos + sizeof(UInt32);
+        char * lengths = values + runs * sizeof(T);
+        size_t run = 0;
+        UInt32 length = 1;
+        for (size_t i = 1; i <= n; ++i)
+        {
+            if (i < n && value_at(i) == value_at(i - 1))
+            {
+                ++length;
+                continue;
+            }
+            unalignedStore<T>(values + run * sizeof(T), value_at(i - 1));
+            unalignedStore<UInt32>(lengths + run * sizeof(UInt32), length);
+            ++run;
+            length = 1;
+        }
+    }
+    else if (compressed_size == for_size)
+    {
+        dest[COMPRESSED_BLOCK_HEADER_SIZE + 1] = static_cast<UInt8>(LightweightEncoding::FOR);
+        unalignedStore<UInt64>(pos, static_cast<UInt64>(min_value));
+        pos[sizeof(UInt64)] = for_bits;
+        bitPack(
+            n,
+            for_bits,
+            [&](size_t i) { return static_cast<T>(value_at(i) - min_value); },
+            pos + sizeof(UInt64) + 1);
+    }
+    else
+    {
+        dest[COMPRESSED_BLOCK_HEADER_SIZE + 1] = static_cast<UInt8>(LightweightEncoding::DELTA_FOR);
+        unalignedStore<UInt64>(pos, static_cast<UInt64>(first));
+        unalignedStore<UInt64>(pos + sizeof(UInt64), static_cast<UInt64>(min_delta));
+        pos[sizeof(UInt64) * 2] = delta_bits;
+        bitPack(
+            n - 1,
+            delta_bits,
+            [&](size_t i) { return static_cast<T>(value_at(i + 1) - value_at(i) - min_delta); },
+            pos + sizeof(UInt64) * 2 + 1);
+    }
+    return compressed_size;
+}
+
+template <typename T>
+void decompressImpl(const char * source, size_t source_size, char * dest, size_t dest_size)
+{
+    const size_t n = dest_size / sizeof(T);
+    const auto encoding = static_cast<LightweightEncoding>(source[COMPRESSED_BLOCK_HEADER_SIZE + 1]);
+    const char * pos = source + BLOCK_HEADER_SIZE;
+    const char * end = source + source_size;
+    auto check_size = [&](size_t expected_size, bool exact) {
+        auto remaining = static_cast<size_t>(end - pos);
+        if (unlikely(exact ? remaining != expected_size : remaining < expected_size))
+            throw Exception("Cannot decompress lightweight encoded data: size mismatch", ErrorCodes::CANNOT_DECOMPRESS);
+    };
+
+    switch (encoding)
+    {
+    case LightweightEncoding::RLE:
+    {
+        check_size(sizeof(UInt32), false);
+        const auto runs = unalignedLoad<UInt32>(pos);
+        pos += sizeof(UInt32);
+        check_size(runs * (sizeof(T) + sizeof(UInt32)), true);
+        const char * values = pos;
+        const char * lengths = values + runs * sizeof(T);
+        size_t offset = 0;
+        for (size_t run = 0; run < runs; ++run)
+        {
+            const T value = unalignedLoad<T>(values + run * sizeof(T));
+            const auto length = unalignedLoad<UInt32>(lengths + run * sizeof(UInt32));
+            if (unlikely(offset + length > n))
+                throw Exception("Cannot decompress lightweight encoded data: too many rows", ErrorCodes::CANNOT_DECOMPRESS);
+            for (size_t i = offset; i < offset + length; ++i)
+                unalignedStore<T>(dest + i * sizeof(T), value);
+            offset += length;
+        }
+        if (unlikely(offset != n))
+            throw Exception("Cannot decompress lightweight encoded data: too few rows", ErrorCodes::CANNOT_DECOMPRESS);
+        break;
+    }
+    case LightweightEncoding::FOR:
+    {
+        check_size(sizeof(UInt64) + 1, false);
+        const auto base = static_cast<T>(unalignedLoad<UInt64>(pos));
+        const UInt8 bits = pos[sizeof(UInt64)];
+        if (unlikely(bits > MAX_PACKED_BITS))
+            throw Exception("Cannot decompress lightweight encoded data: invalid bit width", ErrorCodes::CANNOT_DECOMPRESS);
+        pos += sizeof(UInt64) + 1;
+        check_size(bitPackedSize(n, bits), true);
+        const UInt64 mask = bits == 0 ? 0 : (~0ULL >> (64 - bits));
+        for (size_t i = 0; i < n; ++i)
+            unalignedStore<T>(dest + i * sizeof(T), static_cast<T>(base + bitUnpack<T>(pos, i, bits, mask)));
+        break;
+    }
+    case LightweightEncoding::DELTA_FOR:
+    {
+        check_size(sizeof(UInt64) * 2 + 1, false);
+        auto value = static_cast<T>(unalignedLoad<UInt64>(pos));
+        const auto min_delta = static_cast<T>(unalignedLoad<UInt64>(pos + sizeof(UInt64)));
+        const UInt8 bits = pos[sizeof(UInt64) * 2];
+        if (unlikely(bits > MAX_PACKED_BITS))
+            throw Exception("Cannot decompress lightweight encoded data: invalid bit width", ErrorCodes::CANNOT_DECOMPRESS);
+        pos += sizeof(UInt64) * 2 + 1;
+        check_size(bitPackedSize(n - 1, bits), true);
+        const UInt64 mask = bits == 0 ? 0 : (~0ULL >> (64 - bits));
+        unalignedStore<T>(dest, value);
+        for (size_t i = 1; i < n; ++i)
+        {
+            value = static_cast<T>(value + min_delta + bitUnpack<T>(pos, i - 1, bits, mask));
+            unalignedStore<T>(dest + i * sizeof(T), value);
+        }
+        break;
+    }
+    default:
+        throw Exception("Cannot decompress lightweight encoded data: unknown encoding " + std::to_string(static_cast<UInt8>(encoding)), ErrorCodes::CANNOT_DECOMPRESS);
+    }
+}
+
+} // namespace
+
+size_t compressLightweight(const char * source, size_t source_size, CompressionDataType data_type, PODArray<char> & dest)
+{
+    const auto width = static_cast<size_t>(data_type);
+    if (width == 0 || source_size == 0 || source_size % width != 0)
+        return 0;
+
+    switch (data_type)
+    {
+    case CompressionDataType::Int8:
+        return compressImpl<UInt8>(source, source_size, dest);
+    case CompressionDataType::Int16:
+        return compressImpl<UInt16>(source, source_size, dest);
+    case CompressionDataType::Int32:
+        return compressImpl<UInt32>(source, source_size, dest);
+    case CompressionDataType::Int64:
+        return compressImpl<UInt64>(source, source_size, dest);
+    default:
+        return 0;
+    }
+}
+
+void decompressLightweight(const char * source, size_t source_size, char * dest, size_t dest_size)
+{
+    if (unlikely(source_size < BLOCK_HEADER_SIZE))
+        throw Exception("Cannot decompress lightweight encoded data: block is too small", ErrorCodes::CANNOT_DECOMPRESS);
+
+    const UInt8 width = source[COMPRESSED_BLOCK_HEADER_SIZE];
+    if (unlikely(width == 0 || dest_size == 0 || dest_size % width != 0))
+        throw Exception("Cannot decompress lightweight encoded data: size mismatch", ErrorCodes::CANNOT_DECOMPRESS);
+
+    switch (width)
+    {
+    case 1:
+        decompressImpl<UInt8>(source, source_size, dest, dest_size);
+        break;
+    case 2:
+        decompressImpl<UInt16>(source, source_size, dest, dest_size);
+        break;
+    case 4:
+        decompressImpl<UInt32>(source, source_size, dest, dest_size);
+        break;
+    case 8:
+        decompressImpl<UInt64>(source, source_size, dest, dest_size);
+        break;
+    default:
+        throw Exception("Cannot decompress lightweight encoded data: unknown integer size " + std::to_string(width), ErrorCodes::CANNOT_DECOMPRESS);
+    }
+}
+
+} // namespace DB
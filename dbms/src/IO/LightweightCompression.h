@@ -0,0 +1,43 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/PODArray.h>
+#include <IO/CompressedStream.h>
+
+namespace DB
+{
+/** Lightweight encodings of fixed size integers, they compress the timestamps, the sorted handles,
+  * the versions and the delete marks far better than the general compression methods, and decoding
+  * them is just a few tight loops without any branch.
+  *
+  * The compressed block is the common 9 bytes header (see CompressedStream.h) followed by:
+  *   1 byte - the size of an integer.
+  *   1 byte - the encoding:
+  *     RLE       - UInt32 number of runs, then the value of every run, then the UInt32 length of every run.
+  *     FOR       - UInt64 base, UInt8 bit width, then every value minus base in bit-packed.
+  *     DELTA_FOR - UInt64 first value, UInt64 min delta, UInt8 bit width, then every delta minus min delta in bit-packed.
+  * The bit-packed data is followed by 8 bytes padding, so that every value can be decoded by one unaligned load.
+  * All the integers are processed as unsigned integers and the subtractions wrap around.
+  */
+
+/// Compress `source_size` bytes of integers into `dest` with the encoding of the minimal size.
+/// Returns the size of the compressed block, or 0 if no encoding can be applied or compresses the data.
+size_t compressLightweight(const char * source, size_t source_size, CompressionDataType data_type, PODArray<char> & dest);
+
+/// Decompress the compressed block which is `source_size` bytes into `dest`.
+void decompressLightweight(const char * source, size_t source_size, char * dest, size_t dest_size);
+
+} // namespace DB
@@ -15,8 +15,8 @@
 #pragma once
 
 #include <Common/HashTable/Hash.h>
-#include <Common/LRUCache.h>
 #include <Common/ProfileEvents.h>
+#include <Common/ShardedCache.h>
 #include <Common/SipHash.h>
 #include <IO/BufferWithOwnMemory.h>
 
@@ -43,14 +43,14 @@ struct UncompressedSizeWeightFunction
 
 /** Cache of decompressed blocks for implementation of CachedCompressedReadBuffer. thread-safe.
   */
-class UncompressedCache : public LRUCache<UInt128, UncompressedCacheCell, TrivialHash, UncompressedSizeWeightFunction>
+class UncompressedCache : public ShardedCache<UInt128, UncompressedCacheCell, TrivialHash, UncompressedSizeWeightFunction>
 {
 private:
-    using Base = LRUCache<UInt128, UncompressedCacheCell, TrivialHash, UncompressedSizeWeightFunction>;
+    using Base = ShardedCache<UInt128, UncompressedCacheCell, TrivialHash, UncompressedSizeWeightFunction>;
 
 public:
-    UncompressedCache(size_t max_size_in_bytes)
-        : Base(max_size_in_bytes)
+    explicit UncompressedCache(size_t max_size_in_bytes, const CacheOptions & options = {})
+        : Base(max_size_in_bytes, options)
     {}
 
     /// Calculate key from path to file and offset.
@@ -0,0 +1,118 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <IO/CompressedReadBuffer.h>
+#include <IO/CompressedWriteBuffer.h>
+#include <IO/LightweightCompression.h>
+#include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromString.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <random>
+
+namespace DB
+{
+namespace tests
+{
+namespace
+{
+template <typename T>
+std::pair<String, UInt8> compressAndCheck(const std::vector<T> & values)
+{
+    CompressionSettings settings(CompressionMethod::LZ4);
+    settings.data_type = static_cast<CompressionDataType>(sizeof(T));
+
+    WriteBufferFromOwnString out;
+    {
+        CompressedWriteBuffer<> compressed_out(out, settings);
+        compressed_out.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+        compressed_out.next();
+    }
+    String compressed = out.str();
+
+    ReadBufferFromString in(compressed);
+    CompressedReadBuffer<> compressed_in(in);
+    std::vector<T> decompressed(values.size());
+    compressed_in.readStrict(reinterpret_cast<char *>(decompressed.data()), decompressed.size() * sizeof(T));
+    EXPECT_TRUE(compressed_in.eof());
+    EXPECT_EQ(decompressed, values);
+
+    // The method byte is after the 16 bytes checksum.
+    return {compressed, static_cast<UInt8>(compressed[16])};
+}
+} // namespace
+
+TEST(LightweightCompressionTest, Encodings)
+{
+    std::mt19937_64 rand_gen(42);
+    constexpr auto lightweight = static_cast<UInt8>(CompressionMethodByte::Lightweight);
+
+    // Sorted handles are encoded by DELTA_FOR.
+    std::vector<Int64> handles;
+    for (Int64 i = 0; i < 8192; ++i)
+        handles.push_back(-1000 + i * 3 + static_cast<Int64>(rand_gen() % 2));
+    auto [handles_compressed, handles_method] = compressAndCheck(handles);
+    ASSERT_EQ(handles_method, lightweight);
+    ASSERT_LT(handles_compressed.size(), handles.size() * sizeof(Int64) / 16);
+
+    // Versions in a small range are encoded by FOR.
+    std::vector<UInt64> versions;
+    for (size_t i = 0; i < 8192; ++i)
+        versions.push_back(440000000000000000ULL + rand_gen() % 100000);
+    auto [versions_compressed, versions_method] = compressAndCheck(versions);
+    ASSERT_EQ(versions_method, lightweight);
+    ASSERT_LT(versions_compressed.size(), versions.size() * sizeof(UInt64) / 3);
+
+    // Delete marks without any deleted rows are encoded by RLE.
+    std::vector<UInt8> del_marks(8192, 0);
+    auto [del_marks_compressed, del_marks_method] = compressAndCheck(del_marks);
+    ASSERT_EQ(del_marks_method, lightweight);
+
+    // Delete marks with a few deleted rows could be encoded by either method.
+    for (size_t i = 0; i < 10; ++i)
+        del_marks[rand_gen() % del_marks.size()] = 1;
+    compressAndCheck(del_marks);
+
+    // Fallback to the general compression method when the lightweight encodings do not help.
+    std::vector<UInt32> random_values;
+    for (size_t i = 0; i < 8192; ++i)
+        random_values.push_back(rand_gen());
+    auto [random_compressed, random_method] = compressAndCheck(random_values);
+    ASSERT_EQ(random_method, static_cast<UInt8>(CompressionMethodByte::LZ4));
+}
+
+TEST(LightweightCompressionTest, Random)
+{
+    std::mt19937_64 rand_gen(42);
+    for (size_t round = 0; round < 1000; ++round)
+    {
+        const size_t rows = rand_gen() % 1000 + 1;
+        const UInt16 base = rand_gen();
+        const size_t bits = rand_gen() % 16;
+        std::vector<UInt16> values;
+        for (size_t i = 0; i < rows; ++i)
+            values.push_back(rand_gen() % 8 == 0 ? rand_gen() : base + rand_gen() % (1 << bits));
+
+        PODArray<char> compressed;
+        size_t compressed_size = compressLightweight(reinterpret_cast<const char *>(values.data()), rows * sizeof(UInt16), CompressionDataType::Int16, compressed);
+        if (compressed_size == 0)
+            continue;
+        std::vector<UInt16> decompressed(rows);
+        decompressLightweight(compressed.data(), compressed_size, reinterpret_cast<char *>(decompressed.data()), rows * sizeof(UInt16));
+        ASSERT_EQ(decompressed, values);
+    }
+}
+
+} // namespace tests
+} // namespace DB
@@ -2115,6 +2115,121 @@ ManyAggregatedDataVariants Aggregator::prepareVariantsToMerge(ManyAggregatedData
 }
 
 
+MergingBuckets::MergingBuckets(const Aggregator & aggregator_, const ManyAggregatedDataVariants & data_, bool final_, size_t concurrency_)
+    : aggregator(aggregator_)
+    , data(data_)
+    , final(final_)
+    , concurrency(concurrency_)
+{
+    assert(concurrency > 0);
+    /// The buckets are merged without the limit of keys, so `group_by_overflow_mode` = 'any' is not supported,
+    ///  see `AggregationInterpreterHelper::getParallelMergeConcurrency`.
+    RUNTIME_CHECK(aggregator.params.max_rows_to_group_by == 0 || aggregator.params.group_by_overflow_mode != OverflowMode::ANY);
+    /// Every concurrency index uses its own arena in the first data item.
+    if (!data.empty() && concurrency > data[0]->aggregates_pools.size())
+    {
+        Arenas & first_pool = data[0]->aggregates_pools;
+        for (size_t j = first_pool.size(); j < concurrency; ++j)
+            first_pool.emplace_back(std::make_shared<Arena>());
+    }
+}
+
+Block MergingBuckets::getData(size_t concurrency_index)
+{
+    assert(concurrency_index < concurrency);
+
+    if (data.empty())
+        return {};
+
+    FAIL_POINT_TRIGGER_EXCEPTION(FailPoints::random_aggregate_merge_failpoint);
+
+    AggregatedDataVariantsPtr & first = data[0];
+
+    if (concurrency_index == 0)
+    {
+        /// The first data item uses `aggregates_pools[0]` for `without_key`, which is also the arena of `concurrency_index` 0.
+        if (!is_without_key_merged)
+        {
+            is_without_key_merged = true;
+            if (first->type == AggregatedDataVariants::Type::without_key || aggregator.params.overflow_row)
+            {
+                aggregator.mergeWithoutKeyDataImpl(data);
+                return aggregator.prepareBlockAndFillWithoutKey(
+                    *first,
+                    final,
+                    first->type != AggregatedDataVariants::Type::without_key);
+            }
+        }
+
+        if (!first->isTwoLevel())
+        {
+            if (is_single_level_merged || first->type == AggregatedDataVariants::Type::without_key)
+                return {};
+            is_single_level_merged = true;
+
+#define M(NAME)                                                                 \
+    case AggregationMethodType(NAME):                                           \
+    {                                                                           \
+        aggregator.mergeSingleLevelDataImpl<AggregationMethodName(NAME)>(data); \
+        break;                                                                  \
+    }
+            switch (first->type)
+            {
+                APPLY_FOR_VARIANTS_SINGLE_LEVEL(M)
+            default:
+                throw Exception("Unknown aggregated data variant.", ErrorCodes::UNKNOWN_AGGREGATED_DATA_VARIANT);
+            }
+#undef M
+            return aggregator.prepareBlockAndFillSingleLevel(*first, final);
+        }
+    }
+
+    if (!first->isTwoLevel())
+        return {};
+
+    while (true)
+    {
+        Int32 bucket_num = current_bucket_num.fetch_add(1);
+        if (bucket_num >= NUM_BUCKETS)
+            return {};
+
+        /// Skip the empty buckets, so that an empty block always means the end of data.
+        Block block = mergeAndConvertBucket(concurrency_index, bucket_num);
+        if (block.rows() > 0)
+            return block;
+    }
+}
+
+Block MergingBuckets::mergeAndConvertBucket(size_t concurrency_index, Int32 bucket_num)
+{
+    auto & merged_data = *data[0];
+    Arena * arena = merged_data.aggregates_pools.at(concurrency_index).get();
+    Block block;
+
+#define M(NAME)                                                                           \
+    case AggregationMethodType(NAME):                                                     \
+    {                                                                                     \
+        aggregator.mergeBucketImpl<AggregationMethodName(NAME)>(data, bucket_num, arena); \
+        block = aggregator.convertOneBucketToBlock(                                       \
+            merged_data,                                                                  \
+            *ToAggregationMethodPtr(NAME, merged_data.aggregation_method_impl),           \
+            arena,                                                                        \
+            final,                                                                        \
+            bucket_num);                                                                  \
+        break;                                                                            \
+    }
+    switch (merged_data.type)
+    {
+        APPLY_FOR_VARIANTS_TWO_LEVEL(M)
+    default:
+        break;
+    }
+#undef M
+
+    return block;
+}
+
+
 template <bool no_more_keys, typename Method, typename Table>
 void NO_INLINE Aggregator::mergeStreamsImplCase(
     Block & block,
@@ -39,6 +39,7 @@
 #include <common/StringRef.h>
 #include <common/logger_useful.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -1078,6 +1079,7 @@ public:
 protected:
     friend struct AggregatedDataVariants;
     friend class MergingAndConvertingBlockInputStream;
+    friend class MergingBuckets;
 
     Params params;
 
@@ -1327,6 +1329,43 @@ protected:
     bool checkLimits(size_t result_size, bool & no_more_keys) const;
 };
 
+/** Merges the aggregated data and converts it to blocks, for several output streams reading in parallel.
+  * Unlike MergingAndConvertingBlockInputStream, the blocks of a two-level data are not returned in the order of buckets.
+  *  Every caller takes the next bucket not taken yet, merges and converts it in its own thread with its own arena,
+  *  so the callers never wait for each other, and the parallelism is the number of the output streams.
+  * The data without key, the overflow row and the single-level data can not be split, they are returned by
+  *  `concurrency_index` 0 only.
+  * The input is the result of `Aggregator::prepareVariantsToMerge`.
+  */
+class MergingBuckets
+{
+public:
+    MergingBuckets(const Aggregator & aggregator_, const ManyAggregatedDataVariants & data_, bool final_, size_t concurrency_);
+
+    /// Thread safe for different `concurrency_index`. Return an empty block if there is no more data for it.
+    Block getData(size_t concurrency_index);
+
+    size_t getConcurrency() const { return concurrency; }
+
+private:
+    Block mergeAndConvertBucket(size_t concurrency_index, Int32 bucket_num);
+
+    static constexpr Int32 NUM_BUCKETS = 256;
+
+    const Aggregator & aggregator;
+    ManyAggregatedDataVariants data;
+    const bool final;
+    const size_t concurrency;
+
+    /// Only accessed by `concurrency_index` 0.
+    bool is_without_key_merged = false;
+    bool is_single_level_merged = false;
+
+    std::atomic<Int32> current_bucket_num{0};
+};
+
+using MergingBucketsPtr = std::shared_ptr<MergingBuckets>;
+
 /** Get the aggregation variant by its type. */
 template <typename Method>
 Method & getDataVariant(AggregatedDataVariants & variants);
@@ -21,6 +21,7 @@
 #include <IO/UncompressedCache.h>
 #include <Interpreters/AsynchronousMetrics.h>
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
+#include <Storages/DeltaMerge/File/DMFilePackCache.h>
 #include <Storages/DeltaMerge/StoragePool.h>
 #include <Storages/MarkCache.h>
 #include <Storages/Page/FileUsage.h>
@@ -119,6 +120,15 @@ static void calculateMaxAndSum(Max & max, Sum & sum, T x)
         max = x;
 }
 
+/// The hit ratio of the cache since started
+template <typename Cache>
+static double cacheHitRatio(const Cache & cache)
+{
+    size_t hits = 0, misses = 0;
+    cache.getStats(hits, misses);
+    return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / (hits + misses);
+}
+
 FileUsageStatistics AsynchronousMetrics::getPageStorageFileUsage()
 {
     // Get from RegionPersister
@@ -147,6 +157,7 @@ void AsynchronousMetrics::update()
         {
             set("MarkCacheBytes", mark_cache->weight());
             set("MarkCacheFiles", mark_cache->count());
+            set("MarkCacheHitRatio", cacheHitRatio(*mark_cache));
         }
     }
 
@@ -155,6 +166,17 @@ void AsynchronousMetrics::update()
         {
             set("MinMaxIndexCacheBytes", min_max_cache->weight());
             set("MinMaxIndexFiles", min_max_cache->count());
+            set("MinMaxIndexCacheHitRatio", cacheHitRatio(*min_max_cache));
+        }
+        if (auto equal_cache = context.getEqualIndexCache())
+        {
+            set("EqualIndexCacheBytes", equal_cache->weight());
+            set("EqualIndexFiles", equal_cache->count());
+        }
+        if (auto pack_cache = context.getDMFilePackCache())
+        {
+            set("DMFilePackCacheBytes", pack_cache->weight());
+            set("DMFilePackCacheCells", pack_cache->count());
         }
     }
 
@@ -163,6 +185,7 @@ void AsynchronousMetrics::update()
         {
             set("UncompressedCacheBytes", uncompressed_cache->weight());
             set("UncompressedCacheCells", uncompressed_cache->count());
+            set("UncompressedCacheHitRatio", cacheHitRatio(*uncompressed_cache));
         }
     }
 
@@ -50,6 +50,8 @@
 #include <Poco/UUID.h>
 #include <Storages/BackgroundProcessingPool.h>
 #include <Storages/DeltaMerge/DeltaIndexManager.h>
+#include <Storages/DeltaMerge/File/DMFilePackCache.h>
+#include <Storages/DeltaMerge/Index/EqualIndex.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
 #include <Storages/DeltaMerge/StoragePool.h>
 #include <Storages/IStorage.h>
@@ -139,6 +141,8 @@ struct ContextShared
     mutable DBGInvoker dbg_invoker; /// Execute inner functions, debug only.
     mutable MarkCachePtr mark_cache; /// Cache of marks in compressed files.
     mutable DM::MinMaxIndexCachePtr minmax_index_cache; /// Cache of minmax index in compressed files.
+    mutable DM::EqualIndexCachePtr equal_index_cache; /// Cache of equal index in DMFiles.
+    mutable DM::DMFilePackCachePtr dmfile_pack_cache; /// Cache of decompressed column packs in DMFiles.
     mutable DM::DeltaIndexManagerPtr delta_index_manager; /// Manage the Delta Indies of Segments.
     ProcessList process_list; /// Executing queries at the moment.
     ViewDependencies view_dependencies; /// Current dependencies
@@ -1231,14 +1235,14 @@ DAGContext * Context::getDAGContext() const
     return dag_context;
 }
 
-void Context::setUncompressedCache(size_t max_size_in_bytes)
+void Context::setUncompressedCache(size_t max_size_in_bytes, const CacheOptions & options)
 {
     auto lock = getLock();
 
     if (shared->uncompressed_cache)
         throw Exception("Uncompressed cache has been already created.", ErrorCodes::LOGICAL_ERROR);
 
-    shared->uncompressed_cache = std::make_shared<UncompressedCache>(max_size_in_bytes);
+    shared->uncompressed_cache = std::make_shared<UncompressedCache>(max_size_in_bytes, options);
 }
 
 
@@ -1269,14 +1273,14 @@ TMTContext & Context::getTMTContext() const
     return *(shared->tmt_context);
 }
 
-void Context::setMarkCache(size_t cache_size_in_bytes)
+void Context::setMarkCache(size_t cache_size_in_bytes, const CacheOptions & options)
 {
     auto lock = getLock();
 
     if (shared->mark_cache)
         throw Exception("Mark cache has been already created.", ErrorCodes::LOGICAL_ERROR);
 
-    shared->mark_cache = std::make_shared<MarkCache>(cache_size_in_bytes);
+    shared->mark_cache = std::make_shared<MarkCache>(cache_size_in_bytes, options);
 }
 
 
@@ -1295,14 +1299,14 @@ void Context::dropMarkCache() const
 }
 
 
-void Context::setMinMaxIndexCache(size_t cache_size_in_bytes)
+void Context::setMinMaxIndexCache(size_t cache_size_in_bytes, const CacheOptions & options)
 {
     auto lock = getLock();
 
     if (shared->minmax_index_cache)
         throw Exception("Minmax index cache has been already created.", ErrorCodes::LOGICAL_ERROR);
 
-    shared->minmax_index_cache = std::make_shared<DM::MinMaxIndexCache>(cache_size_in_bytes);
+    shared->minmax_index_cache = std::make_shared<DM::MinMaxIndexCache>(cache_size_in_bytes, options);
 }
 
 DM::MinMaxIndexCachePtr Context::getMinMaxIndexCache() const
@@ -1318,6 +1322,52 @@ void Context::dropMinMaxIndexCache() const
         shared->minmax_index_cache->reset();
 }
 
+void Context::setEqualIndexCache(size_t cache_size_in_bytes)
+{
+    auto lock = getLock();
+
+    if (shared->equal_index_cache)
+        throw Exception("Equal index cache has been already created.", ErrorCodes::LOGICAL_ERROR);
+
+    shared->equal_index_cache = std::make_shared<DM::EqualIndexCache>(cache_size_in_bytes);
+}
+
+DM::EqualIndexCachePtr Context::getEqualIndexCache() const
+{
+    auto lock = getLock();
+    return shared->equal_index_cache;
+}
+
+void Context::dropEqualIndexCache() const
+{
+    auto lock = getLock();
+    if (shared->equal_index_cache)
+        shared->equal_index_cache->reset();
+}
+
+void Context::setDMFilePackCache(size_t cache_size_in_bytes)
+{
+    auto lock = getLock();
+
+    if (shared->dmfile_pack_cache)
+        throw Exception("DMFile pack cache has been already created.", ErrorCodes::LOGICAL_ERROR);
+
+    shared->dmfile_pack_cache = std::make_shared<DM::DMFilePackCache>(cache_size_in_bytes);
+}
+
+DM::DMFilePackCachePtr Context::getDMFilePackCache() const
+{
+    auto lock = getLock();
+    return shared->dmfile_pack_cache;
+}
+
+void Context::dropDMFilePackCache() const
+{
+    auto lock = getLock();
+    if (shared->dmfile_pack_cache)
+        shared->dmfile_pack_cache->reset();
+}
+
 bool Context::isDeltaIndexLimited() const
 {
     // Don't need to use a lock here, as delta_index_manager should be set at starting up.
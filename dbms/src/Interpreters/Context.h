@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <Common/CacheOptions.h>
 #include <Core/ColumnsWithTypeAndName.h>
 #include <Core/Types.h>
 #include <Debug/MockServerInfo.h>
@@ -104,6 +105,8 @@ enum class PageStorageRunMode : UInt8;
 namespace DM
 {
 class MinMaxIndexCache;
+class EqualIndexCache;
+class DMFilePackCache;
 class DeltaIndexManager;
 class GlobalStoragePool;
 using GlobalStoragePoolPtr = std::shared_ptr<GlobalStoragePool>;
@@ -350,7 +353,7 @@ public:
     const ProcessList & getProcessList() const;
 
     /// Create a cache of uncompressed blocks of specified size. This can be done only once.
-    void setUncompressedCache(size_t max_size_in_bytes);
+    void setUncompressedCache(size_t max_size_in_bytes, const CacheOptions & options = {});
     std::shared_ptr<UncompressedCache> getUncompressedCache() const;
     void dropUncompressedCache() const;
 
@@ -360,14 +363,22 @@ public:
     TMTContext & getTMTContext() const;
 
     /// Create a cache of marks of specified size. This can be done only once.
-    void setMarkCache(size_t cache_size_in_bytes);
+    void setMarkCache(size_t cache_size_in_bytes, const CacheOptions & options = {});
     std::shared_ptr<MarkCache> getMarkCache() const;
     void dropMarkCache() const;
 
-    void setMinMaxIndexCache(size_t cache_size_in_bytes);
+    void setMinMaxIndexCache(size_t cache_size_in_bytes, const CacheOptions & options = {});
     std::shared_ptr<DM::MinMaxIndexCache> getMinMaxIndexCache() const;
     void dropMinMaxIndexCache() const;
 
+    void setEqualIndexCache(size_t cache_size_in_bytes);
+    std::shared_ptr<DM::EqualIndexCache> getEqualIndexCache() const;
+    void dropEqualIndexCache() const;
+
+    void setDMFilePackCache(size_t cache_size_in_bytes);
+    std::shared_ptr<DM::DMFilePackCache> getDMFilePackCache() const;
+    void dropDMFilePackCache() const;
+
     bool isDeltaIndexLimited() const;
     void setDeltaIndexManager(size_t cache_size_in_bytes);
     std::shared_ptr<DM::DeltaIndexManager> getDeltaIndexManager() const;
@@ -16,21 +16,37 @@
 #include <Columns/ColumnFixedString.h>
 #include <Columns/ColumnNullable.h>
 #include <Columns/ColumnString.h>
+#include <Common/ClickHouseRevision.h>
 #include <Common/ColumnsHashing.h>
 #include <Common/FailPoint.h>
+#include <Common/ProfileEvents.h>
+#include <Common/Stopwatch.h>
 #include <Common/typeid_cast.h>
 #include <Core/ColumnNumbers.h>
 #include <DataStreams/IProfilingBlockInputStream.h>
+#include <DataStreams/NativeBlockOutputStream.h>
+#include <DataStreams/TemporaryFileStream.h>
 #include <DataStreams/materializeBlock.h>
 #include <DataTypes/DataTypeNullable.h>
 #include <DataTypes/DataTypesNumber.h>
+#include <Encryption/WriteBufferFromFileProvider.h>
 #include <Flash/Mpp/HashBaseWriterHelper.h>
 #include <Functions/FunctionHelpers.h>
+#include <IO/CompressedWriteBuffer.h>
 #include <Interpreters/Join.h>
 #include <Interpreters/NullableUtils.h>
+#include <Poco/TemporaryFile.h>
+#include <Storages/DeltaMerge/Filter/RuntimeFilter.h>
 #include <common/logger_useful.h>
 
 
+namespace ProfileEvents
+{
+extern const Event ExternalJoinSpillBuild;
+extern const Event ExternalJoinRestorePartition;
+extern const Event ExternalJoinOversizedPartition;
+} // namespace ProfileEvents
+
 namespace DB
 {
 namespace FailPoints
@@ -91,6 +107,49 @@ void convertColumnToNullable(ColumnWithTypeAndName & column)
         column.column = makeNullable(column.column);
 }
 
+/// A temporary file that the blocks of one side of a spilled partition are written to.
+struct SpillFile
+{
+    SpillFile(const String & tmp_path, const FileProviderPtr & file_provider_, const Block & header)
+        : file_provider(file_provider_)
+        , path(Poco::TemporaryFile::tempName(tmp_path))
+        , file_buf(file_provider, path, EncryptionPath(path, ""))
+        , compressed_buf(file_buf)
+        , block_out(compressed_buf, ClickHouseRevision::get(), header)
+    {}
+
+    ~SpillFile()
+    {
+        try
+        {
+            /// Remove the file through file provider, so its encryption info is removed too.
+            file_provider->deleteRegularFile(path, EncryptionPath(path, ""));
+        }
+        catch (...)
+        {
+            tryLogCurrentException(__PRETTY_FUNCTION__);
+        }
+    }
+
+    void write(const Block & block)
+    {
+        block_out.write(block);
+    }
+
+    void finish()
+    {
+        block_out.flush();
+        compressed_buf.next();
+        file_buf.next();
+    }
+
+    FileProviderPtr file_provider;
+    String path;
+    WriteBufferFromFileProvider file_buf;
+    CompressedWriteBuffer<> compressed_buf;
+    NativeBlockOutputStream block_out;
+};
+
 ColumnRawPtrs getKeyColumns(const Names & key_names, const Block & block)
 {
     size_t keys_size = key_names.size();
@@ -109,6 +168,14 @@ ColumnRawPtrs getKeyColumns(const Names & key_names, const Block & block)
 }
 } // namespace
 
+struct Join::SpilledPartition
+{
+    std::mutex mutex;
+    /// Created lazily by the first block of each side, nullptr means the side of this partition is empty.
+    std::unique_ptr<SpillFile> build_file;
+    std::unique_ptr<SpillFile> probe_file;
+};
+
 const std::string Join::match_helper_prefix = "__left-semi-join-match-helper";
 const DataTypePtr Join::match_helper_type = makeNullable(std::make_shared<DataTypeInt8>());
 
@@ -129,7 +196,8 @@ Join::Join(
     const String & other_eq_filter_from_in_column_,
     ExpressionActionsPtr other_condition_ptr_,
     size_t max_block_size_,
-    const String & match_helper_name)
+    const String & match_helper_name,
+    const JoinSpillConfig & spill_config_)
     : match_helper_name(match_helper_name)
     , kind(kind_)
     , strictness(strictness_)
@@ -145,6 +213,7 @@ Join::Join(
     , other_condition_ptr(other_condition_ptr_)
     , original_strictness(strictness)
     , max_block_size_for_cross_join(max_block_size_)
+    , spill_config(spill_config_)
     , build_table_state(BuildTableState::SUCCEED)
     , log(Logger::get(req_id))
     , enable_fine_grained_shuffle(enable_fine_grained_shuffle_)
@@ -162,16 +231,44 @@ Join::Join(
         throw Exception("Not supported: non left join with left conditions");
     if (unlikely(!right_filter_column.empty() && !isRightJoin(kind)))
         throw Exception("Not supported: non right join with right conditions");
+    if (isSpillEnabled() && unlikely(spill_config.partition_num == 0 || !spill_config.file_provider))
+        throw Exception("Logical error: grace hash join requires partition_num > 0 and a file provider", ErrorCodes::LOGICAL_ERROR);
     LOG_DEBUG(log, "FineGrainedShuffle flag {}, stream count {}", enable_fine_grained_shuffle, fine_grained_shuffle_count);
 }
 
+Join::~Join() = default;
+
 void Join::setBuildTableState(BuildTableState state_)
 {
+    if (state_ == BuildTableState::SUCCEED)
+    {
+        /// All the "right" blocks have been inserted, make the spilled ones readable.
+        std::shared_lock lock(rwlock);
+        if (spilled)
+        {
+            for (auto & partition : spilled_partitions)
+            {
+                if (partition->build_file)
+                    partition->build_file->finish();
+            }
+            LOG_INFO(log, "Build side of join is spilled into {} partitions, {} rows in total", spilled_partitions.size(), total_input_build_rows.load());
+        }
+    }
+    if (state_ == BuildTableState::SUCCEED)
+    {
+        for (const auto & runtime_filter : runtime_filters)
+            runtime_filter->finish();
+    }
     std::lock_guard lk(build_table_mutex);
     build_table_state = state_;
     build_table_cv.notify_all();
 }
 
+bool Join::isSpillEnabled() const
+{
+    return spill_config.max_bytes_before_external_join > 0 && !isCrossJoin(kind);
+}
+
 bool CanAsColumnString(const IColumn * column)
 {
     return typeid_cast<const ColumnString *>(column)
@@ -523,6 +620,7 @@ void Join::init(const Block & sample_block, size_t build_concurrency_)
     /// Choose data structure to use for JOIN.
     initMapImpl(chooseMethod(getKeyColumns(key_names_right, sample_block), key_sizes));
     setSampleBlock(sample_block);
+    build_sample_block = sample_block.cloneEmpty();
 }
 
 namespace
@@ -840,6 +938,7 @@ void Join::insertFromBlock(const Block & block)
     if (unlikely(!initialized))
         throw Exception("Logical error: Join was not initialized", ErrorCodes::LOGICAL_ERROR);
     total_input_build_rows += block.rows();
+    updateRuntimeFilters(block);
     blocks.push_back(block);
     Block * stored_block = &blocks.back();
     insertFromBlockInternal(stored_block, 0);
@@ -854,15 +953,174 @@ void Join::insertFromBlock(const Block & block, size_t stream_index)
 
     if (unlikely(!initialized))
         throw Exception("Logical error: Join was not initialized", ErrorCodes::LOGICAL_ERROR);
+    updateRuntimeFilters(block);
+    if (spilled)
+    {
+        total_input_build_rows += block.rows();
+        spillBuildBlock(block);
+        return;
+    }
     Block * stored_block = nullptr;
     {
         std::lock_guard lk(blocks_lock);
         total_input_build_rows += block.rows();
+        total_input_build_bytes += block.bytes();
         blocks.push_back(block);
         stored_block = &blocks.back();
         original_blocks.push_back(block);
     }
     insertFromBlockInternal(stored_block, stream_index);
+
+    if (unlikely(needSpill()))
+    {
+        /// Upgrade to the unique lock, other threads may have spilled the data in the meantime.
+        lock.unlock();
+        std::unique_lock spill_lock(rwlock);
+        if (!spilled)
+            spillAllBuildData();
+    }
+}
+
+void Join::updateRuntimeFilters(const Block & block) const
+{
+    for (const auto & runtime_filter : runtime_filters)
+        runtime_filter->insertBuildKeys(block.getByName(runtime_filter->getBuildKeyName()));
+}
+
+bool Join::needSpill() const
+{
+    return isSpillEnabled() && !spilled
+        && total_input_build_bytes + getTotalByteCount() > spill_config.max_bytes_before_external_join;
+}
+
+Blocks Join::partitionBlockForSpill(const Block & block, const Names & key_names) const
+{
+    size_t rows = block.rows();
+    size_t partition_num = spill_config.partition_num;
+
+    /// Rows are partitioned by the same hash as the exchange, so the collation of keys is respected.
+    /// The hash is remixed before taking the modulo, because the rows received by this join
+    /// may have been selected by this hash already, see `HashBaseWriterHelper::scatterColumns`.
+    WeakHash32 hash(rows);
+    std::vector<String> sort_key_containers(key_names.size());
+    for (size_t i = 0; i < key_names.size(); ++i)
+    {
+        const auto & key_column = block.getByName(key_names[i]).column;
+        key_column->updateWeakHash32(hash, collators.empty() ? nullptr : collators[i], sort_key_containers[i]);
+    }
+
+    IColumn::Selector selector(rows);
+    const auto & hash_data = hash.getData();
+    for (size_t i = 0; i < rows; ++i)
+        selector[i] = intHashCRC32(hash_data[i]) % partition_num;
+
+    Blocks partitioned_blocks(partition_num);
+    for (auto & partitioned_block : partitioned_blocks)
+        partitioned_block = block.cloneEmpty();
+    for (size_t col = 0; col < block.columns(); ++col)
+    {
+        auto scattered_columns = block.getByPosition(col).column->scatter(partition_num, selector);
+        for (size_t i = 0; i < partition_num; ++i)
+            partitioned_blocks[i].getByPosition(col).column = std::move(scattered_columns[i]);
+    }
+    return partitioned_blocks;
+}
+
+void Join::spillBuildBlock(const Block & block)
+{
+    if (block.rows() == 0)
+        return;
+    Blocks partitioned_blocks = partitionBlockForSpill(materializeBlock(block), key_names_right);
+    for (size_t i = 0; i < partitioned_blocks.size(); ++i)
+    {
+        if (partitioned_blocks[i].rows() == 0)
+            continue;
+        auto & partition = *spilled_partitions[i];
+        std::lock_guard lk(partition.mutex);
+        if (!partition.build_file)
+            partition.build_file = std::make_unique<SpillFile>(spill_config.tmp_path, spill_config.file_provider, build_sample_block);
+        partition.build_file->write(partitioned_blocks[i]);
+    }
+}
+
+void Join::spillProbeBlock(const Block & block) const
+{
+    Block materialized_block = materializeBlock(block);
+    Blocks partitioned_blocks = partitionBlockForSpill(materialized_block, key_names_left);
+    for (size_t i = 0; i < partitioned_blocks.size(); ++i)
+    {
+        if (partitioned_blocks[i].rows() == 0)
+            continue;
+        auto & partition = *spilled_partitions[i];
+        std::lock_guard lk(partition.mutex);
+        if (!partition.probe_file)
+            partition.probe_file = std::make_unique<SpillFile>(spill_config.tmp_path, spill_config.file_provider, materialized_block.cloneEmpty());
+        partition.probe_file->write(partitioned_blocks[i]);
+    }
+}
+
+void Join::spillAllBuildData()
+{
+    Stopwatch watch;
+    size_t bytes_before_spill = total_input_build_bytes + getTotalByteCount();
+
+    for (size_t i = 0; i < spill_config.partition_num; ++i)
+        spilled_partitions.push_back(std::make_unique<SpilledPartition>());
+    for (const auto & block : original_blocks)
+        spillBuildBlock(block);
+
+    /// Release the in-memory hash table, the maps must be reset before the blocks they point to.
+    initMapImpl(type);
+    for (auto & pool : pools)
+        pool = std::make_shared<Arena>();
+    for (auto & rows_not_inserted : rows_not_inserted_to_map)
+        rows_not_inserted = std::make_unique<RowRefList>();
+    blocks.clear();
+    original_blocks.clear();
+    total_input_build_bytes = 0;
+    spilled = true;
+    ProfileEvents::increment(ProfileEvents::ExternalJoinSpillBuild);
+
+    LOG_INFO(
+        log,
+        "Spill build side of join into {} partitions in {:.3f} sec, {:.3f} MiB in memory before spilling",
+        spill_config.partition_num,
+        watch.elapsedSeconds(),
+        bytes_before_spill / 1048576.0);
+}
+
+void Join::finishSpilledProbe()
+{
+    std::call_once(finish_spilled_probe_flag, [this] {
+        for (auto & partition : spilled_partitions)
+        {
+            if (partition->probe_file)
+                partition->probe_file->finish();
+        }
+    });
+}
+
+JoinPtr Join::createJoinForSpilledPartition() const
+{
+    auto join = std::make_shared<Join>(
+        key_names_left,
+        key_names_right,
+        use_nulls,
+        kind,
+        original_strictness,
+        log->identifier(),
+        /*enable_fine_grained_shuffle_=*/false,
+        /*fine_grained_shuffle_count_=*/0,
+        collators,
+        left_filter_column,
+        right_filter_column,
+        other_filter_column,
+        other_eq_filter_from_in_column,
+        other_condition_ptr,
+        max_block_size_for_cross_join,
+        match_helper_name);
+    join->init(build_sample_block, 1);
+    return join;
 }
 
 void Join::insertFromBlockInternal(Block * stored_block, size_t stream_index)
@@ -1928,6 +2186,14 @@ void Join::joinBlock(Block & block) const
 
     checkTypesOfKeys(block, sample_block_with_keys);
 
+    if (spilled && block.rows() > 0)
+    {
+        /// The rows are joined later by the streams created by createStreamWithSpilledPartitions,
+        /// here just join an empty block to get the structure of result.
+        spillProbeBlock(block);
+        block = block.cloneEmpty();
+    }
+
     /// TODO: after we bumping to C++20, use `using enum` to simplify code here.
     /// using enum ASTTableJoin::Strictness;
     /// using enum ASTTableJoin::Kind;
@@ -2301,4 +2567,125 @@ BlockInputStreamPtr createStreamWithNonJoinedRows(const JoinPtr & parent, const
     return std::make_shared<NonJoinedBlockInputStream>(parent, left_sample_block, index, step, max_block_size);
 }
 
+
+/// Stream that joins the spilled partitions of the parent join one by one.
+class SpilledPartitionsBlockInputStream : public IProfilingBlockInputStream
+{
+public:
+    SpilledPartitionsBlockInputStream(const JoinPtr & parent_, const Block & left_sample_block_, size_t index_, size_t step_, size_t max_block_size_)
+        : parent(parent_)
+        , left_sample_block(left_sample_block_.cloneEmpty())
+        , step(step_)
+        , max_block_size(max_block_size_)
+        , next_partition(index_)
+    {
+        if (unlikely(step == 0))
+            throw Exception("The step of SpilledPartitionsBlockInputStream should be positive", ErrorCodes::LOGICAL_ERROR);
+        /// Same as the header of the joined "left" blocks.
+        header = left_sample_block.cloneEmpty();
+        parent->joinBlock(header);
+    }
+
+    String getName() const override { return "SpilledPartitions"; }
+
+    Block getHeader() const override { return header; }
+
+protected:
+    Block readImpl() override
+    {
+        if (!parent->isSpilled())
+            return {};
+
+        parent->finishSpilledProbe();
+        while (true)
+        {
+            if (probe_stream)
+            {
+                if (Block block = probe_stream->block_in->read())
+                {
+                    current_join->joinBlock(block);
+                    return block;
+                }
+                probe_stream.reset();
+                probe_file.reset();
+            }
+            if (non_joined_stream)
+            {
+                if (Block block = non_joined_stream->read())
+                    return block;
+                non_joined_stream.reset();
+            }
+            current_join.reset();
+
+            if (next_partition >= parent->spilled_partitions.size())
+                return {};
+            restorePartition(*parent->spilled_partitions[next_partition]);
+            next_partition += step;
+        }
+    }
+
+private:
+    const JoinPtr parent;
+    Block left_sample_block;
+    size_t step;
+    size_t max_block_size;
+    size_t next_partition;
+    Block header;
+
+    /// The states of the partition being joined.
+    JoinPtr current_join;
+    std::unique_ptr<SpillFile> probe_file;
+    std::unique_ptr<TemporaryFileStream> probe_stream;
+    BlockInputStreamPtr non_joined_stream;
+
+    void restorePartition(Join::SpilledPartition & partition)
+    {
+        bool need_non_joined = getFullness(parent->kind);
+        /// Without "left" rows, only RIGHT and FULL JOINs can produce rows from this partition.
+        if (!partition.probe_file && !need_non_joined)
+        {
+            partition.build_file.reset();
+            return;
+        }
+
+        current_join = parent->createJoinForSpilledPartition();
+        if (partition.build_file)
+        {
+            {
+                TemporaryFileStream build_stream(partition.build_file->path, parent->spill_config.file_provider);
+                while (Block block = build_stream.block_in->read())
+                    current_join->insertFromBlock(block, 0);
+            }
+            partition.build_file.reset();
+        }
+        ProfileEvents::increment(ProfileEvents::ExternalJoinRestorePartition);
+
+        /// The partitions are not spilled recursively, a skewed partition is joined in memory even if it is still too big.
+        size_t restored_bytes = current_join->total_input_build_bytes + current_join->getTotalByteCount();
+        if (restored_bytes > parent->spill_config.max_bytes_before_external_join)
+        {
+            ProfileEvents::increment(ProfileEvents::ExternalJoinOversizedPartition);
+            LOG_WARNING(
+                parent->log,
+                "Restored partition of join is still too big: {:.3f} MiB, max_bytes_before_external_join is {:.3f} MiB",
+                restored_bytes / 1048576.0,
+                parent->spill_config.max_bytes_before_external_join / 1048576.0);
+        }
+
+        if (partition.probe_file)
+        {
+            probe_file = std::move(partition.probe_file);
+            probe_stream = std::make_unique<TemporaryFileStream>(probe_file->path, parent->spill_config.file_provider);
+        }
+        if (need_non_joined)
+            non_joined_stream = createStreamWithNonJoinedRows(current_join, left_sample_block, 0, 1, max_block_size);
+    }
+};
+
+
+BlockInputStreamPtr createStreamWithSpilledPartitions(const JoinPtr & parent, const Block & left_sample_block, size_t index, size_t step, size_t max_block_size)
+{
+    return std::make_shared<SpilledPartitionsBlockInputStream>(parent, left_sample_block, index, step, max_block_size);
+}
+
 } // namespace DB
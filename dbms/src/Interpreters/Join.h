@@ -21,6 +21,7 @@
 #include <Common/HashTable/HashMap.h>
 #include <Common/Logger.h>
 #include <DataStreams/IBlockInputStream.h>
+#include <Encryption/FileProvider.h>
 #include <Interpreters/AggregationCommon.h>
 #include <Interpreters/ExpressionActions.h>
 #include <Interpreters/SettingsCommon.h>
@@ -32,6 +33,13 @@
 
 namespace DB
 {
+namespace DM
+{
+class RuntimeFilter;
+using RuntimeFilterPtr = std::shared_ptr<RuntimeFilter>;
+using RuntimeFilters = std::vector<RuntimeFilterPtr>;
+} // namespace DM
+
 class Join;
 using JoinPtr = std::shared_ptr<Join>;
 using Joins = std::vector<JoinPtr>;
@@ -42,6 +50,24 @@ using Joins = std::vector<JoinPtr>;
 */
 BlockInputStreamPtr createStreamWithNonJoinedRows(const JoinPtr & parent, const Block & left_sample_block, size_t index, size_t step, size_t max_block_size);
 
+/** For grace hash join.
+  * A stream that joins the spilled partitions one by one: it rebuilds the hash table of a partition from its spilled "right" blocks,
+  * then probes it with the spilled "left" blocks of the same partition and, for RIGHT and FULL JOINs, emits the non-joined rows.
+  * Use only after all calls to joinBlock was done, just like the stream of non-joined rows.
+  * Partitions are assigned to streams by `index` and `step`.
+  */
+BlockInputStreamPtr createStreamWithSpilledPartitions(const JoinPtr & parent, const Block & left_sample_block, size_t index, size_t step, size_t max_block_size);
+
+/// Settings of grace hash join, see `Join::spillAllBuildData`.
+struct JoinSpillConfig
+{
+    /// 0 means the build side is always kept in memory.
+    size_t max_bytes_before_external_join = 0;
+    size_t partition_num = 0;
+    String tmp_path;
+    FileProviderPtr file_provider;
+};
+
 
 /** Data structure for implementation of JOIN.
   * It is just a hash table: keys -> rows of joined ("right") table.
@@ -98,6 +124,16 @@ BlockInputStreamPtr createStreamWithNonJoinedRows(const JoinPtr & parent, const
   *  (zero, empty string, etc. and NULL for Nullable data types).
   * If it is true, we always generate Nullable column and substitute NULLs for non-joined rows,
   *  as in standard SQL.
+  *
+  * Grace hash join:
+  *
+  * If `max_bytes_before_external_join` is set and the built data grows beyond it, all the "right" blocks are
+  *  hash-partitioned by the join keys into temporary files and the in-memory hash table is released.
+  * The rest of the "right" blocks, as well as all the "left" blocks passed to joinBlock, are partitioned the same way,
+  *  and joinBlock returns no rows. Then the streams created by createStreamWithSpilledPartitions join the partitions
+  *  one by one, so only the hash table of a single partition is kept in memory at a time.
+  * Since rows with equal keys always fall into the same partition, every kind of equi-JOIN gives the same result as in memory.
+  * CROSS JOINs have no keys to partition by, so they are never spilled.
   */
 class Join
 {
@@ -117,7 +153,10 @@ public:
          const String & other_eq_filter_from_in_column = "",
          ExpressionActionsPtr other_condition_ptr = nullptr,
          size_t max_block_size = 0,
-         const String & match_helper_name = "");
+         const String & match_helper_name = "",
+         const JoinSpillConfig & spill_config_ = {});
+
+    ~Join();
 
     /** Call `setBuildConcurrencyAndInitPool`, `initMapImpl` and `setSampleBlock`.
       * You must call this method before subsequent calls to insertFromBlock.
@@ -147,6 +186,19 @@ public:
 
     size_t getTotalBuildInputRows() const { return total_input_build_rows; }
 
+    /// Whether the build side is allowed to be spilled to disk.
+    bool isSpillEnabled() const;
+    /// Whether the build side has been spilled to disk, only meaningful after the build is finished.
+    bool isSpilled() const
+    {
+        std::shared_lock lock(rwlock);
+        return spilled;
+    }
+
+    /// Runtime filters are filled with the join keys of the build side, and become ready when the build is finished.
+    /// Must be called before the build starts.
+    void setRuntimeFilters(const DM::RuntimeFilters & runtime_filters_) { runtime_filters = runtime_filters_; }
+
     ASTTableJoin::Kind getKind() const { return kind; }
 
     bool useNulls() const { return use_nulls; }
@@ -279,6 +331,7 @@ public:
 
 private:
     friend class NonJoinedBlockInputStream;
+    friend class SpilledPartitionsBlockInputStream;
 
     ASTTableJoin::Kind kind;
     ASTTableJoin::Strictness strictness;
@@ -323,6 +376,17 @@ private:
     /// Additional data - strings for string keys and continuation elements of single-linked lists of references to rows.
     Arenas pools;
 
+    const JoinSpillConfig spill_config;
+    /// Sample of the blocks passed to insertFromBlock, used to rebuild the hash table of a spilled partition.
+    Block build_sample_block;
+    /// Set once the build side is spilled, never reset. Protected by rwlock.
+    bool spilled = false;
+    struct SpilledPartition;
+    std::vector<std::unique_ptr<SpilledPartition>> spilled_partitions;
+    std::once_flag finish_spilled_probe_flag;
+
+    DM::RuntimeFilters runtime_filters;
+
 private:
     Type type = Type::EMPTY;
 
@@ -343,6 +407,8 @@ private:
 
     Block totals;
     std::atomic<size_t> total_input_build_rows{0};
+    /// Bytes of the "right" blocks that are kept in memory, reset after spilling.
+    std::atomic<size_t> total_input_build_bytes{0};
     /** Protect state for concurrent use in insertFromBlock and joinBlock.
       * Note that these methods could be called simultaneously only while use of StorageJoin,
       *  and StorageJoin only calls these two methods.
@@ -386,6 +452,29 @@ private:
       */
     void insertFromBlockInternal(Block * stored_block, size_t stream_index);
 
+    /// Collect the join keys of a build block into the runtime filters.
+    void updateRuntimeFilters(const Block & block) const;
+
+    /// Whether the in-memory build data exceeds `max_bytes_before_external_join` and should be spilled.
+    bool needSpill() const;
+
+    /** Partition all the "right" blocks kept in memory into temporary files and release the hash table.
+      * Must be called with the unique lock of rwlock.
+      */
+    void spillAllBuildData();
+
+    /// Split the block into `partition_num` blocks by the hash of its join keys.
+    Blocks partitionBlockForSpill(const Block & block, const Names & key_names) const;
+
+    void spillBuildBlock(const Block & block);
+    void spillProbeBlock(const Block & block) const;
+
+    /// Flush the temporary files of the spilled "left" blocks, called once before restoring the partitions.
+    void finishSpilledProbe();
+
+    /// Create an in-memory join that shares the same settings of this join, to join one spilled partition.
+    JoinPtr createJoinForSpilledPartition() const;
+
     template <ASTTableJoin::Kind KIND, ASTTableJoin::Strictness STRICTNESS, typename Maps>
     void joinBlockImpl(Block & block, const Maps & maps) const;
 
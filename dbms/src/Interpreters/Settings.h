@@ -101,6 +101,11 @@ struct Settings
     M(SettingBool, distributed_aggregation_memory_efficient, false, "Is the memory-saving mode of distributed aggregation enabled.")                                                                                                    \
     M(SettingUInt64, aggregation_memory_efficient_merge_threads, 0, "Number of threads to use for merge intermediate aggregation results in memory efficient mode. When bigger, then more memory is "                                   \
                                                                     "consumed. 0 means - same as 'max_threads'.")                                                                                                                       \
+    M(SettingUInt64, partial_agg_bypass_sample_rows, 100000, "In the partial phase of a two-phase aggregation, every thread checks the reduction of its hash table after "                                                              \
+                                                             "aggregating this number of rows, and passes the rest rows to the final phase with little aggregation if the "                                                             \
+                                                             "reduction is poor. 0 means disabled.")                                                                                                                                    \
+    M(SettingFloat, partial_agg_bypass_ratio_threshold, 0.8, "The partial aggregation is bypassed if the number of keys is more than this ratio of the sampled rows.")                                                                  \
+    M(SettingBool, enable_parallel_agg_merge, true, "Merge and convert the buckets of the two-level aggregated data by all the output streams of the aggregation in parallel.")                                                         \
                                                                                                                                                                                                                                         \
     M(SettingUInt64, max_parallel_replicas, 1, "The maximum number of replicas of each shard used when the query is executed. For consistency (to get different parts of the "                                                          \
                                                "same partition), this option only works for the specified sampling key. The lag of the replicas is not controlled.")                                                                    \
@@ -228,6 +233,10 @@ struct Settings
     M(SettingUInt64, max_bytes_to_sort, 0, "")                                                                                                                                                                                          \
     M(SettingOverflowMode<false>, sort_overflow_mode, OverflowMode::THROW, "What to do when the limit is exceeded.")                                                                                                                    \
     M(SettingUInt64, max_bytes_before_external_sort, 0, "")                                                                                                                                                                             \
+    M(SettingUInt64, max_bytes_before_external_join, 0, "Spill the build side of hash join to disk when it exceeds this size. 0 means never spill.")                                                                                    \
+    M(SettingUInt64, join_spill_partition_num, 16, "The number of partitions used by the grace hash join once the build side is spilled.")                                                                                              \
+    M(SettingBool, enable_join_runtime_filter, true, "Build runtime filters from the build side of hash join to skip the packs of the probe side table scan.")                                                                          \
+    M(SettingUInt64, join_runtime_filter_max_in_values, 1024, "The max number of distinct join keys kept by a runtime filter, only the min/max of join keys is kept if exceeded.")                                                      \
                                                                                                                                                                                                                                         \
     M(SettingUInt64, max_result_rows, 0, "Limit on result size in rows. Also checked for intermediate data sent from remote servers.")                                                                                                  \
     M(SettingUInt64, max_result_bytes, 0, "Limit on result size in bytes (uncompressed). Also checked for intermediate data sent from remote servers.")                                                                                 \
@@ -282,6 +291,10 @@ struct Settings
     M(SettingFloat, dt_bg_gc_delta_delete_ratio_to_trigger_gc, 0.3, "Trigger segment's gc when the ratio of delta delete range to stable exceeds this ratio.")                                                                          \
     M(SettingUInt64, dt_insert_max_rows, 0, "Max rows of insert blocks when write into DeltaTree Engine. By default 0 means no limit.")                                                                                                 \
     M(SettingBool, dt_enable_rough_set_filter, true, "Whether to parse where expression as Rough Set Index filter or not.")                                                                                                             \
+    M(SettingBool, dt_enable_late_materialization, true, "Whether to read the columns of the pushed down filter first and skip reading other columns of the filtered out rows in fast scan.")                                           \
+    M(SettingBool, dt_enable_aggregation_pushdown, false, "Whether to answer the partial count/min/max without group by keys by the pack statistics of the stable instead of reading the packs. "                                       \
+        "It relies on the rough set index to tell the packs whose rows all pass the filter exactly, so it is disabled by default.")                                                                                                     \
+    M(SettingBool, dt_enable_equal_index, false, "Whether to build the equal index (value set or bloom filter of each pack) for integer columns when writing DMFiles.")                                                                 \
     M(SettingBool, dt_raw_filter_range, true, "[unused] Do range filter or not when read data in raw mode in DeltaTree Engine.")                                                                                                        \
     M(SettingBool, dt_read_delta_only, false, "Only read delta data in DeltaTree Engine.")                                                                                                                                              \
     M(SettingBool, dt_read_stable_only, false, "Only read stable data in DeltaTree Engine.")                                                                                                                                            \
@@ -289,8 +302,14 @@ struct Settings
     M(SettingBool, dt_flush_after_write, false, "Flush cache or not after write in DeltaTree Engine.")                                                                                                                                  \
     M(SettingBool, dt_enable_relevant_place, false, "Enable relevant place or not in DeltaTree Engine.")                                                                                                                                \
     M(SettingBool, dt_enable_skippable_place, true, "Enable skippable place or not in DeltaTree Engine.")                                                                                                                               \
+    M(SettingBool, dt_enable_persisted_delta_index, false, "Persist the delta index of segments after placing the flushed delta, and restore it lazily instead of placing the delta again after it is evicted or "                      \
+        "TiFlash restarts. The pages of the persisted delta indexes are leaked if TiFlash is downgraded to a version without this setting.")                                                                                            \
+    M(SettingUInt64, dt_persisted_delta_index_min_interval_seconds, 60, "The minimum interval of persisting the delta index of the same segment, to limit the writes of the hot segments.")                                             \
     M(SettingBool, dt_enable_stable_column_cache, true, "Enable column cache for StorageDeltaMerge.")                                                                                                                                   \
+    M(SettingBool, dt_enable_stable_pack_cache, true, "Enable the global cache of decompressed column packs of DMFiles for StorageDeltaMerge. Only takes effect when `dmfile_pack_cache_size` is set in config.")                       \
     M(SettingBool, dt_enable_single_file_mode_dmfile, false, "Enable write DMFile in single file mode.")                                                                                                                                \
+    M(SettingUInt64, dt_snapshot_prehandle_threads, 1, "The number of threads to decode the subranges of a snapshot and write them into DTFiles in parallel. 1 means serially.")                                                        \
+    M(SettingUInt64, dt_snapshot_prehandle_subrange_keys, 200000, "The number of write CF keys in a subrange when a snapshot is prehandled in parallel.")                                                                               \
     M(SettingUInt64, dt_open_file_max_idle_seconds, 15, "Max idle time of opening files, 0 means infinite.")                                                                                                                            \
     M(SettingUInt64, dt_page_num_max_expect_legacy_files, 100, "Max number of legacy file expected")                                                                                                                                    \
     M(SettingFloat, dt_page_num_max_gc_valid_rate, 1.0, "Max valid rate of deciding a page file can be compact when exising legacy files are more over than "                                                                           \
@@ -320,12 +339,16 @@ struct Settings
                                                                                                                                                                                                                                         \
     M(SettingDouble, dt_page_gc_threshold, 0.5, "Max valid rate of deciding to do a GC in PageStorage")                                                                                                                                 \
     M(SettingBool, dt_enable_read_thread, true, "Enable storage read thread or not")                                                                                                                                                    \
+    M(SettingBool, dt_enable_bitmap_filter, false, "Read the latest versions by a bitmap filter instead of sort merging the stable and delta when the order of PK is not required")                                                     \
     M(SettingDouble, dt_read_thread_count_scale, 1.0, "Number of read thread = number of logical cpu cores * dt_read_thread_count_scale.  Only has meaning at server startup.")                                                         \
+    M(SettingUInt64, dt_read_task_split_min_packs, 0, "Split the read tasks of a few large segments by the stable packs when there are less tasks than streams, every sub-task "                                                        \
+                                                      "reads at least this number of packs. The sub-tasks are read by the query threads instead of the read thread pool. 0 means disable splitting")                                    \
     M(SettingUInt64, dt_max_sharing_column_bytes_for_all, 2048 * Constant::MB, "Memory limitation for data sharing of all requests, include those sharing blocks in block queue. 0 means disable data sharing")                         \
     M(SettingUInt64, dt_max_sharing_column_count, 5, "Deprecated")                                                                                                                                                                      \
     M(SettingChecksumAlgorithm, dt_checksum_algorithm, ChecksumAlgo::XXH3, "Checksum algorithm for delta tree stable storage")                                                                                                          \
     M(SettingCompressionMethod, dt_compression_method, CompressionMethod::LZ4, "The method of data compression when writing.")                                                                                                          \
     M(SettingInt64, dt_compression_level, 1, "The compression level.")                                                                                                                                                                  \
+    M(SettingBool, dt_enable_lightweight_compression, false, "Try the lightweight encodings (RLE, frame-of-reference and delta) for the integer columns when writing DTFiles, the smaller one of them and dt_compression_method is chosen for every compressed block. The DTFiles written cannot be read by the older versions.") \
     M(SettingUInt64, max_rows_in_set, 0, "Maximum size of the set (in number of elements) resulting from the execution of the IN section.")                                                                                             \
     M(SettingUInt64, max_bytes_in_set, 0, "Maximum size of the set (in bytes in memory) resulting from the execution of the IN section.")                                                                                               \
     M(SettingOverflowMode<false>, set_overflow_mode, OverflowMode::THROW, "What to do when the limit is exceeded.")                                                                                                                     \
@@ -358,6 +381,8 @@ struct Settings
     M(SettingUInt64, elastic_threadpool_shrink_period_ms, 300000, "The shrink period(ms) of elastic thread pool.")                                                                                                                      \
     M(SettingBool, enable_local_tunnel, true, "Enable local data transfer between local MPP tasks.")                                                                                                                                    \
     M(SettingBool, enable_async_grpc_client, true, "Enable async grpc in MPP.")                                                                                                                                                         \
+    M(SettingCompressionMethod, mpp_exchange_compression_method, CompressionMethod::NONE, "The compression method(none, lz4, lz4hc, zstd) of the data exchanged between MPP tasks on different nodes, it should be the same on all the nodes.") \
+    M(SettingBool, mpp_exchange_dictionary_encoding, false, "Encode the low-cardinality string columns shuffled between MPP tasks with dictionaries. The nodes of older versions can not decode them.") \
     M(SettingUInt64, grpc_completion_queue_pool_size, 0, "The size of gRPC completion queue pool. 0 means using hardware_concurrency.")                                                                                                 \
     M(SettingBool, enable_async_server, true, "Enable async rpc server.")                                                                                                                                                               \
     M(SettingUInt64, async_pollers_per_cq, 200, "grpc async pollers per cqs")                                                                                                                                                           \
@@ -369,6 +394,7 @@ struct Settings
     M(SettingUInt64, manual_compact_more_until_ms, 60000, "Continuously compact more segments until reaching specified elapsed time. If 0 is specified, only one segment will be compacted each round.")                                \
                                                                                                                                                                                                                                         \
     M(SettingBool, enable_planner, true, "Enable planner")                                                                                                                                                                              \
+    M(SettingBool, enable_pipeline, false, "Enable pipeline model, which executes the query by the tasks scheduled among the fixed threads of TaskScheduler")                                                                           \
     M(SettingUInt64, ddl_restart_wait_seconds, 180, "The wait time for sync schema in seconds when restart")
 // clang-format on
 #define DECLARE(TYPE, NAME, DEFAULT, DESCRIPTION) TYPE NAME{DEFAULT};
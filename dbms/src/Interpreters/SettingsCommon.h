@@ -848,15 +848,17 @@ public:
             return CompressionMethod::LZ4HC;
         if (lower_str == "zstd")
             return CompressionMethod::ZSTD;
+        if (lower_str == "none")
+            return CompressionMethod::NONE;
 
-        throw Exception("Unknown compression method: '" + s + "', must be one of 'lz4', 'lz4hc', 'zstd'", ErrorCodes::UNKNOWN_COMPRESSION_METHOD);
+        throw Exception("Unknown compression method: '" + s + "', must be one of 'lz4', 'lz4hc', 'zstd', 'none'", ErrorCodes::UNKNOWN_COMPRESSION_METHOD);
     }
 
     String toString() const
     {
-        const char * strings[] = {nullptr, "lz4", "lz4hc", "zstd"};
+        const char * strings[] = {nullptr, "lz4", "lz4hc", "zstd", "none"};
 
-        if (value < CompressionMethod::LZ4 || value > CompressionMethod::ZSTD)
+        if (value < CompressionMethod::LZ4 || value > CompressionMethod::NONE)
             throw Exception("Unknown compression method", ErrorCodes::UNKNOWN_COMPRESSION_METHOD);
 
         return strings[static_cast<size_t>(value)];
@@ -0,0 +1,180 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <AggregateFunctions/AggregateFunctionFactory.h>
+#include <AggregateFunctions/registerAggregateFunctions.h>
+#include <DataTypes/DataTypesNumber.h>
+#include <Interpreters/Aggregator.h>
+#include <TestUtils/ColumnGenerator.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+namespace DB
+{
+namespace tests
+{
+/// The group by keys of the benchmarks, they lead to different aggregation methods.
+enum class AggKeyKind
+{
+    Int8,
+    Int64,
+    NullableInt64,
+    String,
+    TwoInt32,
+    StringAndInt64,
+};
+
+/// Aggregate `sum(v), count()` of 1M rows grouped by the keys.
+/// Args: {AggKeyKind, cardinality, null ratio in percent}
+class AggregatorBench : public benchmark::Fixture
+{
+public:
+    static constexpr size_t total_rows = 1 << 20;
+    static constexpr size_t block_size = 8192;
+    static constexpr size_t string_key_size = 16;
+
+    void SetUp(const benchmark::State & state) override
+    {
+        try
+        {
+            registerAggregateFunctions();
+        }
+        catch (DB::Exception &)
+        {
+            // Maybe another bench has already registered, ignore exception here.
+        }
+
+        auto kind = static_cast<AggKeyKind>(state.range(0));
+        size_t cardinality = state.range(1);
+        double null_ratio = state.range(2) / 100.0;
+
+        Strings key_types;
+        switch (kind)
+        {
+        case AggKeyKind::Int8:
+            key_types = {"Int8"};
+            break;
+        case AggKeyKind::Int64:
+            key_types = {"Int64"};
+            break;
+        case AggKeyKind::NullableInt64:
+            key_types = {"Nullable(Int64)"};
+            break;
+        case AggKeyKind::String:
+            key_types = {"String"};
+            break;
+        case AggKeyKind::TwoInt32:
+            key_types = {"Int32", "Int32"};
+            break;
+        case AggKeyKind::StringAndInt64:
+            key_types = {"String", "Int64"};
+            break;
+        }
+        /// Keep the cardinality of the combined keys about `cardinality`.
+        size_t key_cardinality = std::max<size_t>(1, std::pow(cardinality, 1.0 / key_types.size()));
+
+        blocks.clear();
+        for (size_t rows = 0; rows < total_rows; rows += block_size)
+        {
+            ColumnsWithTypeAndName columns;
+            for (size_t i = 0; i < key_types.size(); ++i)
+            {
+                auto key = ColumnGenerator::instance().generate({block_size, key_types[i], RANDOM, string_key_size, key_cardinality, null_ratio});
+                key.name = fmt::format("k{}", i);
+                columns.push_back(std::move(key));
+            }
+            auto value = ColumnGenerator::instance().generate({block_size, "Int64", RANDOM});
+            value.name = "v";
+            columns.push_back(std::move(value));
+            blocks.emplace_back(std::move(columns));
+        }
+
+        const auto & header = blocks.front();
+        ColumnNumbers keys;
+        for (size_t i = 0; i < key_types.size(); ++i)
+            keys.push_back(i);
+
+        auto & factory = AggregateFunctionFactory::instance();
+        AggregateDescriptions aggregates(2);
+        aggregates[0].function = factory.get("sum", {header.getByName("v").type});
+        aggregates[0].arguments = {header.getPositionByName("v")};
+        aggregates[0].column_name = "sum(v)";
+        aggregates[1].function = factory.get("count", {});
+        aggregates[1].column_name = "count()";
+
+        params = std::make_unique<Aggregator::Params>(
+            header,
+            keys,
+            aggregates,
+            false,
+            0,
+            OverflowMode::THROW,
+            0,
+            0,
+            0,
+            false,
+            "");
+        file_provider = TiFlashTestEnv::getGlobalContext().getFileProvider();
+    }
+
+    void TearDown(const benchmark::State &) override
+    {
+        blocks.clear();
+        params.reset();
+    }
+
+protected:
+    Blocks blocks;
+    std::unique_ptr<Aggregator::Params> params;
+    FileProviderPtr file_provider;
+};
+
+BENCHMARK_DEFINE_F(AggregatorBench, executeOnBlock)
+(benchmark::State & state)
+try
+{
+    Aggregator aggregator(*params, "bench");
+    for (auto _ : state)
+    {
+        AggregatedDataVariants data;
+        ColumnRawPtrs key_columns(params->keys_size);
+        Aggregator::AggregateColumns aggregate_columns(params->aggregates_size);
+        Int64 local_delta_memory = 0;
+        bool no_more_keys = false;
+        for (const auto & block : blocks)
+            aggregator.executeOnBlock(block, data, file_provider, key_columns, aggregate_columns, local_delta_memory, no_more_keys);
+        state.SetLabel(data.getMethodName());
+        benchmark::DoNotOptimize(data.size());
+    }
+    state.SetItemsProcessed(state.iterations() * total_rows);
+}
+CATCH
+
+static void aggregatorArgs(benchmark::internal::Benchmark * b)
+{
+    b->Args({static_cast<int64_t>(AggKeyKind::Int8), 100, 0});
+    for (auto kind : {AggKeyKind::Int64, AggKeyKind::String, AggKeyKind::TwoInt32, AggKeyKind::StringAndInt64})
+    {
+        for (int64_t cardinality : {100, 10000, 1000000})
+            b->Args({static_cast<int64_t>(kind), cardinality, 0});
+    }
+    for (int64_t null_percent : {0, 10, 50, 90})
+        b->Args({static_cast<int64_t>(AggKeyKind::NullableInt64), 10000, null_percent});
+}
+BENCHMARK_REGISTER_F(AggregatorBench, executeOnBlock)->Apply(aggregatorArgs);
+
+} // namespace tests
+} // namespace DB
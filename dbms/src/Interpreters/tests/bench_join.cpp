@@ -0,0 +1,160 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Interpreters/Join.h>
+#include <TestUtils/ColumnGenerator.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <benchmark/benchmark.h>
+
+namespace DB
+{
+namespace tests
+{
+/// The types of the join key, they lead to different hash map types of Join.
+enum class JoinKeyKind
+{
+    Int64,
+    NullableInt64,
+    String,
+};
+
+/// Inner join of a 1M rows probe side with the build side.
+/// Args: {JoinKeyKind, build rows, cardinality of the build side keys, null ratio in percent}
+/// The probe side keys have the same cardinality, so roughly build_rows / cardinality rows are joined with each probe row.
+class JoinBench : public benchmark::Fixture
+{
+public:
+    static constexpr size_t probe_rows = 1 << 20;
+    static constexpr size_t block_size = 8192;
+    static constexpr size_t string_key_size = 16;
+
+    void SetUp(const benchmark::State & state) override
+    {
+        auto kind = static_cast<JoinKeyKind>(state.range(0));
+        size_t build_rows = state.range(1);
+        size_t cardinality = state.range(2);
+        double null_ratio = state.range(3) / 100.0;
+
+        String key_type;
+        switch (kind)
+        {
+        case JoinKeyKind::Int64:
+            key_type = "Int64";
+            break;
+        case JoinKeyKind::NullableInt64:
+            key_type = "Nullable(Int64)";
+            break;
+        case JoinKeyKind::String:
+            key_type = "String";
+            break;
+        }
+
+        auto gen_blocks = [&](size_t rows, const String & key_name, const String & value_name) {
+            Blocks blocks;
+            for (size_t i = 0; i < rows; i += block_size)
+            {
+                size_t size = std::min(block_size, rows - i);
+                auto key = ColumnGenerator::instance().generate({size, key_type, RANDOM, string_key_size, cardinality, null_ratio});
+                key.name = key_name;
+                auto value = ColumnGenerator::instance().generate({size, "Int64", RANDOM});
+                value.name = value_name;
+                blocks.emplace_back(ColumnsWithTypeAndName{std::move(key), std::move(value)});
+            }
+            return blocks;
+        };
+        build_blocks = gen_blocks(build_rows, "b_key", "b_value");
+        probe_blocks = gen_blocks(probe_rows, "p_key", "p_value");
+    }
+
+    void TearDown(const benchmark::State &) override
+    {
+        build_blocks.clear();
+        probe_blocks.clear();
+    }
+
+    JoinPtr buildJoin() const
+    {
+        auto join = std::make_shared<Join>(
+            Names{"p_key"},
+            Names{"b_key"},
+            true,
+            ASTTableJoin::Kind::Inner,
+            ASTTableJoin::Strictness::All,
+            "bench",
+            false,
+            0);
+        join->init(build_blocks.front().cloneEmpty());
+        for (const auto & block : build_blocks)
+            join->insertFromBlock(block, 0);
+        join->setBuildTableState(Join::BuildTableState::SUCCEED);
+        return join;
+    }
+
+protected:
+    Blocks build_blocks;
+    Blocks probe_blocks;
+};
+
+BENCHMARK_DEFINE_F(JoinBench, build)
+(benchmark::State & state)
+try
+{
+    for (auto _ : state)
+    {
+        auto join = buildJoin();
+        benchmark::DoNotOptimize(join->getTotalRowCount());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+CATCH
+
+BENCHMARK_DEFINE_F(JoinBench, probe)
+(benchmark::State & state)
+try
+{
+    auto join = buildJoin();
+    for (auto _ : state)
+    {
+        size_t joined_rows = 0;
+        for (const auto & probe_block : probe_blocks)
+        {
+            Block block = probe_block;
+            join->joinBlock(block);
+            joined_rows += block.rows();
+        }
+        benchmark::DoNotOptimize(joined_rows);
+    }
+    state.SetItemsProcessed(state.iterations() * probe_rows);
+}
+CATCH
+
+static void joinArgs(benchmark::internal::Benchmark * b)
+{
+    for (auto kind : {JoinKeyKind::Int64, JoinKeyKind::String})
+    {
+        for (int64_t build_rows : {10000, 1000000})
+        {
+            /// Unique keys and duplicated keys of the build side.
+            b->Args({static_cast<int64_t>(kind), build_rows, build_rows, 0});
+            b->Args({static_cast<int64_t>(kind), build_rows, build_rows / 10, 0});
+        }
+    }
+    for (int64_t null_percent : {0, 10, 50, 90})
+        b->Args({static_cast<int64_t>(JoinKeyKind::NullableInt64), 1000000, 1000000, null_percent});
+}
+BENCHMARK_REGISTER_F(JoinBench, build)->Apply(joinArgs);
+BENCHMARK_REGISTER_F(JoinBench, probe)->Apply(joinArgs);
+
+} // namespace tests
+} // namespace DB
@@ -36,6 +36,7 @@ bool needFrameMigration(const DB::DM::DMFile & file, const std::string & target)
     return endsWith(target, ".mrk")
         || endsWith(target, ".dat")
         || endsWith(target, ".idx")
+        || endsWith(target, ".eqidx")
         || file.packStatFileName() == target;
 }
 bool isRecognizable(const DB::DM::DMFile & file, const std::string & target)
@@ -41,6 +41,7 @@
 #include <Flash/DiagnosticsService.h>
 #include <Flash/FlashService.h>
 #include <Flash/Mpp/GRPCCompletionQueuePool.h>
+#include <Flash/Pipeline/Schedule/TaskScheduler.h>
 #include <Functions/registerFunctions.h>
 #include <IO/HTTPCommon.h>
 #include <IO/ReadHelpers.h>
@@ -1124,10 +1125,20 @@ int Server::main(const std::vector<std::string> & /*args*/)
     if (config().has("max_table_size_to_drop"))
         global_context->setMaxTableSizeToDrop(config().getUInt64("max_table_size_to_drop"));
 
+    /// The policy and the number of shards of a cache, e.g. `mark_cache_policy = "SLRU"` and `mark_cache_shards = 16`.
+    /// SLRU keeps the entries hit more than once from being flushed out by large scans, and more shards
+    /// reduce the lock contention on machines with many cores.
+    auto get_cache_options = [this](const String & name) {
+        CacheOptions options;
+        options.policy = CacheOptions::parsePolicy(config().getString(name + "_policy", "LRU"));
+        options.num_shards = config().getUInt64(name + "_shards", 1);
+        return options;
+    };
+
     /// Size of cache for uncompressed blocks. Zero means disabled.
     size_t uncompressed_cache_size = config().getUInt64("uncompressed_cache_size", 0);
     if (uncompressed_cache_size)
-        global_context->setUncompressedCache(uncompressed_cache_size);
+        global_context->setUncompressedCache(uncompressed_cache_size, get_cache_options("uncompressed_cache"));
 
     bool use_l0_opt = config().getBool("l0_optimize", false);
     global_context->setUseL0Opt(use_l0_opt);
@@ -1135,12 +1146,22 @@ int Server::main(const std::vector<std::string> & /*args*/)
     /// Size of cache for marks (index of MergeTree family of tables). It is necessary.
     size_t mark_cache_size = config().getUInt64("mark_cache_size", DEFAULT_MARK_CACHE_SIZE);
     if (mark_cache_size)
-        global_context->setMarkCache(mark_cache_size);
+        global_context->setMarkCache(mark_cache_size, get_cache_options("mark_cache"));
 
     /// Size of cache for minmax index, used by DeltaMerge engine.
     size_t minmax_index_cache_size = config().getUInt64("minmax_index_cache_size", mark_cache_size);
     if (minmax_index_cache_size)
-        global_context->setMinMaxIndexCache(minmax_index_cache_size);
+        global_context->setMinMaxIndexCache(minmax_index_cache_size, get_cache_options("minmax_index_cache"));
+
+    /// Size of cache for equal index, used by DeltaMerge engine.
+    size_t equal_index_cache_size = config().getUInt64("equal_index_cache_size", minmax_index_cache_size);
+    if (equal_index_cache_size)
+        global_context->setEqualIndexCache(equal_index_cache_size);
+
+    /// Size of cache for decompressed column packs of DMFiles, used by DeltaMerge engine. Zero means disabled.
+    size_t dmfile_pack_cache_size = config().getUInt64("dmfile_pack_cache_size", 0);
+    if (dmfile_pack_cache_size)
+        global_context->setDMFilePackCache(dmfile_pack_cache_size);
 
     /// Size of max memory usage of DeltaIndex, used by DeltaMerge engine.
     size_t delta_index_cache_size = config().getUInt64("delta_index_cache_size", 0);
@@ -1263,6 +1284,24 @@ int Server::main(const std::vector<std::string> & /*args*/)
         GRPCCompletionQueuePool::global_instance = std::make_unique<GRPCCompletionQueuePool>(size);
     }
 
+    /// setting up the task scheduler of the pipeline model
+    {
+        auto cpu_pool_size = config().getUInt64("pipeline_cpu_task_thread_pool_size", 0);
+        if (cpu_pool_size == 0)
+            cpu_pool_size = std::thread::hardware_concurrency();
+        auto io_pool_size = config().getUInt64("pipeline_io_task_thread_pool_size", 0);
+        if (io_pool_size == 0)
+            io_pool_size = std::thread::hardware_concurrency();
+        TaskSchedulerConfig task_scheduler_config{cpu_pool_size, io_pool_size};
+        assert(!TaskScheduler::instance);
+        TaskScheduler::instance = std::make_unique<TaskScheduler>(task_scheduler_config);
+    }
+    SCOPE_EXIT({
+        // Stop the threads of the task scheduler before shutting down storages.
+        assert(TaskScheduler::instance);
+        TaskScheduler::instance.reset();
+    });
+
     /// Then, startup grpc server to serve raft and/or flash services.
     FlashGrpcServerHolder flash_grpc_server_holder(this->context(), this->config(), this->security_config, raft_config, log);
 
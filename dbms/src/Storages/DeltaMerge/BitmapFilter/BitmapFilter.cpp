@@ -0,0 +1,99 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnsNumber.h>
+#include <Common/Exception.h>
+#include <Common/typeid_cast.h>
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
+#include <fmt/format.h>
+
+#include <algorithm>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int LOGICAL_ERROR;
+} // namespace ErrorCodes
+
+namespace DM
+{
+BitmapFilter::BitmapFilter(UInt32 size_, bool default_value)
+    : filter(size_, default_value)
+    , all_match(default_value)
+{}
+
+void BitmapFilter::set(const ColumnPtr & row_ids)
+{
+    if (!row_ids)
+        return;
+    const auto & data = typeid_cast<const ColumnUInt32 *>(row_ids.get())->getData();
+    for (auto row_id : data)
+    {
+        if (unlikely(row_id >= filter.size()))
+            throw Exception(fmt::format("Row id {} is out of the bitmap filter of size {}", row_id, filter.size()), ErrorCodes::LOGICAL_ERROR);
+        filter[row_id] = 1;
+    }
+}
+
+void BitmapFilter::set(UInt32 start, UInt32 limit, bool value)
+{
+    RUNTIME_CHECK(static_cast<size_t>(start) + limit <= filter.size(), start, limit, filter.size());
+    std::fill(filter.begin() + start, filter.begin() + start + limit, value);
+}
+
+bool BitmapFilter::get(IColumn::Filter & f, UInt32 start, UInt32 limit) const
+{
+    RUNTIME_CHECK(static_cast<size_t>(start) + limit <= filter.size(), start, limit, filter.size());
+    f.resize(limit);
+    if (all_match)
+    {
+        std::fill(f.begin(), f.end(), 1);
+        return true;
+    }
+    std::copy(filter.begin() + start, filter.begin() + start + limit, f.begin());
+    return std::all_of(f.begin(), f.end(), [](UInt8 v) { return v != 0; });
+}
+
+bool BitmapFilter::isNoneMatch(UInt32 start, UInt32 limit) const
+{
+    RUNTIME_CHECK(static_cast<size_t>(start) + limit <= filter.size(), start, limit, filter.size());
+    if (all_match)
+        return limit == 0;
+    return std::none_of(filter.begin() + start, filter.begin() + start + limit, [](UInt8 v) { return v != 0; });
+}
+
+void BitmapFilter::runOptimize()
+{
+    all_match = std::all_of(filter.begin(), filter.end(), [](UInt8 v) { return v != 0; });
+}
+
+size_t BitmapFilter::count() const
+{
+    return std::count_if(filter.begin(), filter.end(), [](UInt8 v) { return v != 0; });
+}
+
+String BitmapFilter::toDebugString() const
+{
+    String s(filter.size(), '0');
+    for (size_t i = 0; i < filter.size(); ++i)
+    {
+        if (filter[i])
+            s[i] = '1';
+    }
+    return s;
+}
+
+} // namespace DM
+} // namespace DB
@@ -0,0 +1,60 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Columns/IColumn.h>
+#include <common/types.h>
+
+#include <memory>
+
+namespace DB
+{
+namespace DM
+{
+/// The visibility of the rows in a segment, indexed by the segment row id (see `getSegmentRowIdColumnDefine`).
+/// It is built by the MVCC filtering of the handle, version and del_mark columns, and then used to filter
+/// the other columns read from the stable and delta directly, without merging them in handle order.
+class BitmapFilter
+{
+public:
+    BitmapFilter(UInt32 size_, bool default_value);
+
+    /// Set the bits of the row ids in `row_ids`, which is a ColumnUInt32.
+    void set(const ColumnPtr & row_ids);
+    /// Set the bits of [start, start + limit) to `value`.
+    void set(UInt32 start, UInt32 limit, bool value = true);
+    /// Copy the bits of [start, start + limit) to `f`. Return true if all of them are set.
+    bool get(IColumn::Filter & f, UInt32 start, UInt32 limit) const;
+    /// Return true if none of the bits of [start, start + limit) is set.
+    bool isNoneMatch(UInt32 start, UInt32 limit) const;
+
+    /// Must be called after all the bits are set.
+    void runOptimize();
+    bool isAllMatch() const { return all_match; }
+
+    size_t size() const { return filter.size(); }
+    size_t count() const;
+
+    String toDebugString() const;
+
+private:
+    IColumn::Filter filter;
+    bool all_match;
+};
+
+using BitmapFilterPtr = std::shared_ptr<BitmapFilter>;
+
+} // namespace DM
+} // namespace DB
@@ -0,0 +1,113 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnsCommon.h>
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilterBlockInputStream.h>
+#include <Storages/DeltaMerge/DeltaMergeHelpers.h>
+#include <common/logger_useful.h>
+
+namespace DB
+{
+namespace DM
+{
+BitmapFilterBlockInputStream::BitmapFilterBlockInputStream(
+    const ColumnDefines & columns_to_read,
+    const SkippableBlockInputStreamPtr & stable_,
+    const BlockInputStreamPtr & delta_,
+    size_t stable_rows_,
+    const BitmapFilterPtr & bitmap_filter_,
+    const String & req_id_)
+    : header(toEmptyBlock(columns_to_read))
+    , stable(stable_)
+    , delta(delta_)
+    , stable_rows(stable_rows_)
+    , bitmap_filter(bitmap_filter_)
+    , log(Logger::get(NAME, req_id_))
+{
+    children.push_back(stable);
+    children.push_back(delta);
+}
+
+BitmapFilterBlockInputStream::~BitmapFilterBlockInputStream()
+{
+    LOG_DEBUG(log, "Total rows: {}, pass: {:.2f}%, stable rows: {}, delta rows: {}", total_rows, passed_rows * 100.0 / total_rows, stable_read_rows, delta_read_rows);
+}
+
+std::pair<Block, UInt32> BitmapFilterBlockInputStream::readBlock()
+{
+    if (!stable_done)
+    {
+        // The skipped packs must be counted before reading, otherwise the stable stream skips them silently.
+        size_t skipped_rows = 0;
+        stable->getSkippedRows(skipped_rows);
+        stable_read_rows += skipped_rows;
+        if (auto block = stable->read(); block)
+        {
+            UInt32 start = stable_read_rows;
+            stable_read_rows += block.rows();
+            return {std::move(block), start};
+        }
+        stable_done = true;
+        RUNTIME_CHECK(stable_read_rows == stable_rows, stable_read_rows, stable_rows);
+    }
+
+    auto block = delta->read();
+    UInt32 start = stable_rows + delta_read_rows;
+    if (block)
+        delta_read_rows += block.rows();
+    return {std::move(block), start};
+}
+
+Block BitmapFilterBlockInputStream::read(FilterPtr & res_filter, bool return_filter)
+{
+    while (true)
+    {
+        auto [block, start] = readBlock();
+        if (!block)
+            return {};
+
+        const size_t rows = block.rows();
+        total_rows += rows;
+        if (bitmap_filter->isNoneMatch(start, rows))
+            continue;
+        if (bitmap_filter->get(filter, start, rows))
+        {
+            passed_rows += rows;
+            // All rows pass, the caller must not use the filter of the previous block.
+            if (return_filter)
+                res_filter = nullptr;
+            return getNewBlockByHeader(header, block);
+        }
+
+        size_t passed_count = countBytesInFilter(filter);
+        passed_rows += passed_count;
+        if (return_filter)
+        {
+            res_filter = &filter;
+            return getNewBlockByHeader(header, block);
+        }
+
+        Block res;
+        for (const auto & c : header)
+        {
+            auto & column = block.getByName(c.name);
+            column.column = column.column->filter(filter, passed_count);
+            res.insert(std::move(column));
+        }
+        return res;
+    }
+}
+
+} // namespace DM
+} // namespace DB
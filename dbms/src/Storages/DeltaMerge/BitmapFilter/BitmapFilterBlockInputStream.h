@@ -0,0 +1,79 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/Logger.h>
+#include <DataStreams/IBlockInputStream.h>
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
+#include <Storages/DeltaMerge/DeltaMergeDefines.h>
+#include <Storages/DeltaMerge/SkippableBlockInputStream.h>
+
+namespace DB
+{
+namespace DM
+{
+/// Read the rows of the stable and then the delta of a segment, and filter them by the `BitmapFilter`.
+/// The rows are not merged, so the output is not sorted by handle.
+class BitmapFilterBlockInputStream : public IBlockInputStream
+{
+    static constexpr auto NAME = "BitmapFilterBlockInputStream";
+
+public:
+    BitmapFilterBlockInputStream(
+        const ColumnDefines & columns_to_read,
+        const SkippableBlockInputStreamPtr & stable_,
+        const BlockInputStreamPtr & delta_,
+        size_t stable_rows_,
+        const BitmapFilterPtr & bitmap_filter_,
+        const String & req_id_);
+
+    ~BitmapFilterBlockInputStream() override;
+
+    String getName() const override { return NAME; }
+    Block getHeader() const override { return header; }
+
+    Block read() override
+    {
+        FilterPtr filter_ignored;
+        return read(filter_ignored, false);
+    }
+
+    /// If `return_filter` is true and the block is partially visible, the block is returned without filtering
+    /// and `res_filter` is set, so that the caller can combine it with its own filter.
+    Block read(FilterPtr & res_filter, bool return_filter) override;
+
+private:
+    /// Return the next block of stable or delta, and the row id of its first row.
+    std::pair<Block, UInt32> readBlock();
+
+    Block header;
+    SkippableBlockInputStreamPtr stable;
+    BlockInputStreamPtr delta;
+    // The row id of the next row of stable or delta.
+    size_t stable_read_rows = 0;
+    size_t delta_read_rows = 0;
+    const size_t stable_rows;
+    bool stable_done = false;
+    BitmapFilterPtr bitmap_filter;
+    IColumn::Filter filter;
+
+    size_t total_rows = 0;
+    size_t passed_rows = 0;
+
+    const LoggerPtr log;
+};
+
+} // namespace DM
+} // namespace DB
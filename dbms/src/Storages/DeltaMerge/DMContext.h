@@ -20,6 +20,7 @@
 #include <Interpreters/Settings.h>
 #include <Storages/DeltaMerge/DMChecksumConfig.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
+#include <Storages/DeltaMerge/Filter/LateMaterializationFilter.h>
 #include <Storages/DeltaMerge/ScanContext.h>
 
 #include <memory>
@@ -84,11 +85,16 @@ struct DMContext : private boost::noncopyable
     const bool read_stable_only;
     const bool enable_relevant_place;
     const bool enable_skippable_place;
+    const bool enable_persisted_delta_index;
+    const size_t persisted_delta_index_min_interval_seconds;
 
     String tracing_id;
 
     ScanContextPtr scan_context;
 
+    // The pushed down filter used by the stable of fast scan, nullptr means disabled.
+    LateMaterializationFilterPtr late_materialization_filter;
+
 public:
     DMContext(const Context & db_context_,
               StoragePathPool & path_pool_,
@@ -122,6 +128,8 @@ public:
         , read_stable_only(settings.dt_read_stable_only)
         , enable_relevant_place(settings.dt_enable_relevant_place)
         , enable_skippable_place(settings.dt_enable_skippable_place)
+        , enable_persisted_delta_index(settings.dt_enable_persisted_delta_index)
+        , persisted_delta_index_min_interval_seconds(settings.dt_persisted_delta_index_min_interval_seconds)
         , tracing_id(tracing_id_)
         , scan_context(scan_context_)
     {
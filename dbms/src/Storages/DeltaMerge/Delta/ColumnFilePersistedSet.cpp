@@ -27,10 +27,21 @@ namespace DB
 {
 namespace DM
 {
-inline void serializeColumnFilePersisteds(WriteBatches & wbs, PageId id, const ColumnFilePersisteds & persisted_files)
+// Marks the page id of the persisted delta index appended after the column files in the metadata,
+// so that any other trailing bytes are rejected instead of being taken as a page id.
+static constexpr UInt64 DELTA_INDEX_PAGE_ID_MARKER = 0x44454c5441494458; // "DELTAIDX"
+
+inline void serializeColumnFilePersisteds(WriteBatches & wbs, PageId id, const ColumnFilePersisteds & persisted_files, PageId delta_index_page_id)
 {
     MemoryWriteBuffer buf(0, COLUMN_FILE_SERIALIZE_BUFFER_SIZE);
     serializeSavedColumnFiles(buf, persisted_files);
+    // The page id of the persisted delta index is appended after the column files only when it exists,
+    // so that the metadata can still be read by the older versions.
+    if (delta_index_page_id != 0)
+    {
+        writeIntBinary(DELTA_INDEX_PAGE_ID_MARKER, buf);
+        writeIntBinary(delta_index_page_id, buf);
+    }
     auto data_size = buf.count();
     wbs.meta.putPage(id, 0, buf.tryGetReadBuffer(), data_size);
 }
@@ -92,18 +103,31 @@ ColumnFilePersistedSetPtr ColumnFilePersistedSet::restore( //
     Page page = context.storage_pool.metaReader()->read(id);
     ReadBufferFromMemory buf(page.data.begin(), page.data.size());
     auto column_files = deserializeSavedColumnFiles(context, segment_range, buf);
-    return std::make_shared<ColumnFilePersistedSet>(id, column_files);
+    auto persisted_file_set = std::make_shared<ColumnFilePersistedSet>(id, column_files);
+    if (!buf.eof())
+    {
+        UInt64 marker = 0;
+        readIntBinary(marker, buf);
+        if (marker != DELTA_INDEX_PAGE_ID_MARKER)
+            throw Exception(fmt::format("Unexpected data after column files in delta metadata, page_id={} marker={:#x}", id, marker), ErrorCodes::LOGICAL_ERROR);
+        PageId delta_index_page_id;
+        readIntBinary(delta_index_page_id, buf);
+        persisted_file_set->setDeltaIndexPageId(delta_index_page_id);
+    }
+    return persisted_file_set;
 }
 
 void ColumnFilePersistedSet::saveMeta(WriteBatches & wbs) const
 {
-    serializeColumnFilePersisteds(wbs, metadata_id, persisted_files);
+    serializeColumnFilePersisteds(wbs, metadata_id, persisted_files, delta_index_page_id.load());
 }
 
 void ColumnFilePersistedSet::recordRemoveColumnFilesPages(WriteBatches & wbs) const
 {
     for (const auto & file : persisted_files)
         file->removeData(wbs);
+    if (auto page_id = delta_index_page_id.load(); page_id != 0)
+        wbs.removed_meta.delPage(page_id);
 }
 
 BlockPtr ColumnFilePersistedSet::getLastSchema()
@@ -236,7 +260,7 @@ bool ColumnFilePersistedSet::appendPersistedColumnFiles(const ColumnFilePersiste
         new_persisted_files.push_back(file);
     }
     /// Save the new metadata of column files to disk.
-    serializeColumnFilePersisteds(wbs, metadata_id, new_persisted_files);
+    serializeColumnFilePersisteds(wbs, metadata_id, new_persisted_files, delta_index_page_id.load());
     wbs.writeMeta();
 
     /// Commit updates in memory.
@@ -339,7 +363,7 @@ bool ColumnFilePersistedSet::installCompactionResults(const MinorCompactionPtr &
     checkColumnFiles(new_persisted_files);
 
     /// Save the new metadata of column files to disk.
-    serializeColumnFilePersisteds(wbs, metadata_id, new_persisted_files);
+    serializeColumnFilePersisteds(wbs, metadata_id, new_persisted_files, delta_index_page_id.load());
     wbs.writeMeta();
 
     /// Commit updates in memory.
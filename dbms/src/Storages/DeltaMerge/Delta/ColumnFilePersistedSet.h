@@ -52,6 +52,9 @@ class ColumnFilePersistedSet : public std::enable_shared_from_this<ColumnFilePer
 private:
     PageId metadata_id;
     ColumnFilePersisteds persisted_files;
+    // The page which stores the persisted delta index of these column files, 0 means there is no persisted delta index.
+    // It is saved along with the metadata, and its lifetime is the same as this instance.
+    std::atomic<PageId> delta_index_page_id = 0;
     // TODO: check the proper memory_order when use this atomic variable
     std::atomic<size_t> persisted_files_count = 0;
 
@@ -106,6 +109,9 @@ public:
 
     void saveMeta(WriteBatches & wbs) const;
 
+    /// Set the page of the persisted delta index, the metadata should be saved later.
+    void setDeltaIndexPageId(PageId page_id) { delta_index_page_id.store(page_id); }
+
     void recordRemoveColumnFilesPages(WriteBatches & wbs) const;
 
     BlockPtr getLastSchema();
@@ -127,6 +133,7 @@ public:
 
     /// Thread safe part start
     PageId getId() const { return metadata_id; }
+    PageId getDeltaIndexPageId() const { return delta_index_page_id.load(); }
 
     size_t getColumnFileCount() const { return persisted_files_count.load(); }
     size_t getRows() const { return rows.load(); }
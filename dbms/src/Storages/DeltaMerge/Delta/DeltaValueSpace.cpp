@@ -29,6 +29,8 @@ namespace DB
 {
 namespace DM
 {
+static constexpr size_t DELTA_INDEX_SERIALIZE_BUFFER_SIZE = 65536;
+
 // ================================================
 // Public methods
 // ================================================
@@ -229,6 +231,116 @@ void DeltaValueSpace::recordRemoveColumnFilesPages(WriteBatches & wbs) const
     mem_table_set->recordRemoveColumnFilesPages(wbs);
 }
 
+bool DeltaValueSpace::persistDeltaIndex(DMContext & context, size_t stable_rows)
+{
+    std::scoped_lock lock(mutex);
+    if (abandoned.load(std::memory_order_relaxed))
+        return false;
+
+    auto [placed_rows, placed_deletes] = delta_index->getPlacedStatus();
+    if (placed_rows == 0 && placed_deletes == 0)
+        return false;
+    // The rows in the mem table could be shuffled when they are flushed, and they are lost after restart.
+    // So only the index that places nothing but the persisted column files can be persisted.
+    if (placed_rows > persisted_file_set->getRows() || placed_deletes > persisted_file_set->getDeletes())
+        return false;
+
+    std::scoped_lock persisted_lock(persisted_delta_index_mutex);
+    if (persisted_delta_index_status == std::make_pair(placed_rows, placed_deletes))
+        return false;
+    // Every placement after flushing rewrites the whole index, so limit the frequency for the hot segments.
+    // The index persisted before is still valid, and the rest of the delta is placed after it is restored.
+    auto now = std::chrono::steady_clock::now();
+    if (last_persist_delta_index_time
+        && now - *last_persist_delta_index_time < std::chrono::seconds(context.persisted_delta_index_min_interval_seconds))
+        return false;
+
+    WriteBatches wbs(context.storage_pool, context.getWriteLimiter());
+    auto page_id = persisted_file_set->getDeltaIndexPageId();
+    const bool is_new_page = page_id == 0;
+    if (is_new_page)
+        page_id = context.storage_pool.newMetaPageId();
+
+    MemoryWriteBuffer buf(0, DELTA_INDEX_SERIALIZE_BUFFER_SIZE);
+    delta_index->serialize(buf);
+    writeIntBinary(static_cast<UInt64>(stable_rows), buf);
+    auto data_size = buf.count(); // Must be called before tryGetReadBuffer.
+    wbs.meta.putPage(page_id, 0, buf.tryGetReadBuffer(), data_size);
+    if (is_new_page)
+    {
+        // Reference the new page in the metadata of the column files, so that it can be found after restart.
+        persisted_file_set->setDeltaIndexPageId(page_id);
+        persisted_file_set->saveMeta(wbs);
+    }
+
+    try
+    {
+        wbs.writeMeta();
+    }
+    catch (...)
+    {
+        if (is_new_page)
+            persisted_file_set->setDeltaIndexPageId(0);
+        throw;
+    }
+
+    persisted_delta_index_status = {placed_rows, placed_deletes};
+    last_persist_delta_index_time = now;
+    LOG_DEBUG(log, "Persisted delta index, delta={} page_id={} placed_rows={} placed_deletes={} bytes={}", simpleInfo(), page_id, placed_rows, placed_deletes, data_size);
+    return true;
+}
+
+bool DeltaValueSpace::tryRestoreDeltaIndex(const DMContext & context, size_t stable_rows)
+{
+    auto page_id = persisted_file_set->getDeltaIndexPageId();
+    if (page_id == 0)
+        return false;
+    // Only restore the index when it is never placed or it has been evicted by the DeltaIndexManager.
+    if (auto [placed_rows, placed_deletes] = delta_index->getPlacedStatus(); placed_rows != 0 || placed_deletes != 0)
+        return false;
+
+    DeltaIndexPtr persisted_index;
+    UInt64 persisted_stable_rows = 0;
+    try
+    {
+        Page page = context.storage_pool.metaReader()->read(page_id);
+        ReadBufferFromMemory buf(page.data.begin(), page.data.size());
+        persisted_index = DeltaIndex::deserialize(buf);
+        readIntBinary(persisted_stable_rows, buf);
+    }
+    catch (DB::Exception & e)
+    {
+        // The page could be removed by a concurrent segment update, it is ok to place the delta again.
+        LOG_WARNING(log, "Failed to restore delta index, delta={} page_id={} err={}", simpleInfo(), page_id, e.message());
+        return false;
+    }
+
+    auto [placed_rows, placed_deletes] = persisted_index->getPlacedStatus();
+    if (persisted_stable_rows != stable_rows || placed_rows > persisted_file_set->getRows() || placed_deletes > persisted_file_set->getDeletes())
+    {
+        LOG_WARNING(
+            log,
+            "Persisted delta index does not match, delta={} page_id={} placed_rows={} placed_deletes={} stable_rows={} expected_stable_rows={}",
+            simpleInfo(),
+            page_id,
+            placed_rows,
+            placed_deletes,
+            persisted_stable_rows,
+            stable_rows);
+        return false;
+    }
+
+    {
+        // So that the same index is not written again after restart.
+        std::scoped_lock persisted_lock(persisted_delta_index_mutex);
+        persisted_delta_index_status = {placed_rows, placed_deletes};
+    }
+    bool restored = delta_index->updateIfAdvanced(*persisted_index);
+    if (restored)
+        LOG_DEBUG(log, "Restored delta index, delta={} page_id={} index={}", simpleInfo(), page_id, delta_index->toString());
+    return restored;
+}
+
 bool DeltaValueSpace::appendColumnFile(DMContext & /*context*/, const ColumnFilePtr & column_file)
 {
     std::scoped_lock lock(mutex);
@@ -33,6 +33,9 @@
 #include <Storages/DeltaMerge/StoragePool.h>
 #include <Storages/Page/PageDefines.h>
 
+#include <chrono>
+#include <optional>
+
 namespace DB
 {
 namespace DM
@@ -92,6 +95,12 @@ private:
     std::atomic<size_t> last_try_place_delta_index_rows = 0;
 
     DeltaIndexPtr delta_index;
+    /// Protects the status of the persisted delta index below.
+    std::mutex persisted_delta_index_mutex;
+    /// The placed status of the delta index stored in the page, known after it is persisted or restored by this instance.
+    std::pair<size_t, size_t> persisted_delta_index_status{0, 0};
+    /// The last time the delta index is persisted by this instance, used to limit the writes of the hot segments.
+    std::optional<std::chrono::steady_clock::time_point> last_persist_delta_index_time;
 
     // Protects the operations in this instance.
     // It is a recursive_mutex because the lock may be also used by the parent segment as its update lock.
@@ -147,6 +156,16 @@ public:
 
     void recordRemoveColumnFilesPages(WriteBatches & wbs) const;
 
+    /// Persist the shared delta index into the meta storage, so that it can be restored by `tryRestoreDeltaIndex`
+    /// instead of placing the delta again after it is evicted or after restart.
+    /// Returns false if nothing is persisted, e.g. the index places the mem table, it has been persisted already,
+    /// or it was persisted less than `dt_persisted_delta_index_min_interval_seconds` ago.
+    bool persistDeltaIndex(DMContext & context, size_t stable_rows);
+
+    /// Restore the shared delta index from the meta storage if it is empty.
+    /// Returns true if the shared delta index is restored.
+    bool tryRestoreDeltaIndex(const DMContext & context, size_t stable_rows);
+
     /**
      * Clone these newly appended column files since `update_snapshot` was created.
      * The clone is implemented by creating ref pages.
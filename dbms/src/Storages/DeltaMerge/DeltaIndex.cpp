@@ -0,0 +1,102 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <IO/ReadHelpers.h>
+#include <IO/WriteHelpers.h>
+#include <Storages/DeltaMerge/DeltaIndex.h>
+#include <Storages/FormatVersion.h>
+
+namespace DB
+{
+namespace ErrorCodes
+{
+extern const int LOGICAL_ERROR;
+} // namespace ErrorCodes
+
+namespace DM
+{
+void DeltaIndex::serialize(WriteBuffer & buf) const
+{
+    DeltaTreePtr delta_tree_copy;
+    size_t placed_rows_copy = 0;
+    size_t placed_deletes_copy = 0;
+    {
+        std::scoped_lock lock(mutex);
+        // The tree is never modified after it is set into a DeltaIndex, so it is safe to iterate it without lock.
+        delta_tree_copy = delta_tree;
+        placed_rows_copy = placed_rows;
+        placed_deletes_copy = placed_deletes;
+    }
+
+    writeIntBinary(DeltaIndexFormat::V1, buf);
+    writeIntBinary(static_cast<UInt64>(placed_rows_copy), buf);
+    writeIntBinary(static_cast<UInt64>(placed_deletes_copy), buf);
+    writeIntBinary(delta_tree_copy->maxDupTupleID(), buf);
+    writeIntBinary(static_cast<UInt64>(delta_tree_copy->numEntries()), buf);
+    // Write the rid instead of the sid, so that the tree can be rebuilt by replaying the entries in order.
+    for (auto it = delta_tree_copy->begin(), end = delta_tree_copy->end(); it != end; ++it)
+    {
+        writeIntBinary(static_cast<UInt64>(it.getRid()), buf);
+        writeIntBinary(static_cast<UInt8>(it.isInsert()), buf);
+        writeIntBinary(static_cast<UInt32>(it.getCount()), buf);
+        writeIntBinary(static_cast<UInt64>(it.getValue()), buf);
+    }
+}
+
+DeltaIndexPtr DeltaIndex::deserialize(ReadBuffer & buf)
+{
+    DeltaIndexFormat::Version version;
+    readIntBinary(version, buf);
+    if (version != DeltaIndexFormat::V1)
+        throw Exception(fmt::format("Illegal delta index version: {}", version), ErrorCodes::LOGICAL_ERROR);
+
+    UInt64 placed_rows = 0;
+    UInt64 placed_deletes = 0;
+    Int64 max_dup_tuple_id = 0;
+    UInt64 num_entries = 0;
+    readIntBinary(placed_rows, buf);
+    readIntBinary(placed_deletes, buf);
+    readIntBinary(max_dup_tuple_id, buf);
+    readIntBinary(num_entries, buf);
+
+    auto delta_tree = std::make_shared<DefaultDeltaTree>();
+    for (UInt64 i = 0; i < num_entries; ++i)
+    {
+        UInt64 rid = 0;
+        UInt8 is_insert = 0;
+        UInt32 count = 0;
+        UInt64 value = 0;
+        readIntBinary(rid, buf);
+        readIntBinary(is_insert, buf);
+        readIntBinary(count, buf);
+        readIntBinary(value, buf);
+
+        if (is_insert)
+        {
+            delta_tree->addInsert(rid, value);
+        }
+        else
+        {
+            // A delete entry covers `count` continuous rows, and the following rows move forward after each delete.
+            for (UInt32 n = 0; n < count; ++n)
+                delta_tree->addDelete(rid);
+        }
+    }
+    delta_tree->setMaxDupTupleID(max_dup_tuple_id);
+
+    return std::make_shared<DeltaIndex>(delta_tree, placed_rows, placed_deletes);
+}
+
+} // namespace DM
+} // namespace DB
@@ -20,6 +20,9 @@
 
 namespace DB
 {
+class ReadBuffer;
+class WriteBuffer;
+
 namespace DM
 {
 class DeltaIndex;
@@ -205,6 +208,13 @@ public:
      */
     DeltaIndexPtr tryClone(size_t rows, size_t deletes) { return tryCloneInner(rows, deletes); }
 
+    /**
+     * Serialize the placed status and the entries of the delta tree, so that the index can be restored
+     * by `deserialize` without placing the delta again.
+     */
+    void serialize(WriteBuffer & buf) const;
+    static DeltaIndexPtr deserialize(ReadBuffer & buf);
+
     DeltaIndexPtr cloneWithUpdates(const Updates & updates)
     {
         RUNTIME_CHECK_MSG(!updates.empty(), "Unexpected empty updates");
@@ -14,7 +14,9 @@
 
 #pragma once
 
+#include <Columns/ColumnsNumber.h>
 #include <Common/Exception.h>
+#include <Common/typeid_cast.h>
 #include <DataStreams/IBlockInputStream.h>
 #include <IO/ReadBufferFromFile.h>
 #include <IO/ReadHelpers.h>
@@ -32,7 +34,8 @@ namespace DM
 /// Note that the columns in stable input stream and value space must exactly the same, including name, type, and id.
 /// The first column must be PK column.
 /// This class does not guarantee that the rows in the return blocks are filltered by range.
-template <class DeltaValueReader, class IndexIterator, bool skippable_place = false>
+/// If `need_row_id` is true, an extra column of the row ids in the segment is appended to the return blocks, see `getSegmentRowIdColumnDefine`.
+template <class DeltaValueReader, class IndexIterator, bool skippable_place = false, bool need_row_id = false>
 class DeltaMergeBlockInputStream final : public SkippableBlockInputStream
     , Allocator<false>
 {
@@ -56,6 +59,14 @@ private:
     size_t sk_skip_total_rows = 0;
     Block sk_first_block;
 
+    /// Those vars are only used when need_row_id is true
+    // The row id of a delta row is its offset in delta plus the number of stable rows.
+    size_t delta_row_id_offset = 0;
+    // How many rows have been read or skipped from the stable input stream.
+    size_t stable_read_rows = 0;
+    size_t cur_stable_block_start_row_id = 0;
+    MutableColumnPtr row_id_column;
+
     DeltaValueReaderPtr delta_value_reader;
     IndexIterator delta_index_it;
     IndexIterator delta_index_end;
@@ -96,8 +107,10 @@ public:
                                const IndexIterator & delta_index_start_,
                                const IndexIterator & delta_index_end_,
                                const RowKeyRange rowkey_range_,
-                               size_t max_block_size_)
+                               size_t max_block_size_,
+                               size_t stable_rows_ = 0)
         : stable_input_stream(stable_input_stream_)
+        , delta_row_id_offset(stable_rows_)
         , delta_value_reader(delta_value_reader_)
         , delta_index_it(delta_index_start_)
         , delta_index_end(delta_index_end_)
@@ -114,6 +127,11 @@ public:
 
         header = stable_input_stream->getHeader();
         num_columns = header.columns();
+        if constexpr (need_row_id)
+        {
+            const auto & cd = getSegmentRowIdColumnDefine();
+            header.insert(ColumnWithTypeAndName(cd.type->createColumn(), cd.type, cd.name, cd.id));
+        }
 
         if (delta_index_it == delta_index_end)
         {
@@ -144,7 +162,7 @@ public:
             throw Exception("Call #getSkippedRows() more than once");
         ++sk_call_status;
 
-        stable_input_stream->getSkippedRows(sk_skip_stable_rows);
+        getStableSkippedRows(sk_skip_stable_rows);
         stable_ignore -= sk_skip_stable_rows;
 
         sk_first_block = doRead();
@@ -247,6 +265,8 @@ private:
             if (limit == max_block_size)
                 continue;
 
+            if constexpr (need_row_id)
+                columns.push_back(std::move(row_id_column));
             return header.cloneWithColumns(std::move(columns));
         }
         return {};
@@ -315,6 +335,23 @@ private:
         {
             columns[i] = header.safeGetByPosition(i).column->cloneEmpty();
         }
+
+        if constexpr (need_row_id)
+            row_id_column = header.safeGetByPosition(num_columns).column->cloneEmpty();
+    }
+
+    inline void getStableSkippedRows(size_t & skips)
+    {
+        stable_input_stream->getSkippedRows(skips);
+        if constexpr (need_row_id)
+            stable_read_rows += skips;
+    }
+
+    inline void writeRowIds(size_t start_row_id, size_t rows)
+    {
+        auto & row_ids = typeid_cast<ColumnUInt32 &>(*row_id_column).getData();
+        for (size_t i = 0; i < rows; ++i)
+            row_ids.push_back(static_cast<UInt32>(start_row_id + i));
     }
 
     inline size_t curStableBlockRemaining() { return cur_stable_block_rows - cur_stable_block_pos; }
@@ -342,6 +379,11 @@ private:
         cur_stable_block_rows = block.rows();
         for (size_t column_id = 0; column_id < num_columns; ++column_id)
             cur_stable_block_columns.push_back(block.getByPosition(column_id).column);
+        if constexpr (need_row_id)
+        {
+            cur_stable_block_start_row_id = stable_read_rows;
+            stable_read_rows += cur_stable_block_rows;
+        }
         return true;
     }
 
@@ -358,7 +400,7 @@ private:
             }
 
             size_t skips;
-            stable_input_stream->getSkippedRows(skips);
+            getStableSkippedRows(skips);
 
             if (skips > 0)
             {
@@ -404,7 +446,7 @@ private:
             }
 
             size_t skips;
-            stable_input_stream->getSkippedRows(skips);
+            getStableSkippedRows(skips);
 
             if (skips > 0)
             {
@@ -474,6 +516,9 @@ private:
             output_write_limit -= std::min(final_limit, output_write_limit);
         }
 
+        if constexpr (need_row_id)
+            writeRowIds(cur_stable_block_start_row_id + final_offset, final_limit);
+
         cur_stable_block_pos += copy_rows;
         use_stable_rows -= copy_rows;
     }
@@ -491,7 +536,11 @@ private:
 
         // Note that the rows between [use_delta_offset, use_delta_offset + write_rows) are guaranteed sorted,
         // otherwise we won't read them in the same range.
-        auto actual_write = delta_value_reader->readRows(output_columns, use_delta_offset, write_rows, &rowkey_range);
+        // When need_row_id is true, the rows are not filtered by range here so that the row ids are continuous,
+        // the caller should filter them later.
+        auto actual_write = delta_value_reader->readRows(output_columns, use_delta_offset, write_rows, need_row_id ? nullptr : &rowkey_range);
+        if constexpr (need_row_id)
+            writeRowIds(delta_row_id_offset + use_delta_offset, actual_write);
 
         if constexpr (skippable_place)
         {
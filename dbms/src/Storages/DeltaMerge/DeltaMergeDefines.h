@@ -113,17 +113,20 @@ inline static const UInt64 INITIAL_EPOCH = 0;
 #define VERSION_COLUMN_NAME ::DB::MutableSupport::version_column_name
 #define TAG_COLUMN_NAME ::DB::MutableSupport::delmark_column_name
 #define EXTRA_TABLE_ID_COLUMN_NAME ::DB::MutableSupport::extra_table_id_column_name
+#define SEGMENT_ROW_ID_COLUMN_NAME ::DB::MutableSupport::segment_row_id_column_name
 
 #define EXTRA_HANDLE_COLUMN_ID ::DB::TiDBPkColumnID
 #define VERSION_COLUMN_ID ::DB::VersionColumnID
 #define TAG_COLUMN_ID ::DB::DelMarkColumnID
 #define EXTRA_TABLE_ID_COLUMN_ID ::DB::ExtraTableIDColumnID
+#define SEGMENT_ROW_ID_COLUMN_ID ::DB::SegmentRowIdColumnID
 
 #define EXTRA_HANDLE_COLUMN_INT_TYPE ::DB::MutableSupport::tidb_pk_column_int_type
 #define EXTRA_HANDLE_COLUMN_STRING_TYPE ::DB::MutableSupport::tidb_pk_column_string_type
 #define VERSION_COLUMN_TYPE ::DB::MutableSupport::version_column_type
 #define TAG_COLUMN_TYPE ::DB::MutableSupport::delmark_column_type
 #define EXTRA_TABLE_ID_COLUMN_TYPE ::DB::MutableSupport::extra_table_id_column_type
+#define SEGMENT_ROW_ID_COLUMN_TYPE ::DB::MutableSupport::segment_row_id_column_type
 
 inline const ColumnDefine & getExtraIntHandleColumnDefine()
 {
@@ -156,6 +159,13 @@ inline const ColumnDefine & getExtraTableIDColumnDefine()
     static ColumnDefine EXTRA_TABLE_ID_COLUMN_DEFINE_{EXTRA_TABLE_ID_COLUMN_ID, EXTRA_TABLE_ID_COLUMN_NAME, EXTRA_TABLE_ID_COLUMN_TYPE};
     return EXTRA_TABLE_ID_COLUMN_DEFINE_;
 }
+/// The position of a row in the segment, the stable rows are numbered first and then the delta rows.
+/// It is only produced internally to build the `BitmapFilter`.
+inline const ColumnDefine & getSegmentRowIdColumnDefine()
+{
+    static ColumnDefine SEGMENT_ROW_ID_COLUMN_DEFINE_{SEGMENT_ROW_ID_COLUMN_ID, SEGMENT_ROW_ID_COLUMN_NAME, SEGMENT_ROW_ID_COLUMN_TYPE};
+    return SEGMENT_ROW_ID_COLUMN_DEFINE_;
+}
 
 static_assert(static_cast<Int64>(static_cast<UInt64>(std::numeric_limits<Int64>::min())) == std::numeric_limits<Int64>::min(), "Unsupported compiler!");
 static_assert(static_cast<Int64>(static_cast<UInt64>(std::numeric_limits<Int64>::max())) == std::numeric_limits<Int64>::max(), "Unsupported compiler!");
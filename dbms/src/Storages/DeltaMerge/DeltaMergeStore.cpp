@@ -979,10 +979,15 @@ BlockInputStreams DeltaMergeStore::read(const Context & db_context,
                                         size_t expected_block_size,
                                         const SegmentIdSet & read_segments,
                                         size_t extra_table_id_index,
-                                        const ScanContextPtr & scan_context)
+                                        const ScanContextPtr & scan_context,
+                                        const LateMaterializationFilterPtr & late_materialization_filter,
+                                        const PushDownAggregationPtr & push_down_aggregation)
 {
     // Use the id from MPP/Coprocessor level as tracing_id
     auto dm_context = newDMContext(db_context, db_settings, tracing_id, scan_context);
+    // Rows are not merged by MVCC in fast scan, so they can be filtered while reading stable.
+    if (is_fast_scan)
+        dm_context->late_materialization_filter = late_materialization_filter;
 
     // If keep order is required, disable read thread.
     auto enable_read_thread = db_context.getSettingsRef().dt_enable_read_thread && !keep_order;
@@ -998,11 +1003,37 @@ BlockInputStreams DeltaMergeStore::read(const Context & db_context,
              db_context.getSettingsRef().dt_enable_read_thread,
              enable_read_thread);
 
+    // The pack statistics only tell the latest versions in normal mode.
+    if (push_down_aggregation && !is_fast_scan)
+        aggregateByPackStats(*dm_context, columns_to_read, tasks, filter, max_version, *push_down_aggregation, tracing_logger);
+
+    // When only a few large segments are read, split them by the stable packs so that they can be read by several streams.
+    // Every sub-task reads a disjoint key range, so the MVCC merge of a segment is also done in parallel in normal mode.
+    // The read thread schedules the tasks by segment id, so fall back to the normal read streams after splitting.
+    const auto split_min_packs = db_context.getSettingsRef().dt_read_task_split_min_packs;
+    if (!keep_order && split_min_packs > 0 && tasks.size() < num_streams)
+    {
+        auto split_tasks = SegmentReadTask::trySplitReadTasksByPacks(*dm_context, tasks, filter, num_streams, split_min_packs);
+        if (split_tasks.size() > tasks.size())
+        {
+            LOG_INFO(tracing_logger, "Split read tasks by packs, tasks {} => {}, enable_read_thread={} => false", tasks.size(), split_tasks.size(), enable_read_thread);
+            tasks = std::move(split_tasks);
+            enable_read_thread = false;
+        }
+    }
+
     auto after_segment_read = [&](const DMContextPtr & dm_context_, const SegmentPtr & segment_) {
         // TODO: Update the tracing_id before checkSegmentUpdate?
         this->checkSegmentUpdate(dm_context_, segment_, ThreadType::Read);
     };
 
+    // The bitmap filter doesn't keep the order of PK.
+    ReadMode read_mode = ReadMode::Normal;
+    if (is_fast_scan)
+        read_mode = ReadMode::Fast;
+    else if (db_context.getSettingsRef().dt_enable_bitmap_filter && !keep_order)
+        read_mode = ReadMode::Bitmap;
+
     GET_METRIC(tiflash_storage_read_tasks_count).Increment(tasks.size());
     size_t final_num_stream = std::max(1, std::min(num_streams, tasks.size()));
     auto read_task_pool = std::make_shared<SegmentReadTaskPool>(
@@ -1012,7 +1043,7 @@ BlockInputStreams DeltaMergeStore::read(const Context & db_context,
         filter,
         max_version,
         expected_block_size,
-        /* read_mode = */ is_fast_scan ? ReadMode::Fast : ReadMode::Normal,
+        read_mode,
         std::move(tasks),
         after_segment_read,
         log_tracing_id,
@@ -1042,7 +1073,7 @@ BlockInputStreams DeltaMergeStore::read(const Context & db_context,
                 filter,
                 max_version,
                 expected_block_size,
-                /* read_mode = */ is_fast_scan ? ReadMode::Fast : ReadMode::Normal,
+                read_mode,
                 extra_table_id_index,
                 physical_table_id,
                 log_tracing_id);
@@ -1054,6 +1085,49 @@ BlockInputStreams DeltaMergeStore::read(const Context & db_context,
     return res;
 }
 
+void DeltaMergeStore::aggregateByPackStats(
+    const DMContext & dm_context,
+    const ColumnDefines & columns_to_read,
+    SegmentReadTasks & tasks,
+    const RSOperatorPtr & filter,
+    UInt64 max_version,
+    PushDownAggregation & aggregation,
+    const LoggerPtr & tracing_logger)
+{
+    Stopwatch watch;
+    auto result = aggregation.createEmptyResult();
+    size_t removed_tasks = 0;
+    for (auto it = tasks.begin(); it != tasks.end();)
+    {
+        auto & task = *it;
+        task->ranges = task->segment->aggregateByPackStats(
+            dm_context,
+            columns_to_read,
+            task->read_snapshot,
+            task->ranges,
+            filter,
+            max_version,
+            aggregation,
+            result);
+        // Empty ranges means reading the whole segment, so remove the task instead.
+        if (task->ranges.empty())
+        {
+            it = tasks.erase(it);
+            ++removed_tasks;
+        }
+        else
+            ++it;
+    }
+    LOG_INFO(
+        tracing_logger,
+        "Aggregate by pack stats done, answered_packs={} answered_rows={} removed_tasks={} cost={}ms",
+        result.packs,
+        result.rows,
+        removed_tasks,
+        watch.elapsedMilliseconds());
+    aggregation.setResult(physical_table_id, std::move(result));
+}
+
 size_t forceMergeDeltaRows(const DMContextPtr & dm_context)
 {
     return dm_context->db_context.getSettingsRef().dt_segment_force_merge_delta_rows;
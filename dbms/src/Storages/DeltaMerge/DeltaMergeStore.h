@@ -21,6 +21,8 @@
 #include <Storages/AlterCommands.h>
 #include <Storages/BackgroundProcessingPool.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
+#include <Storages/DeltaMerge/Filter/LateMaterializationFilter.h>
+#include <Storages/DeltaMerge/PushDownAggregation.h>
 #include <Storages/DeltaMerge/RowKeyRange.h>
 #include <Storages/DeltaMerge/ScanContext.h>
 #include <Storages/DeltaMerge/SegmentReadTaskPool.h>
@@ -319,7 +321,9 @@ public:
                            size_t expected_block_size = DEFAULT_BLOCK_SIZE,
                            const SegmentIdSet & read_segments = {},
                            size_t extra_table_id_index = InvalidColumnID,
-                           const ScanContextPtr & scan_context = std::make_shared<ScanContext>());
+                           const ScanContextPtr & scan_context = std::make_shared<ScanContext>(),
+                           const LateMaterializationFilterPtr & late_materialization_filter = nullptr,
+                           const PushDownAggregationPtr & push_down_aggregation = nullptr);
 
     /// Try flush all data in `range` to disk and return whether the task succeed.
     bool flushCache(const Context & context, const RowKeyRange & range, bool try_until_succeed = true)
@@ -583,6 +587,17 @@ private:
                                           bool try_split_task = true,
                                           const ScanContextPtr & scan_context = nullptr);
 
+    /// Answer `aggregation` by the pack statistics of the segments in `tasks`, the answered rows are excluded
+    /// from the ranges of tasks, and the tasks with nothing left to read are removed.
+    void aggregateByPackStats(
+        const DMContext & dm_context,
+        const ColumnDefines & columns_to_read,
+        SegmentReadTasks & tasks,
+        const RSOperatorPtr & filter,
+        UInt64 max_version,
+        PushDownAggregation & aggregation,
+        const LoggerPtr & tracing_logger);
+
 private:
     void dropAllSegments(bool keep_first_segment);
     String getLogTracingId(const DMContext & dm_ctx);
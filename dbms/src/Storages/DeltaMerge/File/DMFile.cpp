@@ -54,6 +54,7 @@ inline constexpr static const char * FOLDER_PREFIX_DROPPED = ".del.dmf_";
 inline constexpr static const char * DATA_FILE_SUFFIX = ".dat";
 inline constexpr static const char * INDEX_FILE_SUFFIX = ".idx";
 inline constexpr static const char * MARK_FILE_SUFFIX = ".mrk";
+inline constexpr static const char * EQUAL_INDEX_FILE_SUFFIX = ".eqidx";
 
 inline String getNGCPath(const String & prefix, bool is_single_mode)
 {
@@ -199,6 +200,18 @@ String DMFile::colMarkCacheKey(const FileNameBase & file_name_base) const
     }
 }
 
+String DMFile::colEqualIndexCacheKey(const FileNameBase & file_name_base) const
+{
+    if (isSingleFileMode())
+    {
+        return path() + "/" + DMFile::colEqualIndexFileName(file_name_base);
+    }
+    else
+    {
+        return colEqualIndexPath(file_name_base);
+    }
+}
+
 bool DMFile::isColIndexExist(const ColId & col_id) const
 {
     if (isSingleFileMode())
@@ -233,6 +246,11 @@ EncryptionPath DMFile::encryptionMarkPath(const FileNameBase & file_name_base) c
     return EncryptionPath(encryptionBasePath(), isSingleFileMode() ? "" : file_name_base + details::MARK_FILE_SUFFIX);
 }
 
+EncryptionPath DMFile::encryptionEqualIndexPath(const FileNameBase & file_name_base) const
+{
+    return EncryptionPath(encryptionBasePath(), isSingleFileMode() ? "" : file_name_base + details::EQUAL_INDEX_FILE_SUFFIX);
+}
+
 EncryptionPath DMFile::encryptionMetaPath() const
 {
     return EncryptionPath(encryptionBasePath(), isSingleFileMode() ? "" : metaFileName());
@@ -265,6 +283,10 @@ String DMFile::colMarkFileName(const FileNameBase & file_name_base)
 {
     return file_name_base + details::MARK_FILE_SUFFIX;
 }
+String DMFile::colEqualIndexFileName(const FileNameBase & file_name_base)
+{
+    return file_name_base + details::EQUAL_INDEX_FILE_SUFFIX;
+}
 
 DMFile::OffsetAndSize DMFile::writeMetaToBuffer(WriteBuffer & buffer)
 {
@@ -815,7 +837,7 @@ void DMFile::initializeSubFileStatsForFolderMode()
     for (const auto & name : sub_files)
     {
         if (endsWith(name, details::DATA_FILE_SUFFIX) || endsWith(name, details::INDEX_FILE_SUFFIX)
-            || endsWith(name, details::MARK_FILE_SUFFIX))
+            || endsWith(name, details::MARK_FILE_SUFFIX) || endsWith(name, details::EQUAL_INDEX_FILE_SUFFIX))
         {
             auto size = Poco::File(path() + "/" + name).getSize();
             sub_file_stats.emplace(name, SubFileStat{0, size});
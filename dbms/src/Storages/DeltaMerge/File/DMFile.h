@@ -328,22 +328,29 @@ private:
     String colDataPath(const FileNameBase & file_name_base) const { return subFilePath(colDataFileName(file_name_base)); }
     String colIndexPath(const FileNameBase & file_name_base) const { return subFilePath(colIndexFileName(file_name_base)); }
     String colMarkPath(const FileNameBase & file_name_base) const { return subFilePath(colMarkFileName(file_name_base)); }
+    String colEqualIndexPath(const FileNameBase & file_name_base) const { return subFilePath(colEqualIndexFileName(file_name_base)); }
 
     String colIndexCacheKey(const FileNameBase & file_name_base) const;
     String colMarkCacheKey(const FileNameBase & file_name_base) const;
+    String colEqualIndexCacheKey(const FileNameBase & file_name_base) const;
 
     size_t colIndexOffset(const FileNameBase & file_name_base) const { return subFileOffset(colIndexFileName(file_name_base)); }
     size_t colMarkOffset(const FileNameBase & file_name_base) const { return subFileOffset(colMarkFileName(file_name_base)); }
     size_t colIndexSize(const FileNameBase & file_name_base) const { return subFileSize(colIndexFileName(file_name_base)); }
     size_t colMarkSize(const FileNameBase & file_name_base) const { return subFileSize(colMarkFileName(file_name_base)); }
     size_t colDataSize(const FileNameBase & file_name_base) const { return subFileSize(colDataFileName(file_name_base)); }
+    size_t colEqualIndexOffset(const FileNameBase & file_name_base) const { return subFileOffset(colEqualIndexFileName(file_name_base)); }
+    size_t colEqualIndexSize(const FileNameBase & file_name_base) const { return subFileSize(colEqualIndexFileName(file_name_base)); }
 
     bool isColIndexExist(const ColId & col_id) const;
+    // The equal index is optional, the DTFiles written by old versions don't have it.
+    bool isColEqualIndexExist(const ColId & col_id) const { return isSubFileExists(colEqualIndexFileName(getFileNameBase(col_id))); }
 
     String encryptionBasePath() const;
     EncryptionPath encryptionDataPath(const FileNameBase & file_name_base) const;
     EncryptionPath encryptionIndexPath(const FileNameBase & file_name_base) const;
     EncryptionPath encryptionMarkPath(const FileNameBase & file_name_base) const;
+    EncryptionPath encryptionEqualIndexPath(const FileNameBase & file_name_base) const;
     EncryptionPath encryptionMetaPath() const;
     EncryptionPath encryptionPackStatPath() const;
     EncryptionPath encryptionPackPropertyPath() const;
@@ -362,6 +369,7 @@ private:
     static String colDataFileName(const FileNameBase & file_name_base);
     static String colIndexFileName(const FileNameBase & file_name_base);
     static String colMarkFileName(const FileNameBase & file_name_base);
+    static String colEqualIndexFileName(const FileNameBase & file_name_base);
 
     using OffsetAndSize = std::tuple<size_t, size_t>;
     OffsetAndSize writeMetaToBuffer(WriteBuffer & buffer);
@@ -25,6 +25,8 @@ DMFileBlockInputStreamBuilder::DMFileBlockInputStreamBuilder(const Context & con
     // init from global context
     const auto & global_context = context.getGlobalContext();
     setCaches(global_context.getMarkCache(), global_context.getMinMaxIndexCache());
+    equal_index_cache = global_context.getEqualIndexCache();
+    pack_cache = global_context.getDMFilePackCache();
     // init from settings
     setFromSettings(context.getSettingsRef());
 }
@@ -50,7 +52,8 @@ DMFileBlockInputStreamPtr DMFileBlockInputStreamBuilder::build(const DMFilePtr &
         file_provider,
         read_limiter,
         scan_context,
-        tracing_id);
+        tracing_id,
+        equal_index_cache);
 
     bool enable_read_thread = SegmentReaderPoolManager::instance().isSegmentReader();
 
@@ -72,6 +75,7 @@ DMFileBlockInputStreamPtr DMFileBlockInputStreamBuilder::build(const DMFilePtr &
         mark_cache,
         enable_column_cache,
         column_cache,
+        enable_pack_cache ? pack_cache : nullptr,
         aio_threshold,
         max_read_buffer_size,
         file_provider,
@@ -80,7 +84,8 @@ DMFileBlockInputStreamPtr DMFileBlockInputStreamBuilder::build(const DMFilePtr &
         read_one_pack_every_time,
         tracing_id,
         max_sharing_column_bytes_for_all,
-        scan_context);
+        scan_context,
+        late_materialization_filter);
 
     return std::make_shared<DMFileBlockInputStream>(std::move(reader), max_sharing_column_bytes_for_all > 0);
 }
@@ -115,6 +115,13 @@ public:
         return *this;
     }
 
+    // Only set it when the rows can be filtered independently, i.e. in fast scan mode.
+    DMFileBlockInputStreamBuilder & setLateMaterializationFilter(const LateMaterializationFilterPtr & late_materialization_filter_)
+    {
+        late_materialization_filter = late_materialization_filter_;
+        return *this;
+    }
+
     DMFileBlockInputStreamBuilder & setReadPacks(const IdSetPtr & read_packs_)
     {
         read_packs = read_packs_;
@@ -128,6 +135,13 @@ public:
         return *this;
     }
 
+    DMFileBlockInputStreamBuilder & setPackCache(const DMFilePackCachePtr & pack_cache_)
+    {
+        // note that it only takes effect when `enable_pack_cache` is true (see `setFromSettings`)
+        pack_cache = pack_cache_;
+        return *this;
+    }
+
     DMFileBlockInputStreamBuilder & onlyReadOnePackEveryTime()
     {
         read_one_pack_every_time = true;
@@ -151,6 +165,7 @@ private:
     DMFileBlockInputStreamBuilder & setFromSettings(const Settings & settings)
     {
         enable_column_cache = settings.dt_enable_stable_column_cache;
+        enable_pack_cache = settings.dt_enable_stable_pack_cache;
         aio_threshold = settings.min_bytes_to_use_direct_io;
         max_read_buffer_size = settings.max_read_buffer_size;
         max_sharing_column_bytes_for_all = settings.dt_max_sharing_column_bytes_for_all;
@@ -174,13 +189,18 @@ private:
     UInt64 max_data_version = std::numeric_limits<UInt64>::max();
     // Rough set filter
     RSOperatorPtr rs_filter;
+    LateMaterializationFilterPtr late_materialization_filter;
     // packs filter (filter by pack index)
     IdSetPtr read_packs{};
     MarkCachePtr mark_cache;
     MinMaxIndexCachePtr index_cache;
+    EqualIndexCachePtr equal_index_cache;
     // column cache
     bool enable_column_cache = false;
     ColumnCachePtr column_cache;
+    // decompressed pack cache
+    bool enable_pack_cache = false;
+    DMFilePackCachePtr pack_cache;
     ReadLimiterPtr read_limiter;
     size_t aio_threshold{};
     size_t max_read_buffer_size{};
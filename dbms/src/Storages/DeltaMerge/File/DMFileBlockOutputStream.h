@@ -47,7 +47,9 @@ public:
                 CompressionSettings(context.getSettingsRef().dt_compression_method, context.getSettingsRef().dt_compression_level),
                 context.getSettingsRef().min_compress_block_size,
                 context.getSettingsRef().max_compress_block_size,
-                flags})
+                flags,
+                context.getSettingsRef().dt_enable_equal_index,
+                context.getSettingsRef().dt_enable_lightweight_compression})
     {
     }
 
@@ -0,0 +1,114 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Columns/IColumn.h>
+#include <Common/LRUCache.h>
+#include <Common/ProfileEvents.h>
+#include <Storages/DeltaMerge/DeltaMergeDefines.h>
+#include <fmt/format.h>
+
+#include <memory>
+
+namespace ProfileEvents
+{
+extern const Event DMFilePackCacheHits;
+extern const Event DMFilePackCacheMisses;
+} // namespace ProfileEvents
+
+namespace DB
+{
+namespace DM
+{
+/// The decompressed data of some continuous packs of a column in DMFile.
+struct CachedPacks
+{
+    ColumnPtr column;
+};
+
+struct CachedPacksWeightFunction
+{
+    size_t operator()(const String & key, const CachedPacks & packs) const
+    {
+        // 1. the memory cost of the cached column
+        auto column_memory_usage = packs.column->allocatedBytes(); // column data
+        auto cells_memory_usage = 32; // Cells struct memory cost
+
+        // 2. the memory cost of key part
+        auto str_len = key.size(); // key_len
+        auto key_memory_usage = sizeof(String); // String struct memory cost
+
+        // 3. the memory cost of hash table
+        auto unordered_map_memory_usage = 28; // hash table struct approximate memory cost
+
+        // 4. the memory cost of LRUQueue
+        auto list_memory_usage = sizeof(std::list<String>); // list struct memory cost
+
+        return column_memory_usage + cells_memory_usage + str_len * 2 + key_memory_usage * 2 + unordered_map_memory_usage
+            + list_memory_usage;
+    }
+};
+
+/** Global cache of the decompressed column data of stable DMFiles, keyed by (DMFile, column, pack range).
+  * DMFiles are immutable, so the cached data never goes stale. It saves both the IO and the decompression
+  * of the hot small tables (e.g. dimension tables in joins) that are scanned again and again by different
+  * queries, which `ColumnSharingCache` can not help because it only shares data among concurrent readers.
+  */
+class DMFilePackCache : public LRUCache<String, CachedPacks, std::hash<String>, CachedPacksWeightFunction>
+{
+private:
+    using Base = LRUCache<String, CachedPacks, std::hash<String>, CachedPacksWeightFunction>;
+
+public:
+    explicit DMFilePackCache(size_t max_size_in_bytes)
+        : Base(max_size_in_bytes)
+        , max_entry_bytes(max_size_in_bytes / 8)
+    {}
+
+    static String key(const String & dmfile_path, ColId col_id, size_t start_pack_id, size_t pack_count)
+    {
+        return fmt::format("{}/{}/{}/{}", dmfile_path, col_id, start_pack_id, pack_count);
+    }
+
+    ColumnPtr getColumn(const Key & key)
+    {
+        auto packs = Base::get(key);
+        if (!packs)
+        {
+            ProfileEvents::increment(ProfileEvents::DMFilePackCacheMisses);
+            return nullptr;
+        }
+        ProfileEvents::increment(ProfileEvents::DMFilePackCacheHits);
+        return packs->column;
+    }
+
+    // Large pack ranges are not cached, so that one big scan can not flush all the hot entries out.
+    // The caller checks it with the estimated size before reading the column, so that only the columns
+    // to be cached are read outside the MemoryTracker of the query.
+    bool canCache(size_t estimated_bytes) const { return estimated_bytes <= max_entry_bytes; }
+
+    void putColumn(const Key & key, const ColumnPtr & column)
+    {
+        Base::set(key, std::make_shared<CachedPacks>(CachedPacks{column}));
+    }
+
+private:
+    const size_t max_entry_bytes;
+};
+
+using DMFilePackCachePtr = std::shared_ptr<DMFilePackCache>;
+
+} // namespace DM
+} // namespace DB
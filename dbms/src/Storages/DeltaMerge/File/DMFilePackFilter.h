@@ -57,15 +57,27 @@ public:
         const FileProviderPtr & file_provider,
         const ReadLimiterPtr & read_limiter,
         const ScanContextPtr & scan_context,
-        const String & tracing_id)
+        const String & tracing_id,
+        const EqualIndexCachePtr & equal_index_cache = nullptr)
     {
-        auto pack_filter = DMFilePackFilter(dmfile, index_cache, set_cache_if_miss, rowkey_ranges, filter, read_packs, file_provider, read_limiter, scan_context, tracing_id);
+        auto pack_filter = DMFilePackFilter(dmfile, index_cache, set_cache_if_miss, rowkey_ranges, filter, read_packs, file_provider, read_limiter, scan_context, tracing_id, equal_index_cache);
         pack_filter.init();
         return pack_filter;
     }
 
     inline const std::vector<RSResult> & getHandleRes() const { return handle_res; }
     inline const std::vector<UInt8> & getUsePacks() const { return use_packs; }
+    // The rough check result of every pack by both the rowkey ranges and the filter, `All` means all the rows
+    // in the pack are in the ranges and (rough) matched by the filter. It is `None` for the packs not used.
+    inline const std::vector<RSResult> & getPackRes() const { return pack_res; }
+
+    // Return nullptr if the index of the column does not exist.
+    MinMaxIndexPtr getMinMaxIndex(ColId col_id)
+    {
+        tryLoadIndex(col_id);
+        auto iter = param.indexes.find(col_id);
+        return iter == param.indexes.end() ? nullptr : iter->second.minmax;
+    }
 
     Handle getMinHandle(size_t pack_id)
     {
@@ -118,9 +130,11 @@ private:
                      const FileProviderPtr & file_provider_,
                      const ReadLimiterPtr & read_limiter_,
                      const ScanContextPtr & scan_context_,
-                     const String & tracing_id)
+                     const String & tracing_id,
+                     const EqualIndexCachePtr & equal_index_cache_)
         : dmfile(dmfile_)
         , index_cache(index_cache_)
+        , equal_index_cache(equal_index_cache_)
         , set_cache_if_miss(set_cache_if_miss_)
         , rowkey_ranges(rowkey_ranges_)
         , filter(filter_)
@@ -128,6 +142,7 @@ private:
         , file_provider(file_provider_)
         , handle_res(dmfile->getPacks(), RSResult::All)
         , use_packs(dmfile->getPacks())
+        , pack_res(dmfile->getPacks(), RSResult::None)
         , scan_context(scan_context_)
         , log(Logger::get(tracing_id))
         , read_limiter(read_limiter_)
@@ -223,13 +238,22 @@ private:
             for (auto & attr : attrs)
             {
                 tryLoadIndex(attr.col_id);
+                tryLoadEqualIndex(attr.col_id);
             }
 
             for (size_t i = 0; i < pack_count; ++i)
             {
-                use_packs[i] = (static_cast<bool>(use_packs[i])) && (filter->roughCheck(i, param) != None);
+                if (!use_packs[i])
+                    continue;
+                pack_res[i] = handle_res[i] && filter->roughCheck(i, param);
+                use_packs[i] = pack_res[i] != None;
             }
         }
+        else
+        {
+            for (size_t i = 0; i < pack_count; ++i)
+                pack_res[i] = use_packs[i] ? handle_res[i] : None;
+        }
 
         for (auto u : use_packs)
             after_filter += u;
@@ -311,6 +335,60 @@ private:
         indexes.emplace(col_id, RSIndex(type, minmax_index));
     }
 
+    static EqualIndexPtr loadEqualIndex(const DMFilePtr & dmfile,
+                                        const FileProviderPtr & file_provider,
+                                        const EqualIndexCachePtr & equal_index_cache,
+                                        bool set_cache_if_miss,
+                                        ColId col_id,
+                                        const ReadLimiterPtr & read_limiter)
+    {
+        const auto file_name_base = DMFile::getFileNameBase(col_id);
+
+        auto load = [&]() {
+            auto index_file_size = dmfile->colEqualIndexSize(file_name_base);
+            if (!dmfile->configuration)
+            {
+                auto index_buf = ReadBufferFromFileProvider(
+                    file_provider,
+                    dmfile->colEqualIndexPath(file_name_base),
+                    dmfile->encryptionEqualIndexPath(file_name_base),
+                    std::min(static_cast<size_t>(DBMS_DEFAULT_BUFFER_SIZE), index_file_size),
+                    read_limiter);
+                index_buf.seek(dmfile->colEqualIndexOffset(file_name_base));
+                return EqualIndex::read(index_buf, index_file_size);
+            }
+            else
+            {
+                auto index_buf = createReadBufferFromFileBaseByFileProvider(file_provider,
+                                                                            dmfile->colEqualIndexPath(file_name_base),
+                                                                            dmfile->encryptionEqualIndexPath(file_name_base),
+                                                                            index_file_size,
+                                                                            read_limiter,
+                                                                            dmfile->configuration->getChecksumAlgorithm(),
+                                                                            dmfile->configuration->getChecksumFrameLength());
+                index_buf->seek(dmfile->colEqualIndexOffset(file_name_base));
+                auto header_size = dmfile->configuration->getChecksumHeaderLength();
+                auto frame_total_size = dmfile->configuration->getChecksumFrameLength() + header_size;
+                auto frame_count = index_file_size / frame_total_size + (index_file_size % frame_total_size != 0);
+                return EqualIndex::read(*index_buf, index_file_size - header_size * frame_count);
+            }
+        };
+        EqualIndexPtr equal_index;
+        if (equal_index_cache && set_cache_if_miss)
+        {
+            equal_index = equal_index_cache->getOrSet(dmfile->colEqualIndexCacheKey(file_name_base), load);
+        }
+        else
+        {
+            // try load from the cache first
+            if (equal_index_cache)
+                equal_index = equal_index_cache->get(dmfile->colEqualIndexCacheKey(file_name_base));
+            if (equal_index == nullptr)
+                equal_index = load();
+        }
+        return equal_index;
+    }
+
     void tryLoadIndex(const ColId col_id)
     {
         if (param.indexes.count(col_id))
@@ -325,9 +403,26 @@ private:
         scan_context->total_dmfile_rough_set_index_load_time_ms += watch.elapsedMilliseconds();
     }
 
+    // The equal index is only used along with the min/max index, see `Equal` and `In`.
+    void tryLoadEqualIndex(const ColId col_id)
+    {
+        auto iter = param.indexes.find(col_id);
+        if (iter == param.indexes.end() || iter->second.equal)
+            return;
+
+        if (!dmfile->isColEqualIndexExist(col_id))
+            return;
+
+        Stopwatch watch;
+        iter->second.equal = loadEqualIndex(dmfile, file_provider, equal_index_cache, set_cache_if_miss, col_id, read_limiter);
+
+        scan_context->total_dmfile_rough_set_index_load_time_ms += watch.elapsedMilliseconds();
+    }
+
 private:
     DMFilePtr dmfile;
     MinMaxIndexCachePtr index_cache;
+    EqualIndexCachePtr equal_index_cache;
     bool set_cache_if_miss;
     RowKeyRanges rowkey_ranges;
     RSOperatorPtr filter;
@@ -338,6 +433,7 @@ private:
 
     std::vector<RSResult> handle_res;
     std::vector<UInt8> use_packs;
+    std::vector<RSResult> pack_res;
 
     const ScanContextPtr scan_context;
 
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnsCommon.h>
+#include <Columns/FilterDescription.h>
 #include <Common/CurrentMetrics.h>
 #include <Common/MemoryTracker.h>
 #include <Common/Stopwatch.h>
@@ -31,6 +33,8 @@
 #include <Storages/Page/PageUtil.h>
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <optional>
 #include <utility>
 
 namespace CurrentMetrics
@@ -227,6 +231,7 @@ DMFileReader::DMFileReader(
     const MarkCachePtr & mark_cache_,
     bool enable_column_cache_,
     const ColumnCachePtr & column_cache_,
+    const DMFilePackCachePtr & pack_cache_,
     size_t aio_threshold,
     size_t max_read_buffer_size,
     const FileProviderPtr & file_provider_,
@@ -235,7 +240,8 @@ DMFileReader::DMFileReader(
     bool read_one_pack_every_time_,
     const String & tracing_id_,
     size_t max_sharing_column_bytes_,
-    const ScanContextPtr & scan_context_)
+    const ScanContextPtr & scan_context_,
+    const LateMaterializationFilterPtr & late_materialization_filter_)
     : dmfile(dmfile_)
     , read_columns(read_columns_)
     , is_common_handle(is_common_handle_)
@@ -246,10 +252,12 @@ DMFileReader::DMFileReader(
     , is_fast_scan(is_fast_scan_)
     , max_read_version(max_read_version_)
     , pack_filter(std::move(pack_filter_))
+    , late_materialization_filter(is_fast_scan_ ? late_materialization_filter_ : nullptr)
     , skip_packs_by_column(read_columns.size(), 0)
     , mark_cache(mark_cache_)
     , enable_column_cache(enable_column_cache_ && column_cache_)
     , column_cache(column_cache_)
+    , pack_cache(pack_cache_)
     , scan_context(scan_context_)
     , rows_threshold_per_read(rows_threshold_per_read_)
     , max_sharing_column_bytes(max_sharing_column_bytes_)
@@ -286,6 +294,29 @@ DMFileReader::DMFileReader(
             last_read_from_cache[cd.id] = false;
         }
     }
+    if (late_materialization_filter)
+    {
+        // Late materialization only makes sense when the filter depends on a part of the columns
+        // to read, and the filter can be executed on the columns read by this reader.
+        std::vector<size_t> positions;
+        bool all_found = true;
+        for (const auto & name : late_materialization_filter->before_where->getRequiredColumns())
+        {
+            auto iter = std::find_if(read_columns.begin(), read_columns.end(), [&](const ColumnDefine & cd) { return cd.name == name; });
+            if (iter == read_columns.end())
+            {
+                all_found = false;
+                break;
+            }
+            positions.push_back(iter - read_columns.begin());
+        }
+        if (all_found && !positions.empty() && positions.size() < read_columns.size())
+        {
+            std::sort(positions.begin(), positions.end());
+            positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+            filter_column_positions = std::move(positions);
+        }
+    }
 }
 
 bool DMFileReader::shouldSeek(size_t pack_id)
@@ -318,12 +349,8 @@ inline bool isCacheableColumn(const ColumnDefine & cd)
     return cd.id == EXTRA_HANDLE_COLUMN_ID || cd.id == VERSION_COLUMN_ID;
 }
 
-Block DMFileReader::read()
+bool DMFileReader::getNextPackRange(PackRange & pack_range)
 {
-    Stopwatch watch;
-    SCOPE_EXIT(
-        scan_context->total_dmfile_read_time_ms += watch.elapsedMilliseconds(););
-
     // Go to next available pack.
     size_t skip_rows;
 
@@ -331,7 +358,7 @@ Block DMFileReader::read()
 
     const auto & use_packs = pack_filter.getUsePacks();
     if (next_pack_id >= use_packs.size())
-        return {};
+        return false;
     // Find max continuing rows we can read.
     size_t start_pack_id = next_pack_id;
     // When single_file_mode is true, or read_one_pack_every_time is true, we can just read one pack every time.
@@ -371,9 +398,7 @@ Block DMFileReader::read()
     }
 
     if (read_rows == 0)
-        return {};
-
-    Block res;
+        return false;
 
     size_t read_packs = next_pack_id - start_pack_id;
 
@@ -385,172 +410,256 @@ Block DMFileReader::read()
     scan_context->total_dmfile_scanned_packs += read_packs;
     scan_context->total_dmfile_scanned_rows += read_rows;
 
-    // TODO: this will need better algorithm: we should separate those packs which can and can not do clean read.
-    bool do_clean_read_on_normal_mode = enable_handle_clean_read && expected_handle_res == All && not_clean_rows == 0 && (!is_fast_scan);
+    pack_range.start_pack_id = start_pack_id;
+    pack_range.read_packs = read_packs;
+    pack_range.read_rows = read_rows;
 
-    bool do_clean_read_on_handle_on_fast_mode = enable_handle_clean_read && is_fast_scan && expected_handle_res == All;
-    bool do_clean_read_on_del_on_fast_mode = enable_del_clean_read && is_fast_scan && deleted_rows == 0;
+    // TODO: this will need better algorithm: we should separate those packs which can and can not do clean read.
+    pack_range.do_clean_read_on_normal_mode = enable_handle_clean_read && expected_handle_res == All && not_clean_rows == 0 && (!is_fast_scan);
 
+    pack_range.do_clean_read_on_handle_on_fast_mode = enable_handle_clean_read && is_fast_scan && expected_handle_res == All;
+    pack_range.do_clean_read_on_del_on_fast_mode = enable_del_clean_read && is_fast_scan && deleted_rows == 0;
 
-    if (do_clean_read_on_normal_mode)
+    if (pack_range.do_clean_read_on_normal_mode)
     {
         UInt64 max_version = 0;
         for (size_t pack_id = start_pack_id; pack_id < next_pack_id; ++pack_id)
             max_version = std::max(pack_filter.getMaxVersion(pack_id), max_version);
-        do_clean_read_on_normal_mode = max_version <= max_read_version;
+        pack_range.do_clean_read_on_normal_mode = max_version <= max_read_version;
     }
+    return true;
+}
 
-    for (size_t i = 0; i < read_columns.size(); ++i)
+ColumnWithTypeAndName DMFileReader::readColumnInRange(size_t i, const PackRange & pack_range)
+{
+    const auto & pack_stats = dmfile->getPackStats();
+    ColumnWithTypeAndName res;
+    try
     {
-        try
+        // For clean read of column pk, version, tag, instead of loading data from disk, just create placeholder column is OK.
+        auto & cd = read_columns[i];
+        if (cd.id == EXTRA_HANDLE_COLUMN_ID && pack_range.do_clean_read_on_handle_on_fast_mode)
         {
-            // For clean read of column pk, version, tag, instead of loading data from disk, just create placeholder column is OK.
-            auto & cd = read_columns[i];
-            if (cd.id == EXTRA_HANDLE_COLUMN_ID && do_clean_read_on_handle_on_fast_mode)
+            // Return the first row's handle
+            ColumnPtr column;
+            if (is_common_handle)
+            {
+                StringRef min_handle = pack_filter.getMinStringHandle(pack_range.start_pack_id);
+                column = cd.type->createColumnConst(pack_range.read_rows, Field(min_handle.data, min_handle.size));
+            }
+            else
+            {
+                Handle min_handle = pack_filter.getMinHandle(pack_range.start_pack_id);
+                column = cd.type->createColumnConst(pack_range.read_rows, Field(min_handle));
+            }
+            res = ColumnWithTypeAndName{column, cd.type, cd.name, cd.id};
+            skip_packs_by_column[i] = pack_range.read_packs;
+        }
+        else if (cd.id == TAG_COLUMN_ID && pack_range.do_clean_read_on_del_on_fast_mode)
+        {
+            ColumnPtr column;
+
+            column = cd.type->createColumnConst(pack_range.read_rows, Field(static_cast<UInt64>(pack_stats[pack_range.start_pack_id].first_tag)));
+            res = ColumnWithTypeAndName{column, cd.type, cd.name, cd.id};
+
+            skip_packs_by_column[i] = pack_range.read_packs;
+        }
+        else if (pack_range.do_clean_read_on_normal_mode && isExtraColumn(cd))
+        {
+            ColumnPtr column;
+            if (cd.id == EXTRA_HANDLE_COLUMN_ID)
             {
                 // Return the first row's handle
-                ColumnPtr column;
                 if (is_common_handle)
                 {
-                    StringRef min_handle = pack_filter.getMinStringHandle(start_pack_id);
-                    column = cd.type->createColumnConst(read_rows, Field(min_handle.data, min_handle.size));
+                    StringRef min_handle = pack_filter.getMinStringHandle(pack_range.start_pack_id);
+                    column = cd.type->createColumnConst(pack_range.read_rows, Field(min_handle.data, min_handle.size));
                 }
                 else
                 {
-                    Handle min_handle = pack_filter.getMinHandle(start_pack_id);
-                    column = cd.type->createColumnConst(read_rows, Field(min_handle));
+                    Handle min_handle = pack_filter.getMinHandle(pack_range.start_pack_id);
+                    column = cd.type->createColumnConst(pack_range.read_rows, Field(min_handle));
                 }
-                res.insert(ColumnWithTypeAndName{column, cd.type, cd.name, cd.id});
-                skip_packs_by_column[i] = read_packs;
             }
-            else if (cd.id == TAG_COLUMN_ID && do_clean_read_on_del_on_fast_mode)
+            else if (cd.id == VERSION_COLUMN_ID)
             {
-                ColumnPtr column;
-
-                column = cd.type->createColumnConst(read_rows, Field(static_cast<UInt64>(pack_stats[start_pack_id].first_tag)));
-                res.insert(ColumnWithTypeAndName{column, cd.type, cd.name, cd.id});
-
-                skip_packs_by_column[i] = read_packs;
+                column = cd.type->createColumnConst(pack_range.read_rows, Field(pack_stats[pack_range.start_pack_id].first_version));
             }
-            else if (do_clean_read_on_normal_mode && isExtraColumn(cd))
+            else if (cd.id == TAG_COLUMN_ID)
             {
-                ColumnPtr column;
-                if (cd.id == EXTRA_HANDLE_COLUMN_ID)
-                {
-                    // Return the first row's handle
-                    if (is_common_handle)
-                    {
-                        StringRef min_handle = pack_filter.getMinStringHandle(start_pack_id);
-                        column = cd.type->createColumnConst(read_rows, Field(min_handle.data, min_handle.size));
-                    }
-                    else
-                    {
-                        Handle min_handle = pack_filter.getMinHandle(start_pack_id);
-                        column = cd.type->createColumnConst(read_rows, Field(min_handle));
-                    }
-                }
-                else if (cd.id == VERSION_COLUMN_ID)
-                {
-                    column = cd.type->createColumnConst(read_rows, Field(pack_stats[start_pack_id].first_version));
-                }
-                else if (cd.id == TAG_COLUMN_ID)
-                {
-                    column = cd.type->createColumnConst(read_rows, Field(static_cast<UInt64>(pack_stats[start_pack_id].first_tag)));
-                }
+                column = cd.type->createColumnConst(pack_range.read_rows, Field(static_cast<UInt64>(pack_stats[pack_range.start_pack_id].first_tag)));
+            }
 
-                res.insert(ColumnWithTypeAndName{column, cd.type, cd.name, cd.id});
+            res = ColumnWithTypeAndName{column, cd.type, cd.name, cd.id};
 
-                skip_packs_by_column[i] = read_packs;
-            }
-            else
+            skip_packs_by_column[i] = pack_range.read_packs;
+        }
+        else
+        {
+            const auto stream_name = DMFile::getFileNameBase(cd.id);
+            if (auto iter = column_streams.find(stream_name); iter != column_streams.end())
             {
-                const auto stream_name = DMFile::getFileNameBase(cd.id);
-                if (auto iter = column_streams.find(stream_name); iter != column_streams.end())
+                if (enable_column_cache && isCacheableColumn(cd))
                 {
-                    if (enable_column_cache && isCacheableColumn(cd))
-                    {
-                        auto read_strategy = column_cache->getReadStrategy(start_pack_id, read_packs, cd.id);
+                    auto read_strategy = column_cache->getReadStrategy(pack_range.start_pack_id, pack_range.read_packs, cd.id);
 
-                        auto data_type = dmfile->getColumnStat(cd.id).type;
-                        auto column = data_type->createColumn();
-                        column->reserve(read_rows);
-                        for (auto & [range, strategy] : read_strategy)
+                    auto data_type = dmfile->getColumnStat(cd.id).type;
+                    auto column = data_type->createColumn();
+                    column->reserve(pack_range.read_rows);
+                    for (auto & [range, strategy] : read_strategy)
+                    {
+                        if (strategy == ColumnCache::Strategy::Memory)
                         {
-                            if (strategy == ColumnCache::Strategy::Memory)
-                            {
-                                for (size_t cursor = range.first; cursor < range.second; cursor++)
-                                {
-                                    auto cache_element = column_cache->getColumn(cursor, cd.id);
-                                    column->insertRangeFrom(
-                                        *(cache_element.first),
-                                        cache_element.second.first,
-                                        cache_element.second.second);
-                                }
-                                skip_packs_by_column[i] += (range.second - range.first);
-                            }
-                            else if (strategy == ColumnCache::Strategy::Disk)
+                            for (size_t cursor = range.first; cursor < range.second; cursor++)
                             {
-                                size_t rows_count = 0;
-                                for (size_t cursor = range.first; cursor < range.second; cursor++)
-                                {
-                                    rows_count += pack_stats[cursor].rows;
-                                }
-                                ColumnPtr col;
-                                readColumn(cd, col, range.first, range.second - range.first, rows_count, skip_packs_by_column[i], single_file_mode);
-                                column->insertRangeFrom(*col, 0, col->size());
-                                skip_packs_by_column[i] = 0;
+                                auto cache_element = column_cache->getColumn(cursor, cd.id);
+                                column->insertRangeFrom(
+                                    *(cache_element.first),
+                                    cache_element.second.first,
+                                    cache_element.second.second);
                             }
-                            else
+                            skip_packs_by_column[i] += (range.second - range.first);
+                        }
+                        else if (strategy == ColumnCache::Strategy::Disk)
+                        {
+                            size_t rows_count = 0;
+                            for (size_t cursor = range.first; cursor < range.second; cursor++)
                             {
-                                throw Exception("Unknown strategy", ErrorCodes::LOGICAL_ERROR);
+                                rows_count += pack_stats[cursor].rows;
                             }
+                            ColumnPtr col;
+                            readColumn(cd, col, range.first, range.second - range.first, rows_count, skip_packs_by_column[i], single_file_mode);
+                            column->insertRangeFrom(*col, 0, col->size());
+                            skip_packs_by_column[i] = 0;
                         }
-                        ColumnPtr result_column = std::move(column);
-                        size_t rows_offset = 0;
-                        for (size_t cursor = start_pack_id; cursor < start_pack_id + read_packs; cursor++)
+                        else
                         {
-                            column_cache->tryPutColumn(cursor, cd.id, result_column, rows_offset, pack_stats[cursor].rows);
-                            rows_offset += pack_stats[cursor].rows;
+                            throw Exception("Unknown strategy", ErrorCodes::LOGICAL_ERROR);
                         }
-                        // Cast column's data from DataType in disk to what we need now
-                        auto converted_column = convertColumnByColumnDefineIfNeed(data_type, std::move(result_column), cd);
-                        res.insert(ColumnWithTypeAndName{converted_column, cd.type, cd.name, cd.id});
                     }
-                    else
+                    ColumnPtr result_column = std::move(column);
+                    size_t rows_offset = 0;
+                    for (size_t cursor = pack_range.start_pack_id; cursor < pack_range.start_pack_id + pack_range.read_packs; cursor++)
                     {
-                        auto data_type = dmfile->getColumnStat(cd.id).type;
-                        ColumnPtr column;
-                        readColumn(cd, column, start_pack_id, read_packs, read_rows, skip_packs_by_column[i], single_file_mode);
-                        auto converted_column = convertColumnByColumnDefineIfNeed(data_type, std::move(column), cd);
-
-                        res.insert(ColumnWithTypeAndName{std::move(converted_column), cd.type, cd.name, cd.id});
-                        skip_packs_by_column[i] = 0;
+                        column_cache->tryPutColumn(cursor, cd.id, result_column, rows_offset, pack_stats[cursor].rows);
+                        rows_offset += pack_stats[cursor].rows;
                     }
+                    // Cast column's data from DataType in disk to what we need now
+                    auto converted_column = convertColumnByColumnDefineIfNeed(data_type, std::move(result_column), cd);
+                    res = ColumnWithTypeAndName{converted_column, cd.type, cd.name, cd.id};
                 }
                 else
                 {
-                    LOG_TRACE(
-                        log,
-                        "Column [id: {}, name: {}, type: {}] not found, use default value. DMFile: {}",
-                        cd.id,
-                        cd.name,
-                        cd.type->getName(),
-                        dmfile->path());
-                    // New column after ddl is not exist in this DMFile, fill with default value
-                    ColumnPtr column = createColumnWithDefaultValue(cd, read_rows);
-
-                    res.insert(ColumnWithTypeAndName{std::move(column), cd.type, cd.name, cd.id});
+                    auto data_type = dmfile->getColumnStat(cd.id).type;
+                    ColumnPtr column;
+                    readColumn(cd, column, pack_range.start_pack_id, pack_range.read_packs, pack_range.read_rows, skip_packs_by_column[i], single_file_mode);
+                    auto converted_column = convertColumnByColumnDefineIfNeed(data_type, std::move(column), cd);
+
+                    res = ColumnWithTypeAndName{std::move(converted_column), cd.type, cd.name, cd.id};
                     skip_packs_by_column[i] = 0;
                 }
             }
+            else
+            {
+                LOG_TRACE(
+                    log,
+                    "Column [id: {}, name: {}, type: {}] not found, use default value. DMFile: {}",
+                    cd.id,
+                    cd.name,
+                    cd.type->getName(),
+                    dmfile->path());
+                // New column after ddl is not exist in this DMFile, fill with default value
+                ColumnPtr column = createColumnWithDefaultValue(cd, pack_range.read_rows);
+
+                res = ColumnWithTypeAndName{std::move(column), cd.type, cd.name, cd.id};
+                skip_packs_by_column[i] = 0;
+            }
         }
-        catch (DB::Exception & e)
+    }
+    catch (DB::Exception & e)
+    {
+        e.addMessage("(while reading from DTFile: " + this->dmfile->path() + ")");
+        e.rethrow();
+    }
+    return res;
+}
+
+Block DMFileReader::read()
+{
+    Stopwatch watch;
+    SCOPE_EXIT(
+        scan_context->total_dmfile_read_time_ms += watch.elapsedMilliseconds(););
+
+    if (!filter_column_positions.empty())
+        return readWithLateMaterialization();
+
+    PackRange pack_range;
+    if (!getNextPackRange(pack_range))
+        return {};
+
+    Block res;
+    for (size_t i = 0; i < read_columns.size(); ++i)
+        res.insert(readColumnInRange(i, pack_range));
+    return res;
+}
+
+Block DMFileReader::readWithLateMaterialization()
+{
+    const auto & filter = *late_materialization_filter;
+    PackRange pack_range;
+    while (getNextPackRange(pack_range))
+    {
+        Block filter_block;
+        std::vector<ColumnWithTypeAndName> columns(read_columns.size());
+        std::vector<bool> is_read(read_columns.size(), false);
+        for (auto pos : filter_column_positions)
+        {
+            columns[pos] = readColumnInRange(pos, pack_range);
+            is_read[pos] = true;
+            filter_block.insert(columns[pos]);
+        }
+
+        filter.before_where->execute(filter_block);
+        const auto & filter_column = filter_block.getByName(filter.filter_column_name).column;
+
+        ConstantFilterDescription constant_filter_description(*filter_column);
+        std::optional<FilterDescription> filter_description;
+        size_t passed_rows = pack_range.read_rows;
+        if (constant_filter_description.always_false)
+        {
+            passed_rows = 0;
+        }
+        else if (!constant_filter_description.always_true)
         {
-            e.addMessage("(while reading from DTFile: " + this->dmfile->path() + ")");
-            e.rethrow();
+            filter_description.emplace(*filter_column);
+            passed_rows = countBytesInFilter(*filter_description->data);
         }
+
+        if (passed_rows == 0)
+        {
+            // No row of these packs passes the filter, skip the rest columns. They will seek
+            // to the right position in the next read.
+            for (size_t i = 0; i < read_columns.size(); ++i)
+            {
+                if (!is_read[i])
+                    skip_packs_by_column[i] += pack_range.read_packs;
+            }
+            scan_context->late_materialization_skipped_rows += pack_range.read_rows;
+            continue;
+        }
+
+        Block res;
+        for (size_t i = 0; i < read_columns.size(); ++i)
+        {
+            auto column = is_read[i] ? std::move(columns[i]) : readColumnInRange(i, pack_range);
+            if (passed_rows != pack_range.read_rows)
+                column.column = column.column->filter(*filter_description->data, passed_rows);
+            res.insert(std::move(column));
+        }
+        scan_context->late_materialization_skipped_rows += pack_range.read_rows - passed_rows;
+        return res;
     }
-    return res;
+    return {};
 }
 
 void DMFileReader::readFromDisk(
@@ -606,19 +715,39 @@ void DMFileReader::readColumn(ColumnDefine & column_define,
         GET_METRIC(tiflash_storage_read_thread_counter, type_add_cache_total_bytes_limit).Increment();
     }
     bool enable_sharing_column = has_concurrent_reader && !reach_sharing_column_memory_limit;
-    if (!getCachedPacks(column_define.id, start_pack_id, pack_count, read_rows, column))
+
+    String pack_cache_key;
+    ColumnPtr cached_column;
+    bool put_pack_cache = false;
+    if (pack_cache)
+    {
+        pack_cache_key = DMFilePackCache::key(path(), column_define.id, start_pack_id, pack_count);
+        cached_column = pack_cache->getColumn(pack_cache_key);
+        put_pack_cache = pack_cache->canCache(static_cast<size_t>(read_rows * dmfile->getColumnStat(column_define.id).avg_size));
+    }
+
+    if (cached_column)
+    {
+        // The streams are not moved forward, they have to seek before the next read from disk.
+        column = std::move(cached_column);
+        last_read_from_cache[column_define.id] = true;
+    }
+    else if (!getCachedPacks(column_define.id, start_pack_id, pack_count, read_rows, column))
     {
         // If there are concurrent read requests, this data is likely to be shared.
         // So the allocation and deallocation of this data may not be in the same MemoryTracker.
         // This can lead to inaccurate memory statistics of MemoryTracker.
         // To solve this problem, we use a independent global memory tracker to trace the shared column data in ColumnSharingCacheMap.
+        // It is the same for the data put into the global pack cache, which outlives this query.
         auto mem_tracker_guard
-            = enable_sharing_column ? std::make_optional<MemoryTrackerSetter>(true, nullptr) : std::nullopt;
+            = (enable_sharing_column || put_pack_cache) ? std::make_optional<MemoryTrackerSetter>(true, nullptr) : std::nullopt;
         auto data_type = dmfile->getColumnStat(column_define.id).type;
         auto col = data_type->createColumn();
         readFromDisk(column_define, col, start_pack_id, read_rows, skip_packs, force_seek || last_read_from_cache[column_define.id]);
         column = std::move(col);
         last_read_from_cache[column_define.id] = false;
+        if (put_pack_cache)
+            pack_cache->putColumn(pack_cache_key, column);
     }
     else
     {
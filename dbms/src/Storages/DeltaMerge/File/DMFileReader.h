@@ -21,7 +21,9 @@
 #include <Storages/DeltaMerge/DeltaMergeHelpers.h>
 #include <Storages/DeltaMerge/File/ColumnCache.h>
 #include <Storages/DeltaMerge/File/DMFile.h>
+#include <Storages/DeltaMerge/File/DMFilePackCache.h>
 #include <Storages/DeltaMerge/File/DMFilePackFilter.h>
+#include <Storages/DeltaMerge/Filter/LateMaterializationFilter.h>
 #include <Storages/DeltaMerge/ReadThread/ColumnSharingCache.h>
 #include <Storages/DeltaMerge/RowKeyRange.h>
 #include <Storages/DeltaMerge/ScanContext.h>
@@ -89,6 +91,8 @@ public:
         const MarkCachePtr & mark_cache_,
         bool enable_column_cache_,
         const ColumnCachePtr & column_cache_,
+        // nullptr means the global pack cache is disabled
+        const DMFilePackCachePtr & pack_cache_,
         size_t aio_threshold,
         size_t max_read_buffer_size,
         const FileProviderPtr & file_provider_,
@@ -97,7 +101,9 @@ public:
         bool read_one_pack_every_time_,
         const String & tracing_id_,
         size_t max_sharing_column_bytes_,
-        const ScanContextPtr & scan_context_);
+        const ScanContextPtr & scan_context_,
+        // Only used in fast scan mode, nullptr means disabled.
+        const LateMaterializationFilterPtr & late_materialization_filter_ = nullptr);
 
     Block getHeader() const { return toEmptyBlock(read_columns); }
 
@@ -114,6 +120,25 @@ public:
     void addCachedPacks(ColId col_id, size_t start_pack_id, size_t pack_count, ColumnPtr & col);
 
 private:
+    // The continuous packs that are read by one call of #read().
+    struct PackRange
+    {
+        size_t start_pack_id = 0;
+        size_t read_packs = 0;
+        size_t read_rows = 0;
+        bool do_clean_read_on_normal_mode = false;
+        bool do_clean_read_on_handle_on_fast_mode = false;
+        bool do_clean_read_on_del_on_fast_mode = false;
+    };
+
+    /// Move to the next pack range to read. Return false if it is the end of stream.
+    bool getNextPackRange(PackRange & range);
+    /// Read the i-th column of `read_columns` in the pack range.
+    ColumnWithTypeAndName readColumnInRange(size_t i, const PackRange & range);
+    /// Read the columns required by the late materialization filter first, and only read the
+    /// rest columns when there are rows that pass the filter.
+    Block readWithLateMaterialization();
+
     bool shouldSeek(size_t pack_id);
 
     void readFromDisk(ColumnDefine & column_define,
@@ -155,6 +180,10 @@ private:
 
     /// Filters
     DMFilePackFilter pack_filter;
+    const LateMaterializationFilterPtr late_materialization_filter;
+    // The position of the columns in `read_columns` required by `late_materialization_filter`.
+    // Empty if late materialization is disabled for this reader.
+    std::vector<size_t> filter_column_positions;
 
     std::vector<size_t> skip_packs_by_column{};
 
@@ -162,6 +191,7 @@ private:
     MarkCachePtr mark_cache;
     const bool enable_column_cache;
     ColumnCachePtr column_cache;
+    DMFilePackCachePtr pack_cache;
 
     const ScanContextPtr scan_context;
 
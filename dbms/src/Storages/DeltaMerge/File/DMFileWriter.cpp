@@ -27,6 +27,36 @@ namespace DB
 {
 namespace DM
 {
+namespace
+{
+// The lightweight encodings can only be applied on the streams of fixed size integers.
+CompressionDataType getCompressionDataType(const IDataType & type, const IDataType::SubstreamPath & substream_path)
+{
+    if (IDataType::isNullMap(substream_path))
+        return CompressionDataType::Int8;
+
+    const IDataType * data_type = &type;
+    if (type.isNullable())
+        data_type = static_cast<const DataTypeNullable &>(type).getNestedType().get();
+    if (!data_type->isValueRepresentedByInteger())
+        return CompressionDataType::Unknown;
+
+    switch (data_type->getSizeOfValueInMemory())
+    {
+    case 1:
+        return CompressionDataType::Int8;
+    case 2:
+        return CompressionDataType::Int16;
+    case 4:
+        return CompressionDataType::Int32;
+    case 8:
+        return CompressionDataType::Int64;
+    default:
+        return CompressionDataType::Unknown;
+    }
+}
+} // namespace
+
 DMFileWriter::DMFileWriter(const DMFilePtr & dmfile_,
                            const ColumnDefines & write_columns_,
                            const FileProviderPtr & file_provider_,
@@ -75,6 +105,9 @@ DMFileWriter::DMFileWriter(const DMFilePtr & dmfile_,
         /// for handle column always generate index
         auto type = removeNullable(cd.type);
         bool do_index = cd.id == EXTRA_HANDLE_COLUMN_ID || type->isInteger() || type->isDateOrDateTime();
+        /// the equal index is only useful for the columns in the pushed down filters, skip the extra columns
+        bool do_equal_index = options.enable_equal_index && do_index && cd.id != EXTRA_HANDLE_COLUMN_ID && cd.id != VERSION_COLUMN_ID
+            && cd.id != TAG_COLUMN_ID && EqualIndex::isSupportedType(*cd.type);
         if (options.flags.isSingleFile())
         {
             if (do_index)
@@ -82,6 +115,11 @@ DMFileWriter::DMFileWriter(const DMFilePtr & dmfile_,
                 const auto column_name = DMFile::getFileNameBase(cd.id, {});
                 single_file_stream->minmax_indexs.emplace(column_name, std::make_shared<MinMaxIndex>(*cd.type));
             }
+            if (do_equal_index)
+            {
+                const auto column_name = DMFile::getFileNameBase(cd.id, {});
+                single_file_stream->equal_indexs.emplace(column_name, std::make_shared<EqualIndex>());
+            }
 
             auto callback = [&](const IDataType::SubstreamPath & substream_path) {
                 const auto stream_name = DMFile::getFileNameBase(cd.id, substream_path);
@@ -92,25 +130,29 @@ DMFileWriter::DMFileWriter(const DMFilePtr & dmfile_,
         }
         else
         {
-            addStreams(cd.id, cd.type, do_index);
+            addStreams(cd.id, cd.type, do_index, do_equal_index);
         }
         dmfile->column_stats.emplace(cd.id, ColumnStat{cd.id, cd.type, /*avg_size=*/0});
     }
 }
 
-void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index)
+void DMFileWriter::addStreams(ColId col_id, DataTypePtr type, bool do_index, bool do_equal_index)
 {
     auto callback = [&](const IDataType::SubstreamPath & substream_path) {
         const auto stream_name = DMFile::getFileNameBase(col_id, substream_path);
+        auto compression_settings = options.compression_settings;
+        if (options.enable_lightweight_compression)
+            compression_settings.data_type = getCompressionDataType(*type, substream_path);
         auto stream = std::make_unique<Stream>(
             dmfile,
             stream_name,
             type,
-            options.compression_settings,
+            compression_settings,
             options.max_compress_block_size,
             file_provider,
             write_limiter,
-            IDataType::isNullMap(substream_path) ? false : do_index);
+            IDataType::isNullMap(substream_path) ? false : do_index,
+            IDataType::isNullMap(substream_path) ? false : do_equal_index);
         column_streams.emplace(stream_name, std::move(stream));
     };
 
@@ -198,6 +240,8 @@ void DMFileWriter::writeColumn(ColId col_id, const IDataType & type, const IColu
                 // For TAG Column, we also ignore del_mark when add minmax index.
                 iter->second->addPack(column, (col_id == EXTRA_HANDLE_COLUMN_ID || col_id == TAG_COLUMN_ID) ? nullptr : del_mark);
             }
+            if (auto iter = single_file_stream->equal_indexs.find(stream_name); iter != single_file_stream->equal_indexs.end())
+                iter->second->addPack(column, del_mark);
 
             auto offset_in_compressed_block = single_file_stream->original_layer.offset();
             if (unlikely(offset_in_compressed_block != 0))
@@ -264,6 +308,8 @@ void DMFileWriter::writeColumn(ColId col_id, const IDataType & type, const IColu
                     // For TAG Column, we also ignore del_mark when add minmax index.
                     stream->minmaxes->addPack(column, (col_id == EXTRA_HANDLE_COLUMN_ID || col_id == TAG_COLUMN_ID) ? nullptr : del_mark);
                 }
+                if (stream->equal_index)
+                    stream->equal_index->addPack(column, del_mark);
 
                 /// There could already be enough data to compress into the new block.
                 if (stream->compressed_buf->offset() >= options.min_compress_block_size)
@@ -343,6 +389,17 @@ void DMFileWriter::finalizeColumn(ColId col_id, DataTypePtr type)
                 bytes_written += minmax_size_in_file;
                 dmfile->addSubFileStat(DMFile::colIndexFileName(stream_name), minmax_offset_in_file, minmax_size_in_file);
             }
+
+            // write equal index
+            auto & equal_indexs = single_file_stream->equal_indexs;
+            if (auto iter = equal_indexs.find(stream_name); iter != equal_indexs.end())
+            {
+                size_t equal_index_offset_in_file = single_file_stream->plain_layer.count();
+                iter->second->write(single_file_stream->plain_layer);
+                size_t equal_index_size_in_file = single_file_stream->plain_layer.count() - equal_index_offset_in_file;
+                bytes_written += equal_index_size_in_file;
+                dmfile->addSubFileStat(DMFile::colEqualIndexFileName(stream_name), equal_index_offset_in_file, equal_index_size_in_file);
+            }
         };
         type->enumerateStreams(callback, {});
     }
@@ -397,6 +454,23 @@ void DMFileWriter::finalizeColumn(ColId col_id, DataTypePtr type)
 #endif
                 }
             }
+
+            if (stream->equal_index)
+            {
+                auto buf = WriteBufferByFileProviderBuilder(
+                               dmfile->configuration.has_value(),
+                               file_provider,
+                               dmfile->colEqualIndexPath(stream_name),
+                               dmfile->encryptionEqualIndexPath(stream_name),
+                               false,
+                               write_limiter)
+                               .with_checksum_algorithm(detail::getAlgorithmOrNone(*dmfile))
+                               .with_checksum_frame_size(detail::getFrameSizeOrDefault(*dmfile))
+                               .build();
+                stream->equal_index->write(*buf);
+                buf->sync();
+                bytes_written += is_empty_file ? 0 : buf->getMaterializedBytes();
+            }
         };
         type->enumerateStreams(callback, {});
     }
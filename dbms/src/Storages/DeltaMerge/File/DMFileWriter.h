@@ -22,6 +22,7 @@
 #include <IO/WriteBufferFromOStream.h>
 #include <Storages/DeltaMerge/DMChecksumConfig.h>
 #include <Storages/DeltaMerge/File/DMFile.h>
+#include <Storages/DeltaMerge/Index/EqualIndex.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
 
 namespace DB
@@ -53,7 +54,8 @@ public:
                size_t max_compress_block_size,
                FileProviderPtr & file_provider,
                const WriteLimiterPtr & write_limiter_,
-               bool do_index)
+               bool do_index,
+               bool do_equal_index)
             : plain_file(
                 WriteBufferByFileProviderBuilder(
                     dmfile->configuration.has_value(),
@@ -70,6 +72,7 @@ public:
                                  ? std::unique_ptr<WriteBuffer>(new CompressedWriteBuffer<false>(*plain_file, compression_settings))
                                  : std::unique_ptr<WriteBuffer>(new CompressedWriteBuffer<true>(*plain_file, compression_settings)))
             , minmaxes(do_index ? std::make_shared<MinMaxIndex>(*type) : nullptr)
+            , equal_index(do_equal_index ? std::make_shared<EqualIndex>() : nullptr)
             , mark_file(WriteBufferByFileProviderBuilder(
                             dmfile->configuration.has_value(),
                             file_provider,
@@ -85,7 +88,7 @@ public:
 
         void flush()
         {
-            // Note that this method won't flush minmaxes.
+            // Note that this method won't flush minmaxes and equal_index.
             compressed_buf->next();
             plain_file->next();
 
@@ -103,6 +106,7 @@ public:
         WriteBufferPtr compressed_buf;
 
         MinMaxIndexPtr minmaxes;
+        EqualIndexPtr equal_index;
         WriteBufferFromFileBasePtr mark_file;
     };
     using StreamPtr = std::unique_ptr<Stream>;
@@ -146,6 +150,9 @@ public:
         using ColumnMinMaxIndexs = std::unordered_map<String, MinMaxIndexPtr>;
         ColumnMinMaxIndexs minmax_indexs;
 
+        using ColumnEqualIndexs = std::unordered_map<String, EqualIndexPtr>;
+        ColumnEqualIndexs equal_indexs;
+
         using ColumnDataSizes = std::unordered_map<String, size_t>;
         ColumnDataSizes column_data_sizes;
 
@@ -191,14 +198,20 @@ public:
         size_t min_compress_block_size;
         size_t max_compress_block_size;
         Flags flags;
+        // Whether to generate the equal index for the columns that support it, see `EqualIndex`.
+        bool enable_equal_index = false;
+        // Whether to try the lightweight encodings for the streams of integers, see `LightweightCompression.h`.
+        bool enable_lightweight_compression = false;
 
         Options() = default;
 
-        Options(CompressionSettings compression_settings_, size_t min_compress_block_size_, size_t max_compress_block_size_, Flags flags_)
+        Options(CompressionSettings compression_settings_, size_t min_compress_block_size_, size_t max_compress_block_size_, Flags flags_, bool enable_equal_index_ = false, bool enable_lightweight_compression_ = false)
             : compression_settings(compression_settings_)
             , min_compress_block_size(min_compress_block_size_)
             , max_compress_block_size(max_compress_block_size_)
             , flags(flags_)
+            , enable_equal_index(enable_equal_index_)
+            , enable_lightweight_compression(enable_lightweight_compression_)
         {
         }
 
@@ -207,6 +220,8 @@ public:
             , min_compress_block_size(from.min_compress_block_size)
             , max_compress_block_size(from.max_compress_block_size)
             , flags(from.flags)
+            , enable_equal_index(from.enable_equal_index)
+            , enable_lightweight_compression(from.enable_lightweight_compression)
         {
             flags.setSingleFile(file->isSingleFileMode());
         }
@@ -235,7 +250,7 @@ private:
     /// Add streams with specified column id. Since a single column may have more than one Stream,
     /// for example Nullable column has a NullMap column, we would track them with a mapping
     /// FileNameBase -> Stream.
-    void addStreams(ColId col_id, DataTypePtr type, bool do_index);
+    void addStreams(ColId col_id, DataTypePtr type, bool do_index, bool do_equal_index);
 
 private:
     DMFilePtr dmfile;
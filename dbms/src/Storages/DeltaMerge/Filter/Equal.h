@@ -32,7 +32,11 @@ public:
     RSResult roughCheck(size_t pack_id, const RSCheckParam & param) override
     {
         GET_RSINDEX_FROM_PARAM_NOT_FOUND_RETURN_SOME(param, attr, rsindex);
-        return rsindex.minmax->checkEqual(pack_id, value, rsindex.type);
+        auto res = rsindex.minmax->checkEqual(pack_id, value, rsindex.type);
+        // The min/max can not tell whether the value is in the pack, try the equal index.
+        if (res == Some && rsindex.equal)
+            res = rsindex.equal->checkEqual(pack_id, value, rsindex.type);
+        return res;
     }
 };
 
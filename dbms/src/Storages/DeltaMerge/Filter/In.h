@@ -52,9 +52,16 @@ public:
     {
         GET_RSINDEX_FROM_PARAM_NOT_FOUND_RETURN_SOME(param, attr, rsindex);
         // TODO optimize for IN
-        RSResult res = rsindex.minmax->checkEqual(pack_id, values[0], rsindex.type);
+        auto check_equal = [&](const Field & value) {
+            auto res = rsindex.minmax->checkEqual(pack_id, value, rsindex.type);
+            // The min/max can not tell whether the value is in the pack, try the equal index.
+            if (res == Some && rsindex.equal)
+                res = rsindex.equal->checkEqual(pack_id, value, rsindex.type);
+            return res;
+        };
+        RSResult res = check_equal(values[0]);
         for (size_t i = 1; i < values.size(); ++i)
-            res = res || rsindex.minmax->checkEqual(pack_id, values[i], rsindex.type);
+            res = res || check_equal(values[i]);
         return res;
     }
 };
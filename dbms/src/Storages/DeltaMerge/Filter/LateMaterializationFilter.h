@@ -0,0 +1,42 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Interpreters/ExpressionActions.h>
+
+namespace DB
+{
+namespace DM
+{
+struct LateMaterializationFilter;
+using LateMaterializationFilterPtr = std::shared_ptr<LateMaterializationFilter>;
+
+/// The pushed down filter that is evaluated by DMFileReader while reading. The reader reads the columns
+/// required by `before_where` first, and only reads the other columns of the rows that pass the filter.
+/// `before_where` must only depend on the columns stored in the table, and the filter is still executed
+/// by the caller, so it is fine for the storage to return rows that do not pass it.
+struct LateMaterializationFilter
+{
+    LateMaterializationFilter(const ExpressionActionsPtr & before_where_, const String & filter_column_name_)
+        : before_where(before_where_)
+        , filter_column_name(filter_column_name_)
+    {}
+
+    ExpressionActionsPtr before_where;
+    String filter_column_name;
+};
+
+} // namespace DM
+} // namespace DB
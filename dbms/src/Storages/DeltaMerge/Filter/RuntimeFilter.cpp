@@ -0,0 +1,213 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnNullable.h>
+#include <Common/FmtUtils.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <Storages/DeltaMerge/Filter/RuntimeFilter.h>
+
+namespace DB
+{
+namespace DM
+{
+void RuntimeFilter::insertBuildKeys(const ColumnWithTypeAndName & key_column)
+{
+    const auto type = removeNullable(key_column.type);
+    if (!type->isInteger() && !type->isDateOrDateTime())
+    {
+        std::lock_guard lock(mutex);
+        unsupported = true;
+        return;
+    }
+    const bool signed_key = type->isInteger() && !type->isUnsignedInteger();
+
+    const auto full_column = key_column.column->isColumnConst() ? key_column.column->convertToFullColumnIfConst() : key_column.column;
+    const IColumn * nested_column = full_column.get();
+    const NullMap * null_map = nullptr;
+    if (const auto * nullable_column = typeid_cast<const ColumnNullable *>(nested_column))
+    {
+        nested_column = &nullable_column->getNestedColumn();
+        null_map = &nullable_column->getNullMapData();
+    }
+
+    /// Collect the statistics of this block without holding the lock.
+    auto less = [signed_key](UInt64 a, UInt64 b) {
+        return signed_key ? static_cast<Int64>(a) < static_cast<Int64>(b) : a < b;
+    };
+    bool block_has_value = false;
+    UInt64 block_min = 0;
+    UInt64 block_max = 0;
+    std::unordered_set<UInt64> block_values;
+    /// The IN values are useless once there are too many of them.
+    bool block_values_overflow = values_overflow.load(std::memory_order_relaxed);
+    for (size_t i = 0, rows = nested_column->size(); i < rows; ++i)
+    {
+        /// Null keys never match, see `insertFromBlockImplTypeCase` of Join.
+        if (null_map && (*null_map)[i])
+            continue;
+        UInt64 value = signed_key ? static_cast<UInt64>(nested_column->getInt(i)) : nested_column->getUInt(i);
+        if (!block_has_value || less(value, block_min))
+            block_min = value;
+        if (!block_has_value || less(block_max, value))
+            block_max = value;
+        block_has_value = true;
+        if (!block_values_overflow)
+        {
+            block_values.insert(value);
+            block_values_overflow = block_values.size() > max_in_values;
+        }
+    }
+
+    std::lock_guard lock(mutex);
+    is_signed = signed_key;
+    if (!block_has_value)
+        return;
+    if (!has_value || less(block_min, min_value))
+        min_value = block_min;
+    if (!has_value || less(max_value, block_max))
+        max_value = block_max;
+    has_value = true;
+    if (values_overflow)
+        return;
+    if (!block_values_overflow)
+    {
+        values.insert(block_values.begin(), block_values.end());
+        block_values_overflow = values.size() > max_in_values;
+    }
+    if (block_values_overflow)
+    {
+        values_overflow = true;
+        values.clear();
+    }
+}
+
+void RuntimeFilter::finish()
+{
+    std::lock_guard lock(mutex);
+    if (unsupported)
+        return;
+    auto to_field = [this](UInt64 value) {
+        return is_signed ? Field(static_cast<Int64>(value)) : Field(value);
+    };
+    if (has_value)
+    {
+        min_field = to_field(min_value);
+        max_field = to_field(max_value);
+        if (!values_overflow)
+        {
+            in_fields.reserve(values.size());
+            for (auto value : values)
+                in_fields.push_back(to_field(value));
+        }
+        values.clear();
+    }
+    ready = true;
+}
+
+bool RuntimeFilter::isReady() const
+{
+    std::lock_guard lock(mutex);
+    return ready;
+}
+
+RSResult RuntimeFilter::roughCheck(size_t pack_id, const RSCheckParam & param, const Attr & attr) const
+{
+    if (!isReady())
+        return Some;
+    /// The build side is empty, or only contains null keys.
+    if (!has_value)
+        return None;
+
+    GET_RSINDEX_FROM_PARAM_NOT_FOUND_RETURN_SOME(param, attr, rsindex);
+    if (!in_fields.empty())
+    {
+        for (const auto & value : in_fields)
+        {
+            if (rsindex.minmax->checkEqual(pack_id, value, rsindex.type) != None
+                && (!rsindex.equal || rsindex.equal->checkEqual(pack_id, value, rsindex.type) != None))
+                return Some;
+        }
+        return None;
+    }
+    /// All the values of the pack are less than the min key or greater than the max key.
+    if (rsindex.minmax->checkGreaterEqual(pack_id, min_field, rsindex.type, -1) == None
+        || rsindex.minmax->checkGreater(pack_id, max_field, rsindex.type, -1) == All)
+        return None;
+    return Some;
+}
+
+String RuntimeFilter::toDebugString() const
+{
+    std::lock_guard lock(mutex);
+    FmtBuffer buf;
+    buf.fmtAppend(R"({{"col_id":"{}","build_key":"{}","ready":"{}")", target_col_id, build_key_name, ready);
+    if (ready && has_value)
+    {
+        buf.fmtAppend(
+            R"(,"min":"{}","max":"{}","in_values":"{}")",
+            applyVisitor(FieldVisitorToDebugString(), min_field),
+            applyVisitor(FieldVisitorToDebugString(), max_field),
+            in_fields.size());
+    }
+    buf.append("}");
+    return buf.toString();
+}
+
+Attrs RuntimeFilterOperator::getAttrs()
+{
+    Attrs attrs;
+    for (const auto & filter : filter_list->get())
+    {
+        auto attr = attr_creator(filter->getTargetColumnID());
+        if (attr.type)
+            attrs.push_back(std::move(attr));
+    }
+    return attrs;
+}
+
+String RuntimeFilterOperator::toDebugString()
+{
+    const auto filters = filter_list->get();
+    FmtBuffer buf;
+    buf.fmtAppend(R"({{"op":"{}","filters":[)", name());
+    buf.joinStr(
+        filters.begin(),
+        filters.end(),
+        [](const auto & filter, FmtBuffer & fb) { fb.append(filter->toDebugString()); },
+        ",");
+    buf.append("]}");
+    return buf.toString();
+}
+
+RSResult RuntimeFilterOperator::roughCheck(size_t pack_id, const RSCheckParam & param)
+{
+    for (const auto & filter : filter_list->get())
+    {
+        auto attr = attr_creator(filter->getTargetColumnID());
+        if (!attr.type)
+            continue;
+        if (filter->roughCheck(pack_id, param, attr) == None)
+            return None;
+    }
+    return Some;
+}
+
+RSOperatorPtr createRuntimeFilterOperator(const RuntimeFilterListPtr & filter_list, AttrCreatorByColumnID && attr_creator)
+{
+    return std::make_shared<RuntimeFilterOperator>(filter_list, std::move(attr_creator));
+}
+
+} // namespace DM
+
+} // namespace DB
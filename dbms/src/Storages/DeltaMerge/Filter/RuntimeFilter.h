@@ -0,0 +1,144 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Core/ColumnWithTypeAndName.h>
+#include <Storages/DeltaMerge/Filter/RSOperator.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+
+namespace DB
+{
+namespace DM
+{
+class RuntimeFilter;
+using RuntimeFilterPtr = std::shared_ptr<RuntimeFilter>;
+using RuntimeFilters = std::vector<RuntimeFilterPtr>;
+
+class RuntimeFilterList;
+using RuntimeFilterListPtr = std::shared_ptr<RuntimeFilterList>;
+
+/// A runtime filter is generated from the build side of a hash join and is used to skip the
+/// packs of the probe side table scan that can not match any build side row.
+///
+/// The filter keeps the min/max of the join key, and the distinct values of the join key if
+/// there are no more than `max_in_values` of them. Only integer and date/datetime keys are
+/// supported, the filter is never ready for other types so that no pack is skipped.
+class RuntimeFilter
+{
+public:
+    RuntimeFilter(ColumnID target_col_id_, const String & build_key_name_, size_t max_in_values_)
+        : target_col_id(target_col_id_)
+        , build_key_name(build_key_name_)
+        , max_in_values(max_in_values_)
+    {}
+
+    ColumnID getTargetColumnID() const { return target_col_id; }
+    const String & getBuildKeyName() const { return build_key_name; }
+
+    /// Called by the join for every build side block, thread safe.
+    void insertBuildKeys(const ColumnWithTypeAndName & key_column);
+
+    /// Called by the join after all the build side blocks are inserted.
+    void finish();
+
+    bool isReady() const;
+
+    /// Check whether the pack of the probe side table scan may contain a row that matches the
+    /// build side, `attr` is the column this filter applies to.
+    /// Never returns `All`, the join still needs to check every row.
+    RSResult roughCheck(size_t pack_id, const RSCheckParam & param, const Attr & attr) const;
+
+    String toDebugString() const;
+
+private:
+    const ColumnID target_col_id;
+    const String build_key_name;
+    const size_t max_in_values;
+
+    mutable std::mutex mutex;
+    bool ready = false;
+    bool unsupported = false;
+    bool is_signed = false;
+
+    /// Values are stored as the bits of Int64 / UInt64 according to `is_signed`.
+    bool has_value = false;
+    UInt64 min_value = 0;
+    UInt64 max_value = 0;
+    /// Written under `mutex`, but also read without it to skip collecting the values once overflowed.
+    std::atomic<bool> values_overflow = false;
+    std::unordered_set<UInt64> values;
+
+    /// Generated by `finish`.
+    Field min_field;
+    Field max_field;
+    Fields in_fields;
+};
+
+/// The runtime filters that are applied to one table scan. The scan is interpreted before the
+/// join that generates the filters, so the filters are added after the list has been handed
+/// to the storage, but always before the scan starts reading.
+class RuntimeFilterList
+{
+public:
+    void add(const RuntimeFilterPtr & filter)
+    {
+        std::lock_guard lock(mutex);
+        filters.push_back(filter);
+    }
+
+    RuntimeFilters get() const
+    {
+        std::lock_guard lock(mutex);
+        return filters;
+    }
+
+private:
+    mutable std::mutex mutex;
+    RuntimeFilters filters;
+};
+
+using AttrCreatorByColumnID = std::function<Attr(ColumnID)>;
+
+/// The RSOperator used by the storage to apply the runtime filters of a table scan.
+class RuntimeFilterOperator : public RSOperator
+{
+public:
+    RuntimeFilterOperator(const RuntimeFilterListPtr & filter_list_, AttrCreatorByColumnID && attr_creator_)
+        : filter_list(filter_list_)
+        , attr_creator(std::move(attr_creator_))
+    {}
+
+    String name() override { return "runtime_filter"; }
+
+    Attrs getAttrs() override;
+
+    String toDebugString() override;
+
+    RSResult roughCheck(size_t pack_id, const RSCheckParam & param) override;
+
+private:
+    RuntimeFilterListPtr filter_list;
+    AttrCreatorByColumnID attr_creator;
+};
+
+RSOperatorPtr createRuntimeFilterOperator(const RuntimeFilterListPtr & filter_list, AttrCreatorByColumnID && attr_creator);
+
+} // namespace DM
+
+} // namespace DB
@@ -0,0 +1,188 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Columns/ColumnNullable.h>
+#include <Common/HashTable/Hash.h>
+#include <Common/TiFlashException.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <IO/ReadHelpers.h>
+#include <IO/WriteHelpers.h>
+#include <Storages/DeltaMerge/Index/EqualIndex.h>
+
+#include <algorithm>
+
+namespace DB
+{
+namespace DM
+{
+namespace
+{
+/// The value of an integer-represented type is compared by the low `value_size` bytes of UInt64.
+inline UInt64 valueMask(size_t value_size)
+{
+    return value_size >= sizeof(UInt64) ? std::numeric_limits<UInt64>::max() : ((1ULL << (value_size * 8)) - 1);
+}
+} // namespace
+
+bool EqualIndex::isSupportedType(const IDataType & type)
+{
+    const auto & nested_type = type.isNullable() ? *static_cast<const DataTypeNullable &>(type).getNestedType() : type;
+    return (nested_type.isInteger() || nested_type.isDateOrDateTime())
+        && nested_type.getSizeOfValueInMemory() <= sizeof(UInt64);
+}
+
+UInt64 EqualIndex::bloomHash(UInt64 value, size_t probe)
+{
+    // Double hashing, see "Less Hashing, Same Performance: Building a Better Bloom Filter".
+    const UInt64 hash = intHash64(value);
+    const UInt64 h1 = hash & 0xFFFFFFFFULL;
+    const UInt64 h2 = (hash >> 32) | 1;
+    return h1 + probe * h2;
+}
+
+void EqualIndex::addPack(const IColumn & column, const ColumnVector<UInt8> * del_mark)
+{
+    const IColumn * nested_column = &column;
+    const NullMap * null_map = nullptr;
+    if (column.isColumnNullable())
+    {
+        const auto & nullable_column = static_cast<const ColumnNullable &>(column);
+        nested_column = &nullable_column.getNestedColumn();
+        null_map = &nullable_column.getNullMapData();
+    }
+    const auto * del_mark_data = (!del_mark) ? nullptr : &(del_mark->getData());
+
+    const size_t value_size = nested_column->sizeOfValueIfFixed();
+    RUNTIME_CHECK(value_size <= sizeof(UInt64), value_size);
+
+    std::vector<UInt64> values;
+    values.reserve(column.size());
+    for (size_t i = 0; i < column.size(); ++i)
+    {
+        if ((del_mark_data && (*del_mark_data)[i]) || (null_map && (*null_map)[i]))
+            continue;
+        UInt64 value = 0;
+        memcpy(&value, nested_column->getDataAt(i).data, value_size);
+        values.push_back(value);
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+
+    if (values.empty())
+    {
+        kinds.push_back(static_cast<UInt8>(PackKind::Empty));
+    }
+    else if (values.size() <= MAX_SET_SIZE)
+    {
+        kinds.push_back(static_cast<UInt8>(PackKind::Set));
+        data.insert(values.begin(), values.end());
+    }
+    else
+    {
+        kinds.push_back(static_cast<UInt8>(PackKind::Bloom));
+        const size_t num_words = (values.size() * BLOOM_BITS_PER_VALUE + 63) / 64;
+        const size_t num_bits = num_words * 64;
+        const size_t begin = data.size();
+        data.resize_fill(begin + num_words, 0);
+        for (auto value : values)
+        {
+            for (size_t probe = 0; probe < BLOOM_NUM_PROBES; ++probe)
+            {
+                const auto bit = bloomHash(value, probe) % num_bits;
+                data[begin + bit / 64] |= (1ULL << (bit % 64));
+            }
+        }
+    }
+    offsets.push_back(data.size());
+}
+
+void EqualIndex::write(WriteBuffer & buf) const
+{
+    UInt64 size = kinds.size();
+    UInt64 data_size = data.size();
+    DB::writeIntBinary(size, buf);
+    DB::writeIntBinary(data_size, buf);
+    buf.write(reinterpret_cast<const char *>(kinds.data()), sizeof(UInt8) * size);
+    buf.write(reinterpret_cast<const char *>(offsets.data()), sizeof(UInt64) * (size + 1));
+    buf.write(reinterpret_cast<const char *>(data.data()), sizeof(UInt64) * data_size);
+}
+
+EqualIndexPtr EqualIndex::read(ReadBuffer & buf, size_t bytes_limit)
+{
+    UInt64 size = 0;
+    UInt64 data_size = 0;
+    size_t buf_pos = buf.count();
+    DB::readIntBinary(size, buf);
+    DB::readIntBinary(data_size, buf);
+    auto index = std::make_shared<EqualIndex>();
+    index->kinds.resize(size);
+    index->offsets.resize(size + 1);
+    index->data.resize(data_size);
+    buf.readStrict(reinterpret_cast<char *>(index->kinds.data()), sizeof(UInt8) * size);
+    buf.readStrict(reinterpret_cast<char *>(index->offsets.data()), sizeof(UInt64) * (size + 1));
+    buf.readStrict(reinterpret_cast<char *>(index->data.data()), sizeof(UInt64) * data_size);
+    size_t bytes_read = buf.count() - buf_pos;
+    if (unlikely(bytes_read != bytes_limit || index->offsets.back() != data_size))
+    {
+        throw DB::TiFlashException("Bad file format: expected read equal index content size: " + std::to_string(bytes_limit)
+                                       + " vs. actual: " + std::to_string(bytes_read),
+                                   Errors::DeltaTree::Internal);
+    }
+    return index;
+}
+
+RSResult EqualIndex::checkEqual(size_t pack_index, const Field & value, const DataTypePtr & type) const
+{
+    if (pack_index >= kinds.size())
+        return Some;
+
+    // Only the integers can be compared by the stored values, the other types, e.g. Null or String,
+    // are not handled here.
+    UInt64 target;
+    if (value.getType() == Field::Types::UInt64)
+        target = value.get<UInt64>();
+    else if (value.getType() == Field::Types::Int64)
+        target = static_cast<UInt64>(value.get<Int64>());
+    else
+        return Some;
+    // If the value can not be represented by the column type, it is truncated here. The result is
+    // still correct because the value can not exist in the column anyway.
+    target &= valueMask(removeNullable(type)->getSizeOfValueInMemory());
+
+    const auto begin = offsets[pack_index];
+    const auto end = offsets[pack_index + 1];
+    switch (static_cast<PackKind>(kinds[pack_index]))
+    {
+    case PackKind::Empty:
+        return None;
+    case PackKind::Set:
+        return std::binary_search(data.begin() + begin, data.begin() + end, target) ? Some : None;
+    case PackKind::Bloom:
+    {
+        const size_t num_bits = (end - begin) * 64;
+        for (size_t probe = 0; probe < BLOOM_NUM_PROBES; ++probe)
+        {
+            const auto bit = bloomHash(target, probe) % num_bits;
+            if (!(data[begin + bit / 64] & (1ULL << (bit % 64))))
+                return None;
+        }
+        return Some;
+    }
+    }
+    return Some;
+}
+
+} // namespace DM
+
+} // namespace DB
@@ -0,0 +1,133 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Columns/ColumnsNumber.h>
+#include <Common/LRUCache.h>
+#include <Common/PODArray.h>
+#include <Core/Field.h>
+#include <DataTypes/IDataType.h>
+#include <IO/ReadBuffer.h>
+#include <IO/WriteBuffer.h>
+#include <Storages/DeltaMerge/Index/RSResult.h>
+
+namespace DB
+{
+namespace DM
+{
+class EqualIndex;
+using EqualIndexPtr = std::shared_ptr<EqualIndex>;
+
+/// The index used to check whether a pack may contain a value, which is useful for the `Equal` and
+/// `In` operators on high-cardinality columns whose values are spread across all packs, so that the
+/// min/max of packs are useless.
+///
+/// For every pack, the distinct values are kept as a sorted set if there are no more than `MAX_SET_SIZE`
+/// of them, otherwise they are kept in a bloom filter. Only the types whose values can be represented by
+/// at most 8 bytes of integer are supported, see `isSupportedType`.
+class EqualIndex
+{
+public:
+    static constexpr size_t MAX_SET_SIZE = 32;
+    static constexpr size_t BLOOM_BITS_PER_VALUE = 10;
+    static constexpr size_t BLOOM_NUM_PROBES = 7;
+
+    static bool isSupportedType(const IDataType & type);
+
+    EqualIndex()
+        : offsets(1, 0)
+    {}
+
+    size_t byteSize() const
+    {
+        return sizeof(UInt8) * kinds.size() + sizeof(UInt64) * offsets.size() + sizeof(UInt64) * data.size()
+            + 3 * sizeof(PaddedPODArray<UInt8>);
+    }
+
+    void addPack(const IColumn & column, const ColumnVector<UInt8> * del_mark);
+
+    void write(WriteBuffer & buf) const;
+
+    static EqualIndexPtr read(ReadBuffer & buf, size_t bytes_limit);
+
+    /// Return None if no value in the pack equals to `value`, otherwise Some.
+    RSResult checkEqual(size_t pack_index, const Field & value, const DataTypePtr & type) const;
+
+private:
+    enum class PackKind : UInt8
+    {
+        // There is no value in the pack, e.g. all rows are null or deleted.
+        Empty = 0,
+        Set = 1,
+        Bloom = 2,
+    };
+
+    static UInt64 bloomHash(UInt64 value, size_t probe);
+
+    // The kind of each pack
+    PaddedPODArray<UInt8> kinds;
+    // The data of the i-th pack is `data[offsets[i], offsets[i + 1])`
+    PaddedPODArray<UInt64> offsets;
+    // The sorted values for `Set` packs, the bits of bloom filter for `Bloom` packs
+    PaddedPODArray<UInt64> data;
+};
+
+
+struct EqualIndexWeightFunction
+{
+    size_t operator()(const String & key, const EqualIndex & index) const
+    {
+        auto index_memory_usage = index.byteSize(); // index
+        auto cells_memory_usage = 32; // Cells struct memory cost
+
+        // 2. the memory cost of key part
+        auto str_len = key.size(); // key_len
+        auto key_memory_usage = sizeof(String); // String struct memory cost
+
+        // 3. the memory cost of hash table
+        auto unordered_map_memory_usage = 28; // hash table struct approximate memory cost
+
+        // 4. the memory cost of LRUQueue
+        auto list_memory_usage = sizeof(std::list<String>); // list struct memory cost
+
+        return index_memory_usage + cells_memory_usage + str_len * 2 + key_memory_usage * 2 + unordered_map_memory_usage
+            + list_memory_usage;
+    }
+};
+
+
+class EqualIndexCache : public LRUCache<String, EqualIndex, std::hash<String>, EqualIndexWeightFunction>
+{
+private:
+    using Base = LRUCache<String, EqualIndex, std::hash<String>, EqualIndexWeightFunction>;
+
+public:
+    explicit EqualIndexCache(size_t max_size_in_bytes)
+        : Base(max_size_in_bytes)
+    {}
+
+    template <typename LoadFunc>
+    MappedPtr getOrSet(const Key & key, LoadFunc && load)
+    {
+        auto result = Base::getOrSet(key, load);
+        return result.first;
+    }
+};
+
+using EqualIndexCachePtr = std::shared_ptr<EqualIndexCache>;
+
+} // namespace DM
+
+} // namespace DB
@@ -193,6 +193,11 @@ std::pair<UInt64, UInt64> MinMaxIndex::getUInt64MinMax(size_t pack_index)
     return {minmaxes->get64(pack_index * 2), minmaxes->get64(pack_index * 2 + 1)};
 }
 
+std::pair<Field, Field> MinMaxIndex::getFieldMinMax(size_t pack_index) const
+{
+    return {(*minmaxes)[pack_index * 2], (*minmaxes)[pack_index * 2 + 1]};
+}
+
 RSResult MinMaxIndex::checkNullableEqual(size_t pack_index, const Field & value, const DataTypePtr & type)
 {
     const auto & column_nullable = static_cast<const ColumnNullable &>(*minmaxes);
@@ -17,13 +17,20 @@
 #include <AggregateFunctions/Helpers.h>
 #include <Columns/ColumnNullable.h>
 #include <Columns/ColumnsCommon.h>
-#include <Common/LRUCache.h>
+#include <Common/ProfileEvents.h>
+#include <Common/ShardedCache.h>
 #include <DataTypes/DataTypeEnum.h>
 #include <DataTypes/DataTypeString.h>
 #include <DataTypes/DataTypesNumber.h>
 #include <DataTypes/IDataType.h>
 #include <Storages/DeltaMerge/Index/RSResult.h>
 
+namespace ProfileEvents
+{
+extern const Event MinMaxIndexCacheHits;
+extern const Event MinMaxIndexCacheMisses;
+} // namespace ProfileEvents
+
 namespace DB
 {
 namespace DM
@@ -81,6 +88,12 @@ public:
 
     std::pair<UInt64, UInt64> getUInt64MinMax(size_t pack_index);
 
+    /// Only meaningful if `hasValue`, the nulls are not counted in.
+    std::pair<Field, Field> getFieldMinMax(size_t pack_index) const;
+
+    bool hasNull(size_t pack_index) const { return (*has_null_marks)[pack_index]; }
+    bool hasValue(size_t pack_index) const { return (*has_value_marks)[pack_index]; }
+
     RSResult checkEqual(size_t pack_index, const Field & value, const DataTypePtr & type);
     RSResult checkGreater(size_t pack_index, const Field & value, const DataTypePtr & type, int nan_direction);
     RSResult checkGreaterEqual(size_t pack_index, const Field & value, const DataTypePtr & type, int nan_direction);
@@ -116,20 +129,24 @@ struct MinMaxIndexWeightFunction
 };
 
 
-class MinMaxIndexCache : public LRUCache<String, MinMaxIndex, std::hash<String>, MinMaxIndexWeightFunction>
+class MinMaxIndexCache : public ShardedCache<String, MinMaxIndex, std::hash<String>, MinMaxIndexWeightFunction>
 {
 private:
-    using Base = LRUCache<String, MinMaxIndex, std::hash<String>, MinMaxIndexWeightFunction>;
+    using Base = ShardedCache<String, MinMaxIndex, std::hash<String>, MinMaxIndexWeightFunction>;
 
 public:
-    explicit MinMaxIndexCache(size_t max_size_in_bytes)
-        : Base(max_size_in_bytes)
+    explicit MinMaxIndexCache(size_t max_size_in_bytes, const CacheOptions & options = {})
+        : Base(max_size_in_bytes, options)
     {}
 
     template <typename LoadFunc>
     MappedPtr getOrSet(const Key & key, LoadFunc && load)
     {
         auto result = Base::getOrSet(key, load);
+        if (result.second)
+            ProfileEvents::increment(ProfileEvents::MinMaxIndexCacheMisses);
+        else
+            ProfileEvents::increment(ProfileEvents::MinMaxIndexCacheHits);
         return result.first;
     }
 };
@@ -14,22 +14,13 @@
 
 #pragma once
 
+#include <Storages/DeltaMerge/Index/EqualIndex.h>
 #include <Storages/DeltaMerge/Index/MinMaxIndex.h>
 
 namespace DB
 {
 namespace DM
 {
-class EqualIndex;
-using EqualIndexPtr = std::shared_ptr<EqualIndex>;
-
-
-class EqualIndex
-{
-public:
-    virtual ~EqualIndex() = default;
-};
-
 struct RSIndex
 {
     DataTypePtr type;
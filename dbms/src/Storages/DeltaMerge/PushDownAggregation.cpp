@@ -0,0 +1,109 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Common/Exception.h>
+#include <Common/FmtUtils.h>
+#include <Storages/DeltaMerge/PushDownAggregation.h>
+#include <magic_enum.hpp>
+
+namespace DB
+{
+namespace DM
+{
+void PushDownAggregation::Result::merge(const Funcs & funcs, const Result & other)
+{
+    RUNTIME_CHECK(values.size() == funcs.size() && other.values.size() == funcs.size(), values.size(), other.values.size(), funcs.size());
+
+    packs += other.packs;
+    rows += other.rows;
+    for (size_t i = 0; i < funcs.size(); ++i)
+    {
+        auto & value = values[i];
+        const auto & other_value = other.values[i];
+        switch (funcs[i].kind)
+        {
+        case FuncKind::CountAll:
+        case FuncKind::Count:
+            value = Field(static_cast<UInt64>(value.get<UInt64>() + other_value.get<UInt64>()));
+            break;
+        case FuncKind::Min:
+            if (!other_value.isNull() && (value.isNull() || other_value < value))
+                value = other_value;
+            break;
+        case FuncKind::Max:
+            if (!other_value.isNull() && (value.isNull() || value < other_value))
+                value = other_value;
+            break;
+        }
+    }
+}
+
+PushDownAggregation::Result PushDownAggregation::createEmptyResult() const
+{
+    Result result;
+    result.values.reserve(funcs.size());
+    for (const auto & func : funcs)
+    {
+        if (func.kind == FuncKind::CountAll || func.kind == FuncKind::Count)
+            result.values.emplace_back(static_cast<UInt64>(0));
+        else
+            result.values.emplace_back(Null());
+    }
+    return result;
+}
+
+void PushDownAggregation::setResult(TableID physical_table_id, Result && result)
+{
+    std::lock_guard lock(mutex);
+    results[physical_table_id] = std::move(result);
+}
+
+void PushDownAggregation::dropResult(TableID physical_table_id)
+{
+    std::lock_guard lock(mutex);
+    results.erase(physical_table_id);
+}
+
+std::optional<PushDownAggregation::Result> PushDownAggregation::getResult() const
+{
+    auto merged = createEmptyResult();
+    std::lock_guard lock(mutex);
+    for (const auto & [physical_table_id, result] : results)
+    {
+        (void)physical_table_id;
+        merged.merge(funcs, result);
+    }
+    if (merged.packs == 0)
+        return std::nullopt;
+    return merged;
+}
+
+String PushDownAggregation::toDebugString() const
+{
+    FmtBuffer buffer;
+    buffer.joinStr(
+        funcs.begin(),
+        funcs.end(),
+        [](const Func & func, FmtBuffer & fb) {
+            if (func.kind == FuncKind::CountAll)
+                fb.fmtAppend("{}()", magic_enum::enum_name(func.kind));
+            else
+                fb.fmtAppend("{}({})", magic_enum::enum_name(func.kind), func.col_id);
+        },
+        ", ");
+    return buffer.toString();
+}
+
+} // namespace DM
+} // namespace DB
@@ -0,0 +1,98 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Core/Field.h>
+#include <Core/Types.h>
+#include <Storages/Transaction/Types.h>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace DB
+{
+namespace DM
+{
+class PushDownAggregation;
+using PushDownAggregationPtr = std::shared_ptr<PushDownAggregation>;
+
+/// An aggregation without group by keys that is pushed down to the table scan under it.
+///
+/// The stable packs that are fully covered by the read ranges and the filter, hold only the
+/// latest versions visible to the read and are not shadowed by the delta, are answered by the
+/// pack statistics (`DMFile::PackStat` and `MinMaxIndex`) instead of being read, see
+/// `StableValueSpace::Snapshot::aggregateByPackStats`. Only the rest rows are returned by the
+/// table scan, and the partial result of the answered packs is appended to the output of the
+/// aggregation, so it only works for the partial aggregation whose results are merged again.
+class PushDownAggregation
+{
+public:
+    enum class FuncKind
+    {
+        CountAll, // count(*), count(const) or count(not null column)
+        Count, // count(nullable column)
+        Min,
+        Max,
+    };
+
+    struct Func
+    {
+        FuncKind kind;
+        ColumnID col_id = 0; // Not used by CountAll.
+    };
+    using Funcs = std::vector<Func>;
+
+    /// The partial result of the answered packs, `values` are in the order of `funcs`.
+    /// The values of count are UInt64, and the values of min/max are null if no value is found.
+    struct Result
+    {
+        size_t packs = 0;
+        size_t rows = 0;
+        std::vector<Field> values;
+
+        void merge(const Funcs & funcs, const Result & other);
+    };
+
+    explicit PushDownAggregation(Funcs && funcs_)
+        : funcs(std::move(funcs_))
+    {}
+
+    const Funcs & getFuncs() const { return funcs; }
+
+    Result createEmptyResult() const;
+
+    /// Called by the storage after the read of a physical table, the result of a retried read replaces the previous one.
+    void setResult(TableID physical_table_id, Result && result);
+
+    /// Called if the streams of a physical table are discarded.
+    void dropResult(TableID physical_table_id);
+
+    /// The result of all the physical tables, std::nullopt if no pack is answered by the statistics.
+    std::optional<Result> getResult() const;
+
+    String toDebugString() const;
+
+private:
+    const Funcs funcs;
+
+    mutable std::mutex mutex;
+    std::unordered_map<TableID, Result> results;
+};
+
+} // namespace DM
+} // namespace DB
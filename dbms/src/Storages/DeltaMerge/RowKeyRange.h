@@ -204,6 +204,16 @@ struct RowKeyValue
         return RowKeyValue(is_common_handle, prefix_value, prefix_int_value);
     }
 
+    /// The smallest rowkey value that is larger than this one.
+    RowKeyValue toNext() const
+    {
+        if (is_common_handle)
+            return RowKeyValue(is_common_handle, std::make_shared<String>(*value + '\0'), int_value);
+        if (int_value == std::numeric_limits<Int64>::max())
+            return INT_HANDLE_MAX_KEY;
+        return fromHandle(int_value + 1);
+    }
+
     void serialize(WriteBuffer & buf) const
     {
         writeBoolText(is_common_handle, buf);
@@ -177,5 +177,35 @@ RowKeyRanges tryMergeRanges(RowKeyRanges && sorted_ranges, size_t expected_range
 
     return do_merge_ranges.getRanges();
 }
+
+RowKeyRanges excludeRanges(const RowKeyRanges & sorted_ranges, const RowKeyRanges & sorted_excluded)
+{
+    RowKeyRanges res;
+    res.reserve(sorted_ranges.size());
+    size_t ex_idx = 0;
+    for (const auto & range : sorted_ranges)
+    {
+        if (range.none())
+            continue;
+        RowKeyValue start = range.start;
+        // Skip the excluded ranges that end before this range.
+        while (ex_idx < sorted_excluded.size() && sorted_excluded[ex_idx].end.value->compare(*start.value) <= 0)
+            ++ex_idx;
+        for (size_t i = ex_idx; i < sorted_excluded.size(); ++i)
+        {
+            const auto & excluded = sorted_excluded[i];
+            if (excluded.start.value->compare(*range.end.value) >= 0)
+                break;
+            if (excluded.none())
+                continue;
+            if (start.value->compare(*excluded.start.value) < 0)
+                res.emplace_back(start, excluded.start, range.is_common_handle, range.rowkey_column_size);
+            start = max(start, excluded.end);
+        }
+        if (start.value->compare(*range.end.value) < 0)
+            res.emplace_back(start, range.end, range.is_common_handle, range.rowkey_column_size);
+    }
+    return res;
+}
 } // namespace DM
 } // namespace DB
@@ -27,5 +27,8 @@ void sortRangesByStartEdge(RowKeyRanges & ranges);
 
 RowKeyRanges tryMergeRanges(RowKeyRanges && ranges, size_t expected_ranges_count, const LoggerPtr & log = nullptr);
 
+/// Remove `sorted_excluded` from `sorted_ranges`, both of them must be sorted and not overlapped.
+RowKeyRanges excludeRanges(const RowKeyRanges & sorted_ranges, const RowKeyRanges & sorted_excluded);
+
 } // namespace DM
 } // namespace DB
@@ -49,7 +49,7 @@ SSTFilesToBlockInputStream::SSTFilesToBlockInputStream( //
     TMTContext & tmt_,
     size_t expected_size_)
     : region(std::move(region_))
-    , snaps(snaps_)
+    , snaps(&snaps_)
     , proxy_helper(proxy_helper_)
     , schema_snap(std::move(schema_snap_))
     , tmt(tmt_)
@@ -60,9 +60,37 @@ SSTFilesToBlockInputStream::SSTFilesToBlockInputStream( //
 {
 }
 
+SSTFilesToBlockInputStream::SSTFilesToBlockInputStream( //
+    const std::string & log_prefix_,
+    RegionPtr region_,
+    SSTReaders && readers_,
+    const TiFlashRaftProxyHelper * proxy_helper_,
+    DecodingStorageSchemaSnapshotConstPtr schema_snap_,
+    Timestamp gc_safepoint_,
+    bool force_decode_,
+    TMTContext & tmt_,
+    size_t expected_size_)
+    : region(std::move(region_))
+    , snaps(nullptr)
+    , proxy_helper(proxy_helper_)
+    , schema_snap(std::move(schema_snap_))
+    , tmt(tmt_)
+    , gc_safepoint(gc_safepoint_)
+    , expected_size(expected_size_)
+    , log(Logger::get(log_prefix_))
+    , write_cf_reader(std::move(readers_.write_cf))
+    , default_cf_reader(std::move(readers_.default_cf))
+    , lock_cf_reader(std::move(readers_.lock_cf))
+    , force_decode(force_decode_)
+{
+}
+
 SSTFilesToBlockInputStream::~SSTFilesToBlockInputStream() = default;
 
-void SSTFilesToBlockInputStream::readPrefix()
+SSTFilesToBlockInputStream::SSTReaders SSTFilesToBlockInputStream::openSSTReaders(
+    const SSTViewVec & snaps,
+    const TiFlashRaftProxyHelper * proxy_helper,
+    const LoggerPtr & log)
 {
     std::vector<SSTView> ssts_default;
     std::vector<SSTView> ssts_write;
@@ -88,20 +116,34 @@ void SSTFilesToBlockInputStream::readPrefix()
         }
     }
 
+    SSTReaders readers;
     // Pass the log to SSTReader inorder to filter logs by table_id suffix
     if (!ssts_default.empty())
     {
-        default_cf_reader = std::make_unique<MultiSSTReader<MonoSSTReader, SSTView>>(proxy_helper, ColumnFamilyType::Default, make_inner_func, ssts_default, log);
+        readers.default_cf = std::make_unique<MultiSSTReader<MonoSSTReader, SSTView>>(proxy_helper, ColumnFamilyType::Default, make_inner_func, ssts_default, log);
     }
     if (!ssts_write.empty())
     {
-        write_cf_reader = std::make_unique<MultiSSTReader<MonoSSTReader, SSTView>>(proxy_helper, ColumnFamilyType::Write, make_inner_func, ssts_write, log);
+        readers.write_cf = std::make_unique<MultiSSTReader<MonoSSTReader, SSTView>>(proxy_helper, ColumnFamilyType::Write, make_inner_func, ssts_write, log);
     }
     if (!ssts_lock.empty())
     {
-        lock_cf_reader = std::make_unique<MultiSSTReader<MonoSSTReader, SSTView>>(proxy_helper, ColumnFamilyType::Lock, make_inner_func, ssts_lock, log);
+        readers.lock_cf = std::make_unique<MultiSSTReader<MonoSSTReader, SSTView>>(proxy_helper, ColumnFamilyType::Lock, make_inner_func, ssts_lock, log);
+    }
+    LOG_INFO(log, "Finish Construct MultiSSTReader, write {} lock {} default {}", ssts_write.size(), ssts_lock.size(), ssts_default.size());
+    return readers;
+}
+
+void SSTFilesToBlockInputStream::readPrefix()
+{
+    if (snaps != nullptr)
+    {
+        auto readers = openSSTReaders(*snaps, proxy_helper, log);
+        write_cf_reader = std::move(readers.write_cf);
+        default_cf_reader = std::move(readers.default_cf);
+        lock_cf_reader = std::move(readers.lock_cf);
+        LOG_INFO(log, "Open SST files for region {}", region->id());
     }
-    LOG_INFO(log, "Finish Construct MultiSSTReader, write {} lock {} default {} region {}", ssts_write.size(), ssts_lock.size(), ssts_default.size(), this->region->id());
 
     process_keys.default_cf = 0;
     process_keys.write_cf = 0;
@@ -272,6 +314,94 @@ Block SSTFilesToBlockInputStream::readCommitedBlock()
     }
 }
 
+/// Methods for SSTFilesRangeSplitter
+
+SSTFilesRangeSplitter::SSTFilesRangeSplitter(
+    const std::string & log_prefix_,
+    const SSTViewVec & snaps_,
+    const TiFlashRaftProxyHelper * proxy_helper_,
+    size_t write_cf_keys_per_subrange_)
+    : log(Logger::get(log_prefix_))
+    , write_cf_keys_per_subrange(std::max<size_t>(write_cf_keys_per_subrange_, 1))
+    , readers(SSTFilesToBlockInputStream::openSSTReaders(snaps_, proxy_helper_, log))
+{}
+
+SSTFilesRangeSplitter::~SSTFilesRangeSplitter() = default;
+
+namespace
+{
+// The keys in the write and default CF are the encoded rowkeys with the timestamp appended, while the keys in the lock CF
+// are the encoded rowkeys. The encoded rowkeys are memory-comparable.
+std::string_view rowkeyOf(const BaseBuffView & key, bool with_ts)
+{
+    size_t len = with_ts && key.len >= sizeof(Timestamp) ? key.len - sizeof(Timestamp) : key.len;
+    return std::string_view(key.data, len);
+}
+
+void bufferKeyValue(SSTReader & reader, BufferedSSTReader::KeyValues & kvs)
+{
+    BaseBuffView key = reader.keyView();
+    BaseBuffView value = reader.valueView();
+    kvs.emplace_back(std::string(key.data, key.len), std::string(value.data, value.len));
+}
+
+// Buffer the key-values whose rowkeys are less than or equal to `end_rowkey`, or all the key-values if `end_rowkey` is nullptr.
+SSTFilesToBlockInputStream::SSTReaderPtr bufferUntil(SSTReader * reader, bool with_ts, const std::string * end_rowkey)
+{
+    BufferedSSTReader::KeyValues kvs;
+    while (reader && reader->remained())
+    {
+        if (end_rowkey && rowkeyOf(reader->keyView(), with_ts) > *end_rowkey)
+            break;
+        bufferKeyValue(*reader, kvs);
+        reader->next();
+    }
+    return std::make_unique<BufferedSSTReader>(std::move(kvs));
+}
+} // namespace
+
+bool SSTFilesRangeSplitter::next(SSTFilesToBlockInputStream::SSTReaders & subrange_readers)
+{
+    auto remained = [](const SSTFilesToBlockInputStream::SSTReaderPtr & reader) {
+        return reader && reader->remained();
+    };
+    if (!remained(readers.write_cf) && !remained(readers.default_cf) && !remained(readers.lock_cf))
+        return false;
+
+    BufferedSSTReader::KeyValues write_kvs;
+    std::string end_rowkey;
+    auto & write_reader = readers.write_cf;
+    while (remained(write_reader))
+    {
+        if (write_kvs.size() >= write_cf_keys_per_subrange)
+        {
+            // Continue until the rowkey changes, so that all the versions of a rowkey are in the same subrange.
+            if (end_rowkey.empty())
+            {
+                const auto & last_key = write_kvs.back().first;
+                end_rowkey = rowkeyOf(BaseBuffView{last_key.data(), last_key.size()}, true);
+            }
+            if (rowkeyOf(write_reader->keyView(), true) != end_rowkey)
+                break;
+        }
+        bufferKeyValue(*write_reader, write_kvs);
+        write_reader->next();
+    }
+
+    // The rest key-values of other CFs belong to the last subrange.
+    const bool is_last = !remained(write_reader);
+    subrange_readers.write_cf = std::make_unique<BufferedSSTReader>(std::move(write_kvs));
+    subrange_readers.default_cf = bufferUntil(readers.default_cf.get(), true, is_last ? nullptr : &end_rowkey);
+    subrange_readers.lock_cf = bufferUntil(readers.lock_cf.get(), false, is_last ? nullptr : &end_rowkey);
+    ++subrange_count;
+    LOG_DEBUG(
+        log,
+        "Read subrange of SST files, subrange={} end_rowkey={}",
+        subrange_count,
+        is_last ? "<end>" : Redact::keyToDebugString(end_rowkey.data(), end_rowkey.size()));
+    return true;
+}
+
 /// Methods for BoundedSSTFilesToBlockInputStream
 
 BoundedSSTFilesToBlockInputStream::BoundedSSTFilesToBlockInputStream( //
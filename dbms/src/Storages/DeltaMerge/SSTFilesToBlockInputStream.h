@@ -53,6 +53,14 @@ using BoundedSSTFilesToBlockInputStreamPtr = std::shared_ptr<BoundedSSTFilesToBl
 class SSTFilesToBlockInputStream final : public IBlockInputStream
 {
 public:
+    using SSTReaderPtr = std::unique_ptr<SSTReader>;
+    struct SSTReaders
+    {
+        SSTReaderPtr write_cf;
+        SSTReaderPtr default_cf;
+        SSTReaderPtr lock_cf;
+    };
+
     SSTFilesToBlockInputStream( //
         const std::string & log_prefix_,
         RegionPtr region_,
@@ -63,8 +71,21 @@ public:
         bool force_decode_,
         TMTContext & tmt_,
         size_t expected_size_ = DEFAULT_MERGE_BLOCK_SIZE);
+    /// Read the key-values from `readers_` instead of opening the SST files, see `SSTFilesRangeSplitter`.
+    SSTFilesToBlockInputStream( //
+        const std::string & log_prefix_,
+        RegionPtr region_,
+        SSTReaders && readers_,
+        const TiFlashRaftProxyHelper * proxy_helper_,
+        DecodingStorageSchemaSnapshotConstPtr schema_snap_,
+        Timestamp gc_safepoint_,
+        bool force_decode_,
+        TMTContext & tmt_,
+        size_t expected_size_ = DEFAULT_MERGE_BLOCK_SIZE);
     ~SSTFilesToBlockInputStream() override;
 
+    static SSTReaders openSSTReaders(const SSTViewVec & snaps, const TiFlashRaftProxyHelper * proxy_helper, const LoggerPtr & log);
+
     String getName() const override { return "SSTFilesToBlockInputStream"; }
 
     Block getHeader() const override { return toEmptyBlock(*(schema_snap->column_defines)); }
@@ -90,7 +111,8 @@ private:
 
 private:
     RegionPtr region;
-    const SSTViewVec & snaps;
+    // nullptr if the readers are given by the caller
+    const SSTViewVec * snaps;
     const TiFlashRaftProxyHelper * proxy_helper{nullptr};
     DecodingStorageSchemaSnapshotConstPtr schema_snap;
     TMTContext & tmt;
@@ -98,7 +120,6 @@ private:
     size_t expected_size;
     LoggerPtr log;
 
-    using SSTReaderPtr = std::unique_ptr<SSTReader>;
     SSTReaderPtr write_cf_reader;
     SSTReaderPtr default_cf_reader;
     SSTReaderPtr lock_cf_reader;
@@ -114,6 +135,29 @@ private:
     ProcessKeys process_keys;
 };
 
+/// Read the key-values of SST files, and split them into subranges of rowkeys in ascending order. Each subrange contains
+/// about `write_cf_keys_per_subrange_` keys in the write CF, and the key-values of a rowkey are never split into two subranges.
+/// So the subranges can be decoded and written into DTFiles in parallel, and the DTFiles of the subranges do not overlap.
+class SSTFilesRangeSplitter : private boost::noncopyable
+{
+public:
+    SSTFilesRangeSplitter(
+        const std::string & log_prefix_,
+        const SSTViewVec & snaps_,
+        const TiFlashRaftProxyHelper * proxy_helper_,
+        size_t write_cf_keys_per_subrange_);
+    ~SSTFilesRangeSplitter();
+
+    /// Read the key-values of the next subrange into memory. Return false if all the key-values have been read.
+    bool next(SSTFilesToBlockInputStream::SSTReaders & subrange_readers);
+
+private:
+    LoggerPtr log;
+    const size_t write_cf_keys_per_subrange;
+    SSTFilesToBlockInputStream::SSTReaders readers;
+    size_t subrange_count = 0;
+};
+
 // Bound the blocks read from SSTFilesToBlockInputStream by column `_tidb_rowid` and
 // do some calculation for the `DMFileWriter::BlockProperty` of read blocks.
 class BoundedSSTFilesToBlockInputStream final
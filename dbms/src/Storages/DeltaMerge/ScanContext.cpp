@@ -39,6 +39,7 @@ String ScanContext::toJson() const
     json->set("mvcc_input_rows", mvcc_input_rows.load());
     json->set("mvcc_input_bytes", mvcc_input_bytes.load());
     json->set("mvcc_output_rows", mvcc_output_rows.load());
+    json->set("late_materialization_skipped_rows", late_materialization_skipped_rows.load());
 
     std::stringstream buf;
     json->stringify(buf);
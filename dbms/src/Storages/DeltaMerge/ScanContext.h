@@ -60,6 +60,9 @@ public:
     std::atomic<uint64_t> mvcc_input_bytes{0};
     std::atomic<uint64_t> mvcc_output_rows{0};
 
+    // rows dropped by the late materialization filter in dmfiles
+    std::atomic<uint64_t> late_materialization_skipped_rows{0};
+
     // TODO: mode, filter
 
     ScanContext() = default;
@@ -109,6 +112,8 @@ public:
         mvcc_input_rows += other.mvcc_input_rows;
         mvcc_input_bytes += other.mvcc_input_bytes;
         mvcc_output_rows += other.mvcc_output_rows;
+
+        late_materialization_skipped_rows += other.late_materialization_skipped_rows;
     }
 
     String toJson() const;
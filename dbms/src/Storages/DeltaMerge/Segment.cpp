@@ -21,6 +21,7 @@
 #include <DataStreams/SquashingBlockInputStream.h>
 #include <DataTypes/DataTypeFactory.h>
 #include <Poco/Logger.h>
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilterBlockInputStream.h>
 #include <Storages/DeltaMerge/DMContext.h>
 #include <Storages/DeltaMerge/DMDecoratorStreams.h>
 #include <Storages/DeltaMerge/DMVersionFilterBlockInputStream.h>
@@ -34,6 +35,7 @@
 #include <Storages/DeltaMerge/File/DMFileBlockOutputStream.h>
 #include <Storages/DeltaMerge/Filter/FilterHelper.h>
 #include <Storages/DeltaMerge/PKSquashingBlockInputStream.h>
+#include <Storages/DeltaMerge/RowKeyRangeUtils.h>
 #include <Storages/DeltaMerge/Segment.h>
 #include <Storages/DeltaMerge/StoragePool.h>
 #include <Storages/DeltaMerge/WriteBatches.h>
@@ -593,6 +595,9 @@ BlockInputStreamPtr Segment::getInputStream(const ReadMode & read_mode,
     case ReadMode::Normal:
         return getInputStreamModeNormal(dm_context, columns_to_read, segment_snap, read_ranges, filter, max_version, expected_block_size);
         break;
+    case ReadMode::Bitmap:
+        return getBitmapFilterInputStream(dm_context, columns_to_read, segment_snap, read_ranges, filter, max_version, expected_block_size);
+        break;
     case ReadMode::Fast:
         return getInputStreamModeFast(dm_context, columns_to_read, segment_snap, read_ranges, filter, expected_block_size);
         break;
@@ -700,6 +705,112 @@ BlockInputStreamPtr Segment::getInputStreamModeNormal(const DMContext & dm_conte
     return getInputStreamModeNormal(dm_context, columns_to_read, segment_snap, read_ranges, filter, max_version, expected_block_size);
 }
 
+BitmapFilterPtr Segment::buildBitmapFilter(const DMContext & dm_context,
+                                           const SegmentSnapshotPtr & segment_snap,
+                                           const RowKeyRanges & read_ranges,
+                                           const RSOperatorPtr & filter,
+                                           UInt64 max_version,
+                                           size_t expected_block_size)
+{
+    const size_t stable_rows = segment_snap->stable->getDMFilesRows();
+    auto bitmap_filter = std::make_shared<BitmapFilter>(stable_rows + segment_snap->delta->getRows(), false);
+
+    // Only the PK, version and del_mark columns are read and merged, the output is the row ids of the visible rows.
+    auto read_info = getReadInfo(dm_context, /*read_columns*/ {}, segment_snap, read_ranges, max_version);
+    BlockInputStreamPtr stream = getPlacedStream<false, DeltaIndexIterator, true>(
+        dm_context,
+        *read_info.read_columns,
+        read_ranges,
+        filter,
+        segment_snap->stable,
+        read_info.getDeltaReader(),
+        read_info.index_begin,
+        read_info.index_end,
+        expected_block_size,
+        max_version);
+    stream = std::make_shared<DMRowKeyFilterBlockInputStream<true>>(stream, read_ranges, 0);
+    stream = std::make_shared<DMVersionFilterBlockInputStream<DM_VERSION_FILTER_MODE_MVCC>>(
+        stream,
+        ColumnDefines{getSegmentRowIdColumnDefine()},
+        max_version,
+        is_common_handle,
+        dm_context.tracing_id,
+        dm_context.scan_context);
+
+    stream->readPrefix();
+    while (Block block = stream->read())
+        bitmap_filter->set(block.getByPosition(0).column);
+    stream->readSuffix();
+
+    bitmap_filter->runOptimize();
+    return bitmap_filter;
+}
+
+BlockInputStreamPtr Segment::getBitmapFilterInputStream(const DMContext & dm_context,
+                                                        const ColumnDefines & columns_to_read,
+                                                        const SegmentSnapshotPtr & segment_snap,
+                                                        const RowKeyRanges & read_ranges,
+                                                        const RSOperatorPtr & filter,
+                                                        UInt64 max_version,
+                                                        size_t expected_block_size)
+{
+    const size_t stable_rows = segment_snap->stable->getDMFilesRows();
+    // Fallback to the normal mode if the sort merge is cheap or the bitmap filter is not applicable:
+    // 1. There is nothing in delta, the normal mode reads the stable directly.
+    // 2. Nothing to read besides the PK, version and del_mark columns, which are read by building the bitmap filter anyway.
+    // 3. The row ids exceed UInt32.
+    if (dm_context.read_delta_only || dm_context.read_stable_only //
+        || (segment_snap->delta->getRows() == 0 && segment_snap->delta->getDeletes() == 0) //
+        || std::all_of(columns_to_read.begin(), columns_to_read.end(), [](const ColumnDefine & cd) { return cd.id == EXTRA_HANDLE_COLUMN_ID || cd.id == VERSION_COLUMN_ID || cd.id == TAG_COLUMN_ID; })
+        || stable_rows + segment_snap->delta->getRows() > std::numeric_limits<UInt32>::max())
+    {
+        return getInputStreamModeNormal(dm_context, columns_to_read, segment_snap, read_ranges, filter, max_version, expected_block_size);
+    }
+
+    RowKeyRanges real_ranges;
+    for (const auto & read_range : read_ranges)
+    {
+        auto real_range = rowkey_range.shrink(read_range);
+        if (!real_range.none())
+            real_ranges.emplace_back(std::move(real_range));
+    }
+    if (real_ranges.empty())
+        return std::make_shared<EmptyBlockInputStream>(toEmptyBlock(columns_to_read));
+
+    auto bitmap_filter = buildBitmapFilter(dm_context, segment_snap, real_ranges, filter, max_version, expected_block_size);
+
+    // The stable is read with the same ranges and filter as building the bitmap filter, so the packs skipped there are
+    // skipped here too. The delta is read as a whole, the rows out of `real_ranges` are filtered by the bitmap filter.
+    auto stable_stream = segment_snap->stable->getInputStream(
+        dm_context,
+        columns_to_read,
+        real_ranges,
+        filter,
+        max_version,
+        expected_block_size,
+        /* enable_handle_clean_read */ false);
+    auto delta_stream = std::make_shared<DeltaValueInputStream>(
+        dm_context,
+        segment_snap->delta,
+        std::make_shared<ColumnDefines>(columns_to_read),
+        rowkey_range);
+
+    LOG_TRACE(
+        log->getChild(dm_context.tracing_id),
+        "Finish segment create bitmap filter input stream, max_version={} visible_rows={} total_rows={} ranges={}",
+        max_version,
+        bitmap_filter->count(),
+        bitmap_filter->size(),
+        DB::DM::toDebugString(read_ranges));
+    return std::make_shared<BitmapFilterBlockInputStream>(
+        columns_to_read,
+        stable_stream,
+        delta_stream,
+        stable_rows,
+        bitmap_filter,
+        dm_context.tracing_id);
+}
+
 BlockInputStreamPtr Segment::getInputStreamForDataExport(const DMContext & dm_context,
                                                          const ColumnDefines & columns_to_read,
                                                          const SegmentSnapshotPtr & segment_snap,
@@ -889,6 +1000,65 @@ BlockInputStreamPtr Segment::getInputStreamModeRaw(const DMContext & dm_context,
     return getInputStreamModeRaw(dm_context, columns_to_read, segment_snap, {rowkey_range});
 }
 
+RowKeyRanges Segment::aggregateByPackStats(
+    const DMContext & dm_context,
+    const ColumnDefines & columns_to_read,
+    const SegmentSnapshotPtr & segment_snap,
+    const RowKeyRanges & read_ranges,
+    const RSOperatorPtr & filter,
+    UInt64 max_version,
+    const PushDownAggregation & aggregation,
+    PushDownAggregation::Result & result) const
+{
+    // The delete ranges may cover any stable rows, don't bother with them.
+    if (segment_snap->delta->getDeletes() > 0)
+        return read_ranges;
+
+    // The stable rows shadowed by the delta rows are not answered, and we only
+    // check them by the handle range of the delta rows for simplicity.
+    auto delta_range = RowKeyRange::newNone(is_common_handle, rowkey_column_size);
+    if (const size_t delta_rows = segment_snap->delta->getRows(); delta_rows > 0)
+    {
+        auto pk_ver_col_defs
+            = std::make_shared<ColumnDefines>(ColumnDefines{getExtraHandleColumnDefine(is_common_handle), getVersionColumnDefine()});
+        auto delta_reader = std::make_shared<DeltaValueReader>(dm_context, segment_snap->delta, pk_ver_col_defs, rowkey_range);
+        std::optional<RowKeyValue> min_handle;
+        std::optional<RowKeyValue> max_handle;
+        for (auto & item : delta_reader->getPlaceItems(0, 0, delta_rows, 0))
+        {
+            if (!item.isBlock())
+                continue;
+            const auto & block = item.getBlock();
+            RowKeyColumnContainer handles(block.getByPosition(0).column, is_common_handle);
+            for (size_t i = 0; i < block.rows(); ++i)
+            {
+                auto handle = handles.getRowKeyValue(i);
+                if (!min_handle || compare(handle, min_handle->toRowKeyValueRef()) < 0)
+                    min_handle = handle.toRowKeyValue();
+                if (!max_handle || compare(max_handle->toRowKeyValueRef(), handle) < 0)
+                    max_handle = handle.toRowKeyValue();
+            }
+        }
+        if (min_handle)
+            delta_range = RowKeyRange(*min_handle, max_handle->toNext(), is_common_handle, rowkey_column_size);
+    }
+
+    auto sorted_ranges = read_ranges;
+    sortRangesByStartEdge(sorted_ranges);
+    auto answered_ranges = segment_snap->stable->aggregateByPackStats(
+        dm_context,
+        columns_to_read,
+        sorted_ranges,
+        filter,
+        max_version,
+        delta_range,
+        aggregation,
+        result);
+    if (answered_ranges.empty())
+        return read_ranges;
+    return excludeRanges(sorted_ranges, answered_ranges);
+}
+
 SegmentPtr Segment::mergeDelta(DMContext & dm_context, const ColumnDefinesPtr & schema_snap) const
 {
     WriteBatches wbs(dm_context.storage_pool, dm_context.getWriteLimiter());
@@ -1829,6 +1999,8 @@ void Segment::placeDeltaIndex(DMContext & dm_context)
                 /*read_columns=*/{getExtraHandleColumnDefine(is_common_handle)},
                 segment_snap,
                 {RowKeyRange::newAll(is_common_handle, rowkey_column_size)});
+    if (dm_context.enable_persisted_delta_index)
+        delta->persistDeltaIndex(dm_context, segment_snap->stable->getDMFilesRows());
 }
 
 String Segment::simpleInfo() const
@@ -1964,7 +2136,7 @@ ColumnDefinesPtr Segment::arrangeReadColumns(const ColumnDefine & handle, const
     return std::make_shared<ColumnDefines>(std::move(new_columns_to_read));
 }
 
-template <bool skippable_place, class IndexIterator>
+template <bool skippable_place, class IndexIterator, bool need_row_id>
 SkippableBlockInputStreamPtr Segment::getPlacedStream(const DMContext & dm_context,
                                                       const ColumnDefines & read_columns,
                                                       const RowKeyRanges & rowkey_ranges,
@@ -1982,13 +2154,14 @@ SkippableBlockInputStreamPtr Segment::getPlacedStream(const DMContext & dm_conte
     SkippableBlockInputStreamPtr stable_input_stream
         = stable_snap->getInputStream(dm_context, read_columns, rowkey_ranges, filter, max_version, expected_block_size, false);
     RowKeyRange rowkey_range = rowkey_ranges.size() == 1 ? rowkey_ranges[0] : mergeRanges(rowkey_ranges, rowkey_ranges[0].is_common_handle, rowkey_ranges[0].rowkey_column_size);
-    return std::make_shared<DeltaMergeBlockInputStream<DeltaValueReader, IndexIterator, skippable_place>>( //
+    return std::make_shared<DeltaMergeBlockInputStream<DeltaValueReader, IndexIterator, skippable_place, need_row_id>>( //
         stable_input_stream,
         delta_reader,
         delta_index_begin,
         delta_index_end,
         rowkey_range,
-        expected_block_size);
+        expected_block_size,
+        stable_snap->getDMFilesRows());
 }
 
 std::pair<DeltaIndexPtr, bool> Segment::ensurePlace(const DMContext & dm_context,
@@ -1998,6 +2171,9 @@ std::pair<DeltaIndexPtr, bool> Segment::ensurePlace(const DMContext & dm_context
                                                     UInt64 max_version) const
 {
     auto delta_snap = delta_reader->getDeltaSnap();
+    // Restore the shared delta index from disk if it has been evicted or not placed after restart.
+    if (dm_context.enable_persisted_delta_index)
+        delta->tryRestoreDeltaIndex(dm_context, stable_snap->getDMFilesRows());
     // Try to clone from the sahred delta index, if it fails to reuse the shared delta index,
     // it will return an empty delta index and we should place it in the following branch.
     auto my_delta_index = delta_snap->getSharedDeltaIndex()->tryClone(delta_snap->getRows(), delta_snap->getDeletes());
@@ -17,6 +17,7 @@
 #include <Common/nocopyable.h>
 #include <Core/Block.h>
 #include <Interpreters/ExpressionActions.h>
+#include <Storages/DeltaMerge/BitmapFilter/BitmapFilter.h>
 #include <Storages/DeltaMerge/Delta/DeltaValueSpace.h>
 #include <Storages/DeltaMerge/DeltaIndex.h>
 #include <Storages/DeltaMerge/DeltaMergeDefines.h>
@@ -191,6 +192,25 @@ public:
         UInt64 max_version = std::numeric_limits<UInt64>::max(),
         size_t expected_block_size = DEFAULT_BLOCK_SIZE);
 
+    /// Read the latest versions without sort merging stable and delta, see `ReadMode::Bitmap`.
+    BlockInputStreamPtr getBitmapFilterInputStream(
+        const DMContext & dm_context,
+        const ColumnDefines & columns_to_read,
+        const SegmentSnapshotPtr & segment_snap,
+        const RowKeyRanges & read_ranges,
+        const RSOperatorPtr & filter,
+        UInt64 max_version,
+        size_t expected_block_size);
+
+    /// Build the visibility of the rows in `read_ranges` by the MVCC filtering of the PK, version and del_mark columns.
+    BitmapFilterPtr buildBitmapFilter(
+        const DMContext & dm_context,
+        const SegmentSnapshotPtr & segment_snap,
+        const RowKeyRanges & read_ranges,
+        const RSOperatorPtr & filter,
+        UInt64 max_version,
+        size_t expected_block_size);
+
     /**
      * Return a sorted stream which is suitable for exporting data. Unlike `getInputStream`, deletes will be preserved.
      * But outdated versions (exceeds GC safe point) will still be removed.
@@ -223,6 +243,18 @@ public:
         const DMContext & dm_context,
         const ColumnDefines & columns_to_read);
 
+    /// Answer the pushed down aggregation by the pack statistics of the stable, and merge it into `result`.
+    /// Return the rest ranges of `read_ranges` that should still be read.
+    RowKeyRanges aggregateByPackStats(
+        const DMContext & dm_context,
+        const ColumnDefines & columns_to_read,
+        const SegmentSnapshotPtr & segment_snap,
+        const RowKeyRanges & read_ranges,
+        const RSOperatorPtr & filter,
+        UInt64 max_version,
+        const PushDownAggregation & aggregation,
+        PushDownAggregation::Result & result) const;
+
     /// For those split, merge and mergeDelta methods, we should use prepareXXX/applyXXX combo in real production.
     /// split(), merge() and mergeDelta() are only used in test cases.
 
@@ -550,7 +582,9 @@ private:
         const ColumnDefines & columns_to_read);
 
     /// Create a stream which merged delta and stable streams together.
-    template <bool skippable_place = false, class IndexIterator = DeltaIndexIterator>
+    /// If `need_row_id` is true, the row ids of the rows in segment are appended to the blocks, and the delta rows are not
+    /// filtered by `rowkey_ranges`.
+    template <bool skippable_place = false, class IndexIterator = DeltaIndexIterator, bool need_row_id = false>
     static SkippableBlockInputStreamPtr getPlacedStream(
         const DMContext & dm_context,
         const ColumnDefines & read_columns,
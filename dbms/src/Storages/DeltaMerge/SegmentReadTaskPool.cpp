@@ -96,6 +96,65 @@ SegmentReadTasks SegmentReadTask::trySplitReadTasks(const SegmentReadTasks & tas
     return result_tasks;
 }
 
+SegmentReadTasks SegmentReadTask::trySplitReadTasksByPacks(
+    const DMContext & dm_context,
+    const SegmentReadTasks & tasks,
+    const RSOperatorPtr & filter,
+    size_t expected_size,
+    size_t min_packs)
+{
+    if (tasks.empty() || tasks.size() >= expected_size || min_packs == 0)
+        return tasks;
+
+    std::vector<RowKeyValues> tasks_start_keys;
+    tasks_start_keys.reserve(tasks.size());
+    size_t total_packs = 0;
+    for (const auto & task : tasks)
+    {
+        tasks_start_keys.push_back(task->read_snapshot->stable->getPackStartKeys(dm_context, task->ranges, filter));
+        total_packs += tasks_start_keys.back().size();
+    }
+    if (total_packs == 0)
+        return tasks;
+
+    const auto all_range = RowKeyRange::newAll(dm_context.is_common_handle, dm_context.rowkey_column_size);
+    SegmentReadTasks result_tasks;
+    auto task_it = tasks.begin();
+    for (size_t i = 0; i < tasks.size(); ++i, ++task_it)
+    {
+        const auto & task = *task_it;
+        const auto & start_keys = tasks_start_keys[i];
+        // The sub-tasks are distributed by the number of packs to read.
+        size_t split_count = std::min(expected_size * start_keys.size() / total_packs, start_keys.size() / min_packs);
+        if (split_count <= 1)
+        {
+            result_tasks.push_back(task);
+            continue;
+        }
+
+        // Sub-task j reads [start_keys[j * n / split_count], start_keys[(j + 1) * n / split_count]) of the ranges,
+        // the first and the last one are extended to the infinity.
+        const size_t n = start_keys.size();
+        for (size_t j = 0; j < split_count; ++j)
+        {
+            RowKeyRange split_range(
+                j == 0 ? all_range.start : start_keys[j * n / split_count],
+                j + 1 == split_count ? all_range.end : start_keys[(j + 1) * n / split_count],
+                dm_context.is_common_handle,
+                dm_context.rowkey_column_size);
+            RowKeyRanges sub_ranges;
+            for (const auto & range : task->ranges)
+            {
+                auto sub_range = range.shrink(split_range);
+                if (!sub_range.none())
+                    sub_ranges.push_back(std::move(sub_range));
+            }
+            if (!sub_ranges.empty())
+                result_tasks.push_back(std::make_shared<SegmentReadTask>(task->segment, task->read_snapshot->clone(), sub_ranges));
+        }
+    }
+    return result_tasks;
+}
 
 SegmentReadTasksWrapper::SegmentReadTasksWrapper(bool enable_read_thread_, SegmentReadTasks && ordered_tasks_)
     : enable_read_thread(enable_read_thread_)
@@ -54,6 +54,15 @@ struct SegmentReadTask
     void mergeRanges() { ranges = DM::tryMergeRanges(std::move(ranges), 1); }
 
     static SegmentReadTasks trySplitReadTasks(const SegmentReadTasks & tasks, size_t expected_size);
+
+    /// Split the tasks into about `expected_size` sub-tasks by the packs of the stable, so that a few large segments
+    /// can be read by several threads. Every sub-task reads a disjoint key range and at least `min_packs` packs.
+    static SegmentReadTasks trySplitReadTasksByPacks(
+        const DMContext & dm_context,
+        const SegmentReadTasks & tasks,
+        const RSOperatorPtr & filter,
+        size_t expected_size,
+        size_t min_packs);
 };
 
 class BlockStat
@@ -118,6 +127,13 @@ enum class ReadMode
      */
     Normal,
 
+    /**
+     * Read the latest versions like the normal mode, but data is not ordered by PK. The visible rows are decided by a
+     * bitmap built from the PK, version and del_mark columns first, and then the other columns are read from stable and
+     * delta directly and filtered by the bitmap, instead of being sort merged.
+     */
+    Bitmap,
+
     /**
      * Read in fast mode. Data is not sort merged, and all versions are returned. However, deleted records (del_mark=1)
      * will be still filtered out.
@@ -357,6 +357,7 @@ StableValueSpace::Snapshot::getInputStream(
         builder
             .enableCleanRead(enable_handle_clean_read, is_fast_scan, enable_del_clean_read, max_data_version)
             .setRSOperator(filter)
+            .setLateMaterializationFilter(is_fast_scan ? context.late_materialization_filter : nullptr)
             .setColumnCache(column_caches[i])
             .setTracingID(context.tracing_id)
             .setRowsThreshold(expected_block_size);
@@ -468,5 +469,193 @@ StableValueSpace::Snapshot::getAtLeastRowsAndBytes(const DMContext & context, co
     return ret;
 }
 
+RowKeyValues StableValueSpace::Snapshot::getPackStartKeys(const DMContext & context, const RowKeyRanges & rowkey_ranges, const RSOperatorPtr & filter) const
+{
+    RowKeyValues start_keys;
+    for (const auto & file : stable->files)
+    {
+        auto pack_filter = DMFilePackFilter::loadFrom(
+            file,
+            context.db_context.getGlobalContext().getMinMaxIndexCache(),
+            /*set_cache_if_miss*/ true,
+            rowkey_ranges,
+            filter,
+            IdSetPtr{},
+            context.db_context.getFileProvider(),
+            context.getReadLimiter(),
+            context.scan_context,
+            context.tracing_id);
+        const auto & use_packs = pack_filter.getUsePacks();
+        for (size_t pack_id = 0; pack_id < use_packs.size(); ++pack_id)
+        {
+            if (!use_packs[pack_id])
+                continue;
+            if (context.is_common_handle)
+                start_keys.emplace_back(true, std::make_shared<String>(pack_filter.getMinStringHandle(pack_id).toString()), 0);
+            else
+                start_keys.emplace_back(RowKeyValue::fromHandle(pack_filter.getMinHandle(pack_id)));
+        }
+    }
+    return start_keys;
+}
+
+RowKeyRanges StableValueSpace::Snapshot::aggregateByPackStats(
+    const DMContext & context,
+    const ColumnDefines & read_columns,
+    const RowKeyRanges & rowkey_ranges,
+    const RSOperatorPtr & filter,
+    UInt64 max_data_version,
+    const RowKeyRange & delta_range,
+    const PushDownAggregation & aggregation,
+    PushDownAggregation::Result & result) const
+{
+    const auto & funcs = aggregation.getFuncs();
+
+    struct PackCandidate
+    {
+        RowKeyValue min_handle;
+        RowKeyValue max_handle;
+        // std::nullopt if the pack can not be answered by its statistics.
+        std::optional<PushDownAggregation::Result> result;
+    };
+    // The packs of all the files in order, so that the neighbours across the files are checked as well.
+    std::vector<PackCandidate> packs;
+
+    std::vector<ColId> filter_col_ids;
+    if (filter)
+    {
+        for (const auto & attr : filter->getAttrs())
+            filter_col_ids.push_back(attr.col_id);
+    }
+
+    for (const auto & file : stable->files)
+    {
+        auto pack_filter = DMFilePackFilter::loadFrom(
+            file,
+            context.db_context.getGlobalContext().getMinMaxIndexCache(),
+            /*set_cache_if_miss*/ true,
+            rowkey_ranges,
+            filter,
+            IdSetPtr{},
+            context.db_context.getFileProvider(),
+            context.getReadLimiter(),
+            context.scan_context,
+            context.tracing_id);
+        auto handle_index = pack_filter.getMinMaxIndex(EXTRA_HANDLE_COLUMN_ID);
+        auto version_index = pack_filter.getMinMaxIndex(VERSION_COLUMN_ID);
+        if (!handle_index || !version_index)
+            return {};
+
+        // The statistics of a column can be used only if the column is not altered since the file is written.
+        bool file_answerable = true;
+        std::vector<MinMaxIndexPtr> func_indexes(funcs.size());
+        for (size_t j = 0; j < funcs.size() && file_answerable; ++j)
+        {
+            if (funcs[j].kind == PushDownAggregation::FuncKind::CountAll)
+                continue;
+            auto iter = std::find_if(read_columns.begin(), read_columns.end(), [&](const ColumnDefine & cd) {
+                return cd.id == funcs[j].col_id;
+            });
+            file_answerable = iter != read_columns.end() && file->isColumnExist(funcs[j].col_id)
+                && file->getColumnStat(funcs[j].col_id).type->equals(*iter->type);
+            if (file_answerable)
+                func_indexes[j] = pack_filter.getMinMaxIndex(funcs[j].col_id);
+            file_answerable = file_answerable && func_indexes[j];
+        }
+        // The rough check of nullable columns may return `All` even if there are nulls in the pack.
+        std::vector<MinMaxIndexPtr> filter_indexes;
+        for (auto col_id : filter_col_ids)
+        {
+            auto index = pack_filter.getMinMaxIndex(col_id);
+            file_answerable = file_answerable && index;
+            filter_indexes.push_back(index);
+        }
+
+        const auto & pack_res = pack_filter.getPackRes();
+        const auto & pack_stats = file->getPackStats();
+        for (size_t pack_id = 0; pack_id < pack_stats.size(); ++pack_id)
+        {
+            auto & candidate = packs.emplace_back();
+            if (context.is_common_handle)
+            {
+                auto [min_handle, max_handle] = handle_index->getStringMinMax(pack_id);
+                candidate.min_handle = RowKeyValue(true, std::make_shared<String>(min_handle.toString()), 0);
+                candidate.max_handle = RowKeyValue(true, std::make_shared<String>(max_handle.toString()), 0);
+            }
+            else
+            {
+                auto [min_handle, max_handle] = handle_index->getIntMinMax(pack_id);
+                candidate.min_handle = RowKeyValue::fromHandle(min_handle);
+                candidate.max_handle = RowKeyValue::fromHandle(max_handle);
+            }
+
+            const auto & pack_stat = pack_stats[pack_id];
+            if (!file_answerable || pack_res[pack_id] != RSResult::All || pack_stat.rows == 0 || pack_stat.not_clean > 0)
+                continue;
+            if (version_index->getUInt64MinMax(pack_id).second > max_data_version)
+                continue;
+            if (std::any_of(filter_indexes.begin(), filter_indexes.end(), [&](const MinMaxIndexPtr & index) {
+                    return index->hasNull(pack_id);
+                }))
+                continue;
+
+            auto pack_result = aggregation.createEmptyResult();
+            pack_result.packs = 1;
+            pack_result.rows = pack_stat.rows;
+            bool answered = true;
+            for (size_t j = 0; j < funcs.size() && answered; ++j)
+            {
+                const auto & index = func_indexes[j];
+                switch (funcs[j].kind)
+                {
+                case PushDownAggregation::FuncKind::CountAll:
+                    pack_result.values[j] = static_cast<UInt64>(pack_stat.rows);
+                    break;
+                case PushDownAggregation::FuncKind::Count:
+                    if (!index->hasNull(pack_id))
+                        pack_result.values[j] = static_cast<UInt64>(pack_stat.rows);
+                    else if (!index->hasValue(pack_id))
+                        pack_result.values[j] = static_cast<UInt64>(0);
+                    else
+                        answered = false;
+                    break;
+                case PushDownAggregation::FuncKind::Min:
+                case PushDownAggregation::FuncKind::Max:
+                    if (index->hasValue(pack_id))
+                    {
+                        auto [min_value, max_value] = index->getFieldMinMax(pack_id);
+                        pack_result.values[j] = funcs[j].kind == PushDownAggregation::FuncKind::Min ? min_value : max_value;
+                        answered = !pack_result.values[j].isNull();
+                    }
+                    break;
+                }
+            }
+            if (answered)
+                candidate.result = std::move(pack_result);
+        }
+    }
+
+    RowKeyRanges answered_ranges;
+    for (size_t i = 0; i < packs.size(); ++i)
+    {
+        const auto & candidate = packs[i];
+        if (!candidate.result)
+            continue;
+        // The rows with the same handle in the neighbour packs are older versions, or deleted ones
+        // across the files. Skip such packs to keep the answered handle ranges exclusive.
+        if (i > 0 && *packs[i - 1].max_handle.value == *candidate.min_handle.value)
+            continue;
+        if (i + 1 < packs.size() && *packs[i + 1].min_handle.value == *candidate.max_handle.value)
+            continue;
+        RowKeyRange pack_range(candidate.min_handle, candidate.max_handle.toNext(), context.is_common_handle, context.rowkey_column_size);
+        if (pack_range.intersect(delta_range))
+            continue;
+
+        result.merge(funcs, *candidate.result);
+        answered_ranges.push_back(std::move(pack_range));
+    }
+    return answered_ranges;
+}
+
 } // namespace DM
 } // namespace DB
@@ -17,6 +17,7 @@
 #include <Storages/DeltaMerge/File/ColumnCache.h>
 #include <Storages/DeltaMerge/File/DMFile.h>
 #include <Storages/DeltaMerge/Index/RSResult.h>
+#include <Storages/DeltaMerge/PushDownAggregation.h>
 #include <Storages/DeltaMerge/RowKeyRange.h>
 #include <Storages/DeltaMerge/SkippableBlockInputStream.h>
 #include <Storages/Page/Page.h>
@@ -232,6 +233,29 @@ public:
          */
         AtLeastRowsAndBytesResult getAtLeastRowsAndBytes(const DMContext & context, const RowKeyRange & range) const;
 
+        /**
+         * Get the first rowkeys of the packs that will be read by `rowkey_ranges` and `filter`, in ascending order.
+         * They are used as the points to split a read of the segment into several sub-reads.
+         */
+        RowKeyValues getPackStartKeys(const DMContext & context, const RowKeyRanges & rowkey_ranges, const RSOperatorPtr & filter) const;
+
+        /**
+         * Answer the pushed down aggregation by the pack statistics and merge it into `result`. A pack is answered only if
+         * - it is fully covered by `rowkey_ranges` and (rough) matched by `filter`,
+         * - all its rows are the latest versions visible to `max_data_version` and none of them is deleted,
+         * - its handles are not shared by the neighbour packs, and do not intersect with `delta_range`.
+         * Return the sorted handle ranges of the answered packs, which should be excluded from the following read.
+         */
+        RowKeyRanges aggregateByPackStats(
+            const DMContext & context,
+            const ColumnDefines & read_columns,
+            const RowKeyRanges & rowkey_ranges,
+            const RSOperatorPtr & filter,
+            UInt64 max_data_version,
+            const RowKeyRange & delta_range,
+            const PushDownAggregation & aggregation,
+            PushDownAggregation::Result & result) const;
+
     private:
         LoggerPtr log;
     };
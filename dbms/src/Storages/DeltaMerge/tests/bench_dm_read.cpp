@@ -0,0 +1,249 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Poco/File.h>
+#include <Storages/DeltaMerge/DeltaMergeStore.h>
+#include <Storages/DeltaMerge/File/DMFileBlockInputStream.h>
+#include <Storages/DeltaMerge/File/DMFileBlockOutputStream.h>
+#include <Storages/DeltaMerge/Filter/RSOperator.h>
+#include <Storages/DeltaMerge/ScanContext.h>
+#include <Storages/DeltaMerge/tests/DMTestEnv.h>
+#include <TestUtils/ColumnGenerator.h>
+#include <TestUtils/TiFlashTestBasic.h>
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace DB
+{
+namespace DM
+{
+namespace tests
+{
+using namespace DB::tests;
+
+/// The base of the read benchmarks, the table contains [handle, ver, del] and
+/// `num_int_columns` Int64 columns, and a String column of `string_size` bytes if it is not 0.
+class DMReadBench : public benchmark::Fixture
+{
+public:
+    static constexpr size_t total_rows = 1 << 20;
+    static constexpr size_t block_size = 8192;
+
+    void SetUp(const benchmark::State & state) override
+    {
+        path = TiFlashTestEnv::getTemporaryPath(name());
+        if (Poco::File file(path); file.exists())
+            file.remove(true);
+        context = std::make_unique<Context>(TiFlashTestEnv::getContext(DB::Settings(), {path}));
+
+        num_int_columns = state.range(0);
+        string_size = state.range(1);
+        columns = DMTestEnv::getDefaultColumns();
+        for (size_t i = 0; i < num_int_columns; ++i)
+            columns->emplace_back(ColumnDefine(100 + i, fmt::format("i{}", i), DataTypeFactory::instance().get("Int64")));
+        if (string_size > 0)
+            columns->emplace_back(ColumnDefine(200, "s", DataTypeFactory::instance().get("String")));
+    }
+
+    void TearDown(const benchmark::State &) override
+    {
+        context.reset();
+        if (Poco::File file(path); file.exists())
+            file.remove(true);
+    }
+
+    virtual String name() const = 0;
+
+    /// Rows of handle in [beg, end), or the handles of `handles` if it is not empty.
+    Block prepareBlock(size_t beg, size_t end, UInt64 tso, const std::vector<Int64> & handles = {}) const
+    {
+        Block block = DMTestEnv::prepareSimpleWriteBlock(beg, end, false, tso);
+        if (!handles.empty())
+        {
+            auto & handle_column = block.getByPosition(0);
+            auto column = handle_column.type->createColumn();
+            for (auto handle : handles)
+                column->insert(Field(handle));
+            handle_column.column = std::move(column);
+        }
+
+        size_t rows = end - beg;
+        for (size_t i = 0; i < num_int_columns; ++i)
+        {
+            auto column = ColumnGenerator::instance().generate({rows, "Int64", RANDOM});
+            column.name = fmt::format("i{}", i);
+            column.column_id = 100 + i;
+            block.insert(std::move(column));
+        }
+        if (string_size > 0)
+        {
+            /// The strings are fixed to `string_size` bytes.
+            auto column = ColumnGenerator::instance().generate({rows, "String", RANDOM, string_size, rows});
+            column.name = "s";
+            column.column_id = 200;
+            block.insert(std::move(column));
+        }
+        return block;
+    }
+
+protected:
+    String path;
+    std::unique_ptr<Context> context;
+    size_t num_int_columns = 0;
+    size_t string_size = 0;
+    ColumnDefinesPtr columns;
+};
+
+/// Read all columns of a DMFile.
+/// Args: {num Int64 columns, size of the String column}
+class DMFileReadBench : public DMReadBench
+{
+public:
+    void SetUp(const benchmark::State & state) override
+    {
+        DMReadBench::SetUp(state);
+
+        dm_file = DMFile::create(1, path);
+        auto stream = std::make_shared<DMFileBlockOutputStream>(*context, dm_file, *columns);
+        stream->writePrefix();
+        for (size_t beg = 0; beg < total_rows; beg += block_size)
+            stream->write(prepareBlock(beg, beg + block_size, 2), DMFileBlockOutputStream::BlockProperty{0, 0, 0, 0});
+        stream->writeSuffix();
+    }
+
+    void TearDown(const benchmark::State & state) override
+    {
+        dm_file.reset();
+        DMReadBench::TearDown(state);
+    }
+
+    String name() const override { return "DMFileReadBench"; }
+
+protected:
+    DMFilePtr dm_file;
+};
+
+BENCHMARK_DEFINE_F(DMFileReadBench, read)
+(benchmark::State & state)
+try
+{
+    for (auto _ : state)
+    {
+        DMFileBlockInputStreamBuilder builder(*context);
+        auto stream = builder.build(dm_file, *columns, {RowKeyRange::newAll(false, 1)}, std::make_shared<ScanContext>());
+        size_t rows = 0;
+        while (Block block = stream->read())
+            rows += block.rows();
+        benchmark::DoNotOptimize(rows);
+    }
+    state.SetItemsProcessed(state.iterations() * total_rows);
+}
+CATCH
+BENCHMARK_REGISTER_F(DMFileReadBench, read)
+    ->Args({1, 0})
+    ->Args({8, 0})
+    ->Args({32, 0})
+    ->Args({1, 16})
+    ->Args({1, 256});
+
+/// Read all columns from a DeltaMergeStore, in which the stable contains `total_rows` rows
+/// and the delta contains the updates of `delta_percent` percent of them.
+/// Args: {num Int64 columns, size of the String column, delta_percent}
+class DeltaMergeStoreReadBench : public DMReadBench
+{
+public:
+    void SetUp(const benchmark::State & state) override
+    {
+        DMReadBench::SetUp(state);
+
+        const auto & handle = (*columns)[0];
+        store = std::make_shared<DeltaMergeStore>(*context, false, "test", "t_bench", 100, true, *columns, handle, false, 1);
+
+        for (size_t beg = 0; beg < total_rows; beg += block_size)
+        {
+            Block block = prepareBlock(beg, beg + block_size, 2);
+            store->write(*context, context->getSettingsRef(), block);
+        }
+        store->flushCache(*context, RowKeyRange::newAll(false, 1));
+        store->mergeDeltaAll(*context);
+
+        /// Update some random rows, they are left in the delta layer.
+        size_t delta_rows = total_rows * state.range(2) / 100;
+        std::mt19937_64 rand_gen(delta_rows);
+        for (size_t written = 0; written < delta_rows; written += block_size)
+        {
+            size_t rows = std::min(block_size, delta_rows - written);
+            std::vector<Int64> handles(rows);
+            for (auto & h : handles)
+                h = rand_gen() % total_rows;
+            Block block = prepareBlock(0, rows, 3, handles);
+            store->write(*context, context->getSettingsRef(), block);
+        }
+        store->flushCache(*context, RowKeyRange::newAll(false, 1));
+    }
+
+    void TearDown(const benchmark::State & state) override
+    {
+        store->drop();
+        store.reset();
+        DMReadBench::TearDown(state);
+    }
+
+    String name() const override { return "DeltaMergeStoreReadBench"; }
+
+protected:
+    DeltaMergeStorePtr store;
+};
+
+BENCHMARK_DEFINE_F(DeltaMergeStoreReadBench, read)
+(benchmark::State & state)
+try
+{
+    for (auto _ : state)
+    {
+        auto streams = store->read(
+            *context,
+            context->getSettingsRef(),
+            *columns,
+            {RowKeyRange::newAll(false, 1)},
+            /* num_streams= */ 1,
+            /* max_version= */ std::numeric_limits<UInt64>::max(),
+            EMPTY_FILTER,
+            "bench",
+            /* keep_order= */ false);
+        size_t rows = 0;
+        for (auto & stream : streams)
+        {
+            stream->readPrefix();
+            while (Block block = stream->read())
+                rows += block.rows();
+            stream->readSuffix();
+        }
+        benchmark::DoNotOptimize(rows);
+    }
+    state.SetItemsProcessed(state.iterations() * total_rows);
+}
+CATCH
+BENCHMARK_REGISTER_F(DeltaMergeStoreReadBench, read)
+    ->Args({1, 0, 0})
+    ->Args({1, 0, 1})
+    ->Args({1, 0, 10})
+    ->Args({1, 0, 30})
+    ->Args({8, 16, 0})
+    ->Args({8, 16, 10});
+
+} // namespace tests
+} // namespace DM
+} // namespace DB
@@ -12,10 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <IO/ReadBufferFromString.h>
+#include <IO/WriteBufferFromString.h>
 #include <Storages/DeltaMerge/DeltaIndexManager.h>
 #include <Storages/DeltaMerge/DeltaTree.h>
 #include <TestUtils/TiFlashTestBasic.h>
 
+#include <random>
+
 namespace DB
 {
 namespace DM
@@ -93,6 +97,61 @@ try
 }
 CATCH
 
+TEST_F(DeltaIndexManagerTest, RestoreEvictedIndex)
+try
+{
+    auto delta_tree = std::make_shared<DefaultDeltaTree>();
+    std::mt19937_64 rand_gen(42);
+    size_t rows = 1000;
+    UInt64 tuple_id = 0;
+    for (size_t i = 0; i < 3000; ++i)
+    {
+        if (rand_gen() % 3 == 0)
+        {
+            delta_tree->addDelete(rand_gen() % rows);
+            --rows;
+        }
+        else
+        {
+            delta_tree->addInsert(rand_gen() % (rows + 1), tuple_id++);
+            ++rows;
+        }
+    }
+    delta_tree->setMaxDupTupleID(100);
+    auto index = std::make_shared<DeltaIndex>(delta_tree, tuple_id, 0);
+
+    WriteBufferFromOwnString buf;
+    index->serialize(buf);
+
+    // The index is swapped with an empty one when it is evicted.
+    DeltaIndexManager manager(one_node_size);
+    manager.refreshRef(index);
+    manager.refreshRef(genDeltaIndex());
+    ASSERT_EQ(index->getPlacedStatus(), std::make_pair((size_t)0, (size_t)0));
+
+    ReadBufferFromString read_buf(buf.str());
+    auto restored = DeltaIndex::deserialize(read_buf);
+    ASSERT_TRUE(read_buf.eof());
+    ASSERT_EQ(restored->getPlacedStatus(), std::make_pair((size_t)tuple_id, (size_t)0));
+
+    auto restored_tree = restored->getDeltaTree();
+    ASSERT_EQ(restored_tree->numInserts(), delta_tree->numInserts());
+    ASSERT_EQ(restored_tree->numDeletes(), delta_tree->numDeletes());
+    ASSERT_EQ(restored_tree->maxDupTupleID(), 100);
+    auto it = delta_tree->begin();
+    auto restored_it = restored_tree->begin();
+    for (; it != delta_tree->end(); ++it, ++restored_it)
+    {
+        ASSERT_TRUE(restored_it != restored_tree->end());
+        ASSERT_EQ(restored_it.getSid(), it.getSid());
+        ASSERT_EQ(restored_it.isInsert(), it.isInsert());
+        ASSERT_EQ(restored_it.getCount(), it.getCount());
+        ASSERT_EQ(restored_it.getValue(), it.getValue());
+    }
+    ASSERT_TRUE(restored_it == restored_tree->end());
+}
+CATCH
+
 } // namespace tests
 } // namespace DM
 } // namespace DB
@@ -22,6 +22,7 @@
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
 #include <Storages/DeltaMerge/Filter/RSOperator.h>
 #include <Storages/DeltaMerge/PKSquashingBlockInputStream.h>
+#include <Storages/DeltaMerge/PushDownAggregation.h>
 #include <Storages/DeltaMerge/ReadThread/UnorderedInputStream.h>
 #include <Storages/DeltaMerge/RowKeyRange.h>
 #include <Storages/DeltaMerge/tests/DMTestEnv.h>
@@ -567,6 +568,98 @@ try
 }
 CATCH
 
+TEST_F(DeltaMergeStoreTest, ReadWithPushDownAggregation)
+try
+{
+    const ColumnDefine col_a_define(2, "col_a", std::make_shared<DataTypeInt64>());
+    {
+        auto table_column_defines = DMTestEnv::getDefaultColumns();
+        table_column_defines->emplace_back(col_a_define);
+        store = reload(table_column_defines);
+    }
+
+    const size_t num_rows_write = 50000;
+    {
+        Block block = DMTestEnv::prepareSimpleWriteBlock(0, num_rows_write, false);
+        block.insert(DB::tests::createColumn<Int64>(createSignedNumbers(0, num_rows_write), col_a_define.name, col_a_define.id));
+        store->write(*db_context, db_context->getSettingsRef(), block);
+        store->mergeDeltaAll(*db_context);
+    }
+    {
+        // Update a row in the delta, which no longer passes the filter.
+        Block block = DMTestEnv::prepareSimpleWriteBlock(20005, 20006, false, /*tso*/ 3);
+        block.insert(DB::tests::createColumn<Int64>({-100}, col_a_define.name, col_a_define.id));
+        store->write(*db_context, db_context->getSettingsRef(), block);
+    }
+
+    using FuncKind = PushDownAggregation::FuncKind;
+    const PushDownAggregation::Funcs funcs{
+        {FuncKind::CountAll},
+        {FuncKind::Min, col_a_define.id},
+        {FuncKind::Max, col_a_define.id},
+    };
+    auto filter = createGreater(Attr{col_a_define.name, col_a_define.id, col_a_define.type}, Field(static_cast<Int64>(10000)), 0);
+
+    // Read the rows of `col_a > 10000` and return the count/min/max of them, including the result answered by the pack stats.
+    auto read_and_aggregate = [&](bool push_down) {
+        auto aggregation = std::make_shared<PushDownAggregation>(PushDownAggregation::Funcs(funcs));
+        auto streams = store->read(*db_context,
+                                   db_context->getSettingsRef(),
+                                   store->getTableColumns(),
+                                   {RowKeyRange::newAll(store->isCommonHandle(), store->getRowKeyColumnSize())},
+                                   /* num_streams= */ 1,
+                                   /* max_version= */ std::numeric_limits<UInt64>::max(),
+                                   filter,
+                                   TRACING_NAME,
+                                   /* keep_order= */ false,
+                                   /* is_fast_scan= */ false,
+                                   /* expected_block_size= */ 1024,
+                                   /* read_segments */ {},
+                                   /* extra_table_id_index */ InvalidColumnID,
+                                   /* scan_context */ std::make_shared<ScanContext>(),
+                                   /* late_materialization_filter */ nullptr,
+                                   push_down ? aggregation : nullptr);
+
+        // The rough set filter only skips packs, so filter the read rows again like the selection above the table scan.
+        auto result = aggregation->createEmptyResult();
+        for (auto & in : streams)
+        {
+            in->readPrefix();
+            while (Block block = in->read())
+            {
+                const auto & values = block.getByName(col_a_define.name).column;
+                for (size_t i = 0; i < block.rows(); ++i)
+                {
+                    Field value = (*values)[i];
+                    if (value.get<Int64>() <= 10000)
+                        continue;
+                    result.values[0] = static_cast<UInt64>(result.values[0].get<UInt64>() + 1);
+                    if (result.values[1].isNull() || value < result.values[1])
+                        result.values[1] = value;
+                    if (result.values[2].isNull() || result.values[2] < value)
+                        result.values[2] = value;
+                }
+            }
+            in->readSuffix();
+        }
+        auto answered = aggregation->getResult();
+        if (answered)
+            result.merge(funcs, *answered);
+        return std::make_pair(result, answered ? answered->packs : 0);
+    };
+
+    auto [expected, expected_answered_packs] = read_and_aggregate(false);
+    ASSERT_EQ(expected_answered_packs, 0);
+    ASSERT_EQ(expected.values[0].get<UInt64>(), num_rows_write - 10001 - 1);
+    ASSERT_EQ(expected.values[1].get<Int64>(), 10001);
+    ASSERT_EQ(expected.values[2].get<Int64>(), num_rows_write - 1);
+
+    auto [result, answered_packs] = read_and_aggregate(true);
+    ASSERT_GT(answered_packs, 0);
+    ASSERT_EQ(result.values, expected.values);
+}
+CATCH
+
 
 TEST_P(DeltaMergeStoreRWTest, WriteCrashBeforeWalWithoutCache)
 try
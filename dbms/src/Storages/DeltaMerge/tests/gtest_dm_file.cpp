@@ -14,6 +14,8 @@
 
 #include <Common/FailPoint.h>
 #include <Core/ColumnWithTypeAndName.h>
+#include <Functions/FunctionFactory.h>
+#include <Functions/registerFunctions.h>
 #include <Interpreters/Context.h>
 #include <Storages/DeltaMerge/DMContext.h>
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
@@ -29,6 +31,7 @@
 #include <common/types.h>
 
 #include <algorithm>
+#include <set>
 #include <vector>
 
 namespace DB
@@ -97,7 +100,17 @@ public:
         : dm_file(nullptr)
     {}
 
-    static void SetUpTestCase() {}
+    static void SetUpTestCase()
+    {
+        try
+        {
+            registerFunctions();
+        }
+        catch (DB::Exception &)
+        {
+            // Maybe another test has already registed, ignore exception here.
+        }
+    }
 
     void SetUp() override
     {
@@ -582,6 +595,86 @@ try
 }
 CATCH
 
+TEST_P(DMFileTest, ReadFilteredByEqualIndex)
+try
+{
+    auto cols = DMTestEnv::getDefaultColumns();
+    // Prepare columns
+    ColumnDefine i64_cd(2, "i64", typeFromString("Int64"));
+    cols->push_back(i64_cd);
+
+    reload(cols);
+
+    const Int64 num_rows_write = 1024;
+    const Int64 nparts = 5;
+    const Int64 span_per_part = num_rows_write / nparts;
+    const Int64 distinct_per_part = 16;
+
+    {
+        // Prepare some packs in DMFile. The values of every pack are `{0, 1, ..., 15} * nparts + pack_id`,
+        // so the min/max of all packs are overlapped and only the equal index can skip packs.
+        dbContext().getSettingsRef().dt_enable_equal_index = true;
+        auto stream = std::make_shared<DMFileBlockOutputStream>(dbContext(), dm_file, *cols);
+
+        DMFileBlockOutputStream::BlockProperty block_property;
+        stream->writePrefix();
+        size_t pk_beg = 0;
+        for (size_t i = 0; i < nparts; ++i)
+        {
+            size_t pk_end = (i == nparts - 1) ? num_rows_write : (pk_beg + num_rows_write / nparts);
+            Block block = DMTestEnv::prepareSimpleWriteBlock(pk_beg, pk_end, false);
+            std::vector<Int64> values;
+            for (size_t pk = pk_beg; pk < pk_end; ++pk)
+                values.push_back(static_cast<Int64>(pk % distinct_per_part) * nparts + i);
+            block.insert(DB::tests::createColumn<Int64>(values, i64_cd.name, i64_cd.id));
+            stream->write(block, block_property);
+            pk_beg += num_rows_write / nparts;
+        }
+        stream->writeSuffix();
+    }
+
+    ASSERT_TRUE(dm_file->isColEqualIndexExist(i64_cd.id));
+    ASSERT_FALSE(dm_file->isColEqualIndexExist(EXTRA_HANDLE_COLUMN_ID));
+
+    Attr attr = {i64_cd.name, i64_cd.id, i64_cd.type};
+    auto test_read_filter = [&](const RSOperatorPtr & filter, const std::vector<Int64> & expect_packs) {
+        DMFileBlockInputStreamBuilder builder(dbContext());
+        auto stream = builder
+                          .setColumnCache(column_cache)
+                          .setRSOperator(filter)
+                          .build(dm_file, *cols, RowKeyRanges{RowKeyRange::newAll(false, 1)}, std::make_shared<ScanContext>());
+
+        std::vector<Int64> expect_pks;
+        for (auto pack_id : expect_packs)
+        {
+            auto pk_end = (pack_id == nparts - 1) ? num_rows_write : (pack_id + 1) * span_per_part;
+            for (Int64 pk = pack_id * span_per_part; pk < pk_end; ++pk)
+                expect_pks.push_back(pk);
+        }
+        ASSERT_INPUTSTREAM_COLS_UR(
+            stream,
+            Strings({DMTestEnv::pk_name}),
+            createColumns({
+                createColumn<Int64>(expect_pks),
+            }))
+            << filter->toDebugString();
+    };
+
+    auto run_tests = [&]() {
+        test_read_filter(createEqual(attr, Field(static_cast<Int64>(7 * nparts + 2))), {2});
+        // Not exist in any pack, but in the range of min/max
+        test_read_filter(createEqual(attr, Field(static_cast<Int64>(distinct_per_part * nparts))), {});
+        test_read_filter(createIn(attr, {Field(static_cast<Int64>(1)), Field(static_cast<Int64>(3 * nparts + 4))}), {1, 4});
+        test_read_filter(createNotEqual(attr, Field(static_cast<Int64>(7 * nparts + 2))), {0, 1, 2, 3, 4});
+    };
+    run_tests();
+
+    // Restore file from disk and read again
+    dm_file = restoreDMFile();
+    run_tests();
+}
+CATCH
+
 // Test rough filter with some unsupported operations
 TEST_P(DMFileTest, ReadFilteredByRoughSetFilterWithUnsupportedOperation)
 try
@@ -748,6 +841,165 @@ try
 }
 CATCH
 
+TEST_P(DMFileTest, ReadWithPackCache)
+try
+{
+    auto cols = DMTestEnv::getDefaultColumns();
+
+    const Int64 num_rows_write = 1024;
+    const Int64 nparts = 4;
+    const Int64 span_per_part = num_rows_write / nparts;
+
+    {
+        // Prepare some packs in DMFile
+        auto stream = std::make_shared<DMFileBlockOutputStream>(dbContext(), dm_file, *cols);
+
+        DMFileBlockOutputStream::BlockProperty block_property;
+        stream->writePrefix();
+        for (Int64 i = 0; i < nparts; ++i)
+        {
+            Block block = DMTestEnv::prepareSimpleWriteBlock(i * span_per_part, (i + 1) * span_per_part, false);
+            stream->write(block, block_property);
+        }
+        stream->writeSuffix();
+    }
+
+    auto pack_cache = std::make_shared<DMFilePackCache>(64 * 1024 * 1024);
+    // The pack ranges (start pack id, pack count) that have been read into cache
+    std::set<std::pair<size_t, size_t>> cached_ranges;
+    auto test_read = [&](const IdSet & read_packs) {
+        // Continuous packs are read as one range, except in single file mode.
+        size_t expect_hits = 0, expect_misses = 0;
+        for (auto it = read_packs.begin(); it != read_packs.end();)
+        {
+            size_t start = *it, count = 1;
+            for (++it; !dm_file->isSingleFileMode() && it != read_packs.end() && *it == start + count; ++it)
+                ++count;
+            if (cached_ranges.emplace(start, count).second)
+                expect_misses += cols->size();
+            else
+                expect_hits += cols->size();
+        }
+
+        size_t hits_before = 0, misses_before = 0;
+        pack_cache->getStats(hits_before, misses_before);
+
+        DMFileBlockInputStreamBuilder builder(dbContext());
+        auto stream = builder
+                          .setPackCache(pack_cache)
+                          .setReadPacks(std::make_shared<IdSet>(read_packs))
+                          .build(dm_file, *cols, RowKeyRanges{RowKeyRange::newAll(false, 1)}, std::make_shared<ScanContext>());
+
+        std::vector<Int64> expect_pks;
+        for (auto pack_id : read_packs)
+        {
+            for (Int64 pk = pack_id * span_per_part; pk < (pack_id + 1) * span_per_part; ++pk)
+                expect_pks.push_back(pk);
+        }
+        ASSERT_INPUTSTREAM_COLS_UR(
+            stream,
+            Strings({DMTestEnv::pk_name}),
+            createColumns({
+                createColumn<Int64>(expect_pks),
+            }));
+
+        size_t hits = 0, misses = 0;
+        pack_cache->getStats(hits, misses);
+        ASSERT_EQ(hits - hits_before, expect_hits);
+        ASSERT_EQ(misses - misses_before, expect_misses);
+    };
+
+    // The first time from disk, then from memory.
+    test_read({0, 1, 2, 3});
+    test_read({0, 1, 2, 3});
+    // A different pack range is another entry.
+    test_read({0});
+    // Pack 0 is served from memory, the streams must seek to pack 2 before reading from disk.
+    test_read({0, 2});
+    test_read({0, 2});
+    test_read({1, 2, 3});
+
+    // The cached data of a DMFile can be used by the readers of the restored DMFile.
+    dm_file = restoreDMFile();
+    test_read({0, 1, 2, 3});
+}
+CATCH
+
+TEST_P(DMFileTest, ReadWithLateMaterialization)
+try
+{
+    auto cols = DMTestEnv::getDefaultColumns();
+    // Prepare columns
+    ColumnDefine i64_cd(2, "i64", typeFromString("Int64"));
+    cols->push_back(i64_cd);
+
+    reload(cols);
+
+    const Int64 num_rows_write = 1024;
+    const Int64 nparts = 5;
+    const Int64 span_per_part = num_rows_write / nparts;
+
+    {
+        // Prepare some packs in DMFile
+        auto stream = std::make_shared<DMFileBlockOutputStream>(dbContext(), dm_file, *cols);
+
+        DMFileBlockOutputStream::BlockProperty block_property;
+        stream->writePrefix();
+        size_t pk_beg = 0;
+        for (size_t i = 0; i < nparts; ++i)
+        {
+            size_t pk_end = (i == nparts - 1) ? num_rows_write : (pk_beg + num_rows_write / nparts);
+            Block block = DMTestEnv::prepareSimpleWriteBlock(pk_beg, pk_end, false);
+            block.insert(DB::tests::createColumn<Int64>(
+                createNumbers<Int64>(pk_beg, pk_end),
+                i64_cd.name,
+                i64_cd.id));
+            stream->write(block, block_property);
+            pk_beg += num_rows_write / nparts;
+        }
+        stream->writeSuffix();
+    }
+
+    // i64 >= threshold
+    auto create_filter = [&](Int64 threshold) {
+        auto before_where = std::make_shared<ExpressionActions>(NamesAndTypesList{{i64_cd.name, i64_cd.type}}, dbContext().getSettingsRef());
+        auto threshold_type = typeFromString("Int64");
+        before_where->add(ExpressionAction::addColumn({threshold_type->createColumnConst(1, Field(threshold)), threshold_type, "threshold"}));
+        before_where->add(ExpressionAction::applyFunction(
+            FunctionFactory::instance().get("greaterOrEquals", dbContext()),
+            {i64_cd.name, "threshold"},
+            "filter"));
+        return std::make_shared<LateMaterializationFilter>(before_where, "filter");
+    };
+
+    auto test_read_filter = [&](Int64 threshold) {
+        DMFileBlockInputStreamBuilder builder(dbContext());
+        auto stream = builder
+                          .enableCleanRead(false, /*is_fast_scan*/ true, false, std::numeric_limits<UInt64>::max())
+                          .setLateMaterializationFilter(create_filter(threshold))
+                          .setRowsThreshold(span_per_part) // read one pack every time
+                          .build(dm_file, *cols, RowKeyRanges{RowKeyRange::newAll(false, 1)}, std::make_shared<ScanContext>());
+
+        Int64 expect_first = std::clamp<Int64>(threshold, 0, num_rows_write);
+        ASSERT_INPUTSTREAM_COLS_UR(
+            stream,
+            Strings({DMTestEnv::pk_name, i64_cd.name}),
+            createColumns({
+                createColumn<Int64>(createNumbers<Int64>(expect_first, num_rows_write)),
+                createColumn<Int64>(createNumbers<Int64>(expect_first, num_rows_write)),
+            }))
+            << fmt::format("threshold: {}", threshold);
+    };
+
+    // The first packs are filtered out, and a part of the rows in the pack in the middle are filtered out.
+    for (Int64 threshold : {0L, span_per_part, 800L, num_rows_write - 1, num_rows_write})
+    {
+        SCOPED_TRACE(fmt::format("Test reading with late materialization, threshold: {}", threshold));
+        test_read_filter(threshold);
+    }
+}
+CATCH
+
 /// Test reading different column types
 
 TEST_P(DMFileTest, NumberTypes)
@@ -19,6 +19,7 @@
 #include <Storages/DeltaMerge/DMContext.h>
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
 #include <Storages/DeltaMerge/Filter/RSOperator.h>
+#include <Storages/DeltaMerge/Filter/RuntimeFilter.h>
 #include <Storages/DeltaMerge/Index/RoughCheck.h>
 #include <Storages/DeltaMerge/Index/ValueComparison.h>
 #include <Storages/DeltaMerge/Segment.h>
@@ -1380,6 +1381,43 @@ try
 CATCH
 
 
+TEST_F(DMMinMaxIndexTest, RuntimeFilter)
+try
+{
+    const auto * case_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+
+    auto gen_filter = [](const std::vector<Int64> & build_keys, size_t max_in_values, bool finish) -> RSOperatorPtr {
+        auto runtime_filter = std::make_shared<RuntimeFilter>(DEFAULT_COL_ID, "build_key", max_in_values);
+        auto type = DataTypeFactory::instance().get("Nullable(Int64)");
+        auto column = type->createColumn();
+        for (auto key : build_keys)
+            column->insert(Field(key));
+        // null key never matches
+        column->insertDefault();
+        runtime_filter->insertBuildKeys({std::move(column), type, "build_key"});
+        if (finish)
+            runtime_filter->finish();
+        auto filter_list = std::make_shared<RuntimeFilterList>();
+        filter_list->add(runtime_filter);
+        return createRuntimeFilterOperator(filter_list, [](ColumnID) { return attr("Int64"); });
+    };
+
+    // The pack contains [100, 200]
+    CSVTuples tuples = {{"0", "0", "0", "100"}, {"1", "1", "0", "200"}};
+    // check with the distinct build keys
+    ASSERT_EQ(true, checkMatch(case_name, *context, "Int64", tuples, gen_filter({1, 150, 300}, 1024, true)));
+    ASSERT_EQ(false, checkMatch(case_name, *context, "Int64", tuples, gen_filter({1, 50, 300}, 1024, true)));
+    // check with the min/max of build keys
+    ASSERT_EQ(true, checkMatch(case_name, *context, "Int64", tuples, gen_filter({1, 50, 300}, 1, true)));
+    ASSERT_EQ(false, checkMatch(case_name, *context, "Int64", tuples, gen_filter({1, 50}, 1, true)));
+    ASSERT_EQ(false, checkMatch(case_name, *context, "Int64", tuples, gen_filter({300, 400}, 1, true)));
+    // the build side only contains null keys
+    ASSERT_EQ(false, checkMatch(case_name, *context, "Int64", tuples, gen_filter({}, 1024, true)));
+    // the build side is not finished
+    ASSERT_EQ(true, checkMatch(case_name, *context, "Int64", tuples, gen_filter({}, 1024, false)));
+}
+CATCH
+
 TEST_F(DMMinMaxIndexTest, checkPKMatch)
 try
 {
@@ -14,13 +14,18 @@
 
 #include <Common/CurrentMetrics.h>
 #include <Common/SyncPoint/SyncPoint.h>
+#include <DataStreams/BlocksListBlockInputStream.h>
 #include <DataStreams/OneBlockInputStream.h>
+#include <DataTypes/DataTypeNullable.h>
 #include <Storages/DeltaMerge/DMContext.h>
+#include <Storages/DeltaMerge/DMVersionFilterBlockInputStream.h>
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
 #include <Storages/DeltaMerge/File/DMFileBlockOutputStream.h>
+#include <Storages/DeltaMerge/Filter/RSOperator.h>
 #include <Storages/DeltaMerge/Range.h>
 #include <Storages/DeltaMerge/RowKeyRange.h>
 #include <Storages/DeltaMerge/Segment.h>
+#include <Storages/DeltaMerge/SegmentReadTaskPool.h>
 #include <Storages/DeltaMerge/StoragePool.h>
 #include <Storages/DeltaMerge/WriteBatches.h>
 #include <Storages/DeltaMerge/tests/DMTestEnv.h>
@@ -1748,6 +1753,372 @@ try
 }
 CATCH
 
+TEST_F(SegmentTest, AggregateByPackStats)
+try
+{
+    Settings settings = dmContext().db_context.getSettings();
+    settings.dt_segment_stable_pack_rows = 10;
+
+    segment = reload(DMTestEnv::getDefaultColumns(), std::move(settings));
+
+    const size_t num_rows_write = 100;
+    const size_t tso = 10000;
+    {
+        Block block = DMTestEnv::prepareSimpleWriteBlock(0, num_rows_write, false, tso);
+        segment->write(dmContext(), block);
+        segment = segment->mergeDelta(dmContext(), tableColumns());
+        ASSERT_EQ(segment->getStable()->getDMFiles()[0]->getPacks(), num_rows_write / 10);
+    }
+
+    PushDownAggregation aggregation({
+        {PushDownAggregation::FuncKind::CountAll},
+        {PushDownAggregation::FuncKind::Min, EXTRA_HANDLE_COLUMN_ID},
+        {PushDownAggregation::FuncKind::Max, EXTRA_HANDLE_COLUMN_ID},
+    });
+    auto make_range = [](Int64 start, Int64 end) {
+        return RowKeyRange::fromHandleRange(HandleRange(start, end));
+    };
+    const RowKeyRanges read_ranges{make_range(5, 95)};
+    auto aggregate = [&](UInt64 max_version, PushDownAggregation::Result & result) {
+        auto snap = segment->createSnapshot(dmContext(), false, CurrentMetrics::DT_SnapshotOfRead);
+        return segment->aggregateByPackStats(dmContext(), *tableColumns(), snap, read_ranges, EMPTY_FILTER, max_version, aggregation, result);
+    };
+
+    {
+        // Only the packs fully covered by the read ranges are answered.
+        auto result = aggregation.createEmptyResult();
+        auto rest_ranges = aggregate(std::numeric_limits<UInt64>::max(), result);
+        ASSERT_EQ(result.packs, 8);
+        ASSERT_EQ(result.rows, 80);
+        ASSERT_EQ(result.values[0].get<UInt64>(), 80);
+        ASSERT_EQ(result.values[1].get<Int64>(), 10);
+        ASSERT_EQ(result.values[2].get<Int64>(), 89);
+        ASSERT_EQ(rest_ranges, RowKeyRanges({make_range(5, 10), make_range(90, 95)}));
+    }
+    {
+        // The rows are invisible to the read.
+        auto result = aggregation.createEmptyResult();
+        auto rest_ranges = aggregate(tso - 1, result);
+        ASSERT_EQ(result.packs, 0);
+        ASSERT_EQ(rest_ranges, read_ranges);
+    }
+
+    {
+        // The packs overlapped with the delta rows should be read.
+        Block block = DMTestEnv::prepareSimpleWriteBlock(33, 36, false, tso + 1);
+        segment->write(dmContext(), block);
+
+        auto result = aggregation.createEmptyResult();
+        auto rest_ranges = aggregate(std::numeric_limits<UInt64>::max(), result);
+        ASSERT_EQ(result.packs, 7);
+        ASSERT_EQ(result.rows, 70);
+        ASSERT_EQ(result.values[1].get<Int64>(), 10);
+        ASSERT_EQ(result.values[2].get<Int64>(), 89);
+        ASSERT_EQ(rest_ranges, RowKeyRanges({make_range(5, 10), make_range(30, 40), make_range(90, 95)}));
+    }
+    {
+        // Don't answer any pack if there are delete ranges.
+        segment->write(dmContext(), make_range(60, 61));
+
+        auto result = aggregation.createEmptyResult();
+        auto rest_ranges = aggregate(std::numeric_limits<UInt64>::max(), result);
+        ASSERT_EQ(result.packs, 0);
+        ASSERT_EQ(rest_ranges, read_ranges);
+    }
+}
+CATCH
+
+TEST_F(SegmentTest, AggregateByPackStatsGuards)
+try
+{
+    const ColumnDefine col_a_define(2, "col_a", makeNullable(std::make_shared<DataTypeInt64>()));
+    {
+        auto columns = DMTestEnv::getDefaultColumns();
+        columns->emplace_back(col_a_define);
+        segment = reload(columns);
+    }
+
+    const UInt64 tso = 10000;
+    // Write each [begin, end) of handles as a pack of a new DMFile, the value of col_a is the handle except `null_handle`.
+    // The packs written from a mvcc stream are clean if there are no old versions or deleted rows, otherwise they are
+    // always marked as not clean.
+    auto write_file = [&](const std::vector<std::pair<Int64, Int64>> & packs, bool from_mvcc_stream, std::optional<Int64> null_handle = std::nullopt) {
+        BlocksList blocks;
+        for (const auto & [begin, end] : packs)
+        {
+            Block block = DMTestEnv::prepareSimpleWriteBlock(begin, end, false, tso);
+            DB::tests::InferredDataVector<DB::tests::Nullable<Int64>> values;
+            for (Int64 handle = begin; handle < end; ++handle)
+            {
+                if (null_handle == handle)
+                    values.push_back(std::nullopt);
+                else
+                    values.push_back(handle);
+            }
+            block.insert(DB::tests::createColumn<DB::tests::Nullable<Int64>>(values, col_a_define.name, col_a_define.id));
+            blocks.push_back(std::move(block));
+        }
+        BlockInputStreamPtr stream = std::make_shared<BlocksListBlockInputStream>(std::move(blocks));
+        if (from_mvcc_stream)
+            stream = std::make_shared<DMVersionFilterBlockInputStream<DM_VERSION_FILTER_MODE_COMPACT>>(stream, *tableColumns(), 0, false);
+
+        auto delegator = dmContext().path_pool.getStableDiskDelegator();
+        auto file_id = dmContext().storage_pool.newDataPageIdForDTFile(delegator, __PRETTY_FUNCTION__);
+        auto store_path = delegator.choosePath();
+        auto file = writeIntoNewDMFile(dmContext(), tableColumns(), stream, file_id, store_path, DMFileBlockOutputStream::Flags{});
+        delegator.addDTFile(file_id, file->getBytesOnDisk(), store_path);
+        EXPECT_EQ(file->getPacks(), packs.size());
+        return file;
+    };
+    auto aggregate = [&](const DMFiles & files, const RSOperatorPtr & filter, const PushDownAggregation & aggregation, PushDownAggregation::Result & result) {
+        auto stable = std::make_shared<StableValueSpace>(0);
+        stable->setFiles(files, RowKeyRange::newAll(false, 1), &dmContext());
+        return stable->createSnapshot()->aggregateByPackStats(
+            dmContext(),
+            *tableColumns(),
+            {RowKeyRange::newAll(false, 1)},
+            filter,
+            std::numeric_limits<UInt64>::max(),
+            RowKeyRange::newNone(false, 1),
+            aggregation,
+            result);
+    };
+    auto make_range = [](Int64 start, Int64 end) {
+        return RowKeyRange::fromHandleRange(HandleRange(start, end));
+    };
+
+    PushDownAggregation count_all({{PushDownAggregation::FuncKind::CountAll}});
+    PushDownAggregation count_a({
+        {PushDownAggregation::FuncKind::CountAll},
+        {PushDownAggregation::FuncKind::Count, col_a_define.id},
+    });
+
+    const auto file_with_null = write_file({{0, 10}, {10, 20}, {20, 30}, {30, 40}}, true, 25);
+    {
+        // Only the packs whose rows all pass the filter are answered. The rough check of `col_a >= 15` returns All for
+        // the pack [20, 30) even if there is a null, which does not pass the filter.
+        auto filter = createGreaterEqual(Attr{col_a_define.name, col_a_define.id, col_a_define.type}, Field(static_cast<Int64>(15)), 0);
+        auto result = count_all.createEmptyResult();
+        auto answered_ranges = aggregate({file_with_null}, filter, count_all, result);
+        ASSERT_EQ(result.packs, 1);
+        ASSERT_EQ(result.rows, 10);
+        ASSERT_EQ(result.values[0].get<UInt64>(), 10);
+        ASSERT_EQ(answered_ranges, RowKeyRanges({make_range(30, 40)}));
+    }
+    {
+        // The count of a nullable column can not be answered by the pack with both nulls and values.
+        auto result = count_a.createEmptyResult();
+        auto answered_ranges = aggregate({file_with_null}, EMPTY_FILTER, count_a, result);
+        ASSERT_EQ(result.packs, 3);
+        ASSERT_EQ(result.rows, 30);
+        ASSERT_EQ(result.values[0].get<UInt64>(), 30);
+        ASSERT_EQ(result.values[1].get<UInt64>(), 30);
+        ASSERT_EQ(answered_ranges, RowKeyRanges({make_range(0, 10), make_range(10, 20), make_range(30, 40)}));
+    }
+    {
+        // The packs that are not clean may contain old versions or deleted rows.
+        const auto not_clean_file = write_file({{0, 10}, {10, 20}}, false);
+        ASSERT_GT(not_clean_file->getPackStats()[0].not_clean, 0);
+        auto result = count_all.createEmptyResult();
+        auto answered_ranges = aggregate({not_clean_file}, EMPTY_FILTER, count_all, result);
+        ASSERT_EQ(result.packs, 0);
+        ASSERT_TRUE(answered_ranges.empty());
+    }
+    {
+        // The handle 19 is in the neighbour packs across the DMFiles, so neither of the packs is answered.
+        const auto left_file = write_file({{0, 10}, {10, 20}}, true);
+        const auto right_file = write_file({{19, 30}, {30, 40}}, true);
+        ASSERT_EQ(left_file->getPackStats()[1].not_clean, 0);
+        ASSERT_EQ(right_file->getPackStats()[0].not_clean, 0);
+        auto result = count_all.createEmptyResult();
+        auto answered_ranges = aggregate({left_file, right_file}, EMPTY_FILTER, count_all, result);
+        ASSERT_EQ(result.packs, 2);
+        ASSERT_EQ(result.rows, 20);
+        ASSERT_EQ(answered_ranges, RowKeyRanges({make_range(0, 10), make_range(30, 40)}));
+    }
+}
+CATCH
+
+TEST_F(SegmentTest, SplitReadTasksByPacks)
+try
+{
+    Settings settings = dmContext().db_context.getSettings();
+    settings.dt_segment_stable_pack_rows = 10;
+
+    segment = reload(DMTestEnv::getDefaultColumns(), std::move(settings));
+
+    const size_t num_rows_write = 100;
+    {
+        Block block = DMTestEnv::prepareSimpleWriteBlock(0, num_rows_write, false);
+        segment->write(dmContext(), block);
+        segment = segment->mergeDelta(dmContext(), tableColumns());
+        ASSERT_EQ(segment->getStable()->getDMFiles()[0]->getPacks(), num_rows_write / 10);
+    }
+    {
+        // Newer versions of some rows in the delta.
+        Block block = DMTestEnv::prepareSimpleWriteBlock(33, 36, false, /*tso*/ 5);
+        segment->write(dmContext(), block);
+    }
+
+    auto make_range = [](Int64 start, Int64 end) {
+        return RowKeyRange::fromHandleRange(HandleRange(start, end));
+    };
+    auto snap = segment->createSnapshot(dmContext(), false, CurrentMetrics::DT_SnapshotOfRead);
+    SegmentReadTasks tasks{std::make_shared<SegmentReadTask>(segment, snap, RowKeyRanges{make_range(5, 95)})};
+
+    {
+        // Too few packs to split.
+        auto split_tasks = SegmentReadTask::trySplitReadTasksByPacks(dmContext(), tasks, EMPTY_FILTER, 4, 20);
+        ASSERT_EQ(split_tasks.size(), 1);
+    }
+
+    auto split_tasks = SegmentReadTask::trySplitReadTasksByPacks(dmContext(), tasks, EMPTY_FILTER, 4, 2);
+    ASSERT_EQ(split_tasks.size(), 4);
+    std::vector<RowKeyRanges> expected_ranges{
+        {make_range(5, 20)},
+        {make_range(20, 50)},
+        {make_range(50, 70)},
+        {make_range(70, 95)},
+    };
+    size_t i = 0;
+    size_t rows = 0;
+    for (const auto & task : split_tasks)
+    {
+        ASSERT_EQ(task->segment, segment);
+        ASSERT_EQ(task->ranges, expected_ranges[i++]);
+        auto in = segment->getInputStreamModeNormal(dmContext(), *tableColumns(), task->read_snapshot, task->ranges, EMPTY_FILTER, std::numeric_limits<UInt64>::max(), DEFAULT_BLOCK_SIZE);
+        in->readPrefix();
+        while (Block block = in->read())
+            rows += block.rows();
+        in->readSuffix();
+    }
+    // Every row is read once by the sub-tasks.
+    ASSERT_EQ(rows, 90);
+}
+CATCH
+
+TEST_F(SegmentTest, ReadWithBitmapFilter)
+try
+{
+    const ColumnDefine column_i64(4, "i64", typeFromString("Int64"));
+    auto columns = DMTestEnv::getDefaultColumns();
+    columns->emplace_back(column_i64);
+    Settings settings = dmContext().db_context.getSettings();
+    settings.dt_segment_stable_pack_rows = 10;
+    segment = reload(columns, std::move(settings));
+
+    // The value of i64 is pk + value_offset.
+    auto write_rows = [&](Int64 beg, Int64 end, UInt64 tso, Int64 value_offset) {
+        Block block = DMTestEnv::prepareSimpleWriteBlock(beg, end, false, tso);
+        std::vector<Int64> values;
+        for (Int64 pk = beg; pk < end; ++pk)
+            values.push_back(pk + value_offset);
+        block.insert(DB::tests::createColumn<Int64>(values, column_i64.name, column_i64.id));
+        segment->write(dmContext(), std::move(block));
+    };
+    write_rows(0, 100, 2, 0);
+    segment = segment->mergeDelta(dmContext(), tableColumns());
+    write_rows(33, 36, 5, 1000);
+    segment->write(dmContext(), RowKeyRange::fromHandleRange(HandleRange(60, 70)));
+    write_rows(95, 110, 6, 2000);
+
+    const RowKeyRanges read_ranges{RowKeyRange::fromHandleRange(HandleRange(5, 105))};
+    std::vector<Int64> expected_pks;
+    std::vector<Int64> expected_values;
+    for (Int64 pk = 5; pk < 105; ++pk)
+    {
+        if (pk >= 60 && pk < 70)
+            continue;
+        expected_pks.push_back(pk);
+        if (pk >= 95)
+            expected_values.push_back(pk + 2000);
+        else if (pk >= 33 && pk < 36)
+            expected_values.push_back(pk + 1000);
+        else
+            expected_values.push_back(pk);
+    }
+
+    const ColumnDefines columns_to_read{getExtraHandleColumnDefine(false), column_i64};
+    auto snap = segment->createSnapshot(dmContext(), false, CurrentMetrics::DT_SnapshotOfRead);
+    {
+        auto bitmap_filter = segment->buildBitmapFilter(dmContext(), snap, read_ranges, EMPTY_FILTER, std::numeric_limits<UInt64>::max(), DEFAULT_BLOCK_SIZE);
+        ASSERT_EQ(bitmap_filter->size(), 100 + 3 + 15);
+        ASSERT_EQ(bitmap_filter->count(), expected_pks.size());
+    }
+    for (auto read_mode : {ReadMode::Normal, ReadMode::Bitmap})
+    {
+        auto in = segment->getInputStream(read_mode, dmContext(), columns_to_read, snap, read_ranges, EMPTY_FILTER, std::numeric_limits<UInt64>::max(), DEFAULT_BLOCK_SIZE);
+        ASSERT_INPUTSTREAM_COLS_UR(
+            in,
+            Strings({DMTestEnv::pk_name, column_i64.name}),
+            createColumns({createColumn<Int64>(expected_pks), createColumn<Int64>(expected_values)}));
+    }
+}
+CATCH
+
+TEST_F(SegmentTest, PersistAndRestoreDeltaIndex)
+try
+{
+    Settings settings = dmContext().db_context.getSettings();
+    settings.dt_enable_persisted_delta_index = true;
+    segment = reload({}, std::move(settings));
+
+    auto get_rows = [&](const SegmentPtr & seg) {
+        auto in = seg->getInputStreamModeNormal(dmContext(), *tableColumns(), {RowKeyRange::newAll(false, 1)});
+        return getInputStreamNRows(in);
+    };
+
+    {
+        Block block = DMTestEnv::prepareSimpleWriteBlock(0, 100, false);
+        segment->write(dmContext(), std::move(block));
+        segment = segment->mergeDelta(dmContext(), tableColumns());
+    }
+    {
+        // Update [50, 100), insert [100, 150) and delete [10, 20) in the delta.
+        Block block = DMTestEnv::prepareSimpleWriteBlock(50, 150, false, /*tso*/ 3);
+        segment->write(dmContext(), std::move(block), /*flush_cache*/ true);
+        segment->write(dmContext(), {RowKeyRange::fromHandleRange(HandleRange(10, 20))});
+        segment->flushCache(dmContext());
+    }
+
+    // The delta index is persisted after it is placed.
+    segment->placeDeltaIndex(dmContext());
+    auto delta_index_page_id = segment->getDelta()->getPersistedFileSet()->getDeltaIndexPageId();
+    ASSERT_NE(delta_index_page_id, 0);
+    ASSERT_EQ(get_rows(segment), 140);
+
+    // The restored segment loads the delta index from disk instead of placing the delta again.
+    auto new_segment = Segment::restoreSegment(Logger::get(), dmContext(), segment->segmentId());
+    auto new_delta = new_segment->getDelta();
+    ASSERT_EQ(new_delta->getPersistedFileSet()->getDeltaIndexPageId(), delta_index_page_id);
+    ASSERT_EQ(new_delta->getPlacedDeltaRows(), 0);
+    ASSERT_TRUE(new_delta->tryRestoreDeltaIndex(dmContext(), new_segment->getStable()->getDMFilesRows()));
+    ASSERT_EQ(new_delta->getPlacedDeltaRows(), 100);
+    ASSERT_EQ(new_delta->getPlacedDeltaDeletes(), 1);
+    ASSERT_EQ(get_rows(new_segment), 140);
+
+    // The restored delta index is the same as the persisted one, so it is not written again.
+    ASSERT_FALSE(new_delta->persistDeltaIndex(dmContext(), new_segment->getStable()->getDMFilesRows()));
+
+    {
+        // The first newly placed index of the restored segment is persisted,
+        // but the next one is skipped before `dt_persisted_delta_index_min_interval_seconds` passes.
+        new_segment->write(dmContext(), DMTestEnv::prepareSimpleWriteBlock(150, 160, false, /*tso*/ 4), /*flush_cache*/ true);
+        ASSERT_EQ(get_rows(new_segment), 150);
+        ASSERT_TRUE(new_delta->persistDeltaIndex(dmContext(), new_segment->getStable()->getDMFilesRows()));
+        new_segment->write(dmContext(), DMTestEnv::prepareSimpleWriteBlock(160, 170, false, /*tso*/ 5), /*flush_cache*/ true);
+        ASSERT_EQ(get_rows(new_segment), 160);
+        ASSERT_FALSE(new_delta->persistDeltaIndex(dmContext(), new_segment->getStable()->getDMFilesRows()));
+        ASSERT_EQ(new_delta->getPersistedFileSet()->getDeltaIndexPageId(), delta_index_page_id);
+    }
+
+    // The persisted delta index is dropped along with the delta after merging delta.
+    new_segment = new_segment->mergeDelta(dmContext(), tableColumns());
+    ASSERT_EQ(new_segment->getDelta()->getPersistedFileSet()->getDeltaIndexPageId(), 0);
+    ASSERT_EQ(get_rows(new_segment), 160);
+}
+CATCH
+
 INSTANTIATE_TEST_CASE_P(SegmentWriteType,
                         SegmentDDLTest,
                         ::testing::Combine( //
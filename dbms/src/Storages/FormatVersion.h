@@ -57,6 +57,13 @@ inline static constexpr Version V2 = 2; // Support clustered index
 inline static constexpr Version V3 = 3; // Support DeltaPackFile
 } // namespace DeltaFormat
 
+namespace DeltaIndexFormat
+{
+using Version = UInt64;
+
+inline static constexpr Version V1 = 1;
+} // namespace DeltaIndexFormat
+
 namespace PageFormat
 {
 using Version = UInt32;
@@ -25,6 +25,7 @@ const String MutableSupport::tidb_pk_column_name = "_tidb_rowid";
 const String MutableSupport::version_column_name = "_INTERNAL_VERSION";
 const String MutableSupport::delmark_column_name = "_INTERNAL_DELMARK";
 const String MutableSupport::extra_table_id_column_name = "_tidb_tid";
+const String MutableSupport::segment_row_id_column_name = "_INTERNAL_SEGMENT_ROW_ID";
 
 const DataTypePtr MutableSupport::tidb_pk_column_int_type = DataTypeFactory::instance().get("Int64");
 const DataTypePtr MutableSupport::tidb_pk_column_string_type = DataTypeFactory::instance().get("String");
@@ -32,6 +33,7 @@ const DataTypePtr MutableSupport::version_column_type = DataTypeFactory::instanc
 const DataTypePtr MutableSupport::delmark_column_type = DataTypeFactory::instance().get("UInt8");
 /// it should not be nullable, but TiDB does not set not null flag for extra_table_id_column_type, so has to align with TiDB
 const DataTypePtr MutableSupport::extra_table_id_column_type = DataTypeFactory::instance().get("Nullable(Int64)");
+const DataTypePtr MutableSupport::segment_row_id_column_type = DataTypeFactory::instance().get("UInt32");
 ;
 
 } // namespace DB
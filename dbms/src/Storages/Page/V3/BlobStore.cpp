@@ -40,6 +40,7 @@
 #include <iterator>
 #include <magic_enum.hpp>
 #include <mutex>
+#include <tuple>
 #include <unordered_map>
 
 namespace ProfileEvents
@@ -67,6 +68,10 @@ extern const char exception_after_large_write_exceed[];
 namespace PS::V3
 {
 static constexpr bool BLOBSTORE_CHECKSUM_ON_READ = true;
+// The max size of the hole between two ranges that can be merged into one read
+static constexpr size_t BLOBSTORE_READ_MERGE_MAX_GAP = 16 * 1024;
+// The max size of one read for the merged ranges that need a temporary buffer
+static constexpr size_t BLOBSTORE_READ_MERGE_MAX_SIZE = 1024 * 1024;
 
 using BlobStatPtr = BlobStats::BlobStatPtr;
 using ChecksumClass = Digest::CRC64;
@@ -635,11 +640,11 @@ PageMap BlobStore::read(FieldReadInfos & to_read, const ReadLimiterPtr & read_li
 
     ProfileEvents::increment(ProfileEvents::PSMReadPages, to_read.size());
 
-    // Sort in ascending order by offset in file.
+    // Sort in ascending order by <file, offset>, so that the nearby pages can be read at once.
     std::sort(
         to_read.begin(),
         to_read.end(),
-        [](const FieldReadInfo & a, const FieldReadInfo & b) { return a.entry.offset < b.entry.offset; });
+        [](const FieldReadInfo & a, const FieldReadInfo & b) { return std::tie(a.entry.file_id, a.entry.offset) < std::tie(b.entry.file_id, b.entry.offset); });
 
     // allocate data_buf that can hold all pages with specify fields
 
@@ -696,6 +701,24 @@ PageMap BlobStore::read(FieldReadInfos & to_read, const ReadLimiterPtr & read_li
         free(p, buf_size);
     });
 
+    // The fields are placed in the buffer in the same order as they are in the BlobFiles,
+    // so that the continuous fields and pages can be read by one system call.
+    std::vector<ReadRange> ranges;
+    {
+        char * write_offset = shared_data_buf;
+        for (const auto & [page_id_v3, entry, fields] : to_read)
+        {
+            for (const auto field_index : fields)
+            {
+                const auto [beg_offset, end_offset] = entry.getFieldOffsets(field_index);
+                const auto size_to_read = end_offset - beg_offset;
+                ranges.emplace_back(ReadRange{page_id_v3, entry.file_id, entry.offset + beg_offset, size_to_read, write_offset});
+                write_offset += size_to_read;
+            }
+        }
+    }
+    readRanges(ranges, read_limiter);
+
     std::set<FieldOffsetInsidePage> fields_offset_in_page;
     char * pos = shared_data_buf;
     for (const auto & [page_id_v3, entry, fields] : to_read)
@@ -704,10 +727,8 @@ PageMap BlobStore::read(FieldReadInfos & to_read, const ReadLimiterPtr & read_li
         char * write_offset = pos;
         for (const auto field_index : fields)
         {
-            // TODO: Continuously fields can read by one system call.
             const auto [beg_offset, end_offset] = entry.getFieldOffsets(field_index);
             const auto size_to_read = end_offset - beg_offset;
-            auto blob_file = read(page_id_v3, entry.file_id, entry.offset + beg_offset, write_offset, size_to_read, read_limiter);
             fields_offset_in_page.emplace(field_index, read_size_this_entry);
 
             if constexpr (BLOBSTORE_CHECKSUM_ON_READ)
@@ -730,7 +751,7 @@ PageMap BlobStore::read(FieldReadInfos & to_read, const ReadLimiterPtr & read_li
                                     beg_offset,
                                     size_to_read,
                                     toDebugString(entry),
-                                    blob_file->getPath());
+                                    getBlobFile(entry.file_id)->getPath());
                 }
             }
 
@@ -776,9 +797,9 @@ PageMap BlobStore::read(PageIDAndEntriesV3 & entries, const ReadLimiterPtr & rea
 
     ProfileEvents::increment(ProfileEvents::PSMReadPages, entries.size());
 
-    // Sort in ascending order by offset in file.
+    // Sort in ascending order by <file, offset>, so that the nearby pages can be read at once.
     std::sort(entries.begin(), entries.end(), [](const auto & a, const auto & b) {
-        return a.second.offset < b.second.offset;
+        return std::tie(a.second.file_id, a.second.offset) < std::tie(b.second.file_id, b.second.offset);
     });
 
     // allocate data_buf that can hold all pages
@@ -808,12 +829,24 @@ PageMap BlobStore::read(PageIDAndEntriesV3 & entries, const ReadLimiterPtr & rea
         free(p, buf_size);
     });
 
+    // The pages are placed in the buffer in the same order as they are in the BlobFiles,
+    // so that the continuous pages can be read by one system call.
+    std::vector<ReadRange> ranges;
+    ranges.reserve(entries.size());
+    {
+        char * write_offset = data_buf;
+        for (const auto & [page_id_v3, entry] : entries)
+        {
+            ranges.emplace_back(ReadRange{page_id_v3, entry.file_id, entry.offset, entry.size, write_offset});
+            write_offset += entry.size;
+        }
+    }
+    readRanges(ranges, read_limiter);
+
     char * pos = data_buf;
     PageMap page_map;
     for (const auto & [page_id_v3, entry] : entries)
     {
-        auto blob_file = read(page_id_v3, entry.file_id, entry.offset, pos, entry.size, read_limiter);
-
         if constexpr (BLOBSTORE_CHECKSUM_ON_READ)
         {
             ChecksumClass digest;
@@ -827,7 +860,7 @@ PageMap BlobStore::read(PageIDAndEntriesV3 & entries, const ReadLimiterPtr & rea
                                 entry.checksum,
                                 checksum,
                                 toDebugString(entry),
-                                blob_file->getPath()),
+                                getBlobFile(entry.file_id)->getPath()),
                     ErrorCodes::CHECKSUM_DOESNT_MATCH);
             }
         }
@@ -945,6 +978,57 @@ BlobFilePtr BlobStore::read(const PageIdV3Internal & page_id_v3, BlobFileId blob
     return blob_file;
 }
 
+void BlobStore::readRanges(const std::vector<ReadRange> & ranges, const ReadLimiterPtr & read_limiter)
+{
+    size_t begin = 0;
+    while (begin < ranges.size())
+    {
+        const auto & first = ranges[begin];
+        if (first.size == 0)
+        {
+            ++begin;
+            continue;
+        }
+
+        // Find the ranges that can be merged with `first`
+        size_t end = begin + 1;
+        BlobFileOffset read_end = first.offset + first.size;
+        bool need_copy = false;
+        for (; end < ranges.size(); ++end)
+        {
+            const auto & prev = ranges[end - 1];
+            const auto & cur = ranges[end];
+            // The ranges may overlap if different page ids are ref to the same entry
+            if (cur.blob_id != first.blob_id || cur.offset < read_end)
+                break;
+            const bool is_continuous = cur.offset == read_end && cur.buf == prev.buf + prev.size;
+            if (!is_continuous && cur.offset - read_end > BLOBSTORE_READ_MERGE_MAX_GAP)
+                break;
+            // Only the size of reading with a temporary buffer is limited
+            if ((need_copy || !is_continuous) && cur.offset + cur.size - first.offset > BLOBSTORE_READ_MERGE_MAX_SIZE)
+                break;
+            need_copy = need_copy || !is_continuous;
+            read_end = cur.offset + cur.size;
+        }
+
+        const size_t read_size = read_end - first.offset;
+        if (!need_copy)
+        {
+            // Read into the buffers of the ranges directly
+            read(first.page_id, first.blob_id, first.offset, first.buf, read_size, read_limiter);
+        }
+        else
+        {
+            char * tmp_buf = static_cast<char *>(alloc(read_size));
+            SCOPE_EXIT({ free(tmp_buf, read_size); });
+            read(first.page_id, first.blob_id, first.offset, tmp_buf, read_size, read_limiter);
+            for (size_t i = begin; i < end; ++i)
+                memcpy(ranges[i].buf, tmp_buf + (ranges[i].offset - first.offset), ranges[i].size);
+        }
+        begin = end;
+    }
+}
+
 std::vector<BlobFileId> BlobStore::getGCStats()
 {
     // Get a copy of stats map to avoid the big lock on stats map
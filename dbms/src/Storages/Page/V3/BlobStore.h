@@ -91,6 +91,22 @@ private:
 
     BlobFilePtr read(const PageIdV3Internal & page_id_v3, BlobFileId blob_id, BlobFileOffset offset, char * buffers, size_t size, const ReadLimiterPtr & read_limiter = nullptr, bool background = false);
 
+    struct ReadRange
+    {
+        PageIdV3Internal page_id;
+        BlobFileId blob_id;
+        BlobFileOffset offset;
+        size_t size;
+        char * buf;
+    };
+    /**
+     *  Read the ranges, which must be sorted by <blob_id, offset>.
+     *  The ranges that are adjacent in the same BlobFile and whose buffers are also adjacent
+     *  are merged into one read without copying. The ranges with small holes between them
+     *  are read into a temporary buffer by one read and then copied to their buffers.
+     */
+    void readRanges(const std::vector<ReadRange> & ranges, const ReadLimiterPtr & read_limiter = nullptr);
+
     /**
      *  Ask BlobStats to get a span from BlobStat.
      *  We will lock BlobStats until we get a BlobStat that can hold the size.
@@ -933,27 +933,21 @@ PageIDAndEntryV3 PageDirectory::getByIDImpl(PageIdV3Internal page_id, const Page
     bool ok = true;
     while (ok)
     {
-        VersionedPageEntriesPtr iter_v;
+        VersionedPageEntriesPtr iter_v = mvcc_table_directory.find(id_to_resolve);
+        if (iter_v == nullptr)
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto iter = mvcc_table_directory.find(id_to_resolve);
-            if (iter == mvcc_table_directory.end())
+            if (throw_on_not_exist)
             {
-                if (throw_on_not_exist)
-                {
-                    LOG_WARNING(log, "Dump state for invalid page id [page_id={}]", page_id);
-                    for (const auto & [dump_id, dump_entry] : mvcc_table_directory)
-                    {
-                        LOG_WARNING(log, "Dumping state [page_id={}] [entry={}]", dump_id, dump_entry == nullptr ? "<null>" : dump_entry->toDebugString());
-                    }
-                    throw Exception(fmt::format("Invalid page id, entry not exist [page_id={}] [resolve_id={}]", page_id, id_to_resolve), ErrorCodes::PS_ENTRY_NOT_EXISTS);
-                }
-                else
-                {
-                    return PageIDAndEntryV3{page_id, PageEntryV3{.file_id = INVALID_BLOBFILE_ID}};
-                }
+                LOG_WARNING(log, "Dump state for invalid page id [page_id={}]", page_id);
+                mvcc_table_directory.traverse([this](const PageIdV3Internal & dump_id, const VersionedPageEntriesPtr & dump_entry) {
+                    LOG_WARNING(log, "Dumping state [page_id={}] [entry={}]", dump_id, dump_entry == nullptr ? "<null>" : dump_entry->toDebugString());
+                });
+                throw Exception(fmt::format("Invalid page id, entry not exist [page_id={}] [resolve_id={}]", page_id, id_to_resolve), ErrorCodes::PS_ENTRY_NOT_EXISTS);
+            }
+            else
+            {
+                return PageIDAndEntryV3{page_id, PageEntryV3{.file_id = INVALID_BLOBFILE_ID}};
             }
-            iter_v = iter->second;
         }
         auto [resolve_state, next_id_to_resolve, next_ver_to_resolve] = iter_v->resolveToPageId(ver_to_resolve.sequence, /*ignore_delete=*/id_to_resolve != page_id, &entry_got);
         switch (resolve_state)
@@ -1000,22 +994,17 @@ std::pair<PageIDAndEntriesV3, PageIds> PageDirectory::getByIDsImpl(const PageIdV
         bool ok = true;
         while (ok)
         {
-            VersionedPageEntriesPtr iter_v;
+            VersionedPageEntriesPtr iter_v = mvcc_table_directory.find(id_to_resolve);
+            if (iter_v == nullptr)
             {
-                std::shared_lock read_lock(table_rw_mutex);
-                auto iter = mvcc_table_directory.find(id_to_resolve);
-                if (iter == mvcc_table_directory.end())
+                if (throw_on_not_exist)
                 {
-                    if (throw_on_not_exist)
-                    {
-                        throw Exception(fmt::format("Invalid page id, entry not exist [page_id={}] [resolve_id={}]", page_id, id_to_resolve), ErrorCodes::PS_ENTRY_NOT_EXISTS);
-                    }
-                    else
-                    {
-                        return false;
-                    }
+                    throw Exception(fmt::format("Invalid page id, entry not exist [page_id={}] [resolve_id={}]", page_id, id_to_resolve), ErrorCodes::PS_ENTRY_NOT_EXISTS);
+                }
+                else
+                {
+                    return false;
                 }
-                iter_v = iter->second;
             }
             auto [resolve_state, next_id_to_resolve, next_ver_to_resolve] = iter_v->resolveToPageId(ver_to_resolve.sequence, /*ignore_delete=*/id_to_resolve != page_id, &entry_got);
             switch (resolve_state)
@@ -1071,22 +1060,17 @@ PageIdV3Internal PageDirectory::getNormalPageId(PageIdV3Internal page_id, const
     bool keep_resolve = true;
     while (keep_resolve)
     {
-        VersionedPageEntriesPtr iter_v;
+        VersionedPageEntriesPtr iter_v = mvcc_table_directory.find(id_to_resolve);
+        if (iter_v == nullptr)
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto iter = mvcc_table_directory.find(id_to_resolve);
-            if (iter == mvcc_table_directory.end())
+            if (throw_on_not_exist)
             {
-                if (throw_on_not_exist)
-                {
-                    throw Exception(fmt::format("Invalid page id [page_id={}] [resolve_id={}]", page_id, id_to_resolve));
-                }
-                else
-                {
-                    return buildV3Id(0, INVALID_PAGE_ID);
-                }
+                throw Exception(fmt::format("Invalid page id [page_id={}] [resolve_id={}]", page_id, id_to_resolve));
+            }
+            else
+            {
+                return buildV3Id(0, INVALID_PAGE_ID);
             }
-            iter_v = iter->second;
         }
         auto [resolve_state, next_id_to_resolve, next_ver_to_resolve] = iter_v->resolveToPageId(ver_to_resolve.sequence, /*ignore_delete=*/id_to_resolve != page_id, nullptr);
         switch (resolve_state)
@@ -1127,8 +1111,7 @@ PageIdV3Internal PageDirectory::getNormalPageId(PageIdV3Internal page_id, const
 
 PageId PageDirectory::getMaxId() const
 {
-    std::shared_lock read_lock(table_rw_mutex);
-    return max_page_id;
+    return max_page_id.load();
 }
 
 std::set<PageIdV3Internal> PageDirectory::getAllPageIds()
@@ -1136,14 +1119,12 @@ std::set<PageIdV3Internal> PageDirectory::getAllPageIds()
     GET_METRIC(tiflash_storage_page_command_count, type_scan).Increment();
     std::set<PageIdV3Internal> page_ids;
 
-    std::shared_lock read_lock(table_rw_mutex);
     const auto seq = sequence.load();
-    for (auto & [page_id, versioned] : mvcc_table_directory)
-    {
+    mvcc_table_directory.traverse([&page_ids, seq](const PageIdV3Internal & page_id, const VersionedPageEntriesPtr & versioned) {
         // Only return the page_id that is visible
         if (versioned->isVisible(seq))
             page_ids.insert(page_id);
-    }
+    });
     return page_ids;
 }
 
@@ -1188,11 +1169,10 @@ void PageDirectory::applyRefEditRecord(
         -> std::tuple<bool, PageIdV3Internal, PageVersion> {
         while (true)
         {
-            auto resolve_ver_iter = mvcc_table_directory.find(id_to_resolve);
-            if (resolve_ver_iter == mvcc_table_directory.end())
+            const VersionedPageEntriesPtr resolve_version_list = mvcc_table_directory.find(id_to_resolve);
+            if (resolve_version_list == nullptr)
                 return {false, buildV3Id(0, 0), PageVersion(0)};
 
-            const VersionedPageEntriesPtr & resolve_version_list = resolve_ver_iter->second;
             auto [resolve_state, next_id_to_resolve, next_ver_to_resolve] = resolve_version_list->resolveToPageId(
                 ver_to_resolve.sequence,
                 /*ignore_delete=*/id_to_resolve != ori_page_id,
@@ -1233,9 +1213,9 @@ void PageDirectory::applyRefEditRecord(
     {
         SYNC_FOR("before_PageDirectory::applyRefEditRecord_incr_ref_count");
         // Add the ref-count of being-ref entry
-        if (auto resolved_iter = mvcc_table_directory.find(resolved_id); resolved_iter != mvcc_table_directory.end())
+        if (auto resolved_version_list = mvcc_table_directory.find(resolved_id); resolved_version_list != nullptr)
         {
-            resolved_iter->second->incrRefCount(resolved_ver);
+            resolved_version_list->incrRefCount(resolved_ver);
         }
         else
         {
@@ -1354,21 +1334,16 @@ void PageDirectory::apply(PageEntriesEdit && edit, const WriteLimiterPtr & write
     SCOPE_EXIT({ GET_METRIC(tiflash_storage_page_write_duration_seconds, type_commit).Observe(watch.elapsedSeconds()); });
 
     {
-        std::unique_lock table_lock(table_rw_mutex);
-
         // stage 2, create entry version list for page_id.
+        // Only the leader of the write group reach here, and the version list of every page
+        // is protected by the lock of its shard, so the readers of other shards are not blocked.
         for (const auto & r : edit.getRecords())
         {
-            // Protected in write_lock
-            max_page_id = std::max(max_page_id, r.page_id.low);
-
-            auto [iter, created] = mvcc_table_directory.insert(std::make_pair(r.page_id, nullptr));
-            if (created)
-            {
-                iter->second = std::make_shared<VersionedPageEntries>();
-            }
+            // Only updated by the leader
+            if (r.page_id.low > max_page_id.load(std::memory_order_relaxed))
+                max_page_id.store(r.page_id.low);
 
-            auto & version_list = iter->second;
+            auto version_list = mvcc_table_directory.getOrCreate(r.page_id);
             try
             {
                 switch (r.type)
@@ -1430,26 +1405,17 @@ void PageDirectory::gcApply(PageEntriesEdit && migrated_edit, const WriteLimiter
     // Apply migrate edit to the mvcc map
     for (const auto & record : migrated_edit.getRecords())
     {
-        MVCCMapType::const_iterator iter;
-        {
-            std::shared_lock read_lock(table_rw_mutex);
-            iter = mvcc_table_directory.find(record.page_id);
-            RUNTIME_CHECK_MSG(iter != mvcc_table_directory.end(), "Can't find [page_id={}] while doing gcApply", record.page_id);
-        } // release the read lock on `table_rw_mutex`
+        const auto versioned_entries = mvcc_table_directory.find(record.page_id);
+        RUNTIME_CHECK_MSG(versioned_entries != nullptr, "Can't find [page_id={}] while doing gcApply", record.page_id);
 
         // Append the gc version to version list
-        const auto & versioned_entries = iter->second;
         auto id_to_deref = versioned_entries->createUpsertEntry(record.version, record.entry);
         if (id_to_deref.low != INVALID_PAGE_ID)
         {
             // The ref-page is rewritten into a normal page, we need to decrease the ref-count of original page
-            MVCCMapType::const_iterator deref_iter;
-            {
-                std::shared_lock read_lock(table_rw_mutex);
-                deref_iter = mvcc_table_directory.find(id_to_deref);
-                RUNTIME_CHECK_MSG(deref_iter != mvcc_table_directory.end(), "Can't find [page_id={}] to deref after gcApply", id_to_deref);
-            }
-            auto deref_res = deref_iter->second->derefAndClean(/*lowest_seq*/ 0, id_to_deref, record.version, 1, nullptr);
+            const auto deref_entries = mvcc_table_directory.find(id_to_deref);
+            RUNTIME_CHECK_MSG(deref_entries != nullptr, "Can't find [page_id={}] to deref after gcApply", id_to_deref);
+            auto deref_res = deref_entries->derefAndClean(/*lowest_seq*/ 0, id_to_deref, record.version, 1, nullptr);
             RUNTIME_ASSERT(!deref_res);
         }
     }
@@ -1471,14 +1437,18 @@ PageDirectory::getEntriesByBlobIds(const std::vector<BlobFileId> & blob_ids) con
     UInt64 total_page_nums = 0;
     std::map<PageIdV3Internal, std::tuple<PageIdV3Internal, PageVersion>> ref_ids_maybe_rewrite;
 
+    for (size_t shard_idx = 0; shard_idx < MVCCMapType::NUM_SHARDS; ++shard_idx)
     {
+        // Only hold the lock of one shard when moving to the next page, so the scanning
+        // won't block the readers and writers for long.
+        const auto & shard = mvcc_table_directory.shardAt(shard_idx);
         PageIdV3Internal page_id;
         VersionedPageEntriesPtr version_entries;
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto iter = mvcc_table_directory.cbegin();
-            if (iter == mvcc_table_directory.end())
-                return {blob_versioned_entries, total_page_size};
+            std::shared_lock read_lock(shard.mutex);
+            auto iter = shard.map.cbegin();
+            if (iter == shard.map.end())
+                continue;
             page_id = iter->first;
             version_entries = iter->second;
         }
@@ -1497,9 +1467,9 @@ PageDirectory::getEntriesByBlobIds(const std::vector<BlobFileId> & blob_ids) con
             }
 
             {
-                std::shared_lock read_lock(table_rw_mutex);
-                auto iter = mvcc_table_directory.upper_bound(page_id);
-                if (iter == mvcc_table_directory.end())
+                std::shared_lock read_lock(shard.mutex);
+                auto iter = shard.map.upper_bound(page_id);
+                if (iter == shard.map.end())
                     break;
                 page_id = iter->first;
                 version_entries = iter->second;
@@ -1514,13 +1484,8 @@ PageDirectory::getEntriesByBlobIds(const std::vector<BlobFileId> & blob_ids) con
     {
         const auto ori_id = std::get<0>(ori_id_ver);
         const auto ver = std::get<1>(ori_id_ver);
-        VersionedPageEntriesPtr version_entries;
-        {
-            std::shared_lock read_lock(table_rw_mutex);
-            auto page_iter = mvcc_table_directory.find(ori_id);
-            RUNTIME_CHECK(page_iter != mvcc_table_directory.end(), ref_id, ori_id, ver);
-            version_entries = page_iter->second;
-        }
+        VersionedPageEntriesPtr version_entries = mvcc_table_directory.find(ori_id);
+        RUNTIME_CHECK(version_entries != nullptr, ref_id, ori_id, ver);
         // the latest entry with version.seq <= ref_id.create_ver.seq
         auto entry = version_entries->getLastEntry(ver.sequence);
         RUNTIME_CHECK(entry.has_value(), ref_id, ori_id, ver);
@@ -1621,46 +1586,50 @@ PageEntriesV3 PageDirectory::gcInMemEntries(bool return_removed_entries)
     }
 
     PageEntriesV3 all_del_entries;
-    MVCCMapType::iterator iter;
-    {
-        std::shared_lock read_lock(table_rw_mutex);
-        iter = mvcc_table_directory.begin();
-        if (iter == mvcc_table_directory.end())
-            return all_del_entries;
-    }
-
     UInt64 invalid_page_nums = 0;
     UInt64 valid_page_nums = 0;
 
     // The page_id that we need to decrease ref count
     // { id_0: <version, num to decrease>, id_1: <...>, ... }
     std::map<PageIdV3Internal, std::pair<PageVersion, Int64>> normal_entries_to_deref;
-    // Iterate all page_id and try to clean up useless var entries
-    while (true)
+    // Iterate all page_id and try to clean up useless var entries, shard by shard
+    for (size_t shard_idx = 0; shard_idx < MVCCMapType::NUM_SHARDS; ++shard_idx)
     {
-        // `iter` is an iter that won't be invalid cause by `apply`/`gcApply`.
-        // do gc on the version list without lock on `mvcc_table_directory`.
-        const bool all_deleted = iter->second->cleanOutdatedEntries(
-            lowest_seq,
-            &normal_entries_to_deref,
-            return_removed_entries ? &all_del_entries : nullptr,
-            iter->second->acquireLock());
+        auto & shard = mvcc_table_directory.shardAt(shard_idx);
+        MVCCMapType::Map::iterator iter;
+        {
+            std::shared_lock read_lock(shard.mutex);
+            iter = shard.map.begin();
+            if (iter == shard.map.end())
+                continue;
+        }
 
+        while (true)
         {
-            std::unique_lock write_lock(table_rw_mutex);
-            if (all_deleted)
-            {
-                iter = mvcc_table_directory.erase(iter);
-                invalid_page_nums++;
-            }
-            else
+            // `iter` is an iter that won't be invalid cause by `apply`/`gcApply`.
+            // do gc on the version list without lock on the shard.
+            const bool all_deleted = iter->second->cleanOutdatedEntries(
+                lowest_seq,
+                &normal_entries_to_deref,
+                return_removed_entries ? &all_del_entries : nullptr,
+                iter->second->acquireLock());
+
             {
-                valid_page_nums++;
-                iter++;
-            }
+                std::unique_lock write_lock(shard.mutex);
+                if (all_deleted)
+                {
+                    iter = shard.map.erase(iter);
+                    invalid_page_nums++;
+                }
+                else
+                {
+                    valid_page_nums++;
+                    iter++;
+                }
 
-            if (iter == mvcc_table_directory.end())
-                break;
+                if (iter == shard.map.end())
+                    break;
+            }
         }
     }
 
@@ -1669,11 +1638,12 @@ PageEntriesV3 PageDirectory::gcInMemEntries(bool return_removed_entries)
     // Iterate all page_id that need to decrease ref count of specified version.
     for (const auto & [page_id, deref_counter] : normal_entries_to_deref)
     {
-        MVCCMapType::iterator iter;
+        auto & shard = mvcc_table_directory.shardOf(page_id);
+        MVCCMapType::Map::iterator iter;
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            iter = mvcc_table_directory.find(page_id);
-            if (iter == mvcc_table_directory.end())
+            std::shared_lock read_lock(shard.mutex);
+            iter = shard.map.find(page_id);
+            if (iter == shard.map.end())
                 continue;
         }
 
@@ -1686,8 +1656,8 @@ PageEntriesV3 PageDirectory::gcInMemEntries(bool return_removed_entries)
 
         if (all_deleted)
         {
-            std::unique_lock write_lock(table_rw_mutex);
-            mvcc_table_directory.erase(iter);
+            std::unique_lock write_lock(shard.mutex);
+            shard.map.erase(iter);
             invalid_page_nums++;
             valid_page_nums--;
         }
@@ -1723,22 +1693,26 @@ PageEntriesEdit PageDirectory::dumpSnapshotToEdit(PageDirectorySnapshotPtr snap)
     }
 
     PageEntriesEdit edit;
-    MVCCMapType::iterator iter;
+    for (size_t shard_idx = 0; shard_idx < MVCCMapType::NUM_SHARDS; ++shard_idx)
     {
-        std::shared_lock read_lock(table_rw_mutex);
-        iter = mvcc_table_directory.begin();
-        if (iter == mvcc_table_directory.end())
-            return edit;
-    }
-    while (true)
-    {
-        iter->second->collapseTo(snap->sequence, iter->first, edit);
-
+        auto & shard = mvcc_table_directory.shardAt(shard_idx);
+        MVCCMapType::Map::iterator iter;
         {
-            std::shared_lock read_lock(table_rw_mutex);
-            ++iter;
-            if (iter == mvcc_table_directory.end())
-                break;
+            std::shared_lock read_lock(shard.mutex);
+            iter = shard.map.begin();
+            if (iter == shard.map.end())
+                continue;
+        }
+        while (true)
+        {
+            iter->second->collapseTo(snap->sequence, iter->first, edit);
+
+            {
+                std::shared_lock read_lock(shard.mutex);
+                ++iter;
+                if (iter == shard.map.end())
+                    break;
+            }
         }
     }
 
@@ -25,6 +25,7 @@
 #include <Storages/Page/V3/BlobStore.h>
 #include <Storages/Page/V3/MapUtils.h>
 #include <Storages/Page/V3/PageDirectory/ExternalIdsByNamespace.h>
+#include <Storages/Page/V3/PageDirectory/ShardedMVCCMap.h>
 #include <Storages/Page/V3/PageEntriesEdit.h>
 #include <Storages/Page/V3/PageEntry.h>
 #include <Storages/Page/V3/WALStore.h>
@@ -357,7 +358,6 @@ public:
     // Approximate number of pages in memory
     size_t numPages() const
     {
-        std::shared_lock read_lock(table_rw_mutex);
         return mvcc_table_directory.size();
     }
 
@@ -387,10 +387,7 @@ private:
     getByIDsImpl(const PageIdV3Internals & page_ids, const PageDirectorySnapshotPtr & snap, bool throw_on_not_exist) const;
 
 private:
-    // Only `std::map` is allow for `MVCCMap`. Cause `std::map::insert` ensure that
-    // "No iterators or references are invalidated"
-    // https://en.cppreference.com/w/cpp/container/map/insert
-    using MVCCMapType = std::map<PageIdV3Internal, VersionedPageEntriesPtr>;
+    using MVCCMapType = ShardedMVCCMap<VersionedPageEntries>;
 
     static void applyRefEditRecord(
         MVCCMapType & mvcc_table_directory,
@@ -418,7 +415,8 @@ private:
     Writer * buildWriteGroup(Writer * first, std::unique_lock<std::mutex> & /*lock*/);
 
 private:
-    PageId max_page_id;
+    // Only updated by the leader of the write group or restoring.
+    std::atomic<PageId> max_page_id;
     std::atomic<UInt64> sequence;
 
     // Used for avoid concurrently apply edits to wal and mvcc_table_directory.
@@ -439,8 +437,7 @@ private:
     //   2. it becomes the head of the queue, so it continue to finish the write process of the leader;
     std::deque<Writer *> writers;
 
-    // Used to protect mvcc_table_directory between apply threads and read threads
-    mutable std::shared_mutex table_rw_mutex;
+    // Sharded by page id, every shard is protected by its own lock between apply threads and read threads
     MVCCMapType mvcc_table_directory;
 
     mutable std::mutex snapshots_mutex;
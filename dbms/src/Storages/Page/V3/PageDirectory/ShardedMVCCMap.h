@@ -0,0 +1,135 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <Common/HashTable/Hash.h>
+#include <Common/nocopyable.h>
+#include <Storages/Page/PageDefines.h>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+
+namespace DB::PS::V3
+{
+// The map from page id to its version list used by `PageDirectory`.
+// The page ids are partitioned into shards by the hash of namespace id and page id,
+// and every shard is protected by its own lock. So the readers only contend with the
+// writers that touch the same shard, instead of being blocked by every `apply`/`gcApply`
+// or the whole scan of GC.
+// The version list is held by `std::shared_ptr`, and the concurrency control inside
+// a version list is done by itself.
+template <typename VersionedEntries>
+class ShardedMVCCMap
+{
+public:
+    using ValuePtr = std::shared_ptr<VersionedEntries>;
+    // Only `std::map` is allow for the shard. Cause `std::map::insert` ensure that
+    // "No iterators or references are invalidated"
+    // https://en.cppreference.com/w/cpp/container/map/insert
+    // So the iterator of a shard can be used after the lock is released, as long as
+    // the element it points to is not erased.
+    using Map = std::map<PageIdV3Internal, ValuePtr>;
+
+    struct Shard
+    {
+        mutable std::shared_mutex mutex;
+        Map map;
+    };
+
+    static constexpr size_t NUM_SHARDS = 32;
+
+    ShardedMVCCMap() = default;
+
+    // Return nullptr if `page_id` does not exist.
+    ValuePtr find(PageIdV3Internal page_id) const
+    {
+        const auto & shard = shardOf(page_id);
+        std::shared_lock read_lock(shard.mutex);
+        auto iter = shard.map.find(page_id);
+        if (iter == shard.map.end())
+            return nullptr;
+        return iter->second;
+    }
+
+    // Return the version list of `page_id`, create an empty one if it does not exist.
+    ValuePtr getOrCreate(PageIdV3Internal page_id)
+    {
+        auto & shard = shardOf(page_id);
+        {
+            std::shared_lock read_lock(shard.mutex);
+            if (auto iter = shard.map.find(page_id); iter != shard.map.end())
+                return iter->second;
+        }
+        std::unique_lock write_lock(shard.mutex);
+        auto [iter, created] = shard.map.emplace(page_id, nullptr);
+        if (created)
+            iter->second = std::make_shared<VersionedEntries>();
+        return iter->second;
+    }
+
+    // Approximate number of pages
+    size_t size() const
+    {
+        size_t total = 0;
+        for (const auto & shard : shards)
+        {
+            std::shared_lock read_lock(shard.mutex);
+            total += shard.map.size();
+        }
+        return total;
+    }
+
+    // Call `f(page_id, version_list)` on all pages, shard by shard. The pages are
+    // in ascending order within a shard, but not across the shards.
+    // Note the lock of the shard is held while calling `f`.
+    template <typename Func>
+    void traverse(Func && f) const
+    {
+        for (const auto & shard : shards)
+        {
+            std::shared_lock read_lock(shard.mutex);
+            for (const auto & [page_id, entries] : shard.map)
+                f(page_id, entries);
+        }
+    }
+
+    // Copy all pages into one ordered map, only for debugging tools.
+    Map copyToMap() const
+    {
+        Map res;
+        traverse([&res](const PageIdV3Internal & page_id, const ValuePtr & entries) { res.emplace(page_id, entries); });
+        return res;
+    }
+
+    Shard & shardOf(PageIdV3Internal page_id) { return shards[shardIndex(page_id)]; }
+    const Shard & shardOf(PageIdV3Internal page_id) const { return shards[shardIndex(page_id)]; }
+
+    Shard & shardAt(size_t index) { return shards[index]; }
+    const Shard & shardAt(size_t index) const { return shards[index]; }
+
+    static size_t shardIndex(PageIdV3Internal page_id)
+    {
+        return intHash64(page_id.low ^ intHash64(page_id.high)) % NUM_SHARDS;
+    }
+
+    DISALLOW_COPY_AND_MOVE(ShardedMVCCMap);
+
+private:
+    std::array<Shard, NUM_SHARDS> shards;
+};
+
+} // namespace DB::PS::V3
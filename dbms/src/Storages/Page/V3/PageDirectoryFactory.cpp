@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/Stopwatch.h>
+#include <Common/TiFlashMetrics.h>
 #include <Storages/Page/PageDefines.h>
 #include <Storages/Page/V3/PageDirectory.h>
 #include <Storages/Page/V3/PageDirectoryFactory.h>
@@ -20,6 +22,9 @@
 #include <Storages/Page/V3/WAL/serialize.h>
 #include <Storages/Page/V3/WALStore.h>
 
+#include <common/ThreadPool.h>
+
+#include <algorithm>
 #include <memory>
 #include <optional>
 
@@ -39,8 +44,12 @@ PageDirectoryPtr PageDirectoryFactory::create(String storage_name, FileProviderP
 
 PageDirectoryPtr PageDirectoryFactory::createFromReader(String storage_name, WALStoreReaderPtr reader, WALStorePtr wal)
 {
+    Stopwatch total_watch;
+    Stopwatch watch;
     PageDirectoryPtr dir = std::make_unique<PageDirectory>(storage_name, std::move(wal));
     loadFromDisk(dir, std::move(reader));
+    GET_METRIC(tiflash_storage_page_restore_duration_seconds, type_load_wal).Observe(watch.elapsedSeconds());
+    watch.restart();
 
     // Reset the `sequence` to the maximum of persisted.
     dir->sequence = max_applied_ver.sequence;
@@ -49,7 +58,8 @@ PageDirectoryPtr PageDirectoryFactory::createFromReader(String storage_name, WAL
     // try to run GC again on some entries that are already marked as invalid in BlobStore.
     // It's no need to remove the expired entries in BlobStore, so skip filling removed_entries to improve performance.
     dir->gcInMemEntries(/*return_removed_entries=*/false);
-    LOG_INFO(DB::Logger::get(storage_name), "PageDirectory restored [max_page_id={}] [max_applied_ver={}]", dir->getMaxId(), dir->sequence);
+    GET_METRIC(tiflash_storage_page_restore_duration_seconds, type_gc_in_mem).Observe(watch.elapsedSeconds());
+    watch.restart();
 
     if (blob_stats)
     {
@@ -57,10 +67,7 @@ PageDirectoryPtr PageDirectoryFactory::createFromReader(String storage_name, WAL
         // the latest entry to `blob_stats`, or we may meet error since
         // some entries may be removed in memory but not get compacted
         // in the log file.
-        for (const auto & [page_id, entries] : dir->mvcc_table_directory)
-        {
-            (void)page_id;
-
+        dir->mvcc_table_directory.traverse([this](const PageIdV3Internal & /*page_id*/, const VersionedPageEntriesPtr & entries) {
             // We should restore the entry to `blob_stats` even if it is marked as "deleted",
             // or we will mistakenly reuse the space to write other blobs down into that space.
             // So we need to use `getLastEntry` instead of `getEntry(version)` here.
@@ -68,11 +75,22 @@ PageDirectoryPtr PageDirectoryFactory::createFromReader(String storage_name, WAL
             {
                 blob_stats->restoreByEntry(*entry);
             }
-        }
+        });
 
         blob_stats->restore();
+        GET_METRIC(tiflash_storage_page_restore_duration_seconds, type_restore_blob_stats).Observe(watch.elapsedSeconds());
     }
 
+    const auto elapsed_seconds = total_watch.elapsedSeconds();
+    GET_METRIC(tiflash_storage_page_restore_duration_seconds, type_total).Observe(elapsed_seconds);
+    LOG_INFO(
+        DB::Logger::get(storage_name),
+        "PageDirectory restored [max_page_id={}] [max_applied_ver={}] [num_pages={}] [elapsed={:.3f}s]",
+        dir->getMaxId(),
+        dir->sequence,
+        dir->numPages(),
+        elapsed_seconds);
+
     // TODO: After restored ends, set the last offset of log file for `wal`
     return dir;
 }
@@ -107,10 +125,7 @@ PageDirectoryPtr PageDirectoryFactory::createFromEdit(String storage_name, FileP
         // the latest entry to `blob_stats`, or we may meet error since
         // some entries may be removed in memory but not get compacted
         // in the log file.
-        for (const auto & [page_id, entries] : dir->mvcc_table_directory)
-        {
-            (void)page_id;
-
+        dir->mvcc_table_directory.traverse([this](const PageIdV3Internal & /*page_id*/, const VersionedPageEntriesPtr & entries) {
             // We should restore the entry to `blob_stats` even if it is marked as "deleted",
             // or we will mistakenly reuse the space to write other blobs down into that space.
             // So we need to use `getLastEntry` instead of `getEntry(version)` here.
@@ -118,7 +133,7 @@ PageDirectoryPtr PageDirectoryFactory::createFromEdit(String storage_name, FileP
             {
                 blob_stats->restoreByEntry(*entry);
             }
-        }
+        });
 
         blob_stats->restore();
     }
@@ -128,6 +143,12 @@ PageDirectoryPtr PageDirectoryFactory::createFromEdit(String storage_name, FileP
 
 void PageDirectoryFactory::loadEdit(const PageDirectoryPtr & dir, const PageEntriesEdit & edit)
 {
+    if (restore_concurrency > 1 && !dump_entries && edit.size() >= MIN_RECORDS_FOR_PARALLEL_LOAD && isSnapshotEdit(edit))
+    {
+        loadSnapshotEdit(dir, edit);
+        return;
+    }
+
     for (const auto & r : edit.getRecords())
     {
         if (max_applied_ver < r.version)
@@ -139,19 +160,87 @@ void PageDirectoryFactory::loadEdit(const PageDirectoryPtr & dir, const PageEntr
     }
 }
 
+bool PageDirectoryFactory::isSnapshotEdit(const PageEntriesEdit & edit)
+{
+    const auto & records = edit.getRecords();
+    return std::all_of(records.begin(), records.end(), [](const PageEntriesEdit::EditRecord & r) {
+        return r.type == EditRecordType::VAR_ENTRY || r.type == EditRecordType::VAR_REF
+            || r.type == EditRecordType::VAR_EXTERNAL || r.type == EditRecordType::VAR_DELETE;
+    });
+}
+
+void PageDirectoryFactory::loadSnapshotEdit(const PageDirectoryPtr & dir, const PageEntriesEdit & edit)
+{
+    // The records dumped from a directory snapshot are collapsed, applying a record only
+    // touches the version list of its own page. So the records can be applied shard by shard
+    // in parallel without contention. The records of the same page are in the same shard and
+    // keep their order.
+    using MVCCMapType = PageDirectory::MVCCMapType;
+    const auto & records = edit.getRecords();
+    std::vector<std::vector<size_t>> records_by_shard(MVCCMapType::NUM_SHARDS);
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        const auto & r = records[i];
+        if (max_applied_ver < r.version)
+            max_applied_ver = r.version;
+        records_by_shard[MVCCMapType::shardIndex(r.page_id)].push_back(i);
+    }
+
+    const size_t num_threads = std::min(restore_concurrency, MVCCMapType::NUM_SHARDS);
+    std::vector<std::vector<std::shared_ptr<PageIdV3Internal>>> external_holders(num_threads);
+    std::vector<PageId> max_page_ids(num_threads, 0);
+    {
+        ThreadPool pool(num_threads);
+        for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx)
+        {
+            pool.schedule([&, thread_idx] {
+                for (size_t shard_idx = thread_idx; shard_idx < MVCCMapType::NUM_SHARDS; shard_idx += num_threads)
+                {
+                    for (const auto record_idx : records_by_shard[shard_idx])
+                    {
+                        const auto & r = records[record_idx];
+                        max_page_ids[thread_idx] = std::max(max_page_ids[thread_idx], r.page_id.low);
+                        const auto version_list = dir->mvcc_table_directory.getOrCreate(r.page_id);
+                        try
+                        {
+                            if (r.type == EditRecordType::VAR_DELETE)
+                            {
+                                version_list->createDelete(r.version);
+                            }
+                            else if (auto holder = version_list->fromRestored(r); holder)
+                            {
+                                *holder = r.page_id;
+                                external_holders[thread_idx].emplace_back(std::move(holder));
+                            }
+                        }
+                        catch (DB::Exception & e)
+                        {
+                            e.addMessage(fmt::format(" [type={}] [page_id={}] [ver={}]", magic_enum::enum_name(r.type), r.page_id, r.version));
+                            throw;
+                        }
+                    }
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx)
+    {
+        dir->max_page_id = std::max(dir->max_page_id.load(), max_page_ids[thread_idx]);
+        for (const auto & holder : external_holders[thread_idx])
+            dir->external_ids_by_ns.addExternalIdUnlock(holder);
+    }
+}
+
 void PageDirectoryFactory::applyRecord(
     const PageDirectoryPtr & dir,
     const PageEntriesEdit::EditRecord & r)
 {
-    auto [iter, created] = dir->mvcc_table_directory.insert(std::make_pair(r.page_id, nullptr));
-    if (created)
-    {
-        iter->second = std::make_shared<VersionedPageEntries>();
-    }
+    const auto version_list = dir->mvcc_table_directory.getOrCreate(r.page_id);
 
-    dir->max_page_id = std::max(dir->max_page_id, r.page_id.low);
+    dir->max_page_id = std::max(dir->max_page_id.load(), r.page_id.low);
 
-    const auto & version_list = iter->second;
     const auto & restored_version = r.version;
     try
     {
@@ -201,9 +290,9 @@ void PageDirectoryFactory::applyRecord(
             if (id_to_deref.low != INVALID_PAGE_ID)
             {
                 // The ref-page is rewritten into a normal page, we need to decrease the ref-count of the original page
-                auto deref_iter = dir->mvcc_table_directory.find(id_to_deref);
-                RUNTIME_CHECK_MSG(deref_iter != dir->mvcc_table_directory.end(), "Can't find [page_id={}] to deref when applying upsert", id_to_deref);
-                auto deref_res = deref_iter->second->derefAndClean(/*lowest_seq*/ 0, id_to_deref, restored_version, 1, nullptr);
+                auto deref_entries = dir->mvcc_table_directory.find(id_to_deref);
+                RUNTIME_CHECK_MSG(deref_entries != nullptr, "Can't find [page_id={}] to deref when applying upsert", id_to_deref);
+                auto deref_res = deref_entries->derefAndClean(/*lowest_seq*/ 0, id_to_deref, restored_version, 1, nullptr);
                 RUNTIME_ASSERT(!deref_res);
             }
             break;
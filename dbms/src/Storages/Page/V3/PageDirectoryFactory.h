@@ -61,15 +61,31 @@ public:
         return *this;
     }
 
+    // The number of threads for loading the directory snapshot (the checkpoint) in the WAL.
+    // Loading with 1 thread is the same as replaying any other edits.
+    PageDirectoryFactory & setRestoreConcurrency(size_t restore_concurrency_)
+    {
+        restore_concurrency = std::max<size_t>(1, restore_concurrency_);
+        return *this;
+    }
+
 private:
     void loadFromDisk(const PageDirectoryPtr & dir, WALStoreReaderPtr && reader);
     void loadEdit(const PageDirectoryPtr & dir, const PageEntriesEdit & edit);
+    // Load the edit dumped by `PageDirectory::dumpSnapshotToEdit` in parallel.
+    void loadSnapshotEdit(const PageDirectoryPtr & dir, const PageEntriesEdit & edit);
+    static bool isSnapshotEdit(const PageEntriesEdit & edit);
     static void applyRecord(
         const PageDirectoryPtr & dir,
         const PageEntriesEdit::EditRecord & r);
 
     BlobStats * blob_stats = nullptr;
 
+    static constexpr size_t DEFAULT_RESTORE_CONCURRENCY = 8;
+    size_t restore_concurrency = DEFAULT_RESTORE_CONCURRENCY;
+    // Only load the directory snapshot in parallel when it is large enough
+    static constexpr size_t MIN_RECORDS_FOR_PARALLEL_LOAD = 10000;
+
     // For debug tool
     friend class PageStorageControlV3;
     bool dump_entries = false;
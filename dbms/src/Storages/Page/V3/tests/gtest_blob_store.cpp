@@ -14,6 +14,7 @@
 
 #include <Common/FailPoint.h>
 #include <Common/Logger.h>
+#include <Common/TiFlashMetrics.h>
 #include <Encryption/RateLimiter.h>
 #include <IO/ReadBufferFromMemory.h>
 #include <Poco/Logger.h>
@@ -1140,6 +1141,86 @@ try
 }
 CATCH
 
+TEST_F(BlobStoreTest, ReadMergedRanges)
+try
+{
+    const auto file_provider = DB::tests::TiFlashTestEnv::getContext().getFileProvider();
+    auto blob_store = BlobStore(getCurrentTestName(), file_provider, delegator, config);
+
+    // All pages are written into one BlobFile continuously
+    const size_t page_num = 30;
+    std::vector<String> page_data(page_num);
+    WriteBatch wb;
+    for (size_t i = 0; i < page_num; ++i)
+    {
+        page_data[i].resize(100 + i * 10);
+        for (size_t j = 0; j < page_data[i].size(); ++j)
+            page_data[i][j] = static_cast<char>(i * 7 + j);
+        ReadBufferPtr buff = std::make_shared<ReadBufferFromMemory>(page_data[i].data(), page_data[i].size());
+        PageFieldSizes field_sizes{10, 20, page_data[i].size() - 30};
+        wb.putPage(i, /* tag */ 0, buff, page_data[i].size(), field_sizes);
+    }
+    PageEntriesEdit edit = blob_store.write(std::move(wb), nullptr);
+    ASSERT_EQ(edit.size(), page_num);
+
+    auto & read_blob_counter = GET_METRIC(tiflash_storage_page_command_count, type_read_blob);
+    auto check_read = [&](const std::vector<size_t> & page_idxs, size_t expected_reads) {
+        PageIDAndEntriesV3 entries;
+        // in reverse order to check the sorting
+        for (auto it = page_idxs.rbegin(); it != page_idxs.rend(); ++it)
+            entries.emplace_back(buildV3Id(TEST_NAMESPACE_ID, *it), edit.getRecords()[*it].entry);
+        const auto reads_before = read_blob_counter.Value();
+        auto page_map = blob_store.read(entries);
+        ASSERT_EQ(read_blob_counter.Value() - reads_before, expected_reads);
+        ASSERT_EQ(page_map.size(), page_idxs.size());
+        for (const auto idx : page_idxs)
+        {
+            const auto & page = page_map[idx];
+            ASSERT_EQ(page.data.size(), page_data[idx].size());
+            ASSERT_EQ(memcmp(page.data.begin(), page_data[idx].data(), page.data.size()), 0);
+            ASSERT_EQ(page.getFieldData(1).size(), 20);
+            ASSERT_EQ(memcmp(page.getFieldData(1).begin(), page_data[idx].data() + 10, 20), 0);
+        }
+    };
+    // The continuous pages are read at once without copying
+    check_read({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29}, 1);
+    // The pages with small holes are read at once with a temporary buffer
+    check_read({0, 2, 4, 6, 8}, 1);
+    check_read({3, 4, 5, 7, 8}, 1);
+    check_read({0}, 1);
+
+    {
+        // Read some fields of the pages, the holes between the fields are small
+        BlobStore::FieldReadInfos read_infos;
+        for (size_t i = 0; i < page_num; i += 3)
+            read_infos.emplace_back(buildV3Id(TEST_NAMESPACE_ID, i), edit.getRecords()[i].entry, std::vector<size_t>{0, 2});
+        const auto reads_before = read_blob_counter.Value();
+        auto page_map = blob_store.read(read_infos);
+        ASSERT_EQ(read_blob_counter.Value() - reads_before, 1);
+        for (size_t i = 0; i < page_num; i += 3)
+        {
+            const auto & page = page_map[i];
+            ASSERT_EQ(page.fieldSize(), 2);
+            ASSERT_EQ(memcmp(page.getFieldData(0).begin(), page_data[i].data(), 10), 0);
+            ASSERT_EQ(memcmp(page.getFieldData(2).begin(), page_data[i].data() + 30, page_data[i].size() - 30), 0);
+        }
+    }
+
+    {
+        // Different page ids ref to the same entry
+        PageIDAndEntriesV3 entries;
+        entries.emplace_back(buildV3Id(TEST_NAMESPACE_ID, 100), edit.getRecords()[5].entry);
+        entries.emplace_back(buildV3Id(TEST_NAMESPACE_ID, 101), edit.getRecords()[5].entry);
+        entries.emplace_back(buildV3Id(TEST_NAMESPACE_ID, 102), edit.getRecords()[6].entry);
+        auto page_map = blob_store.read(entries);
+        ASSERT_EQ(page_map.size(), 3);
+        ASSERT_EQ(memcmp(page_map[100].data.begin(), page_data[5].data(), page_data[5].size()), 0);
+        ASSERT_EQ(memcmp(page_map[101].data.begin(), page_data[5].data(), page_data[5].size()), 0);
+        ASSERT_EQ(memcmp(page_map[102].data.begin(), page_data[6].data(), page_data[6].size()), 0);
+    }
+}
+CATCH
+
 TEST_F(BlobStoreTest, LargeWrite)
 try
 {
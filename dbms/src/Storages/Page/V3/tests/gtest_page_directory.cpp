@@ -1084,6 +1084,87 @@ try
 }
 CATCH
 
+TEST_F(PageDirectoryTest, ConcurrentApplyAndReadAcrossShards)
+try
+{
+    // The pages of different namespaces are spread across the shards of the directory,
+    // and the ref pages may point to the pages in other shards.
+    const NamespaceId num_ns = 4;
+    const PageId pages_per_ns = 200;
+    const size_t num_rounds = 10;
+    auto entry_of = [](size_t round, PageId page_id) {
+        return PageEntryV3{.file_id = 1, .size = 1024, .padded_size = 0, .tag = round, .offset = page_id, .checksum = 0x4567};
+    };
+
+    auto writer = std::async([&]() {
+        for (size_t round = 0; round < num_rounds; ++round)
+        {
+            PageEntriesEdit edit;
+            for (NamespaceId ns_id = 0; ns_id < num_ns; ++ns_id)
+            {
+                for (PageId page_id = 1; page_id <= pages_per_ns; ++page_id)
+                    edit.put(buildV3Id(ns_id, page_id), entry_of(round, page_id));
+            }
+            if (round == 0)
+            {
+                // ref ${ns}.${pages_per_ns + 1} -> ${ns + 1}.${pages_per_ns + 2}
+                for (NamespaceId ns_id = 0; ns_id < num_ns; ++ns_id)
+                    edit.put(buildV3Id(ns_id, pages_per_ns + 2), entry_of(round, pages_per_ns + 2));
+                for (NamespaceId ns_id = 0; ns_id < num_ns; ++ns_id)
+                    edit.ref(buildV3Id(ns_id, pages_per_ns + 1), buildV3Id((ns_id + 1) % num_ns, pages_per_ns + 2));
+            }
+            dir->apply(std::move(edit));
+        }
+    });
+    auto reader = std::async([&]() {
+        while (true)
+        {
+            auto snap = dir->createSnapshot();
+            PageIdV3Internals ids;
+            for (NamespaceId ns_id = 0; ns_id < num_ns; ++ns_id)
+            {
+                for (PageId page_id = 1; page_id <= pages_per_ns; ++page_id)
+                    ids.emplace_back(buildV3Id(ns_id, page_id));
+            }
+            auto [entries, not_found] = dir->getByIDsOrNull(ids, snap);
+            // The whole edit is visible or not visible to the snapshot
+            if (entries.empty())
+            {
+                ASSERT_EQ(not_found.size(), ids.size());
+                continue;
+            }
+            ASSERT_EQ(entries.size(), ids.size());
+            const auto round = entries[0].second.tag;
+            for (const auto & [page_id, entry] : entries)
+                ASSERT_SAME_ENTRY(entry, entry_of(round, page_id.low));
+            if (round == num_rounds - 1)
+                break;
+        }
+    });
+    writer.get();
+    reader.get();
+
+    auto snap = dir->createSnapshot();
+    ASSERT_EQ(dir->numPages(), num_ns * (pages_per_ns + 2));
+    ASSERT_EQ(dir->getAllPageIds().size(), num_ns * (pages_per_ns + 2));
+    ASSERT_EQ(dir->getMaxId(), pages_per_ns + 2);
+    for (NamespaceId ns_id = 0; ns_id < num_ns; ++ns_id)
+    {
+        auto ref_id = buildV3Id(ns_id, pages_per_ns + 1);
+        auto normal_id = dir->getNormalPageId(ref_id, snap, true);
+        ASSERT_EQ(normal_id.high, (ns_id + 1) % num_ns);
+        ASSERT_EQ(normal_id.low, pages_per_ns + 2);
+        ASSERT_SAME_ENTRY(dir->getByID(ref_id, snap).second, entry_of(0, pages_per_ns + 2));
+    }
+
+    // Only the latest version of every page is left after gc
+    snap.reset();
+    auto removed_entries = dir->gcInMemEntries();
+    ASSERT_EQ(removed_entries.size(), num_ns * pages_per_ns * (num_rounds - 1));
+    ASSERT_EQ(dir->numPages(), num_ns * (pages_per_ns + 2));
+}
+CATCH
+
 class PageDirectoryGCTest : public PageDirectoryTest
 {
 };
@@ -2190,6 +2271,63 @@ try
 }
 CATCH
 
+TEST_F(PageDirectoryGCTest, RestoreLargeSnapshotInParallel)
+try
+{
+    const PageId num_pages = 12000;
+    const PageId num_refs = 100;
+    const NamespaceId ext_ns_id = TEST_NAMESPACE_ID + 1;
+    auto entry_of = [](PageId page_id) {
+        return PageEntryV3{.file_id = 1, .size = 1024, .padded_size = 0, .tag = 0, .offset = page_id * 1024, .checksum = 0x4567};
+    };
+    {
+        PageEntriesEdit edit;
+        for (PageId page_id = 1; page_id <= num_pages; ++page_id)
+            edit.put(buildV3Id(TEST_NAMESPACE_ID, page_id), entry_of(page_id));
+        for (PageId page_id = 1; page_id <= num_refs; ++page_id)
+            edit.putExternal(buildV3Id(ext_ns_id, page_id));
+        dir->apply(std::move(edit));
+    }
+    {
+        // ref ${num_pages + i} -> ${i}, and delete the half of the being-ref pages
+        PageEntriesEdit edit;
+        for (PageId page_id = 1; page_id <= num_refs; ++page_id)
+            edit.ref(buildV3Id(TEST_NAMESPACE_ID, num_pages + page_id), buildV3Id(TEST_NAMESPACE_ID, page_id));
+        for (PageId page_id = 1; page_id <= num_refs / 2; ++page_id)
+            edit.del(buildV3Id(TEST_NAMESPACE_ID, page_id));
+        dir->apply(std::move(edit));
+    }
+
+    for (size_t concurrency : {1, 4})
+    {
+        auto edit = dir->dumpSnapshotToEdit();
+        ASSERT_GT(edit.size(), num_pages);
+        auto ctx = ::DB::tests::TiFlashTestEnv::getContext();
+        auto provider = ctx.getFileProvider();
+        auto path = getTemporaryPath();
+        PSDiskDelegatorPtr delegator = std::make_shared<DB::tests::MockDiskDelegatorSingle>(path);
+        PageDirectoryFactory factory;
+        auto restored_dir = factory.setRestoreConcurrency(concurrency).createFromEdit(getCurrentTestName(), provider, delegator, edit);
+
+        ASSERT_EQ(restored_dir->numPages(), num_pages + 2 * num_refs);
+        ASSERT_EQ(restored_dir->getMaxId(), num_pages + num_refs);
+        auto snap = restored_dir->createSnapshot();
+        for (PageId page_id = 1; page_id <= num_pages; ++page_id)
+        {
+            if (page_id <= num_refs / 2)
+                EXPECT_ENTRY_NOT_EXIST(restored_dir, page_id, snap);
+            else
+                EXPECT_SAME_ENTRY(getEntry(restored_dir, page_id, snap), entry_of(page_id));
+        }
+        for (PageId page_id = 1; page_id <= num_refs; ++page_id)
+            EXPECT_SAME_ENTRY(getEntry(restored_dir, num_pages + page_id, snap), entry_of(page_id));
+        auto alive_ids = restored_dir->getAliveExternalIds(ext_ns_id);
+        ASSERT_TRUE(alive_ids.has_value());
+        ASSERT_EQ(alive_ids->size(), num_refs);
+    }
+}
+CATCH
+
 TEST_F(PageDirectoryGCTest, CleanAfterDecreaseRef)
 try
 {
@@ -204,7 +204,7 @@ private:
         // Other display mode need to restore ps instance
         PageStorageImpl ps(String(NAME), delegator, config, provider);
         ps.restore();
-        PageDirectory::MVCCMapType & mvcc_table_directory = ps.page_directory->mvcc_table_directory;
+        auto mvcc_table_directory = ps.page_directory->mvcc_table_directory.copyToMap();
 
         switch (options.mode)
         {
@@ -292,7 +292,7 @@ private:
         return stats_info.toString();
     }
 
-    static String getDirectoryInfo(PageDirectory::MVCCMapType & mvcc_table_directory, UInt64 ns_id, UInt64 page_id)
+    static String getDirectoryInfo(PageDirectory::MVCCMapType::Map & mvcc_table_directory, UInt64 ns_id, UInt64 page_id)
     {
         auto page_info = [](UInt128 page_internal_id_, const VersionedPageEntriesPtr & versioned_entries) {
             FmtBuffer page_str;
@@ -357,7 +357,7 @@ private:
         return directory_info.toString();
     }
 
-    static String getSummaryInfo(PageDirectory::MVCCMapType & mvcc_table_directory, BlobStore & blob_store)
+    static String getSummaryInfo(PageDirectory::MVCCMapType::Map & mvcc_table_directory, BlobStore & blob_store)
     {
         UInt64 longest_version_chaim = 0;
         UInt64 shortest_version_chaim = UINT64_MAX;
@@ -404,7 +404,7 @@ private:
         return dir_summary_info.toString();
     }
 
-    static String checkSinglePage(PageDirectory::MVCCMapType & mvcc_table_directory, BlobStore & blob_store, UInt64 ns_id, UInt64 page_id)
+    static String checkSinglePage(PageDirectory::MVCCMapType::Map & mvcc_table_directory, BlobStore & blob_store, UInt64 ns_id, UInt64 page_id)
     {
         const auto & page_internal_id = buildV3Id(ns_id, page_id);
         const auto & it = mvcc_table_directory.find(page_internal_id);
@@ -460,7 +460,7 @@ private:
         return error_msg.toString();
     }
 
-    static String checkAllDataCrc(PageDirectory::MVCCMapType & mvcc_table_directory, BlobStore & blob_store, bool enable_fo_check)
+    static String checkAllDataCrc(PageDirectory::MVCCMapType::Map & mvcc_table_directory, BlobStore & blob_store, bool enable_fo_check)
     {
         size_t total_pages = mvcc_table_directory.size();
         size_t cut_index = 0;
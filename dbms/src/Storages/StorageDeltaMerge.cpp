@@ -39,6 +39,7 @@
 #include <Storages/DeltaMerge/DeltaMergeHelpers.h>
 #include <Storages/DeltaMerge/DeltaMergeStore.h>
 #include <Storages/DeltaMerge/Filter/RSOperator.h>
+#include <Storages/DeltaMerge/Filter/RuntimeFilter.h>
 #include <Storages/DeltaMerge/FilterParser/FilterParser.h>
 #include <Storages/MutableSupport.h>
 #include <Storages/PrimaryKeyNotMatchException.h>
@@ -723,7 +724,14 @@ DM::RSOperatorPtr StorageDeltaMerge::parseRoughSetFilter(const SelectQueryInfo &
                 // Maybe throw an exception? Or check if `type` is nullptr before creating filter?
                 return Attr{.col_name = "", .col_id = column_id, .type = DataTypePtr{}};
             };
-            rs_operator = FilterParser::parseDAGQuery(*query_info.dag_query, columns_to_read, std::move(create_attr_by_column_id), log);
+            rs_operator = FilterParser::parseDAGQuery(*query_info.dag_query, columns_to_read, create_attr_by_column_id, log);
+
+            /// Runtime filters generated by the hash joins that probe this table
+            if (query_info.dag_query->runtime_filter_list)
+            {
+                auto runtime_filter = DM::createRuntimeFilterOperator(query_info.dag_query->runtime_filter_list, std::move(create_attr_by_column_id));
+                rs_operator = rs_operator != DM::EMPTY_FILTER ? DM::createAnd({rs_operator, runtime_filter}) : runtime_filter;
+            }
         }
         if (likely(rs_operator != DM::EMPTY_FILTER))
             LOG_DEBUG(tracing_logger, "Rough set filter: {}", rs_operator->toDebugString());
@@ -838,6 +846,13 @@ BlockInputStreams StorageDeltaMerge::read(
 
     auto rs_operator = parseRoughSetFilter(query_info, columns_to_read, context, tracing_logger);
 
+    // The packs are answered only if they are fully matched by the rough set filter, which
+    // must not be skipped if there are filters.
+    DM::PushDownAggregationPtr push_down_aggregation;
+    if (query_info.dag_query && query_info.dag_query->push_down_aggregation
+        && (query_info.dag_query->filters.empty() || rs_operator != DM::EMPTY_FILTER))
+        push_down_aggregation = query_info.dag_query->push_down_aggregation;
+
     auto streams = store->read(
         context,
         context.getSettingsRef(),
@@ -852,7 +867,9 @@ BlockInputStreams StorageDeltaMerge::read(
         max_block_size,
         parseSegmentSet(select_query.segment_expression_list),
         extra_table_id_index,
-        scan_context);
+        scan_context,
+        query_info.dag_query ? query_info.dag_query->late_materialization_filter : nullptr,
+        push_down_aggregation);
 
     /// Ensure read_tso info after read.
     checkReadTso(mvcc_query_info.read_tso, context.getTMTContext(), context, global_context);
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <Common/FailPoint.h>
+#include <Common/ThreadManager.h>
 #include <Common/TiFlashMetrics.h>
 #include <Common/setThreadName.h>
 #include <Interpreters/Context.h>
@@ -32,7 +33,9 @@
 #include <Storages/Transaction/Types.h>
 #include <TiDB/Schema/SchemaSyncer.h>
 
+#include <condition_variable>
 #include <ext/scope_guard.h>
+#include <mutex>
 
 namespace DB
 {
@@ -287,8 +290,8 @@ std::vector<DM::ExternalDTFileInfo> KVStore::preHandleSnapshotToFiles(
 std::vector<DM::ExternalDTFileInfo> KVStore::preHandleSSTsToDTFiles(
     RegionPtr new_region,
     const SSTViewVec snaps,
-    uint64_t /*index*/,
-    uint64_t /*term*/,
+    uint64_t index,
+    uint64_t term,
     DM::FileConvertJobType job_type,
     TMTContext & tmt)
 {
@@ -308,7 +311,8 @@ std::vector<DM::ExternalDTFileInfo> KVStore::preHandleSSTsToDTFiles(
     {
         // If any schema changes is detected during decoding SSTs to DTFiles, we need to cancel and recreate DTFiles with
         // the latest schema. Or we will get trouble in `BoundedSSTFilesToBlockInputStream`.
-        std::shared_ptr<DM::SSTFilesToDTFilesOutputStream<DM::BoundedSSTFilesToBlockInputStreamPtr>> stream;
+        using SSTFilesToDTFilesOutputStreamPtr = std::shared_ptr<DM::SSTFilesToDTFilesOutputStream<DM::BoundedSSTFilesToBlockInputStreamPtr>>;
+        std::vector<SSTFilesToDTFilesOutputStreamPtr> streams;
         try
         {
             // Get storage schema atomically, will do schema sync if the storage does not exists.
@@ -333,41 +337,145 @@ std::vector<DM::ExternalDTFileInfo> KVStore::preHandleSSTsToDTFiles(
 
             auto & global_settings = context.getGlobalContext().getSettingsRef();
 
-            // Read from SSTs and refine the boundary of blocks output to DTFiles
-            auto sst_stream = std::make_shared<DM::SSTFilesToBlockInputStream>(
-                log_prefix,
-                new_region,
-                snaps,
-                proxy_helper,
-                schema_snap,
-                gc_safepoint,
-                force_decode,
-                tmt,
-                expected_block_size);
-            auto bounded_stream = std::make_shared<DM::BoundedSSTFilesToBlockInputStream>(sst_stream, ::DB::TiDBPkColumnID, schema_snap);
-            stream = std::make_shared<DM::SSTFilesToDTFilesOutputStream<DM::BoundedSSTFilesToBlockInputStreamPtr>>(
-                log_prefix,
-                bounded_stream,
-                storage,
-                schema_snap,
-                snapshot_apply_method,
-                job_type,
-                /* split_after_rows */ global_settings.dt_segment_limit_rows,
-                /* split_after_size */ global_settings.dt_segment_limit_size,
-                context);
-
-            stream->writePrefix();
-            stream->write();
-            stream->writeSuffix();
-            generated_ingest_ids = stream->outputFiles();
+            auto create_stream = [&](const DM::SSTFilesToBlockInputStreamPtr & sst_stream) {
+                // Refine the boundary of blocks output to DTFiles
+                auto bounded_stream = std::make_shared<DM::BoundedSSTFilesToBlockInputStream>(sst_stream, ::DB::TiDBPkColumnID, schema_snap);
+                auto stream = std::make_shared<DM::SSTFilesToDTFilesOutputStream<DM::BoundedSSTFilesToBlockInputStreamPtr>>(
+                    log_prefix,
+                    bounded_stream,
+                    storage,
+                    schema_snap,
+                    snapshot_apply_method,
+                    job_type,
+                    /* split_after_rows */ global_settings.dt_segment_limit_rows,
+                    /* split_after_size */ global_settings.dt_segment_limit_size,
+                    context);
+                streams.push_back(stream);
+                return stream;
+            };
+
+            const size_t prehandle_threads = global_settings.dt_snapshot_prehandle_threads;
+            if (prehandle_threads <= 1)
+            {
+                // Read from SSTs
+                auto sst_stream = std::make_shared<DM::SSTFilesToBlockInputStream>(
+                    log_prefix,
+                    new_region,
+                    snaps,
+                    proxy_helper,
+                    schema_snap,
+                    gc_safepoint,
+                    force_decode,
+                    tmt,
+                    expected_block_size);
+                auto stream = create_stream(sst_stream);
+                stream->writePrefix();
+                stream->write();
+                stream->writeSuffix();
+                generated_ingest_ids = stream->outputFiles();
+            }
+            else
+            {
+                // Split the SSTs into subranges of rowkeys, and decode and write them into separate DTFiles in parallel.
+                // The uncommitted data of each subrange is kept in a temporary region, and merged into `new_region` at last.
+                DM::SSTFilesRangeSplitter splitter(log_prefix, snaps, proxy_helper, global_settings.dt_snapshot_prehandle_subrange_keys);
+                std::vector<RegionPtr> subrange_regions;
+
+                // Limit the number of subranges buffered in memory.
+                std::mutex mutex;
+                std::condition_variable cv;
+                size_t running_tasks = 0;
+                bool has_error = false;
+                auto thread_pool = newThreadPoolManager(prehandle_threads);
+                try
+                {
+                    while (true)
+                    {
+                        {
+                            std::unique_lock lock(mutex);
+                            cv.wait(lock, [&] { return running_tasks < prehandle_threads || has_error; });
+                            if (has_error)
+                                break;
+                        }
+
+                        DM::SSTFilesToBlockInputStream::SSTReaders readers;
+                        if (!splitter.next(readers))
+                            break;
+
+                        auto subrange_region = genRegionPtr(new_region->getMetaRegion(), new_region->dumpRegionMetaSnapshot().peer.id(), index, term);
+                        subrange_regions.push_back(subrange_region);
+                        auto sst_stream = std::make_shared<DM::SSTFilesToBlockInputStream>(
+                            log_prefix,
+                            subrange_region,
+                            std::move(readers),
+                            proxy_helper,
+                            schema_snap,
+                            gc_safepoint,
+                            force_decode,
+                            tmt,
+                            expected_block_size);
+                        auto stream = create_stream(sst_stream);
+
+                        {
+                            std::lock_guard lock(mutex);
+                            ++running_tasks;
+                        }
+                        thread_pool->schedule(true, [&, stream] {
+                            bool succeed = false;
+                            SCOPE_EXIT({
+                                std::lock_guard lock(mutex);
+                                --running_tasks;
+                                has_error |= !succeed;
+                                cv.notify_one();
+                            });
+                            setThreadName("SnapPrehandle");
+                            stream->writePrefix();
+                            stream->write();
+                            stream->writeSuffix();
+                            succeed = true;
+                        });
+                    }
+                }
+                catch (...)
+                {
+                    // The running tasks refer to the local variables, wait for them before leaving.
+                    try
+                    {
+                        thread_pool->wait();
+                    }
+                    catch (...)
+                    {
+                        tryLogCurrentException(log, "Exception while prehandling the subranges of snapshot");
+                    }
+                    throw;
+                }
+                // Rethrow the first exception of the tasks if any.
+                thread_pool->wait();
+
+                // The subranges are in ascending order, so are the DTFiles.
+                for (const auto & stream : streams)
+                {
+                    auto files = stream->outputFiles();
+                    generated_ingest_ids.insert(generated_ingest_ids.end(), files.begin(), files.end());
+                }
+                for (const auto & subrange_region : subrange_regions)
+                    new_region->mergeDataFrom(*subrange_region);
+                LOG_INFO(
+                    log,
+                    "Prehandled snapshot in parallel, region={} subranges={} threads={} dt_files={}",
+                    new_region->toString(true),
+                    subrange_regions.size(),
+                    prehandle_threads,
+                    generated_ingest_ids.size());
+            }
 
             (void)table_drop_lock; // the table should not be dropped during ingesting file
             break;
         }
         catch (DB::Exception & e)
         {
-            auto try_clean_up = [&stream]() -> void {
-                if (stream != nullptr)
+            auto try_clean_up = [&streams]() -> void {
+                for (const auto & stream : streams)
                     stream->cancel();
             };
             if (e.code() == ErrorCodes::REGION_DATA_SCHEMA_UPDATED)
@@ -64,6 +64,21 @@ struct DecodingStorageSchemaSnapshot
     // the pos in the column list which is sorted by column id
     std::map<ColumnID, size_t> pk_pos_map;
 
+    // The columns decoded from the encoded value, i.e. the columns except extra handle, version and delmark, sorted by column id.
+    // The i-th column is at `pos of extra handle, version and delmark + i` in the block. Precomputed for `appendRowsToBlock`.
+    struct ValueColumnDecodeInfo
+    {
+        ColumnID column_id;
+        // pos in `column_defines`/`column_infos`
+        size_t pos;
+        bool is_nullable;
+        // the pk column of a pk_is_handle table, which is decoded from the key instead of the value
+        bool is_pk_handle;
+        // the index in `pk_column_ids` if it is a pk column of a common handle table, otherwise -1
+        Int64 common_handle_index;
+    };
+    std::vector<ValueColumnDecodeInfo> value_column_decode_plan;
+
     bool pk_is_handle;
     bool is_common_handle;
     size_t rowkey_column_size;
@@ -149,6 +164,26 @@ struct DecodingStorageSchemaSnapshot
             if (unlikely(pk_pos_iter != pk_pos_map.end()))
                 throw Exception("Cannot find all pk columns in block", ErrorCodes::LOGICAL_ERROR);
         }
+
+        for (const auto & [column_id, pos] : sorted_column_id_with_pos)
+        {
+            if (column_id == TiDBPkColumnID || column_id == VersionColumnID || column_id == DelMarkColumnID)
+                continue;
+            Int64 common_handle_index = -1;
+            if (is_common_handle)
+            {
+                auto iter = std::find(pk_column_ids.begin(), pk_column_ids.end(), column_id);
+                if (iter != pk_column_ids.end())
+                    common_handle_index = iter - pk_column_ids.begin();
+            }
+            value_column_decode_plan.push_back(ValueColumnDecodeInfo{
+                .column_id = column_id,
+                .pos = pos,
+                .is_nullable = (*column_defines)[pos].type->isNullable(),
+                .is_pk_handle = pk_is_handle && column_id == pk_column_ids[0],
+                .common_handle_index = common_handle_index,
+            });
+        }
     }
 
     DISALLOW_COPY(DecodingStorageSchemaSnapshot);
@@ -91,6 +91,13 @@ void Region::clearAllData()
     data = RegionData();
 }
 
+void Region::mergeDataFrom(const Region & other)
+{
+    std::shared_lock other_lock(other.mutex);
+    std::unique_lock lock(mutex);
+    data.mergeFrom(other.data);
+}
+
 UInt64 Region::appliedIndex() const
 {
     return meta.appliedIndex();
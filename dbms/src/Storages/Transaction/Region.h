@@ -126,6 +126,8 @@ public:
 
     // Directly drop all data in this Region object.
     void clearAllData();
+    // Merge all data of `other` into this Region object, the keys must not overlap.
+    void mergeDataFrom(const Region & other);
 
     CommittedScanner createCommittedScanner(bool use_lock = true);
     CommittedRemover createCommittedRemover(bool use_lock = true);
@@ -114,14 +114,39 @@ bool RegionBlockReader::readImpl(Block & block, const RegionDataReadInfoList & d
         }
     }
 
+    /// The values are decoded column by column in batches of rows by `appendRowsToBlock`, unless the batch contains
+    /// some rows which are not supported by it, then the values of the batch are decoded row by row.
+    std::vector<const TiKVValue::Base *> batch_values;
+    std::vector<const String *> batch_common_handles;
+    bool batch_decoded = false;
+    size_t batch_end = 0;
+
     size_t index = 0;
     for (const auto & [pk, write_type, commit_ts, value_ptr] : data_list)
     {
+        if (need_decode_value && index == batch_end)
+        {
+            batch_end = std::min(index + decode_batch_rows, data_list.size());
+            batch_values.clear();
+            batch_common_handles.clear();
+            for (size_t i = index; i < batch_end; ++i)
+            {
+                const auto & info = data_list[i];
+                batch_values.push_back(std::get<1>(info) == Region::DelFlag ? nullptr : std::get<3>(info).get());
+                if constexpr (pk_type == TMTPKType::STRING)
+                    batch_common_handles.push_back(std::get<0>(info).get());
+            }
+            auto res = appendRowsToBlock(batch_values, batch_common_handles, block, next_column_pos, schema_snapshot, force_decode);
+            if (res && !*res)
+                return false;
+            batch_decoded = res.has_value();
+        }
+
         /// set delmark and version column
         delmark_data.emplace_back(write_type == Region::DelFlag);
         version_data.emplace_back(commit_ts);
 
-        if (need_decode_value)
+        if (need_decode_value && !batch_decoded)
         {
             if (write_type == Region::DelFlag)
             {
@@ -190,9 +215,9 @@ bool RegionBlockReader::readImpl(Block & block, const RegionDataReadInfoList & d
             // For common handle, sometimes we need to decode the value from encoded key instead of encoded value
             auto * raw_extra_column = const_cast<IColumn *>((block.getByPosition(extra_handle_column_pos)).column.get());
             raw_extra_column->insertData(pk->data(), pk->size());
-            /// decode key and insert pk columns if needed
+            /// decode key and insert pk columns if needed, the pk columns have been filled if the values are decoded in batch
             size_t cursor = 0, pos = 0;
-            while (cursor < pk->size() && pos < pk_column_ids.size())
+            while (!batch_decoded && cursor < pk->size() && pos < pk_column_ids.size())
             {
                 Field value = DecodeDatum(cursor, *pk);
                 /// for a pk col, if it does not exist in the value, then decode it from the key
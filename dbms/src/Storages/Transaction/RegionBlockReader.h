@@ -42,6 +42,9 @@ private:
     bool readImpl(Block & block, const RegionDataReadInfoList & data_list, bool force_decode);
 
 private:
+    /// The number of rows decoded column by column at a time.
+    static constexpr size_t decode_batch_rows = 512;
+
     DecodingStorageSchemaSnapshotConstPtr schema_snapshot;
 };
 
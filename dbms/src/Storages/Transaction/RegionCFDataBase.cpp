@@ -202,7 +202,8 @@ size_t RegionCFDataBase<Trait>::splitInto(const RegionRange & range, RegionCFDat
             if (start_key.compare(key) <= 0 && end_key.compare(key) > 0)
             {
                 size_changed += calcTiKVKeyValueSize(it->second);
-                tar_map.insert(std::move(*it));
+                // Copy the entry, the key of an erased entry is still used for searching in RegionCFDataMap.
+                tar_map.insert(*it);
                 it = ori_map.erase(it);
             }
             else
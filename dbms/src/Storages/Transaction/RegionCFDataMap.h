@@ -0,0 +1,284 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <common/types.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace DB
+{
+/**
+ * A sorted map used by the write and default column families of a region instead of std::map.
+ *
+ * Hot regions hold lots of uncommitted rows, and the node-per-entry allocation and the pointer chasing
+ * of std::map are costly in raft apply and flush. So the entries are kept in a sorted vector, and the new
+ * entries are inserted into a small sorted write buffer first, which is merged into the vector once it is
+ * full. The limit of the buffer grows with sqrt(n), so both inserting into the buffer and the amortized
+ * merging move O(sqrt(n)) entries.
+ * Erasing an entry of the vector only marks it and releases its value. The marked entries are dropped when
+ * the buffer is merged, or when more than half of the vector is marked.
+ *
+ * The interface is the subset of std::map used by RegionCFDataBase, with some differences:
+ *   - Inserting and erasing invalidate all the iterators except the returned one.
+ *   - The key must not be modified through the iterators.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class RegionCFDataMap
+{
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+
+private:
+    template <bool is_const>
+    class IteratorImpl
+    {
+        using Container = std::conditional_t<is_const, const RegionCFDataMap, RegionCFDataMap>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = RegionCFDataMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<is_const, const value_type &, value_type &>;
+        using pointer = std::conditional_t<is_const, const value_type *, value_type *>;
+
+        IteratorImpl() = default;
+
+        template <bool other_is_const, typename = std::enable_if_t<is_const && !other_is_const>>
+        IteratorImpl(const IteratorImpl<other_is_const> & other) // NOLINT(google-explicit-constructor)
+            : container(other.container)
+            , sorted_pos(other.sorted_pos)
+            , buffer_pos(other.buffer_pos)
+            , in_sorted(other.in_sorted)
+        {}
+
+        reference operator*() const { return in_sorted ? container->sorted[sorted_pos] : container->buffer[buffer_pos]; }
+        pointer operator->() const { return &**this; }
+
+        IteratorImpl & operator++()
+        {
+            if (in_sorted)
+                sorted_pos = container->nextAlive(sorted_pos + 1);
+            else
+                ++buffer_pos;
+            settle();
+            return *this;
+        }
+
+        IteratorImpl operator++(int)
+        {
+            auto res = *this;
+            ++*this;
+            return res;
+        }
+
+        bool operator==(const IteratorImpl & other) const { return sorted_pos == other.sorted_pos && buffer_pos == other.buffer_pos; }
+        bool operator!=(const IteratorImpl & other) const { return !(*this == other); }
+
+    private:
+        friend class RegionCFDataMap;
+        template <bool>
+        friend class IteratorImpl;
+
+        /// `sorted_pos_` must point to an entry not erased, or the end of the vector.
+        IteratorImpl(Container * container_, size_t sorted_pos_, size_t buffer_pos_)
+            : container(container_)
+            , sorted_pos(sorted_pos_)
+            , buffer_pos(buffer_pos_)
+        {
+            settle();
+        }
+
+        /// Point to the smaller one of the next entries in the vector and the buffer.
+        void settle()
+        {
+            bool has_sorted = sorted_pos < container->sorted.size();
+            bool has_buffer = buffer_pos < container->buffer.size();
+            in_sorted = has_sorted && (!has_buffer || container->comp(container->sorted[sorted_pos].first, container->buffer[buffer_pos].first));
+        }
+
+        Container * container = nullptr;
+        size_t sorted_pos = 0;
+        size_t buffer_pos = 0;
+        bool in_sorted = false;
+    };
+
+public:
+    using iterator = IteratorImpl<false>;
+    using const_iterator = IteratorImpl<true>;
+
+    size_t size() const { return sorted.size() - erased_count + buffer.size(); }
+    bool empty() const { return size() == 0; }
+
+    iterator begin() { return iterator(this, nextAlive(0), 0); }
+    iterator end() { return iterator(this, sorted.size(), buffer.size()); }
+    const_iterator begin() const { return const_iterator(this, nextAlive(0), 0); }
+    const_iterator end() const { return const_iterator(this, sorted.size(), buffer.size()); }
+
+    iterator find(const Key & key)
+    {
+        auto [sorted_pos, buffer_pos, found] = lookup(key);
+        return found ? iterator(this, sorted_pos, buffer_pos) : end();
+    }
+
+    const_iterator find(const Key & key) const
+    {
+        auto [sorted_pos, buffer_pos, found] = lookup(key);
+        return found ? const_iterator(this, sorted_pos, buffer_pos) : end();
+    }
+
+    std::pair<iterator, bool> emplace(value_type && kv)
+    {
+        auto [sorted_pos, buffer_pos, found] = lookup(kv.first);
+        if (found)
+            return {iterator(this, sorted_pos, buffer_pos), false};
+
+        buffer.insert(buffer.begin() + buffer_pos, std::move(kv));
+        if (buffer.size() < bufferLimit())
+            return {iterator(this, sorted_pos, buffer_pos), true};
+
+        Key key = buffer[buffer_pos].first;
+        mergeBuffer();
+        return {find(key), true};
+    }
+
+    std::pair<iterator, bool> emplace(const value_type & kv) { return emplace(value_type(kv)); }
+
+    std::pair<iterator, bool> insert(value_type && kv) { return emplace(std::move(kv)); }
+    std::pair<iterator, bool> insert(const value_type & kv) { return emplace(kv); }
+
+    iterator erase(iterator it)
+    {
+        if (!it.in_sorted)
+        {
+            buffer.erase(buffer.begin() + it.buffer_pos);
+            return iterator(this, it.sorted_pos, it.buffer_pos);
+        }
+
+        erased[it.sorted_pos] = 1;
+        sorted[it.sorted_pos].second = Value{};
+        ++erased_count;
+        if (erased_count * 2 > sorted.size())
+            return iterator(this, compact(it.sorted_pos + 1), it.buffer_pos);
+        return iterator(this, nextAlive(it.sorted_pos + 1), it.buffer_pos);
+    }
+
+    void clear()
+    {
+        std::vector<value_type>().swap(sorted);
+        std::vector<UInt8>().swap(erased);
+        erased_count = 0;
+        buffer.clear();
+    }
+
+private:
+    static constexpr size_t min_buffer_limit = 64;
+
+    size_t bufferLimit() const { return std::max(min_buffer_limit, static_cast<size_t>(std::sqrt(sorted.size()))); }
+
+    bool equals(const Key & a, const Key & b) const { return !comp(a, b) && !comp(b, a); }
+
+    size_t nextAlive(size_t pos) const
+    {
+        while (pos < sorted.size() && erased[pos])
+            ++pos;
+        return pos;
+    }
+
+    /// Return the positions of the first entries not less than `key` in the vector and the buffer,
+    /// and whether one of them equals `key`.
+    std::tuple<size_t, size_t, bool> lookup(const Key & key) const
+    {
+        auto less = [this](const value_type & kv, const Key & k) {
+            return comp(kv.first, k);
+        };
+        size_t sorted_pos = nextAlive(std::lower_bound(sorted.begin(), sorted.end(), key, less) - sorted.begin());
+        size_t buffer_pos = std::lower_bound(buffer.begin(), buffer.end(), key, less) - buffer.begin();
+        bool found = (sorted_pos < sorted.size() && equals(sorted[sorted_pos].first, key))
+            || (buffer_pos < buffer.size() && equals(buffer[buffer_pos].first, key));
+        return {sorted_pos, buffer_pos, found};
+    }
+
+    void mergeBuffer()
+    {
+        std::vector<value_type> merged;
+        merged.reserve(sorted.size() - erased_count + buffer.size());
+        size_t pos = 0;
+        for (auto & kv : buffer)
+        {
+            for (; pos < sorted.size() && comp(sorted[pos].first, kv.first); ++pos)
+            {
+                if (!erased[pos])
+                    merged.push_back(std::move(sorted[pos]));
+            }
+            merged.push_back(std::move(kv));
+        }
+        for (; pos < sorted.size(); ++pos)
+        {
+            if (!erased[pos])
+                merged.push_back(std::move(sorted[pos]));
+        }
+
+        sorted.swap(merged);
+        erased.assign(sorted.size(), 0);
+        erased_count = 0;
+        buffer.clear();
+    }
+
+    /// Drop the erased entries of the vector, return the new position of the first entry not erased since `pos`.
+    size_t compact(size_t pos)
+    {
+        size_t new_pos = 0;
+        size_t alive = 0;
+        for (size_t i = 0; i < sorted.size(); ++i)
+        {
+            if (i == pos)
+                new_pos = alive;
+            if (erased[i])
+                continue;
+            if (i != alive)
+                sorted[alive] = std::move(sorted[i]);
+            ++alive;
+        }
+        if (pos >= sorted.size())
+            new_pos = alive;
+
+        sorted.erase(sorted.begin() + alive, sorted.end());
+        if (sorted.capacity() > 4 * sorted.size())
+            sorted.shrink_to_fit();
+        erased.assign(sorted.size(), 0);
+        erased_count = 0;
+        return new_pos;
+    }
+
+    Compare comp;
+    /// The sorted entries, the erased ones are marked in `erased`.
+    std::vector<value_type> sorted;
+    std::vector<UInt8> erased;
+    size_t erased_count = 0;
+    /// The sorted write buffer of the new entries.
+    std::vector<value_type> buffer;
+};
+
+} // namespace DB
@@ -14,13 +14,21 @@
 
 #pragma once
 
+#include <Storages/Transaction/RegionCFDataMap.h>
 #include <Storages/Transaction/TiKVRecordFormat.h>
 
-#include <map>
+#include <unordered_map>
 
 namespace DB
 {
 
+/// Allocate the key and the value of an entry of the write or default column family in one block.
+inline std::pair<std::shared_ptr<const TiKVKey>, std::shared_ptr<const TiKVValue>> makeTiKVKeyValuePtr(TiKVKey && key, TiKVValue && value)
+{
+    auto holder = std::make_shared<const std::pair<TiKVKey, TiKVValue>>(std::move(key), std::move(value));
+    return {std::shared_ptr<const TiKVKey>(holder, &holder->first), std::shared_ptr<const TiKVValue>(holder, &holder->second)};
+}
+
 struct CFKeyHasher
 {
     size_t operator()(const std::pair<HandleID, Timestamp> & k) const noexcept
@@ -36,7 +44,7 @@ struct RegionWriteCFDataTrait
     using DecodedWriteCFValue = RecordKVFormat::InnerDecodedWriteCFValue;
     using Key = std::pair<RawTiDBPK, Timestamp>;
     using Value = std::tuple<std::shared_ptr<const TiKVKey>, std::shared_ptr<const TiKVValue>, DecodedWriteCFValue>;
-    using Map = std::map<Key, Value>;
+    using Map = RegionCFDataMap<Key, Value>;
 
     static std::optional<Map::value_type> genKVPair(TiKVKey && key, const DecodedTiKVKey & raw_key, TiKVValue && value)
     {
@@ -46,9 +54,8 @@ struct RegionWriteCFDataTrait
 
         RawTiDBPK tidb_pk = RecordKVFormat::getRawTiDBPK(raw_key);
         Timestamp ts = RecordKVFormat::getTs(key);
-        return Map::value_type(Key(std::move(tidb_pk), ts),
-            Value(std::make_shared<const TiKVKey>(std::move(key)), std::make_shared<const TiKVValue>(std::move(value)),
-                std::move(*decoded_val)));
+        auto [key_ptr, value_ptr] = makeTiKVKeyValuePtr(std::move(key), std::move(value));
+        return Map::value_type(Key(std::move(tidb_pk), ts), Value(std::move(key_ptr), std::move(value_ptr), std::move(*decoded_val)));
     }
 
     static const std::shared_ptr<const TiKVValue> & getRecordRawValuePtr(const Value & value) { return std::get<2>(value).short_value; }
@@ -61,14 +68,14 @@ struct RegionDefaultCFDataTrait
 {
     using Key = std::pair<RawTiDBPK, Timestamp>;
     using Value = std::tuple<std::shared_ptr<const TiKVKey>, std::shared_ptr<const TiKVValue>>;
-    using Map = std::map<Key, Value>;
+    using Map = RegionCFDataMap<Key, Value>;
 
     static std::optional<Map::value_type> genKVPair(TiKVKey && key, const DecodedTiKVKey & raw_key, TiKVValue && value)
     {
         RawTiDBPK tidb_pk = RecordKVFormat::getRawTiDBPK(raw_key);
         Timestamp ts = RecordKVFormat::getTs(key);
-        return Map::value_type(Key(std::move(tidb_pk), ts),
-            Value(std::make_shared<const TiKVKey>(std::move(key)), std::make_shared<const TiKVValue>(std::move(value))));
+        auto [key_ptr, value_ptr] = makeTiKVKeyValuePtr(std::move(key), std::move(value));
+        return Map::value_type(Key(std::move(tidb_pk), ts), Value(std::move(key_ptr), std::move(value_ptr)));
     }
 
     static std::shared_ptr<const TiKVValue> getTiKVValue(const Map::const_iterator & it) { return std::get<1>(it->second); }
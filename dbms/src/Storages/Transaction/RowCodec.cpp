@@ -12,7 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnsNumber.h>
 #include <Columns/IColumn.h>
+#include <Common/typeid_cast.h>
 #include <IO/Endian.h>
 #include <IO/Operators.h>
 #include <Storages/Transaction/Datum.h>
@@ -648,4 +651,391 @@ bool appendRowV1ToBlock(
     return true;
 }
 
+namespace
+{
+enum class DecodeCellKind : UInt8
+{
+    // Decode the datum of length `length` at `offset` of the encoded value.
+    Datum,
+    // Insert the default value of the column type, i.e. NULL for a nullable column.
+    TypeDefault,
+    // Insert the default value of the column in the schema.
+    ColumnDefault,
+    // Insert the field at `offset` of the fields decoded from the common handles.
+    KeyField,
+};
+
+struct DecodeCell
+{
+    UInt32 offset;
+    UInt32 length;
+    DecodeCellKind kind;
+};
+
+/// The state of decoding a batch of rows. The rows are decoded in two passes: the first pass parses the header of each
+/// row and records where the datum of each column is, which follows the same logic as `appendRowV2ToBlockImpl`, the
+/// second pass decodes the datums column by column.
+struct BatchDecodeContext
+{
+    BatchDecodeContext(const DecodingStorageSchemaSnapshot & schema_, size_t rows_, bool force_decode_)
+        : schema(schema_)
+        , plan(schema_.value_column_decode_plan)
+        , rows(rows_)
+        , force_decode(force_decode_)
+        , ignore_pk_if_absent(schema_.is_common_handle || schema_.pk_is_handle)
+        , cells(plan.size() * rows_)
+        , key_fields_range(rows_, {0, 0})
+    {}
+
+    DecodeCell & cell(size_t column_index, size_t row) { return cells[column_index * rows + row]; }
+
+    const DecodingStorageSchemaSnapshot & schema;
+    const std::vector<DecodingStorageSchemaSnapshot::ValueColumnDecodeInfo> & plan;
+    const size_t rows;
+    const bool force_decode;
+    const bool ignore_pk_if_absent;
+
+    // column-major, the cells of a column are continuous
+    std::vector<DecodeCell> cells;
+
+    // The fields decoded from the common handles, only decoded for the rows whose pk columns are absent in the value.
+    std::vector<Field> key_fields;
+    std::vector<std::pair<size_t, size_t>> key_fields_range;
+
+    // reused by parsing the header of each row
+    std::vector<ColumnID> not_null_column_ids;
+    std::vector<ColumnID> null_column_ids;
+    std::vector<size_t> value_offsets;
+};
+
+std::optional<bool> planKeyField(BatchDecodeContext & ctx, size_t column_index, size_t row, const String * common_handle)
+{
+    const auto & info = ctx.plan[column_index];
+    if (info.common_handle_index < 0 || common_handle == nullptr)
+        return std::nullopt;
+
+    auto & [begin, end] = ctx.key_fields_range[row];
+    if (begin == end)
+    {
+        begin = ctx.key_fields.size();
+        size_t cursor = 0;
+        for (size_t i = 0; i < ctx.schema.pk_column_ids.size() && cursor < common_handle->size(); ++i)
+            ctx.key_fields.emplace_back(DecodeDatum(cursor, *common_handle));
+        end = ctx.key_fields.size();
+    }
+    if (static_cast<size_t>(info.common_handle_index) >= end - begin)
+        return std::nullopt;
+    ctx.cell(column_index, row) = DecodeCell{static_cast<UInt32>(begin + info.common_handle_index), 0, DecodeCellKind::KeyField};
+    return true;
+}
+
+/// Same as `addDefaultValueToColumnIfPossible`, but records the cell instead of inserting into the column.
+std::optional<bool> planMissingColumn(BatchDecodeContext & ctx, size_t column_index, size_t row, const String * common_handle)
+{
+    const auto & info = ctx.plan[column_index];
+    if (info.is_pk_handle)
+        return true;
+
+    const auto & column_info = ctx.schema.column_infos[info.pos];
+    if (column_info.hasPriKeyFlag())
+    {
+        // For clustered index, the pk column is decoded from the key.
+        if (ctx.ignore_pk_if_absent)
+            return planKeyField(ctx, column_index, row, common_handle);
+        if (!ctx.force_decode)
+            return false;
+    }
+
+    if (column_info.hasNoDefaultValueFlag() && column_info.hasNotNullFlag())
+    {
+        if (!ctx.force_decode)
+            return false;
+    }
+    ctx.cell(column_index, row) = DecodeCell{0, 0, DecodeCellKind::ColumnDefault};
+    return true;
+}
+
+template <bool is_big>
+std::optional<bool> planRowV2(BatchDecodeContext & ctx, size_t row, const TiKVValue::Base & raw_value, const String * common_handle)
+{
+    size_t cursor = 2; // Skip the initial codec ver and row flag.
+    size_t num_not_null_columns = decodeUInt<UInt16>(cursor, raw_value);
+    size_t num_null_columns = decodeUInt<UInt16>(cursor, raw_value);
+    auto & not_null_column_ids = ctx.not_null_column_ids;
+    auto & null_column_ids = ctx.null_column_ids;
+    auto & value_offsets = ctx.value_offsets;
+    not_null_column_ids.clear();
+    null_column_ids.clear();
+    value_offsets.clear();
+    decodeUInts<ColumnID, typename RowV2::Types<is_big>::ColumnIDType>(cursor, raw_value, num_not_null_columns, not_null_column_ids);
+    decodeUInts<ColumnID, typename RowV2::Types<is_big>::ColumnIDType>(cursor, raw_value, num_null_columns, null_column_ids);
+    decodeUInts<size_t, typename RowV2::Types<is_big>::ValueOffsetType>(cursor, raw_value, num_not_null_columns, value_offsets);
+    size_t values_start_pos = cursor;
+    size_t idx_not_null = 0;
+    size_t idx_null = 0;
+    size_t column_index = 0;
+    while (idx_not_null < not_null_column_ids.size() || idx_null < null_column_ids.size())
+    {
+        if (column_index == ctx.plan.size())
+        {
+            // extra column
+            return ctx.force_decode;
+        }
+
+        bool is_null;
+        if (idx_not_null < not_null_column_ids.size() && idx_null < null_column_ids.size())
+            is_null = not_null_column_ids[idx_not_null] > null_column_ids[idx_null];
+        else
+            is_null = idx_null < null_column_ids.size();
+
+        auto next_datum_column_id = is_null ? null_column_ids[idx_null] : not_null_column_ids[idx_not_null];
+        const auto & info = ctx.plan[column_index];
+        if (info.column_id > next_datum_column_id)
+        {
+            // extra column
+            if (!ctx.force_decode)
+                return false;
+        }
+        else if (info.column_id < next_datum_column_id)
+        {
+            // missing column
+            if (auto res = planMissingColumn(ctx, column_index, row, common_handle); !res || !*res)
+                return res;
+            ++column_index;
+            continue;
+        }
+        else if (!info.is_pk_handle)
+        {
+            auto & cell = ctx.cell(column_index, row);
+            if (is_null)
+            {
+                if (info.is_nullable)
+                    cell = DecodeCell{0, 0, DecodeCellKind::TypeDefault};
+                else if (!ctx.force_decode)
+                    return false;
+                else
+                    cell = DecodeCell{0, 0, DecodeCellKind::ColumnDefault};
+            }
+            else
+            {
+                size_t start = idx_not_null ? value_offsets[idx_not_null - 1] : 0;
+                size_t length = value_offsets[idx_not_null] - start;
+                cell = DecodeCell{static_cast<UInt32>(values_start_pos + start), static_cast<UInt32>(length), DecodeCellKind::Datum};
+            }
+            ++column_index;
+        }
+        else
+        {
+            ++column_index;
+        }
+
+        if (is_null)
+            idx_null++;
+        else
+            idx_not_null++;
+    }
+    for (; column_index < ctx.plan.size(); ++column_index)
+    {
+        if (auto res = planMissingColumn(ctx, column_index, row, common_handle); !res || !*res)
+            return res;
+    }
+    return true;
+}
+
+template <typename T>
+bool decodeNumberColumn(
+    ColumnVector<T> & column,
+    NullMap * null_map,
+    const DecodeCell * cells,
+    const std::vector<const TiKVValue::Base *> & raw_values,
+    bool force_decode)
+{
+    const size_t rows = raw_values.size();
+    auto & data = column.getData();
+    const size_t offset = data.size();
+    data.resize(offset + rows);
+    if (null_map)
+        null_map->resize_fill(offset + rows, 0);
+
+    for (size_t row = 0; row < rows; ++row)
+    {
+        const auto & cell = cells[row];
+        if (cell.kind == DecodeCellKind::TypeDefault)
+        {
+            data[offset + row] = T();
+            if (null_map)
+                (*null_map)[offset + row] = 1;
+            continue;
+        }
+
+        const char * pos = raw_values[row]->data() + cell.offset;
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            if (unlikely(cell.length != sizeof(Float64)))
+                throw Exception("Invalid float value length " + std::to_string(cell.length), ErrorCodes::LOGICAL_ERROR);
+            constexpr UInt64 SIGN_MASK = UInt64(1) << 63; // NOLINT(readability-identifier-naming)
+            auto num = readBigEndian<UInt64>(pos);
+            if (num & SIGN_MASK)
+                num ^= SIGN_MASK;
+            else
+                num = ~num;
+            Float64 res;
+            memcpy(&res, &num, sizeof(UInt64));
+            data[offset + row] = static_cast<T>(res);
+        }
+        else
+        {
+            if (unlikely(cell.length > sizeof(T)))
+            {
+                if (!force_decode)
+                    return false;
+                throw Exception("Detected overflow when decoding integer of length " + std::to_string(cell.length) + " with column type " + column.getName(),
+                                ErrorCodes::LOGICAL_ERROR);
+            }
+            switch (cell.length)
+            {
+            case sizeof(UInt8):
+                data[offset + row] = decodeInt<T, UInt8>(pos);
+                break;
+            case sizeof(UInt16):
+                data[offset + row] = decodeInt<T, UInt16>(pos);
+                break;
+            case sizeof(UInt32):
+                data[offset + row] = decodeInt<T, UInt32>(pos);
+                break;
+            case sizeof(UInt64):
+                data[offset + row] = decodeInt<T, UInt64>(pos);
+                break;
+            default:
+                throw Exception("Invalid integer length " + std::to_string(cell.length), ErrorCodes::LOGICAL_ERROR);
+            }
+        }
+    }
+    return true;
+}
+
+template <typename T, typename... Ts>
+std::optional<bool> tryDecodeNumberColumn(
+    IColumn & nested_column,
+    NullMap * null_map,
+    const DecodeCell * cells,
+    const std::vector<const TiKVValue::Base *> & raw_values,
+    bool force_decode)
+{
+    if (auto * column = typeid_cast<ColumnVector<T> *>(&nested_column))
+        return decodeNumberColumn(*column, null_map, cells, raw_values, force_decode);
+    if constexpr (sizeof...(Ts) > 0)
+        return tryDecodeNumberColumn<Ts...>(nested_column, null_map, cells, raw_values, force_decode);
+    else
+        return std::nullopt;
+}
+
+bool decodeColumn(
+    BatchDecodeContext & ctx,
+    size_t column_index,
+    IColumn & column,
+    const std::vector<const TiKVValue::Base *> & raw_values)
+{
+    const DecodeCell * cells = &ctx.cell(column_index, 0);
+
+    // Fast path for the number columns which only have datums and NULLs.
+    bool only_datum_or_null = std::all_of(cells, cells + ctx.rows, [](const DecodeCell & cell) {
+        return cell.kind == DecodeCellKind::Datum || cell.kind == DecodeCellKind::TypeDefault;
+    });
+    if (only_datum_or_null)
+    {
+        IColumn * nested_column = &column;
+        NullMap * null_map = nullptr;
+        if (auto * nullable_column = typeid_cast<ColumnNullable *>(&column))
+        {
+            nested_column = &nullable_column->getNestedColumn();
+            null_map = &nullable_column->getNullMapData();
+        }
+        auto res = tryDecodeNumberColumn<Int8, Int16, Int32, Int64, UInt8, UInt16, UInt32, UInt64, Float32, Float64>(
+            *nested_column,
+            null_map,
+            cells,
+            raw_values,
+            ctx.force_decode);
+        if (res)
+            return *res;
+    }
+
+    std::optional<Field> column_default;
+    for (size_t row = 0; row < ctx.rows; ++row)
+    {
+        const auto & cell = cells[row];
+        switch (cell.kind)
+        {
+        case DecodeCellKind::Datum:
+            if (!column.decodeTiDBRowV2Datum(cell.offset, *raw_values[row], cell.length, ctx.force_decode))
+                return false;
+            break;
+        case DecodeCellKind::TypeDefault:
+            column.insertDefault();
+            break;
+        case DecodeCellKind::ColumnDefault:
+            if (!column_default)
+                column_default = ctx.schema.column_infos[ctx.plan[column_index].pos].defaultValueToField();
+            column.insert(*column_default);
+            break;
+        case DecodeCellKind::KeyField:
+            column.insert(ctx.key_fields[cell.offset]);
+            break;
+        }
+    }
+    return true;
+}
+} // namespace
+
+std::optional<bool> appendRowsToBlock(
+    const std::vector<const TiKVValue::Base *> & raw_values,
+    const std::vector<const String *> & common_handles,
+    Block & block,
+    size_t block_column_pos,
+    const DecodingStorageSchemaSnapshotConstPtr & schema_snapshot,
+    bool force_decode)
+{
+    BatchDecodeContext ctx(*schema_snapshot, raw_values.size(), force_decode);
+    for (size_t row = 0; row < ctx.rows; ++row)
+    {
+        const auto * raw_value = raw_values[row];
+        const auto * common_handle = common_handles.empty() ? nullptr : common_handles[row];
+        if (raw_value == nullptr)
+        {
+            // deleted row
+            for (size_t column_index = 0; column_index < ctx.plan.size(); ++column_index)
+                ctx.cell(column_index, row) = DecodeCell{0, 0, DecodeCellKind::TypeDefault};
+            continue;
+        }
+
+        std::optional<bool> res;
+        switch (static_cast<UInt8>((*raw_value)[0]))
+        {
+        case static_cast<UInt8>(RowCodecVer::ROW_V2):
+        {
+            auto row_flag = readLittleEndian<UInt8>(&(*raw_value)[1]);
+            bool is_big = row_flag & RowV2::BigRowMask;
+            res = is_big ? planRowV2<true>(ctx, row, *raw_value, common_handle) : planRowV2<false>(ctx, row, *raw_value, common_handle);
+            break;
+        }
+        default:
+            // Row format v1 is rare, decode it row by row.
+            return std::nullopt;
+        }
+        if (!res || !*res)
+            return res;
+    }
+
+    for (size_t column_index = 0; column_index < ctx.plan.size(); ++column_index)
+    {
+        if (ctx.plan[column_index].is_pk_handle)
+            continue;
+        auto * raw_column = const_cast<IColumn *>((block.getByPosition(block_column_pos + column_index)).column.get());
+        if (!decodeColumn(ctx, column_index, *raw_column, raw_values))
+            return false;
+    }
+    return true;
+}
+
 } // namespace DB
@@ -18,6 +18,8 @@
 #include <Storages/Transaction/DecodingStorageSchemaSnapshot.h>
 #include <Storages/Transaction/TiKVKeyValue.h>
 
+#include <optional>
+
 namespace DB
 {
 /// The following two encode functions are used for testing.
@@ -33,5 +35,19 @@ bool appendRowToBlock(
     const DecodingStorageSchemaSnapshotConstPtr & schema_snapshot,
     bool force_decode);
 
+/// Decode the values of a batch of rows into the columns after `block_column_pos` of `block` column by column, with the
+/// `value_column_decode_plan` precomputed in `schema_snapshot`. The result is the same as calling `appendRowToBlock` on each row.
+/// `raw_values[i]` is nullptr if the i-th row is deleted, then its columns are filled with the default value of the column type.
+/// `common_handles[i]` is the common handle of the i-th row, only used to fill the pk columns absent in the value of a common handle table.
+/// Return std::nullopt without modifying `block` if the rows can not be decoded in batch, e.g. some rows are encoded in row format v1,
+/// then the caller should decode them by `appendRowToBlock` one by one.
+std::optional<bool> appendRowsToBlock(
+    const std::vector<const TiKVValue::Base *> & raw_values,
+    const std::vector<const String *> & common_handles,
+    Block & block,
+    size_t block_column_pos,
+    const DecodingStorageSchemaSnapshotConstPtr & schema_snapshot,
+    bool force_decode);
+
 
 } // namespace DB
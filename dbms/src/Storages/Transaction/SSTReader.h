@@ -49,6 +49,26 @@ private:
     ColumnFamilyType type;
 };
 
+/// BufferedSSTReader reads the key-values buffered in memory, which are read from SST files in advance.
+class BufferedSSTReader : public SSTReader
+{
+public:
+    using KeyValues = std::vector<std::pair<std::string, std::string>>;
+
+    explicit BufferedSSTReader(KeyValues && kvs_)
+        : kvs(std::move(kvs_))
+    {}
+
+    bool remained() const override { return pos < kvs.size(); }
+    BaseBuffView keyView() const override { return BaseBuffView{kvs[pos].first.data(), kvs[pos].first.size()}; }
+    BaseBuffView valueView() const override { return BaseBuffView{kvs[pos].second.data(), kvs[pos].second.size()}; }
+    void next() override { ++pos; }
+
+private:
+    KeyValues kvs;
+    size_t pos = 0;
+};
+
 /// MultiSSTReader helps when there are multiple sst files in a column family.
 /// It is derived from virtual class SSTReader, so it can be holded in a SSTReaderPtr.
 /// It also maintains instance of `R` which is normaly SSTReader(and MockSSTReader in tests),
@@ -40,6 +40,7 @@ enum : ColumnID
     ExtraTableIDColumnID = -3,
     VersionColumnID = -1024,
     DelMarkColumnID = -1025,
+    SegmentRowIdColumnID = -1026,
     InvalidColumnID = -10000,
 };
 
@@ -12,6 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <Common/FieldVisitors.h>
+#include <Debug/MockTiDB.h>
+#include <Debug/dbgTools.h>
+#include <Storages/DeltaMerge/File/DMFile.h>
+#include <Storages/DeltaMerge/File/DMFileBlockInputStream.h>
+#include <Storages/DeltaMerge/SSTFilesToBlockInputStream.h>
+
 #include "kvstore_helper.h"
 
 namespace DB
@@ -222,6 +229,9 @@ TEST_F(RegionKVStoreTest, KVStoreSnapshot)
             table_id = proxy_instance->bootstrap_table(ctx, kvs, ctx.getTMTContext());
             proxy_instance->bootstrap(kvs, ctx.getTMTContext(), region_id);
         }
+        SCOPE_EXIT({
+            proxy_instance->clear_tables(ctx, getKVS(), ctx.getTMTContext());
+        });
         {
             KVStore & kvs = getKVS();
             auto kvr1 = kvs.getRegion(region_id);
@@ -369,5 +379,202 @@ TEST_F(RegionKVStoreTest, KVStoreSnapshot)
     }
 }
 
+TEST_F(RegionKVStoreTest, SnapshotSubrangeSplitter)
+{
+    const TableID table_id = 100;
+    const String write_sst = "subrange_write", default_sst = "subrange_default", lock_sst = "subrange_lock";
+    {
+        MockSSTReader::Data write_kvs, default_kvs, lock_kvs;
+        for (HandleID handle = 0; handle < 30; ++handle)
+        {
+            // The versions of a rowkey are sorted by timestamp desc in SST files.
+            const Timestamp versions = handle % 3 + 1;
+            for (Timestamp v = versions; v > 0; --v)
+            {
+                const Timestamp start_ts = handle * 10 + v * 2;
+                write_kvs.emplace_back(RecordKVFormat::genKey(table_id, handle, start_ts + 1), RecordKVFormat::encodeWriteCfValue(Region::PutFlag, start_ts));
+                default_kvs.emplace_back(RecordKVFormat::genKey(table_id, handle, start_ts), "v");
+            }
+            if (handle % 4 == 0)
+                lock_kvs.emplace_back(RecordKVFormat::genKey(table_id, handle), "lock");
+        }
+        // The rowkeys after the last write CF key belong to the last subrange.
+        default_kvs.emplace_back(RecordKVFormat::genKey(table_id, 100, 1000), "v");
+        lock_kvs.emplace_back(RecordKVFormat::genKey(table_id, 100), "lock");
+
+        MockSSTReader::getMockSSTData().clear();
+        MockSSTReader::getMockSSTData()[MockSSTReader::Key{write_sst, ColumnFamilyType::Write}] = std::move(write_kvs);
+        MockSSTReader::getMockSSTData()[MockSSTReader::Key{default_sst, ColumnFamilyType::Default}] = std::move(default_kvs);
+        MockSSTReader::getMockSSTData()[MockSSTReader::Key{lock_sst, ColumnFamilyType::Lock}] = std::move(lock_kvs);
+    }
+    auto expected_keys = [](const String & sst, ColumnFamilyType cf) {
+        std::vector<String> keys;
+        for (const auto & kv : MockSSTReader::getMockSSTData()[MockSSTReader::Key{sst, cf}])
+            keys.push_back(kv.first);
+        return keys;
+    };
+    const auto expected_write_keys = expected_keys(write_sst, ColumnFamilyType::Write);
+    const auto expected_default_keys = expected_keys(default_sst, ColumnFamilyType::Default);
+    const auto expected_lock_keys = expected_keys(lock_sst, ColumnFamilyType::Lock);
+
+    proxy_helper->sst_reader_interfaces = make_mock_sst_reader_interface();
+    std::vector<SSTView> sst_views{
+        SSTView{ColumnFamilyType::Write, BaseBuffView{write_sst.data(), write_sst.size()}},
+        SSTView{ColumnFamilyType::Default, BaseBuffView{default_sst.data(), default_sst.size()}},
+        SSTView{ColumnFamilyType::Lock, BaseBuffView{lock_sst.data(), lock_sst.size()}},
+    };
+    SSTViewVec snaps{sst_views.data(), sst_views.size()};
+    DM::SSTFilesRangeSplitter splitter("[SnapshotSubrangeSplitter]", snaps, proxy_helper.get(), /*write_cf_keys_per_subrange*/ 4);
+
+    auto rowkey_of = [](const BaseBuffView & key, bool with_ts) {
+        return String(key.data, with_ts ? key.len - sizeof(Timestamp) : key.len);
+    };
+    // rowkey -> index of the subrange
+    std::map<String, size_t> write_subranges;
+    std::vector<std::pair<String, size_t>> other_subranges;
+    std::vector<String> write_keys, default_keys, lock_keys;
+    size_t subrange = 0;
+    DM::SSTFilesToBlockInputStream::SSTReaders readers;
+    for (; splitter.next(readers); ++subrange)
+    {
+        for (auto & reader = *readers.write_cf; reader.remained(); reader.next())
+        {
+            auto key = reader.keyView();
+            // All the versions of a rowkey are in the same subrange.
+            auto [iter, inserted] = write_subranges.emplace(rowkey_of(key, true), subrange);
+            ASSERT_EQ(iter->second, subrange);
+            write_keys.emplace_back(key.data, key.len);
+        }
+        for (auto & reader = *readers.default_cf; reader.remained(); reader.next())
+        {
+            auto key = reader.keyView();
+            other_subranges.emplace_back(rowkey_of(key, true), subrange);
+            default_keys.emplace_back(key.data, key.len);
+        }
+        for (auto & reader = *readers.lock_cf; reader.remained(); reader.next())
+        {
+            auto key = reader.keyView();
+            other_subranges.emplace_back(rowkey_of(key, false), subrange);
+            lock_keys.emplace_back(key.data, key.len);
+        }
+    }
+    ASSERT_GT(subrange, 1UL);
+
+    // The default and lock CF keys are in the same subrange as the write CF key of the same rowkey.
+    for (const auto & [rowkey, subrange_of_key] : other_subranges)
+    {
+        if (auto iter = write_subranges.find(rowkey); iter != write_subranges.end())
+            ASSERT_EQ(subrange_of_key, iter->second);
+        else
+            ASSERT_EQ(subrange_of_key, subrange - 1);
+    }
+    // No key-value is lost or reordered.
+    ASSERT_EQ(write_keys, expected_write_keys);
+    ASSERT_EQ(default_keys, expected_default_keys);
+    ASSERT_EQ(lock_keys, expected_lock_keys);
+}
+
+TEST_F(RegionKVStoreTest, SnapshotPrehandleInParallel)
+{
+    auto ctx = TiFlashTestEnv::getGlobalContext();
+    UInt64 region_id = 1;
+    initStorages();
+    KVStore & kvs = getKVS();
+    TableID table_id = proxy_instance->bootstrap_table(ctx, kvs, ctx.getTMTContext());
+    SCOPE_EXIT({
+        proxy_instance->clear_tables(ctx, kvs, ctx.getTMTContext());
+    });
+    const auto table_info = MockTiDB::instance().getTableByName("d", "t")->table_info;
+
+    const String write_sst = "prehandle_write", default_sst = "prehandle_default", lock_sst = "prehandle_lock";
+    {
+        MockSSTReader::Data write_kvs, default_kvs, lock_kvs;
+        auto encode_row = [&](Int64 value) {
+            WriteBufferFromOwnString ss;
+            RegionBench::encodeRow(table_info, {Field(value)}, ss);
+            return ss.releaseStr();
+        };
+        for (HandleID handle = 0; handle < 300; ++handle)
+        {
+            // Some rowkeys have an uncommitted version, which is newer than the committed versions.
+            if (handle % 7 == 0)
+            {
+                const Timestamp start_ts = handle * 10 + 9;
+                default_kvs.emplace_back(RecordKVFormat::genKey(table_id, handle, start_ts), encode_row(-handle));
+                lock_kvs.emplace_back(RecordKVFormat::genKey(table_id, handle), RecordKVFormat::encodeLockCfValue(Region::PutFlag, "PK", start_ts, 20));
+            }
+            for (Timestamp v = handle % 3 + 1; v > 0; --v)
+            {
+                const Timestamp start_ts = handle * 10 + v * 2;
+                write_kvs.emplace_back(RecordKVFormat::genKey(table_id, handle, start_ts + 1), RecordKVFormat::encodeWriteCfValue(Region::PutFlag, start_ts));
+                default_kvs.emplace_back(RecordKVFormat::genKey(table_id, handle, start_ts), encode_row(static_cast<Int64>(start_ts)));
+            }
+        }
+        MockSSTReader::getMockSSTData().clear();
+        MockSSTReader::getMockSSTData()[MockSSTReader::Key{write_sst, ColumnFamilyType::Write}] = std::move(write_kvs);
+        MockSSTReader::getMockSSTData()[MockSSTReader::Key{default_sst, ColumnFamilyType::Default}] = std::move(default_kvs);
+        MockSSTReader::getMockSSTData()[MockSSTReader::Key{lock_sst, ColumnFamilyType::Lock}] = std::move(lock_kvs);
+    }
+    std::vector<SSTView> sst_views{
+        SSTView{ColumnFamilyType::Write, BaseBuffView{write_sst.data(), write_sst.size()}},
+        SSTView{ColumnFamilyType::Default, BaseBuffView{default_sst.data(), default_sst.size()}},
+        SSTView{ColumnFamilyType::Lock, BaseBuffView{lock_sst.data(), lock_sst.size()}},
+    };
+    SSTViewVec snaps{sst_views.data(), sst_views.size()};
+    kvs.mutProxyHelperUnsafe()->sst_reader_interfaces = make_mock_sst_reader_interface();
+
+    auto settings_backup = ctx.getGlobalContext().getSettings();
+    SCOPE_EXIT({
+        ctx.getGlobalContext().setSettings(settings_backup);
+    });
+
+    // Prehandle the snapshot, and return the serialized region and the rows in the generated DTFiles.
+    auto prehandle = [&](size_t threads) {
+        auto & settings = ctx.getGlobalContext().getSettingsRef();
+        settings.dt_snapshot_prehandle_threads = threads;
+        settings.dt_snapshot_prehandle_subrange_keys = 50;
+
+        auto region = makeRegion(region_id, RecordKVFormat::genKey(table_id, 0), RecordKVFormat::genKey(table_id, 1000));
+        auto ingest_ids = kvs.preHandleSnapshotToFiles(region, snaps, 6, 6, ctx.getTMTContext());
+
+        WriteBufferFromOwnString region_buf;
+        region->serialize(region_buf);
+
+        auto storage = std::dynamic_pointer_cast<StorageDeltaMerge>(ctx.getTMTContext().getStorages().get(table_id));
+        const auto & store = storage->getStore();
+        auto delegate = store->path_pool->getStableDiskDelegator();
+        std::vector<String> rows;
+        for (const auto & ingest_id : ingest_ids)
+        {
+            auto file = DM::DMFile::restore(ctx.getFileProvider(), ingest_id.id, ingest_id.id, delegate.getDTFilePath(ingest_id.id), DM::DMFile::ReadMetaMode::all());
+            auto stream = DM::DMFileBlockInputStreamBuilder(ctx).build(
+                file,
+                *store->getStoreColumns(),
+                DM::RowKeyRanges{DM::RowKeyRange::newAll(false, 1)},
+                std::make_shared<DM::ScanContext>());
+            while (Block block = stream->read())
+            {
+                for (size_t i = 0; i < block.rows(); ++i)
+                {
+                    String row;
+                    for (const auto & column : block)
+                        row += applyVisitor(FieldVisitorToString(), (*column.column)[i]) + ",";
+                    rows.push_back(std::move(row));
+                }
+            }
+        }
+        return std::make_tuple(region_buf.releaseStr(), region->dataSize(), rows);
+    };
+
+    auto [region_single, data_size_single, rows_single] = prehandle(1);
+    auto [region_parallel, data_size_parallel, rows_parallel] = prehandle(4);
+    // The uncommitted data is kept in the region.
+    ASSERT_GT(data_size_single, 0UL);
+    ASSERT_EQ(data_size_parallel, data_size_single);
+    ASSERT_EQ(region_parallel, region_single);
+    ASSERT_FALSE(rows_single.empty());
+    ASSERT_EQ(rows_parallel, rows_single);
+}
+
 } // namespace tests
 } // namespace DB
@@ -339,6 +339,24 @@ TEST_F(RegionBlockReaderTest, CommonHandle)
     ASSERT_TRUE(decodeAndCheckColumns(decoding_schema, true));
 }
 
+TEST_F(RegionBlockReaderTest, MultipleBatches)
+{
+    // More rows than a batch, and the last batch contains rows in row format v1 which are decoded row by row.
+    for (const auto & handle_ids : std::vector<ColumnIDs>{{EXTRA_HANDLE_COLUMN_ID}, {2}, {2, 3, 4}})
+    {
+        SetUp();
+        rows = 1000;
+        bool is_common_handle = handle_ids.size() > 1;
+        auto [table_info, fields] = getNormalTableInfoFields(handle_ids, is_common_handle);
+        encodeColumns(table_info, fields, RowEncodeVersion::RowV2);
+        encodeColumns(table_info, fields, RowEncodeVersion::RowV1);
+        rows = data_list_read.size();
+        auto decoding_schema = getDecodingStorageSchemaSnapshot(table_info);
+        ASSERT_TRUE(decodeAndCheckColumns(decoding_schema, false));
+        ASSERT_TRUE(decodeAndCheckColumns(decoding_schema, true));
+    }
+}
+
 TEST_F(RegionBlockReaderTest, MissingColumnRowV2)
 {
     auto [table_info, fields] = getNormalTableInfoFields({EXTRA_HANDLE_COLUMN_ID}, false);
@@ -0,0 +1,116 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <Storages/Transaction/RegionCFDataMap.h>
+#include <TestUtils/TiFlashTestBasic.h>
+
+#include <map>
+#include <random>
+
+namespace DB::tests
+{
+namespace
+{
+using TestMap = RegionCFDataMap<UInt64, std::shared_ptr<UInt64>>;
+
+void assertSameAs(const TestMap & map, const std::map<UInt64, UInt64> & expected)
+{
+    ASSERT_EQ(map.size(), expected.size());
+    auto it = map.begin();
+    for (const auto & [key, value] : expected)
+    {
+        ASSERT_TRUE(it != map.end());
+        ASSERT_EQ(it->first, key);
+        ASSERT_EQ(*it->second, value);
+        ++it;
+    }
+    ASSERT_TRUE(it == map.end());
+}
+} // namespace
+
+TEST(RegionCFDataMapTest, Basic)
+{
+    TestMap map;
+    ASSERT_TRUE(map.empty());
+    ASSERT_TRUE(map.begin() == map.end());
+
+    ASSERT_TRUE(map.emplace({3, std::make_shared<UInt64>(30)}).second);
+    ASSERT_TRUE(map.emplace({1, std::make_shared<UInt64>(10)}).second);
+    auto [it, ok] = map.emplace({2, std::make_shared<UInt64>(20)});
+    ASSERT_TRUE(ok);
+    ASSERT_EQ(it->first, 2);
+
+    // Duplicated key is not inserted.
+    auto [dup_it, dup_ok] = map.emplace({2, std::make_shared<UInt64>(200)});
+    ASSERT_FALSE(dup_ok);
+    ASSERT_EQ(*dup_it->second, 20);
+    assertSameAs(map, {{1, 10}, {2, 20}, {3, 30}});
+
+    ASSERT_TRUE(map.find(4) == map.end());
+    it = map.erase(map.find(2));
+    ASSERT_EQ(it->first, 3);
+    ASSERT_TRUE(map.find(2) == map.end());
+    assertSameAs(map, {{1, 10}, {3, 30}});
+
+    map.clear();
+    ASSERT_TRUE(map.empty());
+}
+
+TEST(RegionCFDataMapTest, Random)
+{
+    // Enough entries to cover merging the write buffer and compacting the erased entries.
+    TestMap map;
+    std::map<UInt64, UInt64> expected;
+    std::mt19937_64 rand_gen(42);
+    for (size_t round = 0; round < 20; ++round)
+    {
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            UInt64 key = rand_gen() % 5000;
+            auto [it, ok] = map.emplace({key, std::make_shared<UInt64>(key * 2)});
+            ASSERT_EQ(ok, expected.emplace(key, key * 2).second);
+            ASSERT_EQ(it->first, key);
+        }
+        assertSameAs(map, expected);
+
+        // Erase some entries while iterating, like `Region::tryCompactionFilter`.
+        const UInt64 mod = round % 3 + 2;
+        for (auto it = map.begin(); it != map.end();)
+        {
+            if (it->first % mod == 0)
+            {
+                expected.erase(it->first);
+                it = map.erase(it);
+            }
+            else
+                ++it;
+        }
+        assertSameAs(map, expected);
+
+        for (size_t i = 0; i < 500; ++i)
+        {
+            UInt64 key = rand_gen() % 5000;
+            auto it = map.find(key);
+            ASSERT_EQ(it != map.end(), expected.count(key) > 0);
+            if (it != map.end())
+            {
+                map.erase(it);
+                expected.erase(key);
+            }
+        }
+        assertSameAs(map, expected);
+    }
+}
+
+} // namespace DB::tests
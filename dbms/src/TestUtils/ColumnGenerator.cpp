@@ -11,6 +11,9 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+#include <Columns/ColumnNullable.h>
+#include <Columns/ColumnsNumber.h>
+#include <DataTypes/DataTypeNullable.h>
 #include <TestUtils/ColumnGenerator.h>
 
 namespace DB::tests
@@ -24,6 +27,22 @@ ColumnWithTypeAndName ColumnGenerator::generate(const ColumnGeneratorOpts & opts
     else
         type = DataTypeFactory::instance().get(opts.type_name);
 
+    if (type->isNullable())
+    {
+        auto nested_opts = opts;
+        nested_opts.type_name = removeNullable(type)->getName();
+        auto nested = generate(nested_opts);
+
+        std::bernoulli_distribution null_rand_gen(opts.null_ratio);
+        auto null_map = ColumnUInt8::create(opts.size, 0);
+        for (auto & is_null : null_map->getData())
+            is_null = null_rand_gen(rand_gen);
+        return {ColumnNullable::create(nested.column, std::move(null_map)), makeNullable(nested.type)};
+    }
+
+    cardinality = opts.cardinality;
+    string_size = opts.string_max_size;
+
     auto col = type->createColumn();
     col->reserve(opts.size);
 
@@ -84,8 +103,16 @@ DataTypePtr ColumnGenerator::createDecimalType()
     return DB::createDecimal(prec, scale);
 }
 
+UInt64 ColumnGenerator::randomValue()
+{
+    return cardinality == 0 ? rand_gen() : rand_gen() % cardinality;
+}
+
 String ColumnGenerator::randomString()
 {
+    if (cardinality != 0)
+        return fmt::format("{:0>{}}", randomValue(), string_size);
+
     String str(int_rand_gen(rand_gen), 0);
     std::generate_n(str.begin(), str.size(), [this]() { return charset[rand_gen() % charset.size()]; });
     return str;
@@ -140,13 +167,13 @@ String ColumnGenerator::randomDecimal(uint64_t prec, uint64_t scale)
 
 void ColumnGenerator::genInt(MutableColumnPtr & col)
 {
-    Field f = static_cast<Int64>(rand_gen());
+    Field f = static_cast<Int64>(randomValue());
     col->insert(f);
 }
 
 void ColumnGenerator::genUInt(MutableColumnPtr & col)
 {
-    Field f = static_cast<UInt64>(rand_gen());
+    Field f = static_cast<UInt64>(randomValue());
     col->insert(f);
 }
 
@@ -34,6 +34,11 @@ struct ColumnGeneratorOpts
     String type_name;
     DataDistribution distribution;
     size_t string_max_size = 128;
+    /// The number of distinct values of integers and strings, 0 means not limited.
+    /// The strings are fixed to `string_max_size` bytes if it is limited.
+    size_t cardinality = 0;
+    /// The ratio of null values, only used for nullable types like "Nullable(Int64)".
+    double null_ratio = 0;
 };
 
 class ColumnGenerator : public ext::Singleton<ColumnGenerator>
@@ -43,10 +48,13 @@ public:
 
 private:
     std::mt19937_64 rand_gen;
+    size_t cardinality = 0;
+    size_t string_size = 0;
     std::uniform_int_distribution<Int64> int_rand_gen = std::uniform_int_distribution<Int64>(0, 128);
     std::uniform_real_distribution<double> real_rand_gen;
     const std::string charset{"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz!@#$%^&*()、｜【】[]{}「」；：:;'‘,<《.>》。？·～`~"};
 
+    UInt64 randomValue();
     String randomString();
     int randomTimeOffset();
     time_t randomUTCTimestamp();
@@ -16,6 +16,7 @@
 #include <Common/FmtUtils.h>
 #include <Debug/MockComputeServerManager.h>
 #include <Flash/Coprocessor/DAGQuerySource.h>
+#include <Flash/Pipeline/Schedule/TaskScheduler.h>
 #include <Flash/executeQuery.h>
 #include <TestUtils/ExecutorTestUtils.h>
 #include <TestUtils/executorSerializer.h>
@@ -82,6 +83,12 @@ void ExecutorTest::SetUpTestCase()
     register_func(DB::registerFunctions);
     register_func(DB::registerAggregateFunctions);
     register_func(DB::registerWindowFunctions);
+
+    if (!TaskScheduler::instance)
+    {
+        TaskSchedulerConfig config{8, 8};
+        TaskScheduler::instance = std::make_unique<TaskScheduler>(config);
+    }
 }
 
 void ExecutorTest::initializeClientInfo()
@@ -107,41 +114,52 @@ void ExecutorTest::executeExecutor(
     std::function<::testing::AssertionResult(const ColumnsWithTypeAndName &)> assert_func)
 {
     WRAP_FOR_DIS_ENABLE_PLANNER_BEGIN
-    std::vector<size_t> concurrencies{1, 2, 10};
-    for (auto concurrency : concurrencies)
+    // The pipeline model only works with the planner.
+    std::vector<bool> enable_pipelines{false};
+    if (enable_planner)
+        enable_pipelines.push_back(true);
+    for (auto enable_pipeline : enable_pipelines)
     {
-        std::vector<size_t> block_sizes{1, 2, DEFAULT_BLOCK_SIZE};
-        for (auto block_size : block_sizes)
+        enablePipeline(enable_pipeline);
+        std::vector<size_t> concurrencies{1, 2, 10};
+        for (auto concurrency : concurrencies)
         {
-            context.context.setSetting("max_block_size", Field(static_cast<UInt64>(block_size)));
-            auto res = executeStreams(request, concurrency);
-            auto test_info_msg = [&]() {
-                const auto & test_info = testing::UnitTest::GetInstance()->current_test_info();
-                assert(test_info);
-                return fmt::format(
-                    "test info:\n"
-                    "    file: {}\n"
-                    "    line: {}\n"
-                    "    test_case_name: {}\n"
-                    "    test_func_name: {}\n"
-                    "    enable_planner: {}\n"
-                    "    concurrency: {}\n"
-                    "    block_size: {}\n"
-                    "    dag_request: \n{}"
-                    "    result_block: \n{}",
-                    test_info->file(),
-                    test_info->line(),
-                    test_info->test_case_name(),
-                    test_info->name(),
-                    enable_planner,
-                    concurrency,
-                    block_size,
-                    ExecutorSerializer().serialize(request.get()),
-                    getColumnsContent(res));
-            };
-            ASSERT_TRUE(assert_func(res)) << test_info_msg();
+            std::vector<size_t> block_sizes{1, 2, DEFAULT_BLOCK_SIZE};
+            for (auto block_size : block_sizes)
+            {
+                context.context.setSetting("max_block_size", Field(static_cast<UInt64>(block_size)));
+                auto res = executeStreams(request, concurrency);
+                auto test_info_msg = [&]() {
+                    const auto & test_info = testing::UnitTest::GetInstance()->current_test_info();
+                    assert(test_info);
+                    return fmt::format(
+                        "test info:\n"
+                        "    file: {}\n"
+                        "    line: {}\n"
+                        "    test_case_name: {}\n"
+                        "    test_func_name: {}\n"
+                        "    enable_planner: {}\n"
+                        "    enable_pipeline: {}\n"
+                        "    concurrency: {}\n"
+                        "    block_size: {}\n"
+                        "    dag_request: \n{}"
+                        "    result_block: \n{}",
+                        test_info->file(),
+                        test_info->line(),
+                        test_info->test_case_name(),
+                        test_info->name(),
+                        enable_planner,
+                        enable_pipeline,
+                        concurrency,
+                        block_size,
+                        ExecutorSerializer().serialize(request.get()),
+                        getColumnsContent(res));
+                };
+                ASSERT_TRUE(assert_func(res)) << test_info_msg();
+            }
         }
     }
+    enablePipeline(false);
     WRAP_FOR_DIS_ENABLE_PLANNER_END
 }
 
@@ -222,6 +240,11 @@ void ExecutorTest::enablePlanner(bool is_enable)
     context.context.setSetting("enable_planner", is_enable ? "true" : "false");
 }
 
+void ExecutorTest::enablePipeline(bool is_enable)
+{
+    context.context.setSetting("enable_pipeline", is_enable ? "true" : "false");
+}
+
 DB::ColumnsWithTypeAndName ExecutorTest::executeStreams(const std::shared_ptr<tipb::DAGRequest> & request, size_t concurrency)
 {
     DAGContext dag_context(*request, "executor_test", concurrency);
@@ -65,6 +65,8 @@ public:
 
     void enablePlanner(bool is_enable);
 
+    void enablePipeline(bool is_enable);
+
     static void dagRequestEqual(const String & expected_string, const std::shared_ptr<tipb::DAGRequest> & actual);
 
     void executeInterpreter(const String & expected_string, const std::shared_ptr<tipb::DAGRequest> & request, size_t concurrency);
@@ -15,6 +15,8 @@
 #include <TestUtils/ColumnGenerator.h>
 #include <TestUtils/TiFlashTestBasic.h>
 
+#include <set>
+
 namespace DB
 {
 namespace tests
@@ -32,6 +34,37 @@ try
 }
 CATCH
 
+TEST(TestColumnGenerator, CardinalityAndNull)
+try
+{
+    size_t rows = 10000;
+    auto int_column = ColumnGenerator::instance().generate({rows, "Int64", RANDOM, 128, /*cardinality=*/10}).column;
+    std::set<Int64> distinct_ints;
+    for (size_t i = 0; i < rows; ++i)
+        distinct_ints.insert(int_column->getInt(i));
+    ASSERT_LE(distinct_ints.size(), 10);
+
+    auto str_column = ColumnGenerator::instance().generate({rows, "String", RANDOM, 16, /*cardinality=*/100}).column;
+    std::set<String> distinct_strs;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        auto str = str_column->getDataAt(i).toString();
+        ASSERT_EQ(str.size(), 16);
+        distinct_strs.insert(str);
+    }
+    ASSERT_LE(distinct_strs.size(), 100);
+
+    auto nullable = ColumnGenerator::instance().generate({rows, "Nullable(Int64)", RANDOM, 128, 0, /*null_ratio=*/0.5});
+    ASSERT_TRUE(nullable.type->isNullable());
+    ASSERT_EQ(nullable.column->size(), rows);
+    size_t nulls = 0;
+    for (size_t i = 0; i < rows; ++i)
+        nulls += nullable.column->isNullAt(i);
+    ASSERT_GT(nulls, rows / 4);
+    ASSERT_LT(nulls, rows * 3 / 4);
+}
+CATCH
+
 } // namespace tests
 
 } // namespace DB
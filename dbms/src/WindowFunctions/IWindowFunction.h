@@ -18,12 +18,24 @@
 #include <Core/Field.h>
 #include <Core/Types.h>
 #include <DataTypes/IDataType.h>
+#include <Storages/Transaction/Collator.h>
+
+#include <memory>
 
 
 namespace DB
 {
 struct WindowTransformAction;
 
+// The runtime state of a window function. The window function is shared by all the window streams,
+// so every `WindowTransformAction` holds its own states, see `IWindowFunction::createState`.
+struct IWindowFunctionState
+{
+    virtual ~IWindowFunctionState() = default;
+};
+
+using WindowFunctionStatePtr = std::unique_ptr<IWindowFunctionState>;
+
 class IWindowFunction
 {
 public:
@@ -43,6 +55,11 @@ public:
         const ColumnNumbers & arguments)
         = 0;
 
+    // Return nullptr if the function doesn't need a state across rows, like rank and row_number.
+    virtual WindowFunctionStatePtr createState() const { return nullptr; }
+
+    virtual void setCollators(TiDB::TiDBCollators &) {}
+
 protected:
     DataTypes argument_types;
 };
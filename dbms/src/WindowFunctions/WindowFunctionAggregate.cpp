@@ -0,0 +1,394 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <AggregateFunctions/AggregateFunctionFactory.h>
+#include <Columns/ColumnNullable.h>
+#include <Common/Arena.h>
+#include <Common/assert_cast.h>
+#include <DataStreams/WindowBlockInputStream.h>
+#include <DataTypes/DataTypeNullable.h>
+#include <WindowFunctions/WindowFunctionAggregate.h>
+#include <WindowFunctions/WindowFunctionFactory.h>
+
+#include <deque>
+#include <ext/scope_guard.h>
+
+namespace DB
+{
+namespace
+{
+/// Allocates the aggregate states of one window stream, and the freed states are reused.
+class AggregateStatePool : private boost::noncopyable
+{
+public:
+    explicit AggregateStatePool(const AggregateFunctionPtr & function_)
+        : function(function_)
+        , arena(std::make_unique<Arena>())
+    {}
+
+    AggregateDataPtr alloc()
+    {
+        AggregateDataPtr place;
+        if (free_places.empty())
+        {
+            place = arena->alignedAlloc(function->sizeOfData(), function->alignOfData());
+        }
+        else
+        {
+            place = free_places.back();
+            free_places.pop_back();
+        }
+        function->create(place);
+        return place;
+    }
+
+    void free(AggregateDataPtr place)
+    {
+        if (!function->hasTrivialDestructor())
+            function->destroy(place);
+        free_places.push_back(place);
+    }
+
+    /// The functions like min/max of strings keep the data in the arena, which can not be freed
+    /// state by state, so the arena is dropped when all the states are freed and it has grown.
+    void shrink()
+    {
+        if (arena->size() > initial_arena_size)
+        {
+            free_places.clear();
+            arena = std::make_unique<Arena>(initial_arena_size);
+        }
+    }
+
+    Arena * getArena() { return arena.get(); }
+
+private:
+    static constexpr size_t initial_arena_size = 4096;
+
+    AggregateFunctionPtr function;
+    std::unique_ptr<Arena> arena;
+    std::vector<AggregateDataPtr> free_places;
+};
+
+/// The states of the rows of a partition, organized as a segment tree: the node `i` of level `l` is
+/// the state of the rows [i << l, (i + 1) << l). The rows are appended in order, and the parent is
+/// built when its right child is appended, so the state of any range of rows is merged from O(log n)
+/// nodes. The nodes only covering the rows before the frame start are freed, so the memory is bounded
+/// by the frame size instead of the partition size.
+class AggregateSegmentTree : private boost::noncopyable
+{
+public:
+    AggregateSegmentTree(const AggregateFunctionPtr & function_, AggregateStatePool & pool_)
+        : function(function_)
+        , pool(pool_)
+    {}
+
+    ~AggregateSegmentTree()
+    {
+        clear();
+    }
+
+    /// `columns` is nullptr if the arguments of the row contain NULL, then the leaf is an empty state.
+    void append(const IColumn ** columns, size_t row)
+    {
+        AggregateDataPtr leaf = pool.alloc();
+        if (columns)
+            function->add(leaf, columns, row, pool.getArena());
+        push(0, leaf);
+        ++rows;
+    }
+
+    /// Merge the states of the rows [begin, end) into `place`.
+    void merge(size_t begin, size_t end, AggregateDataPtr place) const
+    {
+        assert(end <= rows);
+        for (size_t level = 0; begin < end; ++level, begin >>= 1, end >>= 1)
+        {
+            if (begin & 1)
+                mergeNode(level, begin++, place);
+            if (end & 1)
+                mergeNode(level, --end, place);
+        }
+    }
+
+    /// The rows before `begin` will never be merged again.
+    void discardBefore(size_t begin)
+    {
+        for (size_t level = 0; level < levels.size(); ++level)
+        {
+            auto & cur = levels[level];
+            while (!cur.nodes.empty() && ((cur.first + 1) << level) <= begin)
+            {
+                if (cur.nodes.front())
+                    pool.free(cur.nodes.front());
+                cur.nodes.pop_front();
+                ++cur.first;
+            }
+        }
+    }
+
+    void clear()
+    {
+        for (auto & level : levels)
+        {
+            for (auto node : level.nodes)
+            {
+                if (node)
+                    pool.free(node);
+            }
+        }
+        levels.clear();
+        rows = 0;
+    }
+
+    size_t size() const { return rows; }
+
+private:
+    struct Level
+    {
+        std::deque<AggregateDataPtr> nodes;
+        // The index of `nodes.front()`.
+        size_t first = 0;
+    };
+
+    void push(size_t level, AggregateDataPtr node)
+    {
+        if (levels.size() == level)
+            levels.emplace_back();
+        auto & cur = levels[level];
+        const size_t index = cur.first + cur.nodes.size();
+        cur.nodes.push_back(node);
+        if (index % 2 == 0)
+            return;
+
+        // If the left sibling is discarded, the parent covers some discarded rows and will never be
+        // merged, but it is still pushed as a placeholder to keep the indexes of its level.
+        AggregateDataPtr parent = nullptr;
+        if (node && index - 1 >= cur.first && cur.nodes[index - 1 - cur.first])
+        {
+            parent = pool.alloc();
+            function->merge(parent, cur.nodes[index - 1 - cur.first], pool.getArena());
+            function->merge(parent, node, pool.getArena());
+        }
+        push(level + 1, parent);
+    }
+
+    void mergeNode(size_t level, size_t index, AggregateDataPtr place) const
+    {
+        const auto & cur = levels[level];
+        assert(index >= cur.first && index - cur.first < cur.nodes.size());
+        AggregateDataPtr node = cur.nodes[index - cur.first];
+        assert(node);
+        function->merge(place, node, pool.getArena());
+    }
+
+    AggregateFunctionPtr function;
+    AggregateStatePool & pool;
+    std::vector<Level> levels;
+    size_t rows = 0;
+};
+
+struct WindowAggregateState : public IWindowFunctionState
+{
+    enum class Mode
+    {
+        // The frame start never moves, the rows entering the frame are added to `place`.
+        Cumulative,
+        // The rows entering the frame are added to `place`, and the rows leaving the frame are removed.
+        Invertible,
+        // The rows entering the frame are appended to `tree`.
+        SegmentTree,
+    };
+
+    WindowAggregateState(const AggregateFunctionPtr & function_, size_t arguments_size)
+        : function(function_)
+        , pool(function_)
+        , tree(function_, pool)
+        , argument_columns(arguments_size)
+    {}
+
+    ~WindowAggregateState() override
+    {
+        if (place)
+            pool.free(place);
+    }
+
+    void reset(const WindowTransformAction & action)
+    {
+        initialized = true;
+        partition_start = action.partition_start;
+        frame_start = action.partition_start;
+        frame_end = action.partition_start;
+        frame_start_pos = 0;
+        not_null_rows = 0;
+
+        if (place)
+        {
+            pool.free(place);
+            place = nullptr;
+        }
+        tree.clear();
+        pool.shrink();
+
+        if (action.window_description.frame.begin_type == WindowFrame::BoundaryType::Unbounded)
+            mode = Mode::Cumulative;
+        else if (function->supportRemove())
+            mode = Mode::Invertible;
+        else
+            mode = Mode::SegmentTree;
+
+        if (mode != Mode::SegmentTree)
+            place = pool.alloc();
+    }
+
+    // Return false if any argument of the row is NULL, otherwise fill `argument_columns` with the
+    // not nullable columns of the arguments.
+    bool fetchArguments(const WindowTransformAction & action, const RowNumber & row, const ColumnNumbers & arguments)
+    {
+        const auto & columns = action.inputAt(row);
+        for (size_t i = 0; i < arguments.size(); ++i)
+        {
+            const IColumn * column = columns[arguments[i]].get();
+            if (column->isColumnNullable())
+            {
+                const auto & nullable_column = static_cast<const ColumnNullable &>(*column);
+                if (nullable_column.isNullAt(row.row))
+                    return false;
+                column = &nullable_column.getNestedColumn();
+            }
+            argument_columns[i] = column;
+        }
+        return true;
+    }
+
+    void addRow(const WindowTransformAction & action, const RowNumber & row, const ColumnNumbers & arguments)
+    {
+        const bool not_null = fetchArguments(action, row, arguments);
+        not_null_rows += not_null;
+        if (mode == Mode::SegmentTree)
+            tree.append(not_null ? argument_columns.data() : nullptr, row.row);
+        else if (not_null)
+            function->add(place, argument_columns.data(), row.row, pool.getArena());
+    }
+
+    void removeRow(const WindowTransformAction & action, const RowNumber & row, const ColumnNumbers & arguments)
+    {
+        RUNTIME_CHECK_MSG(mode != Mode::Cumulative, "the frame start of a cumulative window aggregation should not move");
+        const bool not_null = fetchArguments(action, row, arguments);
+        not_null_rows -= not_null;
+        if (mode == Mode::SegmentTree)
+            ++frame_start_pos;
+        else if (not_null)
+            function->remove(place, argument_columns.data(), row.row, pool.getArena());
+    }
+
+    AggregateFunctionPtr function;
+    // Must be declared before the states.
+    AggregateStatePool pool;
+
+    Mode mode = Mode::Cumulative;
+    AggregateDataPtr place = nullptr;
+    AggregateSegmentTree tree;
+
+    bool initialized = false;
+    RowNumber partition_start;
+    // The rows in [frame_start, frame_end) have been aggregated.
+    RowNumber frame_start;
+    RowNumber frame_end;
+    // The position of `frame_start` in the partition, only used by Mode::SegmentTree.
+    size_t frame_start_pos = 0;
+    // The number of rows in the frame whose arguments are all not NULL.
+    size_t not_null_rows = 0;
+
+    std::vector<const IColumn *> argument_columns;
+};
+} // namespace
+
+WindowFunctionAggregate::WindowFunctionAggregate(const String & name_, const DataTypes & argument_types_)
+    : IWindowFunction(argument_types_)
+    , name(name_)
+{
+    DataTypes nested_types;
+    nested_types.reserve(argument_types.size());
+    for (const auto & type : argument_types)
+        nested_types.push_back(removeNullable(type));
+    nested_function = AggregateFunctionFactory::instance().get(name, nested_types);
+
+    // Like the aggregation, count returns 0 for the empty frame, and the others return NULL.
+    result_is_nullable = name != "count";
+    return_type = result_is_nullable ? makeNullable(nested_function->getReturnType()) : nested_function->getReturnType();
+}
+
+WindowFunctionStatePtr WindowFunctionAggregate::createState() const
+{
+    return std::make_unique<WindowAggregateState>(nested_function, argument_types.size());
+}
+
+void WindowFunctionAggregate::windowInsertResultInto(
+    WindowTransformAction & action,
+    size_t function_index,
+    const ColumnNumbers & arguments)
+{
+    auto & state = static_cast<WindowAggregateState &>(*action.workspaces[function_index].state);
+    if (!state.initialized || !(state.partition_start == action.partition_start))
+        state.reset(action);
+
+    // Both the frame start and the frame end never move backward in a partition. Add the rows entering
+    // the frame first, so the rows to remove have always been added.
+    assert(state.frame_end <= action.frame_end);
+    for (; state.frame_end < action.frame_end; action.advanceRowNumber(state.frame_end))
+        state.addRow(action, state.frame_end, arguments);
+    assert(state.frame_start <= action.frame_start);
+    for (; state.frame_start < action.frame_start; action.advanceRowNumber(state.frame_start))
+        state.removeRow(action, state.frame_start, arguments);
+
+    AggregateDataPtr result_place = state.place;
+    if (state.mode == WindowAggregateState::Mode::SegmentTree)
+    {
+        state.tree.discardBefore(state.frame_start_pos);
+        result_place = state.pool.alloc();
+        state.tree.merge(state.frame_start_pos, state.tree.size(), result_place);
+    }
+    SCOPE_EXIT({
+        if (result_place != state.place)
+            state.pool.free(result_place);
+    });
+
+    IColumn & to = *action.outputAt(action.current_row)[function_index];
+    if (!result_is_nullable)
+    {
+        nested_function->insertResultInto(result_place, to, state.pool.getArena());
+    }
+    else if (state.not_null_rows == 0)
+    {
+        to.insertDefault();
+    }
+    else
+    {
+        auto & nullable_to = assert_cast<ColumnNullable &>(to);
+        nested_function->insertResultInto(result_place, nullable_to.getNestedColumn(), state.pool.getArena());
+        nullable_to.getNullMapData().push_back(0);
+    }
+}
+
+void registerWindowAggregateFunctions(WindowFunctionFactory & factory)
+{
+    for (const auto * name : {"count", "sum", "min", "max", "avg"})
+    {
+        factory.registerFunction(name, [name](const DataTypes & argument_types) {
+            return std::make_shared<WindowFunctionAggregate>(name, argument_types);
+        });
+    }
+}
+} // namespace DB
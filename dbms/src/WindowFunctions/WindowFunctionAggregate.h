@@ -0,0 +1,72 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <AggregateFunctions/IAggregateFunction.h>
+#include <WindowFunctions/IWindowFunction.h>
+
+namespace DB
+{
+class WindowFunctionFactory;
+
+/**
+ * Computes an aggregate function over the window frame, like
+ *   SUM(x) OVER (PARTITION BY p ORDER BY o ROWS BETWEEN 2 PRECEDING AND CURRENT ROW)
+ * by reusing `IAggregateFunction`. How the state follows the frame depends on the frame and the function:
+ *   - The frame starts at UNBOUNDED PRECEDING: the rows entering the frame are added to one state.
+ *   - The function supports `remove` (count, and sum/avg of integers and decimals): the rows leaving
+ *     the frame are also removed from the state.
+ *   - Otherwise (min, max, sum of floats...): the states of the rows are kept in a segment tree, and
+ *     the state of the frame is merged from O(log n) nodes.
+ * So a sliding frame costs O(1) or O(log n) per row instead of O(frame size).
+ * NULL arguments are skipped, and the result of an empty frame is NULL except for count.
+ */
+class WindowFunctionAggregate final : public IWindowFunction
+{
+public:
+    WindowFunctionAggregate(const String & name_, const DataTypes & argument_types_);
+
+    String getName() const override
+    {
+        return name;
+    }
+
+    DataTypePtr getReturnType() const override
+    {
+        return return_type;
+    }
+
+    void windowInsertResultInto(
+        WindowTransformAction & action,
+        size_t function_index,
+        const ColumnNumbers & arguments) override;
+
+    WindowFunctionStatePtr createState() const override;
+
+    void setCollators(TiDB::TiDBCollators & collators) override
+    {
+        nested_function->setCollators(collators);
+    }
+
+private:
+    String name;
+    // Created with the not nullable argument types, the NULL arguments are handled by the window function.
+    AggregateFunctionPtr nested_function;
+    DataTypePtr return_type;
+    bool result_is_nullable;
+};
+
+void registerWindowAggregateFunctions(WindowFunctionFactory & factory);
+} // namespace DB
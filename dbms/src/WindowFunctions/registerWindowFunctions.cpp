@@ -17,11 +17,13 @@
 namespace DB
 {
 void registerWindowFunctions(WindowFunctionFactory & factory);
+void registerWindowAggregateFunctions(WindowFunctionFactory & factory);
 
 void registerWindowFunctions()
 {
     auto & window_factory = WindowFunctionFactory::instance();
     registerWindowFunctions(window_factory);
+    registerWindowAggregateFunctions(window_factory);
 }
 
 } // namespace DB
@@ -0,0 +1,247 @@
+// Copyright 2023 PingCAP, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <TestUtils/ExecutorTestUtils.h>
+
+#include <algorithm>
+
+namespace DB::tests
+{
+class WindowAggregation : public DB::tests::ExecutorTest
+{
+    static const size_t max_concurrency_level = 10;
+
+public:
+    static constexpr auto value_col_name = "value";
+    const ASTPtr value_col = col(value_col_name);
+
+    static MockWindowFrameBound preceding(UInt64 offset) { return {tipb::WindowBoundType::Preceding, false, offset}; }
+    static MockWindowFrameBound following(UInt64 offset) { return {tipb::WindowBoundType::Following, false, offset}; }
+    static MockWindowFrameBound unboundedPreceding() { return {tipb::WindowBoundType::Preceding, true, 0}; }
+    static MockWindowFrameBound unboundedFollowing() { return {tipb::WindowBoundType::Following, true, 0}; }
+    static MockWindowFrameBound currentRow() { return {tipb::WindowBoundType::CurrentRow, false, 0}; }
+
+    static MockWindowFrame rowsFrame(const MockWindowFrameBound & start, const MockWindowFrameBound & end)
+    {
+        return {tipb::WindowFrameType::Rows, start, end};
+    }
+
+    static MockWindowFrame rangeFrame(const MockWindowFrameBound & start, const MockWindowFrameBound & end)
+    {
+        return {tipb::WindowFrameType::Ranges, start, end};
+    }
+
+    void executeWithConcurrencyAndBlockSize(const std::shared_ptr<tipb::DAGRequest> & request, const ColumnsWithTypeAndName & expect_columns)
+    {
+        WRAP_FOR_DIS_ENABLE_PLANNER_BEGIN
+        std::vector<size_t> block_sizes{1, 2, 3, 4, DEFAULT_BLOCK_SIZE};
+        for (auto block_size : block_sizes)
+        {
+            context.context.setSetting("max_block_size", Field(static_cast<UInt64>(block_size)));
+            // The order of the peers in a RANGE frame is not deterministic.
+            ASSERT_COLUMNS_EQ_UR(expect_columns, executeStreams(request));
+            ASSERT_COLUMNS_EQ_UR(expect_columns, executeStreams(request, 2));
+            ASSERT_COLUMNS_EQ_UR(expect_columns, executeStreams(request, max_concurrency_level));
+        }
+        WRAP_FOR_DIS_ENABLE_PLANNER_END
+    }
+
+    void executeFunctionAndAssert(
+        const ColumnWithTypeAndName & result,
+        const ASTPtr & function,
+        const MockWindowFrame & frame,
+        const ColumnsWithTypeAndName & input)
+    {
+        ColumnsWithTypeAndName actual_input = input;
+        assert(actual_input.size() == 3);
+        TiDB::TP value_tp = dataTypeToTP(actual_input[2].type);
+
+        actual_input[0].name = "partition";
+        actual_input[1].name = "order";
+        actual_input[2].name = value_col_name;
+        context.addMockTable(
+            {"test_db", "test_table_for_window_agg"},
+            {{"partition", TiDB::TP::TypeLongLong},
+             {"order", TiDB::TP::TypeLongLong},
+             {value_col_name, value_tp}},
+            actual_input);
+
+        auto request = context
+                           .scan("test_db", "test_table_for_window_agg")
+                           .sort({{"partition", false}, {"order", false}}, true)
+                           .window(function, {"order", false}, {"partition", false}, frame)
+                           .build(context);
+
+        ColumnsWithTypeAndName expect = input;
+        expect.push_back(result);
+        executeWithConcurrencyAndBlockSize(request, expect);
+    }
+
+    // Rows of the tests for ROWS frame.
+    ColumnsWithTypeAndName rowsInput() const
+    {
+        return {
+            toNullableVec<Int64>(/*partition*/ {1, 1, 1, 1, 1, 2, 2, 2}),
+            toNullableVec<Int64>(/*order*/ {1, 2, 3, 4, 5, 1, 2, 3}),
+            toNullableVec<Int64>(/*value*/ {1, 3, 2, {}, 5, 4, 6, 1})};
+    }
+
+    // Rows of the tests for RANGE frame, which have some peers.
+    ColumnsWithTypeAndName rangeInput() const
+    {
+        return {
+            toNullableVec<Int64>(/*partition*/ {1, 1, 1, 1, 1, 2, 2, 2}),
+            toNullableVec<Int64>(/*order*/ {1, 2, 2, 3, 3, 1, 1, 2}),
+            toNullableVec<Int64>(/*value*/ {1, 3, 2, {}, 5, 4, 6, 1})};
+    }
+};
+
+TEST_F(WindowAggregation, runningTotal)
+try
+{
+    executeFunctionAndAssert(
+        toNullableVec<Int64>({1, 4, 6, 6, 11, 4, 10, 11}),
+        Sum(value_col),
+        rowsFrame(unboundedPreceding(), currentRow()),
+        rowsInput());
+    executeFunctionAndAssert(
+        toVec<UInt64>({1, 2, 3, 3, 4, 1, 2, 3}),
+        Count(value_col),
+        rowsFrame(unboundedPreceding(), currentRow()),
+        rowsInput());
+    executeFunctionAndAssert(
+        toNullableVec<Int64>({1, 3, 3, 3, 5, 4, 6, 6}),
+        Max(value_col),
+        rowsFrame(unboundedPreceding(), currentRow()),
+        rowsInput());
+    executeFunctionAndAssert(
+        toNullableVec<Int64>({11, 11, 11, 11, 11, 11, 11, 11}),
+        Sum(value_col),
+        rowsFrame(unboundedPreceding(), unboundedFollowing()),
+        rowsInput());
+}
+CATCH
+
+TEST_F(WindowAggregation, slidingInvertible)
+try
+{
+    executeFunctionAndAssert(
+        toNullableVec<Int64>({1, 4, 5, 2, 5, 4, 10, 7}),
+        Sum(value_col),
+        rowsFrame(preceding(1), currentRow()),
+        rowsInput());
+    executeFunctionAndAssert(
+        toVec<UInt64>({2, 3, 2, 2, 1, 2, 3, 2}),
+        Count(value_col),
+        rowsFrame(preceding(1), following(1)),
+        rowsInput());
+    executeFunctionAndAssert(
+        toNullableVec<Float64>({1, 2, 2.5, 2, 5, 4, 5, 3.5}),
+        Avg(value_col),
+        rowsFrame(preceding(1), currentRow()),
+        rowsInput());
+    // The frame can be empty, or only contain NULL.
+    executeFunctionAndAssert(
+        toNullableVec<Int64>({{}, 1, 4, 5, 2, {}, 4, 10}),
+        Sum(value_col),
+        rowsFrame(preceding(2), preceding(1)),
+        rowsInput());
+    executeFunctionAndAssert(
+        toNullableVec<Int64>({2, 5, 5, {}, {}, 1, {}, {}}),
+        Sum(value_col),
+        rowsFrame(following(2), following(3)),
+        rowsInput());
+    executeFunctionAndAssert(
+        toNullableVec<Int64>({1, 3, 2, {}, 5, 4, 6, 1}),
+        Sum(value_col),
+        rowsFrame(currentRow(), currentRow()),
+        rowsInput());
+}
+CATCH
+
+TEST_F(WindowAggregation, slidingSegmentTree)
+try
+{
+    executeFunctionAndAssert(
+        toNullableVec<Int64>({1, 3, 3, 3, 5, 4, 6, 6}),
+        Max(value_col),
+        rowsFrame(preceding(2), currentRow()),
+        rowsInput());
+    executeFunctionAndAssert(
+        toNullableVec<Int64>({1, 1, 2, 2, 5, 4, 1, 1}),
+        Min(value_col),
+        rowsFrame(preceding(1), following(1)),
+        rowsInput());
+    executeFunctionAndAssert(
+        toNullableVec<Int64>({{}, 1, 3, 2, {}, {}, 4, 6}),
+        Max(value_col),
+        rowsFrame(preceding(1), preceding(1)),
+        rowsInput());
+    executeFunctionAndAssert(
+        toNullableVec<Int64>({1, 2, 2, 5, 5, 1, 1, 1}),
+        Min(value_col),
+        rowsFrame(currentRow(), unboundedFollowing()),
+        rowsInput());
+
+    // A long partition to cover the multi-level nodes and the discarded nodes of the segment tree.
+    const size_t rows = 1000;
+    const size_t offset = 37;
+    std::vector<Int64> partition(rows, 1);
+    std::vector<Int64> order(rows);
+    std::vector<Int64> value(rows);
+    std::vector<Int64> expect(rows);
+    for (size_t i = 0; i < rows; ++i)
+    {
+        order[i] = i;
+        value[i] = (i * 7919) % 1009;
+    }
+    for (size_t i = 0; i < rows; ++i)
+        expect[i] = *std::max_element(value.begin() + (i > offset ? i - offset : 0), value.begin() + i + 1);
+    executeFunctionAndAssert(
+        toNullableVec<Int64>(std::vector<std::optional<Int64>>(expect.begin(), expect.end())),
+        Max(value_col),
+        rowsFrame(preceding(offset), currentRow()),
+        {toNullableVec<Int64>(std::vector<std::optional<Int64>>(partition.begin(), partition.end())),
+         toNullableVec<Int64>(std::vector<std::optional<Int64>>(order.begin(), order.end())),
+         toNullableVec<Int64>(std::vector<std::optional<Int64>>(value.begin(), value.end()))});
+}
+CATCH
+
+TEST_F(WindowAggregation, rangeFrame)
+try
+{
+    executeFunctionAndAssert(
+        toNullableVec<Int64>({1, 6, 6, 11, 11, 10, 10, 11}),
+        Sum(value_col),
+        rangeFrame(unboundedPreceding(), currentRow()),
+        rangeInput());
+    executeFunctionAndAssert(
+        toNullableVec<Int64>({11, 10, 10, 5, 5, 11, 11, 1}),
+        Sum(value_col),
+        rangeFrame(currentRow(), unboundedFollowing()),
+        rangeInput());
+    executeFunctionAndAssert(
+        toNullableVec<Int64>({1, 2, 2, 5, 5, 1, 1, 1}),
+        Min(value_col),
+        rangeFrame(currentRow(), unboundedFollowing()),
+        rangeInput());
+    executeFunctionAndAssert(
+        toVec<UInt64>({1, 2, 2, 1, 1, 2, 2, 1}),
+        Count(value_col),
+        rangeFrame(currentRow(), currentRow()),
+        rangeInput());
+}
+CATCH
+
+} // namespace DB::tests